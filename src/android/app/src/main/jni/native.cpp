@@ -335,7 +335,9 @@ void EmulationSession::RunEmulation() {
         m_is_running = true;
     }
 
-    // Load the disk shader cache.
+    // Load the disk texture and shader caches.
+    m_system.Renderer().ReadRasterizer()->LoadDiskTextureCache(
+        m_system.GetApplicationProcessProgramID());
     if (Settings::values.use_disk_shader_cache.GetValue()) {
         LoadDiskCacheProgress(VideoCore::LoadCallbackStage::Prepare, 0, 0);
         m_system.Renderer().ReadRasterizer()->LoadDiskResources(
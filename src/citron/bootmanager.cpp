@@ -86,6 +86,8 @@ void EmuThread::run() {
     gpu.ObtainContext();
 
     emit LoadProgress(VideoCore::LoadCallbackStage::Prepare, 0, 0);
+    m_system.Renderer().ReadRasterizer()->LoadDiskTextureCache(
+        m_system.GetApplicationProcessProgramID());
     if (Settings::values.use_disk_shader_cache.GetValue()) {
         m_system.Renderer().ReadRasterizer()->LoadDiskResources(
             m_system.GetApplicationProcessProgramID(), stop_token,
@@ -144,6 +144,9 @@ std::unique_ptr<TranslationMap> InitializeTranslations(QWidget* parent) {
            tr("Allows saving shaders to storage for faster loading on following game "
               "boots.\nDisabling "
               "it is only intended for debugging."));
+    INSERT(Settings, use_disk_texture_cache, tr("Use disk texture transcode cache"),
+           tr("Saves textures decoded or recompressed on the CPU (ASTC and BCn) to storage, so "
+              "they are not decoded again on following game boots."));
     INSERT(
         Settings, use_asynchronous_gpu_emulation, tr("Use asynchronous GPU emulation"),
         tr("Uses an extra CPU thread for rendering.\nThis option should always remain enabled."));
@@ -189,6 +192,9 @@ std::unique_ptr<TranslationMap> InitializeTranslations(QWidget* parent) {
     // Renderer (Advanced Graphics)
     INSERT(Settings, async_presentation, tr("Enable asynchronous presentation (Vulkan only)"),
            tr("Slightly improves performance by moving presentation to a separate CPU thread."));
+    INSERT(Settings, gpu_thread_spin_wait, tr("Spin wait on the GPU thread"),
+           tr("Makes the GPU thread briefly spin before sleeping when it runs out of commands.\n"
+              "This reduces the latency of GPU work at the cost of some CPU usage."));
     INSERT(
         Settings, renderer_force_max_clock, tr("Force maximum clocks (Vulkan only)"),
         tr("Runs work in the background while waiting for graphics commands to keep the GPU from "
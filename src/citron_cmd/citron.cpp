@@ -424,6 +424,8 @@ int main(int argc, char** argv) {
     system.GPU().Start();
     system.GetCpuManager().OnGpuReady();
 
+    system.Renderer().ReadRasterizer()->LoadDiskTextureCache(
+        system.GetApplicationProcessProgramID());
     if (Settings::values.use_disk_shader_cache.GetValue()) {
         system.Renderer().ReadRasterizer()->LoadDiskResources(
             system.GetApplicationProcessProgramID(), std::stop_token{},
@@ -0,0 +1,138 @@
+// SPDX-FileCopyrightText: Copyright 2026 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <utility>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "common/fs/mapped_file.h"
+#include "common/fs/path_util.h"
+#include "common/logging/log.h"
+
+namespace Common::FS {
+
+MappedFile::MappedFile() = default;
+
+MappedFile::MappedFile(const std::filesystem::path& path) {
+    Open(path);
+}
+
+MappedFile::~MappedFile() {
+    Close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : data{std::exchange(other.data, nullptr)}, size{std::exchange(other.size, 0)},
+      is_open{std::exchange(other.is_open, false)} {}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        Close();
+        data = std::exchange(other.data, nullptr);
+        size = std::exchange(other.size, 0);
+        is_open = std::exchange(other.is_open, false);
+    }
+    return *this;
+}
+
+bool MappedFile::Open(const std::filesystem::path& path) {
+    Close();
+
+#ifdef _WIN32
+    const HANDLE file = CreateFileW(path.c_str(), GENERIC_READ,
+                                    FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                                    nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        LOG_ERROR(Common_Filesystem, "Failed to open path={}, error={}", PathToUTF8String(path),
+                  GetLastError());
+        return false;
+    }
+    LARGE_INTEGER file_size{};
+    if (!GetFileSizeEx(file, &file_size)) {
+        LOG_ERROR(Common_Filesystem, "Failed to get the size of path={}, error={}",
+                  PathToUTF8String(path), GetLastError());
+        CloseHandle(file);
+        return false;
+    }
+    if (file_size.QuadPart != 0) {
+        // The view keeps the mapping alive after its handles are closed
+        const HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        void* const view =
+            mapping != nullptr ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+        const DWORD error = GetLastError();
+        if (mapping != nullptr) {
+            CloseHandle(mapping);
+        }
+        if (view == nullptr) {
+            LOG_ERROR(Common_Filesystem, "Failed to map path={}, error={}", PathToUTF8String(path),
+                      error);
+            CloseHandle(file);
+            return false;
+        }
+        data = static_cast<const u8*>(view);
+        size = static_cast<size_t>(file_size.QuadPart);
+    }
+    CloseHandle(file);
+#else
+    const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd == -1) {
+        LOG_ERROR(Common_Filesystem, "Failed to open path={}, errno={}", PathToUTF8String(path),
+                  errno);
+        return false;
+    }
+    struct stat file_stat {};
+    if (fstat(fd, &file_stat) != 0) {
+        LOG_ERROR(Common_Filesystem, "Failed to get the size of path={}, errno={}",
+                  PathToUTF8String(path), errno);
+        close(fd);
+        return false;
+    }
+    if (file_stat.st_size != 0) {
+        const size_t file_size = static_cast<size_t>(file_stat.st_size);
+        void* const view = mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (view == MAP_FAILED) {
+            LOG_ERROR(Common_Filesystem, "Failed to map path={}, errno={}", PathToUTF8String(path),
+                      errno);
+            close(fd);
+            return false;
+        }
+        data = static_cast<const u8*>(view);
+        size = file_size;
+    }
+    close(fd);
+#endif
+
+    is_open = true;
+    return true;
+}
+
+void MappedFile::Close() {
+    if (data != nullptr) {
+#ifdef _WIN32
+        UnmapViewOfFile(data);
+#else
+        munmap(const_cast<u8*>(data), size);
+#endif
+    }
+    data = nullptr;
+    size = 0;
+    is_open = false;
+}
+
+bool MappedFile::IsOpen() const {
+    return is_open;
+}
+
+std::span<const u8> MappedFile::Data() const {
+    return {data, size};
+}
+
+} // namespace Common::FS
@@ -0,0 +1,65 @@
+// SPDX-FileCopyrightText: Copyright 2026 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <filesystem>
+#include <span>
+
+#include "common/common_types.h"
+
+namespace Common::FS {
+
+/**
+ * Read-only view of a whole file mapped into memory.
+ * The view is invalidated when the file is closed, and the file must not be resized or replaced
+ * while it is mapped.
+ */
+class MappedFile final {
+public:
+    MappedFile();
+
+    explicit MappedFile(const std::filesystem::path& path);
+
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    /**
+     * Maps the file at path, closing any previously mapped file.
+     * An empty file is opened successfully with an empty view.
+     *
+     * @param path Filesystem path
+     *
+     * @returns True if the file was mapped, false otherwise.
+     */
+    bool Open(const std::filesystem::path& path);
+
+    /// Unmaps the file if it is mapped.
+    void Close();
+
+    /**
+     * Checks whether the file is mapped.
+     *
+     * @returns True if the file is mapped, false otherwise.
+     */
+    [[nodiscard]] bool IsOpen() const;
+
+    /**
+     * Gets the contents of the mapped file.
+     *
+     * @returns The contents of the file, or an empty span if no file is mapped.
+     */
+    [[nodiscard]] std::span<const u8> Data() const;
+
+private:
+    const u8* data{};
+    size_t size{};
+    bool is_open{};
+};
+
+} // namespace Common::FS
@@ -1,6 +1,8 @@
 // SPDX-FileCopyrightText: Copyright 2019 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
+
 #include "common/page_table.h"
 #include "common/scope_exit.h"
 
@@ -47,6 +49,25 @@ bool PageTable::ContinueTraversal(TraversalEntry* out_entry, TraversalContext* c
     return true;
 }
 
+PageTable::Run PageTable::ResolveRun(Common::ProcessAddress address,
+                                    std::size_t max_size) const {
+    std::size_t page = address / page_size;
+    const uintptr_t raw = pointers[page].Raw();
+    const PageType type = PageInfo::ExtractType(raw);
+
+    Run run{PageInfo::ExtractPointer(raw), type,
+            std::min(page_size - (address & (page_size - 1)), max_size)};
+    if (type != PageType::Memory && type != PageType::Unmapped) {
+        return run;
+    }
+    // Memory pages store their host pointer minus their address, so the pages of a contiguous
+    // host allocation have the same page information
+    while (run.size < max_size && pointers[++page].Raw() == raw) {
+        run.size = std::min(run.size + page_size, max_size);
+    }
+    return run;
+}
+
 void PageTable::Resize(std::size_t address_space_width_in_bits, std::size_t page_size_in_bits) {
     const std::size_t num_page_table_entries{1ULL
                                              << (address_space_width_in_bits - page_size_in_bits)};
@@ -101,6 +101,22 @@ struct PageTable {
     PageTable(PageTable&&) noexcept = default;
     PageTable& operator=(PageTable&&) noexcept = default;
 
+    /// Range of consecutive pages sharing the same page information
+    struct Run {
+        uintptr_t pointer{};
+        PageType type{};
+        std::size_t size{};
+    };
+
+    /**
+     * Resolves the pages starting at the given address, up to max_size bytes, as a single run.
+     * Consecutive Memory pages are coalesced while they are backed by contiguous host memory,
+     * and so are consecutive Unmapped pages. Pages of other types form a run on their own, as
+     * they need to be handled one by one.
+     * The whole range must be within the address space.
+     */
+    [[nodiscard]] Run ResolveRun(Common::ProcessAddress address, std::size_t max_size) const;
+
     bool BeginTraversal(TraversalEntry* out_entry, TraversalContext* out_context,
                         Common::ProcessAddress address) const;
     bool ContinueTraversal(TraversalEntry* out_entry, TraversalContext* context) const;
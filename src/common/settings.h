@@ -277,6 +277,8 @@ struct Values {
 
     SwitchableSetting<bool> use_disk_shader_cache{linkage, true, "use_disk_shader_cache",
                                                   Category::Renderer};
+    SwitchableSetting<bool> use_disk_texture_cache{linkage, true, "use_disk_texture_cache",
+                                                   Category::Renderer};
     SwitchableSetting<bool> use_asynchronous_gpu_emulation{
         linkage, true, "use_asynchronous_gpu_emulation", Category::Renderer};
     SwitchableSetting<bool> respect_present_interval_zero{
@@ -400,6 +402,14 @@ struct Values {
                                                false,
 #endif
                                                "async_presentation", Category::RendererAdvanced};
+    SwitchableSetting<bool> gpu_thread_spin_wait{linkage,
+#ifdef ANDROID
+                                                 false,
+#else
+                                                 true,
+#endif
+                                                 "gpu_thread_spin_wait",
+                                                 Category::RendererAdvanced};
     SwitchableSetting<bool> renderer_force_max_clock{linkage, false, "force_max_clock",
                                                      Category::RendererAdvanced};
     SwitchableSetting<bool> use_reactive_flushing{linkage,
@@ -573,6 +583,13 @@ struct Values {
                                         Category::DataStorage};
     Setting<std::string> gamecard_path{linkage, std::string(), "gamecard_path",
                                        Category::DataStorage};
+    // Budget of the decoded NCA block cache in MiB, 0 disables it
+    Setting<u32, true> nca_block_cache_size{linkage, 128, 0, 2048, "nca_block_cache_size",
+                                            Category::DataStorage};
+    Setting<u32, true> romfs_read_ahead_depth{linkage, 4, 0, 16, "romfs_read_ahead_depth",
+                                              Category::DataStorage};
+    Setting<bool> verify_romfs_integrity{linkage, false, "verify_romfs_integrity",
+                                         Category::DataStorage};
 
     // Debugging
     bool record_frame_times;
@@ -586,14 +603,23 @@ struct Values {
         false};
     Setting<bool> dump_macros{
         linkage, false, "dump_macros", Category::DebuggingGraphics, Specialization::Default, false};
+    Setting<bool> profile_macros{linkage, false, "profile_macros", Category::DebuggingGraphics,
+                                 Specialization::Default, false};
     Setting<bool> enable_fs_access_log{linkage, false, "enable_fs_access_log", Category::Debugging};
     Setting<bool> reporting_services{
         linkage, false, "reporting_services", Category::Debugging, Specialization::Default, false};
+    Setting<bool> use_session_executor{linkage, false, "use_session_executor",
+                                       Category::Debugging};
+    Setting<bool> profile_services{linkage, false, "profile_services", Category::Debugging,
+                                   Specialization::Default, false};
     Setting<bool> quest_flag{linkage, false, "quest_flag", Category::Debugging};
     Setting<bool> disable_macro_jit{linkage, false, "disable_macro_jit",
                                     Category::DebuggingGraphics};
     Setting<bool> disable_macro_hle{linkage, false, "disable_macro_hle",
                                     Category::DebuggingGraphics};
+    Setting<bool> disable_macro_threaded_interpreter{linkage, false,
+                                                     "disable_macro_threaded_interpreter",
+                                                     Category::DebuggingGraphics};
     Setting<bool> extended_logging{
         linkage, false, "extended_logging", Category::Debugging, Specialization::Default, false};
     Setting<bool> use_debug_asserts{linkage, false, "use_debug_asserts", Category::Debugging};
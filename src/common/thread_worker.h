@@ -78,6 +78,10 @@ public:
     StatefulThreadWorker& operator=(StatefulThreadWorker&&) = delete;
     StatefulThreadWorker(StatefulThreadWorker&&) = delete;
 
+    size_t NumWorkers() const noexcept {
+        return threads.size();
+    }
+
     void QueueWork(Task work) {
         {
             std::unique_lock lock{queue_mutex};
@@ -147,6 +147,8 @@ static CPUCaps Detect() {
 
             caps.waitpkg = Common::Bit<5>(cpu_id[2]);
             caps.gfni = Common::Bit<8>(cpu_id[2]);
+            // VAES only operates on AVX registers
+            caps.vaes = caps.avx && Common::Bit<9>(cpu_id[2]);
 
             __cpuidex(cpu_id, 0x00000007, 0x00000001);
             caps.avx_vnni = caps.avx && Common::Bit<4>(cpu_id[0]);
@@ -12,11 +12,10 @@
 #include <string>
 #include <thread>
 
-#include <boost/heap/fibonacci_heap.hpp>
-
 #include "common/common_types.h"
 #include "common/thread.h"
 #include "common/wall_clock.h"
+#include "core/core_timing_queue.h"
 
 namespace Core::Timing {
 
@@ -54,10 +53,12 @@ enum class UnscheduleEventType {
  * So to schedule a new event on a regular basis:
  * inside callback:
  *   ScheduleEvent(period_in_ns - ns_late, callback, "whatever")
+ *
+ * The data structure keeping the pending events is selected at construction.
  */
 class CoreTiming {
 public:
-    CoreTiming();
+    explicit CoreTiming(EventQueueType queue_type = EventQueueType::Heap);
     ~CoreTiming();
 
     CoreTiming(const CoreTiming&) = delete;
@@ -139,8 +140,6 @@ public:
 #endif
 
 private:
-    struct Event;
-
     static void ThreadEntry(CoreTiming& instance);
     void ThreadLoop();
 
@@ -154,10 +153,7 @@ private:
     s64 timer_resolution_ns;
 #endif
 
-    using heap_t =
-        boost::heap::fibonacci_heap<CoreTiming::Event, boost::heap::compare<std::greater<>>>;
-
-    heap_t event_queue;
+    std::unique_ptr<EventQueue> event_queue;
     u64 event_fifo_id = 0;
 
     Common::Event event{};
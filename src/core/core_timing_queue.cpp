@@ -0,0 +1,364 @@
+// SPDX-FileCopyrightText: Copyright 2026 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <bit>
+#include <tuple>
+
+#include "common/assert.h"
+#include "core/core_timing_queue.h"
+
+namespace Core::Timing {
+
+EventQueue::~EventQueue() = default;
+
+std::unique_ptr<EventQueue> CreateEventQueue(EventQueueType type) {
+    switch (type) {
+    case EventQueueType::Heap:
+        return std::make_unique<HeapEventQueue>();
+    case EventQueueType::TimingWheel:
+        return std::make_unique<TimingWheelEventQueue>();
+    }
+    UNREACHABLE_MSG("Invalid event queue type={}", static_cast<u32>(type));
+}
+
+struct HeapEventQueue::Entry {
+    Event event;
+    heap_t::handle_type handle{};
+
+    // Sort by time, unless the times are the same, in which case sort by
+    // the order added to the queue
+    friend bool operator>(const Entry& left, const Entry& right) {
+        return std::tie(left.event.time, left.event.fifo_order) >
+               std::tie(right.event.time, right.event.fifo_order);
+    }
+};
+
+HeapEventQueue::HeapEventQueue() = default;
+
+HeapEventQueue::~HeapEventQueue() = default;
+
+void HeapEventQueue::Push(const std::shared_ptr<EventType>& type, s64 time, u64 fifo_order,
+                          s64 reschedule_time) {
+    auto h{heap.emplace(Entry{Event{time, fifo_order, type, reschedule_time}})};
+    (*h).handle = h;
+}
+
+void HeapEventQueue::Remove(const EventType* type) {
+    std::vector<heap_t::handle_type> to_remove;
+    for (auto itr = heap.begin(); itr != heap.end(); itr++) {
+        if (itr->event.type.lock().get() == type) {
+            to_remove.push_back(itr->handle);
+        }
+    }
+    for (auto& h : to_remove) {
+        heap.erase(h);
+    }
+}
+
+void HeapEventQueue::Clear() {
+    heap.clear();
+}
+
+bool HeapEventQueue::Empty() const {
+    return heap.empty();
+}
+
+std::optional<s64> HeapEventQueue::NextTime() const {
+    if (heap.empty()) {
+        return std::nullopt;
+    }
+    return heap.top().event.time;
+}
+
+std::optional<Event> HeapEventQueue::PopDue(s64 time) {
+    if (heap.empty() || heap.top().event.time > time) {
+        return std::nullopt;
+    }
+    Event event = heap.top().event;
+    heap.pop();
+    return event;
+}
+
+namespace {
+
+bool EarlierThan(const Event& left, const Event& right) {
+    return std::tie(left.time, left.fifo_order) < std::tie(right.time, right.fifo_order);
+}
+
+} // Anonymous namespace
+
+TimingWheelEventQueue::TimingWheelEventQueue() = default;
+
+TimingWheelEventQueue::~TimingWheelEventQueue() {
+    Clear();
+    free_nodes.clear();
+}
+
+void TimingWheelEventQueue::Push(const std::shared_ptr<EventType>& type, s64 time,
+                                 u64 fifo_order, s64 reschedule_time) {
+    Node& node = AllocateNode();
+    node.event = Event{time, fifo_order, type, reschedule_time};
+    node.key = type.get();
+    type_lists[node.key].push_back(node);
+    ++num_events;
+    Insert(node);
+}
+
+void TimingWheelEventQueue::Remove(const EventType* type) {
+    const auto it = type_lists.find(type);
+    if (it == type_lists.end()) {
+        return;
+    }
+    TypeList& list = it->second;
+    while (!list.empty()) {
+        Node& node = list.front();
+        Unlink(node);
+        FreeNode(node);
+    }
+}
+
+void TimingWheelEventQueue::Clear() {
+    for (auto& [key, list] : type_lists) {
+        while (!list.empty()) {
+            Node& node = list.front();
+            Unlink(node);
+            FreeNode(node);
+        }
+    }
+    // Drop the lists of event types that may not exist anymore
+    type_lists.clear();
+}
+
+bool TimingWheelEventQueue::Empty() const {
+    return num_events == 0;
+}
+
+std::optional<s64> TimingWheelEventQueue::NextTime() const {
+    if (!ready.empty()) {
+        // Ready events are due before anything left in the wheel
+        return ready.front()->event.time;
+    }
+    std::optional<s64> next_time;
+    const auto visit = [&next_time](const NodeList& list) {
+        for (const Node& node : list) {
+            if (!next_time || node.event.time < *next_time) {
+                next_time = node.event.time;
+            }
+        }
+    };
+    for (size_t level = 0; level < NUM_LEVELS; ++level) {
+        if (occupied[level] == 0) {
+            continue;
+        }
+        // The earliest occupied slot of a level holds the earliest event of that level
+        const s64 shift = static_cast<s64>(level) * LEVEL_SHIFT;
+        const s64 tick = FirstOccupiedTick(level);
+        visit(slots[level * SLOTS_PER_LEVEL + ((tick >> shift) & (SLOTS_PER_LEVEL - 1))]);
+    }
+    visit(overflow);
+    return next_time;
+}
+
+std::optional<Event> TimingWheelEventQueue::PopDue(s64 time) {
+    const auto is_due = [this, time] {
+        return !ready.empty() && ready.front()->event.time <= time;
+    };
+    if (!is_due()) {
+        AdvanceTo(time >> TICK_SHIFT);
+        if (!is_due()) {
+            return std::nullopt;
+        }
+    }
+    Node& node = *ready.front();
+    ReadyErase(node);
+    Event event = std::move(node.event);
+    FreeNode(node);
+    return event;
+}
+
+TimingWheelEventQueue::Node& TimingWheelEventQueue::AllocateNode() {
+    if (free_nodes.empty()) {
+        std::unique_ptr<Node[]>& chunk = chunks.emplace_back(new Node[NODES_PER_CHUNK]);
+        for (size_t i = 0; i < NODES_PER_CHUNK; ++i) {
+            free_nodes.push_back(chunk[i]);
+        }
+    }
+    Node& node = free_nodes.front();
+    free_nodes.pop_front();
+    return node;
+}
+
+void TimingWheelEventQueue::FreeNode(Node& node) {
+    TypeList& list = type_lists.find(node.key)->second;
+    list.erase(list.iterator_to(node));
+    node.event.type.reset();
+    node.key = nullptr;
+    node.location = LOCATION_FREE;
+    free_nodes.push_back(node);
+    --num_events;
+}
+
+void TimingWheelEventQueue::Insert(Node& node) {
+    const s64 tick = node.event.time >> TICK_SHIFT;
+    if (tick <= current_tick) {
+        ReadyPush(node);
+        return;
+    }
+    for (size_t level = 0; level < NUM_LEVELS; ++level) {
+        const s64 shift = static_cast<s64>(level) * LEVEL_SHIFT;
+        if ((tick >> shift) - (current_tick >> shift) >= static_cast<s64>(SLOTS_PER_LEVEL)) {
+            continue;
+        }
+        const size_t index = static_cast<size_t>(tick >> shift) & (SLOTS_PER_LEVEL - 1);
+        const size_t slot = level * SLOTS_PER_LEVEL + index;
+        slots[slot].push_back(node);
+        occupied[level] |= u64{1} << index;
+        node.location = static_cast<u32>(slot);
+        return;
+    }
+    overflow_min_tick = overflow.empty() ? tick : std::min(overflow_min_tick, tick);
+    overflow.push_back(node);
+    node.location = LOCATION_OVERFLOW;
+}
+
+void TimingWheelEventQueue::Unlink(Node& node) {
+    switch (node.location) {
+    case LOCATION_READY:
+        ReadyErase(node);
+        break;
+    case LOCATION_OVERFLOW:
+        // The cached minimum stays a lower bound, it is refreshed on the next rescan
+        overflow.erase(overflow.iterator_to(node));
+        break;
+    default: {
+        NodeList& list = slots[node.location];
+        list.erase(list.iterator_to(node));
+        if (list.empty()) {
+            occupied[node.location / SLOTS_PER_LEVEL] &=
+                ~(u64{1} << (node.location % SLOTS_PER_LEVEL));
+        }
+        break;
+    }
+    }
+    node.location = LOCATION_FREE;
+}
+
+void TimingWheelEventQueue::AdvanceTo(s64 target_tick) {
+    while (current_tick < target_tick) {
+        // Skip empty slots, jumping straight to the next slot that has to be expired or
+        // cascaded to a finer level
+        std::array<s64, NUM_LEVELS> first_ticks{};
+        s64 next_tick = target_tick;
+        for (size_t level = 0; level < NUM_LEVELS; ++level) {
+            if (occupied[level] != 0) {
+                first_ticks[level] = FirstOccupiedTick(level);
+                next_tick = std::min(next_tick, first_ticks[level]);
+            }
+        }
+        const bool rescan_overflow = !overflow.empty() && OverflowWakeTick() <= next_tick;
+        if (rescan_overflow) {
+            next_tick = OverflowWakeTick();
+        }
+        current_tick = next_tick;
+
+        for (size_t level = NUM_LEVELS; level-- > 0;) {
+            if (occupied[level] == 0 || first_ticks[level] != current_tick) {
+                continue;
+            }
+            const s64 shift = static_cast<s64>(level) * LEVEL_SHIFT;
+            const size_t index = static_cast<size_t>(current_tick >> shift) & (SLOTS_PER_LEVEL - 1);
+            occupied[level] &= ~(u64{1} << index);
+            Cascade(slots[level * SLOTS_PER_LEVEL + index]);
+        }
+        if (rescan_overflow) {
+            RescanOverflow();
+        }
+    }
+}
+
+void TimingWheelEventQueue::Cascade(NodeList& list) {
+    while (!list.empty()) {
+        Node& node = list.front();
+        list.pop_front();
+        Insert(node);
+    }
+}
+
+void TimingWheelEventQueue::RescanOverflow() {
+    NodeList pending;
+    pending.splice(pending.end(), overflow);
+    Cascade(pending);
+}
+
+s64 TimingWheelEventQueue::FirstOccupiedTick(size_t level) const {
+    // Occupied slots hold the ticks following the current one, in circular order
+    const s64 shift = static_cast<s64>(level) * LEVEL_SHIFT;
+    const s64 next = (current_tick >> shift) + 1;
+    const int rotation = static_cast<int>(next & static_cast<s64>(SLOTS_PER_LEVEL - 1));
+    const s64 distance = std::countr_zero(std::rotr(occupied[level], rotation));
+    return (next + distance) << shift;
+}
+
+s64 TimingWheelEventQueue::OverflowWakeTick() const {
+    // First tick where the earliest overflowing event fits in the last level
+    constexpr s64 shift = static_cast<s64>(NUM_LEVELS - 1) * LEVEL_SHIFT;
+    return ((overflow_min_tick >> shift) - static_cast<s64>(SLOTS_PER_LEVEL - 1)) << shift;
+}
+
+void TimingWheelEventQueue::ReadyPush(Node& node) {
+    node.location = LOCATION_READY;
+    node.heap_index = static_cast<u32>(ready.size());
+    ready.push_back(&node);
+    ReadySiftUp(ready.size() - 1);
+}
+
+void TimingWheelEventQueue::ReadyErase(Node& node) {
+    const size_t index = node.heap_index;
+    Node* const last = ready.back();
+    ready.pop_back();
+    if (index < ready.size()) {
+        ready[index] = last;
+        last->heap_index = static_cast<u32>(index);
+        ReadySiftUp(index);
+        ReadySiftDown(last->heap_index);
+    }
+}
+
+void TimingWheelEventQueue::ReadySiftUp(size_t index) {
+    Node* const node = ready[index];
+    while (index > 0) {
+        const size_t parent = (index - 1) / 2;
+        if (!EarlierThan(node->event, ready[parent]->event)) {
+            break;
+        }
+        ready[index] = ready[parent];
+        ready[index]->heap_index = static_cast<u32>(index);
+        index = parent;
+    }
+    ready[index] = node;
+    node->heap_index = static_cast<u32>(index);
+}
+
+void TimingWheelEventQueue::ReadySiftDown(size_t index) {
+    Node* const node = ready[index];
+    for (;;) {
+        size_t child = index * 2 + 1;
+        if (child >= ready.size()) {
+            break;
+        }
+        if (child + 1 < ready.size() && EarlierThan(ready[child + 1]->event, ready[child]->event)) {
+            ++child;
+        }
+        if (!EarlierThan(ready[child]->event, node->event)) {
+            break;
+        }
+        ready[index] = ready[child];
+        ready[index]->heap_index = static_cast<u32>(index);
+        index = child;
+    }
+    ready[index] = node;
+    node->heap_index = static_cast<u32>(index);
+}
+
+} // namespace Core::Timing
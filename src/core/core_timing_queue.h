@@ -0,0 +1,166 @@
+// SPDX-FileCopyrightText: Copyright 2026 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/heap/fibonacci_heap.hpp>
+
+#include "common/common_types.h"
+#include "common/intrusive_list.h"
+
+namespace Core::Timing {
+
+struct EventType;
+
+/// Data structure used by CoreTiming to keep its pending events
+enum class EventQueueType {
+    /// Fibonacci heap, cancelling an event searches the whole heap
+    Heap,
+    /// Hierarchical timing wheel with pooled nodes, scheduling and cancelling are O(1)
+    TimingWheel,
+};
+
+/// A scheduled occurrence of an event type
+struct Event {
+    s64 time;
+    u64 fifo_order;
+    std::weak_ptr<EventType> type;
+    s64 reschedule_time;
+};
+
+/**
+ * Queue of pending events, ordered by time and then by the order they were added in.
+ * Implementations are not thread safe, CoreTiming serializes the accesses.
+ */
+class EventQueue {
+public:
+    virtual ~EventQueue();
+
+    /// Adds an event of the given type
+    virtual void Push(const std::shared_ptr<EventType>& type, s64 time, u64 fifo_order,
+                      s64 reschedule_time) = 0;
+
+    /// Removes every pending event of the given type
+    virtual void Remove(const EventType* type) = 0;
+
+    /// Removes every pending event
+    virtual void Clear() = 0;
+
+    [[nodiscard]] virtual bool Empty() const = 0;
+
+    /// Returns the time of the earliest pending event
+    [[nodiscard]] virtual std::optional<s64> NextTime() const = 0;
+
+    /// Removes and returns the earliest pending event when it is due at the given time
+    [[nodiscard]] virtual std::optional<Event> PopDue(s64 time) = 0;
+};
+
+[[nodiscard]] std::unique_ptr<EventQueue> CreateEventQueue(EventQueueType type);
+
+class HeapEventQueue final : public EventQueue {
+public:
+    HeapEventQueue();
+    ~HeapEventQueue() override;
+
+    void Push(const std::shared_ptr<EventType>& type, s64 time, u64 fifo_order,
+              s64 reschedule_time) override;
+    void Remove(const EventType* type) override;
+    void Clear() override;
+    bool Empty() const override;
+    std::optional<s64> NextTime() const override;
+    std::optional<Event> PopDue(s64 time) override;
+
+private:
+    struct Entry;
+
+    using heap_t = boost::heap::fibonacci_heap<Entry, boost::heap::compare<std::greater<>>>;
+
+    heap_t heap;
+};
+
+/**
+ * Hierarchical timing wheel. Level 0 has one slot per tick of 2^TICK_SHIFT nanoseconds, and
+ * each following level has slots covering a whole turn of the previous level. An event is
+ * linked to the finest level able to hold it, and cascades to finer levels as time advances.
+ * Events due in the current tick are moved to a small binary heap, so they are returned in
+ * exactly the same order as HeapEventQueue.
+ * Nodes are pooled and also linked in a list per event type, scheduling and cancelling an
+ * event do not allocate nor search the queue.
+ */
+class TimingWheelEventQueue final : public EventQueue {
+public:
+    static constexpr s64 TICK_SHIFT = 10;
+    static constexpr s64 LEVEL_SHIFT = 6;
+    static constexpr size_t SLOTS_PER_LEVEL = size_t{1} << LEVEL_SHIFT;
+    static constexpr size_t NUM_LEVELS = 6;
+    static constexpr size_t NODES_PER_CHUNK = 256;
+
+    TimingWheelEventQueue();
+    ~TimingWheelEventQueue() override;
+
+    void Push(const std::shared_ptr<EventType>& type, s64 time, u64 fifo_order,
+              s64 reschedule_time) override;
+    void Remove(const EventType* type) override;
+    void Clear() override;
+    bool Empty() const override;
+    std::optional<s64> NextTime() const override;
+    std::optional<Event> PopDue(s64 time) override;
+
+private:
+    static constexpr u32 NUM_SLOTS = static_cast<u32>(NUM_LEVELS * SLOTS_PER_LEVEL);
+    static constexpr u32 LOCATION_READY = NUM_SLOTS;
+    static constexpr u32 LOCATION_OVERFLOW = NUM_SLOTS + 1;
+    static constexpr u32 LOCATION_FREE = NUM_SLOTS + 2;
+
+    struct Node {
+        Event event{};
+        const EventType* key{};
+        u32 location = LOCATION_FREE;
+        u32 heap_index{};
+        Common::IntrusiveListNode list_node;
+        Common::IntrusiveListNode type_node;
+    };
+
+    using NodeList = Common::IntrusiveListMemberTraits<&Node::list_node>::ListType;
+    using TypeList = Common::IntrusiveListMemberTraits<&Node::type_node>::ListType;
+
+    Node& AllocateNode();
+    void FreeNode(Node& node);
+
+    /// Links a node to the wheel, or to the ready heap if it is due in the current tick
+    void Insert(Node& node);
+    void Unlink(Node& node);
+
+    /// Moves the wheel to the given tick, moving the events due until then to the ready heap
+    void AdvanceTo(s64 target_tick);
+    void Cascade(NodeList& list);
+    void RescanOverflow();
+
+    /// Returns the first tick of the earliest occupied slot of a level
+    s64 FirstOccupiedTick(size_t level) const;
+    s64 OverflowWakeTick() const;
+
+    void ReadyPush(Node& node);
+    void ReadyErase(Node& node);
+    void ReadySiftUp(size_t index);
+    void ReadySiftDown(size_t index);
+
+    std::array<NodeList, NUM_SLOTS> slots;
+    std::array<u64, NUM_LEVELS> occupied{};
+    NodeList overflow;
+    s64 overflow_min_tick{};
+    NodeList free_nodes;
+    std::vector<std::unique_ptr<Node[]>> chunks;
+    std::vector<Node*> ready;
+    std::unordered_map<const EventType*, TypeList> type_lists;
+    s64 current_tick{};
+    size_t num_events{};
+};
+
+} // namespace Core::Timing
@@ -0,0 +1,396 @@
+// SPDX-FileCopyrightText: Copyright 2026 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstring>
+#include <utility>
+
+#ifdef ARCHITECTURE_x86_64
+#include <immintrin.h>
+#endif
+
+#include "common/assert.h"
+#include "common/swap.h"
+#include "core/crypto/aes_ni.h"
+
+#ifdef ARCHITECTURE_x86_64
+#include "common/x64/cpu_detect.h"
+#endif
+
+#if defined(ARCHITECTURE_x86_64) && !defined(_MSC_VER)
+#define AESNI_TARGET __attribute__((target("aes,sse4.1")))
+#define VAES_TARGET __attribute__((target("aes,sse4.1,avx2,vaes")))
+#define FORCE_INLINE __attribute__((always_inline)) inline
+#elif defined(_MSC_VER)
+#define AESNI_TARGET
+#define VAES_TARGET
+#define FORCE_INLINE __forceinline
+#else
+#define AESNI_TARGET
+#define VAES_TARGET
+#define FORCE_INLINE inline
+#endif
+
+namespace Core::Crypto::AesNi {
+
+#ifdef ARCHITECTURE_x86_64
+namespace {
+
+constexpr std::size_t BLOCK_SIZE = 0x10;
+constexpr std::size_t LAST_ROUND = KeySchedule::NumRoundKeys - 1;
+constexpr std::size_t BLOCKS_IN_FLIGHT = 8;
+constexpr std::size_t CHUNK_SIZE = BLOCKS_IN_FLIGHT * BLOCK_SIZE;
+
+// Plain structs rather than std::array, which drops the alignment attributes of vector types
+struct RoundKeys {
+    __m128i keys[KeySchedule::NumRoundKeys];
+
+    __m128i operator[](std::size_t round) const {
+        return keys[round];
+    }
+};
+
+struct WideRoundKeys {
+    __m256i keys[KeySchedule::NumRoundKeys];
+
+    VAES_TARGET __m256i operator[](std::size_t round) const {
+        return keys[round];
+    }
+};
+
+AESNI_TARGET RoundKeys LoadRoundKeys(const decltype(KeySchedule::encrypt)& keys) {
+    RoundKeys round_keys;
+    for (std::size_t i = 0; i < KeySchedule::NumRoundKeys; ++i) {
+        round_keys.keys[i] = _mm_load_si128(reinterpret_cast<const __m128i*>(keys.data()) + i);
+    }
+    return round_keys;
+}
+
+VAES_TARGET WideRoundKeys BroadcastRoundKeys(const RoundKeys& round_keys) {
+    WideRoundKeys wide_keys;
+    for (std::size_t i = 0; i < KeySchedule::NumRoundKeys; ++i) {
+        wide_keys.keys[i] = _mm256_broadcastsi128_si256(round_keys[i]);
+    }
+    return wide_keys;
+}
+
+AESNI_TARGET FORCE_INLINE __m128i ExpandStep(__m128i key, __m128i assist) {
+    assist = _mm_shuffle_epi32(assist, 0xFF);
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    return _mm_xor_si128(key, assist);
+}
+
+template <bool encrypt>
+AESNI_TARGET FORCE_INLINE __m128i Round(__m128i block, __m128i key) {
+    return encrypt ? _mm_aesenc_si128(block, key) : _mm_aesdec_si128(block, key);
+}
+
+template <bool encrypt>
+AESNI_TARGET FORCE_INLINE __m128i LastRound(__m128i block, __m128i key) {
+    return encrypt ? _mm_aesenclast_si128(block, key) : _mm_aesdeclast_si128(block, key);
+}
+
+template <bool encrypt>
+VAES_TARGET FORCE_INLINE __m256i Round(__m256i block, __m256i key) {
+    return encrypt ? _mm256_aesenc_epi128(block, key) : _mm256_aesdec_epi128(block, key);
+}
+
+template <bool encrypt>
+VAES_TARGET FORCE_INLINE __m256i LastRound(__m256i block, __m256i key) {
+    return encrypt ? _mm256_aesenclast_epi128(block, key) : _mm256_aesdeclast_epi128(block, key);
+}
+
+// Batches are expanded with index sequences rather than loops, so their blocks stay in registers
+using Batch = std::make_index_sequence<BLOCKS_IN_FLIGHT>;
+using WideBatch = std::make_index_sequence<BLOCKS_IN_FLIGHT / 2>;
+using Single = std::make_index_sequence<1>;
+
+AESNI_TARGET FORCE_INLINE __m128i Load(const u8* src, std::size_t index) {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(src) + index);
+}
+
+VAES_TARGET FORCE_INLINE __m256i LoadWide(const u8* src, std::size_t index) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src) + index);
+}
+
+AESNI_TARGET FORCE_INLINE void Store(u8* dest, std::size_t index, __m128i value) {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dest) + index, value);
+}
+
+VAES_TARGET FORCE_INLINE void Store(u8* dest, std::size_t index, __m256i value) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest) + index, value);
+}
+
+/// Runs the rounds on a batch of blocks, interleaving the blocks for each round key
+template <bool encrypt, std::size_t... I>
+AESNI_TARGET FORCE_INLINE void Rounds(__m128i (&blocks)[sizeof...(I)], const RoundKeys& keys,
+                                      std::index_sequence<I...>) {
+    ((blocks[I] = _mm_xor_si128(blocks[I], keys[0])), ...);
+    for (std::size_t round = 1; round < LAST_ROUND; ++round) {
+        ((blocks[I] = Round<encrypt>(blocks[I], keys[round])), ...);
+    }
+    ((blocks[I] = LastRound<encrypt>(blocks[I], keys[LAST_ROUND])), ...);
+}
+
+/// Runs the rounds on a batch of block pairs, interleaving the pairs for each round key
+template <bool encrypt, std::size_t... I>
+VAES_TARGET FORCE_INLINE void Rounds(__m256i (&blocks)[sizeof...(I)], const WideRoundKeys& keys,
+                                     std::index_sequence<I...>) {
+    ((blocks[I] = _mm256_xor_si256(blocks[I], keys[0])), ...);
+    for (std::size_t round = 1; round < LAST_ROUND; ++round) {
+        ((blocks[I] = Round<encrypt>(blocks[I], keys[round])), ...);
+    }
+    ((blocks[I] = LastRound<encrypt>(blocks[I], keys[LAST_ROUND])), ...);
+}
+
+AESNI_TARGET FORCE_INLINE __m128i EncryptBlock(const RoundKeys& keys, __m128i block) {
+    __m128i blocks[]{block};
+    Rounds<true>(blocks, keys, Single{});
+    return blocks[0];
+}
+
+/// Multiplies an XTS tweak by x in GF(2^128), with the little endian convention of IEEE P1619
+AESNI_TARGET FORCE_INLINE __m128i MultiplyByX(__m128i tweak) {
+    // Carry the top bit of each 32-bit lane into the next one, and reduce the top bit of the
+    // tweak with the polynomial x^7 + x^2 + x + 1
+    __m128i carry = _mm_srai_epi32(tweak, 31);
+    carry = _mm_shuffle_epi32(carry, 0x93);
+    carry = _mm_and_si128(carry, _mm_set_epi32(1, 1, 1, 0x87));
+    return _mm_xor_si128(_mm_add_epi32(tweak, tweak), carry);
+}
+
+/// Returns the tweak and advances it to the tweak of the next block
+AESNI_TARGET FORCE_INLINE __m128i NextTweak(__m128i& tweak) {
+    const __m128i current = tweak;
+    tweak = MultiplyByX(tweak);
+    return current;
+}
+
+/// Returns the tweaks of the next two blocks
+VAES_TARGET FORCE_INLINE __m256i NextTweakPair(__m128i& tweak) {
+    const __m128i first = NextTweak(tweak);
+    const __m128i second = NextTweak(tweak);
+    return _mm256_set_m128i(second, first);
+}
+
+/// Big endian 128-bit counter
+struct Counter {
+    u64 high;
+    u64 low;
+
+    explicit Counter(const u8* bytes) {
+        std::memcpy(&high, bytes, sizeof(high));
+        std::memcpy(&low, bytes + sizeof(high), sizeof(low));
+        high = Common::swap64(high);
+        low = Common::swap64(low);
+    }
+
+    void Store(u8* bytes) const {
+        const u64 high_be = Common::swap64(high);
+        const u64 low_be = Common::swap64(low);
+        std::memcpy(bytes, &high_be, sizeof(high_be));
+        std::memcpy(bytes + sizeof(high_be), &low_be, sizeof(low_be));
+    }
+
+    /// Returns the counter block and increments the counter
+    AESNI_TARGET FORCE_INLINE __m128i Next() {
+        const __m128i swap_mask =
+            _mm_set_epi8(8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7);
+        const __m128i block = _mm_shuffle_epi8(
+            _mm_set_epi64x(static_cast<s64>(low), static_cast<s64>(high)), swap_mask);
+        if (++low == 0) {
+            ++high;
+        }
+        return block;
+    }
+
+    /// Returns the next two counter blocks
+    VAES_TARGET FORCE_INLINE __m256i NextPair() {
+        const __m128i first = Next();
+        const __m128i second = Next();
+        return _mm256_set_m128i(second, first);
+    }
+};
+
+template <std::size_t... I>
+AESNI_TARGET FORCE_INLINE void CtrChunk(const RoundKeys& keys, Counter& counter, const u8* src,
+                                        u8* dest, std::index_sequence<I...> batch) {
+    // Braced initializers are evaluated in order
+    __m128i blocks[]{(static_cast<void>(I), counter.Next())...};
+    Rounds<true>(blocks, keys, batch);
+    (Store(dest, I, _mm_xor_si128(Load(src, I), blocks[I])), ...);
+}
+
+template <std::size_t... I>
+VAES_TARGET FORCE_INLINE void CtrChunk(const WideRoundKeys& keys, Counter& counter, const u8* src,
+                                       u8* dest, std::index_sequence<I...> batch) {
+    __m256i blocks[]{(static_cast<void>(I), counter.NextPair())...};
+    Rounds<true>(blocks, keys, batch);
+    (Store(dest, I, _mm256_xor_si256(LoadWide(src, I), blocks[I])), ...);
+}
+
+AESNI_TARGET void CtrTail(const RoundKeys& keys, Counter& counter, const u8* src, u8* dest,
+                          std::size_t size) {
+    for (; size >= BLOCK_SIZE; src += BLOCK_SIZE, dest += BLOCK_SIZE, size -= BLOCK_SIZE) {
+        CtrChunk(keys, counter, src, dest, Single{});
+    }
+    if (size > 0) {
+        std::array<u8, BLOCK_SIZE> block{};
+        std::memcpy(block.data(), src, size);
+        CtrChunk(keys, counter, block.data(), block.data(), Single{});
+        std::memcpy(dest, block.data(), size);
+    }
+}
+
+AESNI_TARGET void CtrAesNi(const RoundKeys& keys, Counter& counter, const u8* src, u8* dest,
+                           std::size_t size) {
+    for (; size >= CHUNK_SIZE; src += CHUNK_SIZE, dest += CHUNK_SIZE, size -= CHUNK_SIZE) {
+        CtrChunk(keys, counter, src, dest, Batch{});
+    }
+    CtrTail(keys, counter, src, dest, size);
+}
+
+VAES_TARGET void CtrVaes(const RoundKeys& keys, Counter& counter, const u8* src, u8* dest,
+                         std::size_t size) {
+    const WideRoundKeys wide_keys = BroadcastRoundKeys(keys);
+    for (; size >= CHUNK_SIZE; src += CHUNK_SIZE, dest += CHUNK_SIZE, size -= CHUNK_SIZE) {
+        CtrChunk(wide_keys, counter, src, dest, WideBatch{});
+    }
+    CtrTail(keys, counter, src, dest, size);
+}
+
+template <bool encrypt, std::size_t... I>
+AESNI_TARGET FORCE_INLINE void XtsChunk(const RoundKeys& keys, __m128i& tweak, const u8* src,
+                                        u8* dest, std::index_sequence<I...> batch) {
+    const __m128i tweaks[]{(static_cast<void>(I), NextTweak(tweak))...};
+    __m128i blocks[]{_mm_xor_si128(Load(src, I), tweaks[I])...};
+    Rounds<encrypt>(blocks, keys, batch);
+    (Store(dest, I, _mm_xor_si128(blocks[I], tweaks[I])), ...);
+}
+
+template <bool encrypt, std::size_t... I>
+VAES_TARGET FORCE_INLINE void XtsChunk(const WideRoundKeys& keys, __m128i& tweak, const u8* src,
+                                       u8* dest, std::index_sequence<I...> batch) {
+    const __m256i tweaks[]{(static_cast<void>(I), NextTweakPair(tweak))...};
+    __m256i blocks[]{_mm256_xor_si256(LoadWide(src, I), tweaks[I])...};
+    Rounds<encrypt>(blocks, keys, batch);
+    (Store(dest, I, _mm256_xor_si256(blocks[I], tweaks[I])), ...);
+}
+
+template <bool encrypt>
+AESNI_TARGET void XtsAesNi(const RoundKeys& keys, __m128i tweak, const u8* src, u8* dest,
+                           std::size_t size) {
+    for (; size >= CHUNK_SIZE; src += CHUNK_SIZE, dest += CHUNK_SIZE, size -= CHUNK_SIZE) {
+        XtsChunk<encrypt>(keys, tweak, src, dest, Batch{});
+    }
+    for (; size > 0; src += BLOCK_SIZE, dest += BLOCK_SIZE, size -= BLOCK_SIZE) {
+        XtsChunk<encrypt>(keys, tweak, src, dest, Single{});
+    }
+}
+
+template <bool encrypt>
+VAES_TARGET void XtsVaes(const RoundKeys& keys, __m128i tweak, const u8* src, u8* dest,
+                         std::size_t size) {
+    const WideRoundKeys wide_keys = BroadcastRoundKeys(keys);
+    for (; size >= CHUNK_SIZE; src += CHUNK_SIZE, dest += CHUNK_SIZE, size -= CHUNK_SIZE) {
+        XtsChunk<encrypt>(wide_keys, tweak, src, dest, WideBatch{});
+    }
+    XtsAesNi<encrypt>(keys, tweak, src, dest, size);
+}
+
+} // Anonymous namespace
+
+bool IsSupported() {
+    const auto& caps = Common::GetCPUCaps();
+    return caps.aes && caps.sse4_1;
+}
+
+bool IsVaesSupported() {
+    const auto& caps = Common::GetCPUCaps();
+    return IsSupported() && caps.avx2 && caps.vaes;
+}
+
+AESNI_TARGET void ExpandKey(const u8* key, KeySchedule& schedule) {
+    __m128i keys[KeySchedule::NumRoundKeys];
+    keys[0] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(key));
+    // The round constant of the key generation must be an immediate
+    keys[1] = ExpandStep(keys[0], _mm_aeskeygenassist_si128(keys[0], 0x01));
+    keys[2] = ExpandStep(keys[1], _mm_aeskeygenassist_si128(keys[1], 0x02));
+    keys[3] = ExpandStep(keys[2], _mm_aeskeygenassist_si128(keys[2], 0x04));
+    keys[4] = ExpandStep(keys[3], _mm_aeskeygenassist_si128(keys[3], 0x08));
+    keys[5] = ExpandStep(keys[4], _mm_aeskeygenassist_si128(keys[4], 0x10));
+    keys[6] = ExpandStep(keys[5], _mm_aeskeygenassist_si128(keys[5], 0x20));
+    keys[7] = ExpandStep(keys[6], _mm_aeskeygenassist_si128(keys[6], 0x40));
+    keys[8] = ExpandStep(keys[7], _mm_aeskeygenassist_si128(keys[7], 0x80));
+    keys[9] = ExpandStep(keys[8], _mm_aeskeygenassist_si128(keys[8], 0x1B));
+    keys[10] = ExpandStep(keys[9], _mm_aeskeygenassist_si128(keys[9], 0x36));
+
+    // The equivalent inverse cipher uses the round keys in reverse order, with InvMixColumns
+    // applied to the inner ones
+    auto* const encrypt = reinterpret_cast<__m128i*>(schedule.encrypt.data());
+    auto* const decrypt = reinterpret_cast<__m128i*>(schedule.decrypt.data());
+    for (std::size_t i = 0; i < KeySchedule::NumRoundKeys; ++i) {
+        _mm_store_si128(encrypt + i, keys[i]);
+        const __m128i round_key = keys[LAST_ROUND - i];
+        _mm_store_si128(decrypt + i,
+                        i == 0 || i == LAST_ROUND ? round_key : _mm_aesimc_si128(round_key));
+    }
+}
+
+void CtrTranscode(const KeySchedule& key, u8* counter, const u8* src, u8* dest, std::size_t size,
+                  bool use_vaes) {
+    const RoundKeys keys = LoadRoundKeys(key.encrypt);
+    Counter ctr{counter};
+    if (use_vaes) {
+        CtrVaes(keys, ctr, src, dest, size);
+    } else {
+        CtrAesNi(keys, ctr, src, dest, size);
+    }
+    ctr.Store(counter);
+}
+
+AESNI_TARGET void XtsTranscode(const KeySchedule& data_key, const KeySchedule& tweak_key,
+                               const u8* iv, const u8* src, u8* dest, std::size_t size, Op op,
+                               bool use_vaes) {
+    ASSERT(size % BLOCK_SIZE == 0);
+    const __m128i tweak = EncryptBlock(LoadRoundKeys(tweak_key.encrypt),
+                                       _mm_loadu_si128(reinterpret_cast<const __m128i*>(iv)));
+    if (op == Op::Encrypt) {
+        const RoundKeys keys = LoadRoundKeys(data_key.encrypt);
+        use_vaes ? XtsVaes<true>(keys, tweak, src, dest, size)
+                 : XtsAesNi<true>(keys, tweak, src, dest, size);
+    } else {
+        const RoundKeys keys = LoadRoundKeys(data_key.decrypt);
+        use_vaes ? XtsVaes<false>(keys, tweak, src, dest, size)
+                 : XtsAesNi<false>(keys, tweak, src, dest, size);
+    }
+}
+
+#else
+
+bool IsSupported() {
+    return false;
+}
+
+bool IsVaesSupported() {
+    return false;
+}
+
+void ExpandKey(const u8* key, KeySchedule& schedule) {
+    UNREACHABLE_MSG("AES-NI is not available on this host");
+}
+
+void CtrTranscode(const KeySchedule& key, u8* counter, const u8* src, u8* dest, std::size_t size,
+                  bool use_vaes) {
+    UNREACHABLE_MSG("AES-NI is not available on this host");
+}
+
+void XtsTranscode(const KeySchedule& data_key, const KeySchedule& tweak_key, const u8* iv,
+                  const u8* src, u8* dest, std::size_t size, Op op, bool use_vaes) {
+    UNREACHABLE_MSG("AES-NI is not available on this host");
+}
+
+#endif
+
+} // namespace Core::Crypto::AesNi
@@ -0,0 +1,47 @@
+// SPDX-FileCopyrightText: Copyright 2026 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#include "common/common_types.h"
+#include "core/crypto/aes_util.h"
+
+// Native AES-128 engine using the AES instructions of x86-64 hosts. Each loop iteration keeps
+// eight blocks in flight, to hide the latency of the round instructions.
+namespace Core::Crypto::AesNi {
+
+/// Expanded round keys of an AES-128 key
+struct KeySchedule {
+    static constexpr std::size_t NumRoundKeys = 11;
+
+    alignas(16) std::array<u8, NumRoundKeys * 0x10> encrypt;
+    alignas(16) std::array<u8, NumRoundKeys * 0x10> decrypt;
+};
+
+/// Returns true when the host supports AES-NI
+[[nodiscard]] bool IsSupported();
+
+/// Returns true when the host supports VAES, running AES on two blocks per instruction
+[[nodiscard]] bool IsVaesSupported();
+
+/// Expands a 16 bytes key, the host must support AES-NI
+void ExpandKey(const u8* key, KeySchedule& schedule);
+
+/**
+ * Transcodes data in CTR mode. The big endian counter is advanced by the number of blocks started,
+ * the keystream of a partial last block is discarded.
+ */
+void CtrTranscode(const KeySchedule& key, u8* counter, const u8* src, u8* dest, std::size_t size,
+                  bool use_vaes);
+
+/**
+ * Transcodes a data unit in XTS mode. The tweak is the encryption of iv with the tweak key.
+ * The size must be a multiple of the block size, ciphertext stealing is not supported.
+ */
+void XtsTranscode(const KeySchedule& data_key, const KeySchedule& tweak_key, const u8* iv,
+                  const u8* src, u8* dest, std::size_t size, Op op, bool use_vaes);
+
+} // namespace Core::Crypto::AesNi
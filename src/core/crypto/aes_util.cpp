@@ -1,10 +1,13 @@
 // SPDX-FileCopyrightText: Copyright 2018 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
 #include <array>
+#include <cstring>
 #include <mbedtls/cipher.h>
 #include "common/assert.h"
 #include "common/logging/log.h"
+#include "core/crypto/aes_ni.h"
 #include "core/crypto/aes_util.h"
 #include "core/crypto/key_manager.h"
 
@@ -20,8 +23,39 @@ NintendoTweak CalculateNintendoTweak(std::size_t sector_id) {
     }
     return out;
 }
+
+/// Picks the backend running a cipher, only AES-128 CTR and XTS have a native implementation
+AesBackend ResolveBackend(AesBackend requested, Mode mode, std::size_t key_size) {
+    const bool has_native = (mode == Mode::CTR && key_size == 0x10) ||
+                            (mode == Mode::XTS && key_size == 0x20);
+    if (!has_native) {
+        return AesBackend::Mbedtls;
+    }
+    if (requested == AesBackend::Auto) {
+        for (const AesBackend backend : {AesBackend::Vaes, AesBackend::AesNi}) {
+            if (IsAesBackendSupported(backend)) {
+                return backend;
+            }
+        }
+        return AesBackend::Mbedtls;
+    }
+    return IsAesBackendSupported(requested) ? requested : AesBackend::Mbedtls;
+}
 } // Anonymous namespace
 
+bool IsAesBackendSupported(AesBackend backend) {
+    switch (backend) {
+    case AesBackend::Auto:
+    case AesBackend::Mbedtls:
+        return true;
+    case AesBackend::AesNi:
+        return AesNi::IsSupported();
+    case AesBackend::Vaes:
+        return AesNi::IsVaesSupported();
+    }
+    return false;
+}
+
 static_assert(static_cast<std::size_t>(Mode::CTR) ==
                   static_cast<std::size_t>(MBEDTLS_CIPHER_AES_128_CTR),
               "CTR has incorrect value.");
@@ -36,10 +70,18 @@ static_assert(static_cast<std::size_t>(Mode::XTS) ==
 struct CipherContext {
     mbedtls_cipher_context_t encryption_context;
     mbedtls_cipher_context_t decryption_context;
+
+    // State of the native backends, the mbedtls contexts stay set up for the fallback paths
+    AesBackend backend;
+    Mode mode;
+    AesNi::KeySchedule data_key;
+    AesNi::KeySchedule tweak_key;
+    std::array<u8, 0x10> encryption_iv;
+    std::array<u8, 0x10> decryption_iv;
 };
 
 template <typename Key, std::size_t KeySize>
-Crypto::AESCipher<Key, KeySize>::AESCipher(Key key, Mode mode)
+Crypto::AESCipher<Key, KeySize>::AESCipher(Key key, Mode mode, AesBackend backend)
     : ctx(std::make_unique<CipherContext>()) {
     mbedtls_cipher_init(&ctx->encryption_context);
     mbedtls_cipher_init(&ctx->decryption_context);
@@ -57,6 +99,18 @@ Crypto::AESCipher<Key, KeySize>::AESCipher(Key key, Mode mode)
     ASSERT(
         !mbedtls_cipher_setkey(&ctx->decryption_context, key.data(), KeySize * 8, MBEDTLS_DECRYPT));
     //"Failed to set key on mbedtls ciphers.");
+
+    ctx->backend = ResolveBackend(backend, mode, KeySize);
+    ctx->mode = mode;
+    ctx->encryption_iv = {};
+    ctx->decryption_iv = {};
+    if (ctx->backend != AesBackend::Mbedtls) {
+        // XTS keys are the data key followed by the tweak key
+        AesNi::ExpandKey(key.data(), ctx->data_key);
+        if (mode == Mode::XTS) {
+            AesNi::ExpandKey(key.data() + 0x10, ctx->tweak_key);
+        }
+    }
 }
 
 template <typename Key, std::size_t KeySize>
@@ -65,8 +119,29 @@ AESCipher<Key, KeySize>::~AESCipher() {
     mbedtls_cipher_free(&ctx->decryption_context);
 }
 
+template <typename Key, std::size_t KeySize>
+AesBackend AESCipher<Key, KeySize>::GetBackend() const {
+    return ctx->backend;
+}
+
 template <typename Key, std::size_t KeySize>
 void AESCipher<Key, KeySize>::Transcode(const u8* src, std::size_t size, u8* dest, Op op) const {
+    if (ctx->backend != AesBackend::Mbedtls) {
+        // Like mbedtls, each context keeps its own counter, advanced by the blocks transcoded
+        auto& iv = op == Op::Encrypt ? ctx->encryption_iv : ctx->decryption_iv;
+        const bool use_vaes = ctx->backend == AesBackend::Vaes;
+        if (ctx->mode == Mode::CTR) {
+            AesNi::CtrTranscode(ctx->data_key, iv.data(), src, dest, size, use_vaes);
+            return;
+        }
+        // Ciphertext stealing is left to mbedtls
+        if (size % 0x10 == 0) {
+            AesNi::XtsTranscode(ctx->data_key, ctx->tweak_key, iv.data(), src, dest, size, op,
+                                use_vaes);
+            return;
+        }
+    }
+
     auto* const context = op == Op::Encrypt ? &ctx->encryption_context : &ctx->decryption_context;
 
     mbedtls_cipher_reset(context);
@@ -111,6 +186,17 @@ void AESCipher<Key, KeySize>::XTSTranscode(const u8* src, std::size_t size, u8*
                                            std::size_t sector_id, std::size_t sector_size, Op op) {
     ASSERT_MSG(size % sector_size == 0, "XTS decryption size must be a multiple of sector size.");
 
+    if (ctx->backend != AesBackend::Mbedtls && sector_size % 0x10 == 0) {
+        // Skip setting the IV of the mbedtls contexts for every sector
+        const bool use_vaes = ctx->backend == AesBackend::Vaes;
+        for (std::size_t i = 0; i < size; i += sector_size) {
+            const NintendoTweak tweak = CalculateNintendoTweak(sector_id++);
+            AesNi::XtsTranscode(ctx->data_key, ctx->tweak_key, tweak.data(), src + i, dest + i,
+                                sector_size, op, use_vaes);
+        }
+        return;
+    }
+
     for (std::size_t i = 0; i < size; i += sector_size) {
         SetIV(CalculateNintendoTweak(sector_id++));
         Transcode(src + i, sector_size, dest + i, op);
@@ -122,6 +208,10 @@ void AESCipher<Key, KeySize>::SetIV(std::span<const u8> data) {
     ASSERT_MSG((mbedtls_cipher_set_iv(&ctx->encryption_context, data.data(), data.size()) ||
                 mbedtls_cipher_set_iv(&ctx->decryption_context, data.data(), data.size())) == 0,
                "Failed to set IV on mbedtls ciphers.");
+
+    const std::size_t iv_size = std::min(data.size(), ctx->encryption_iv.size());
+    std::memcpy(ctx->encryption_iv.data(), data.data(), iv_size);
+    std::memcpy(ctx->decryption_iv.data(), data.data(), iv_size);
 }
 
 template class AESCipher<Key128>;
@@ -24,15 +24,29 @@ enum class Op {
     Decrypt,
 };
 
+/// Implementation used to run the cipher
+enum class AesBackend {
+    Auto,    ///< Fastest backend supported by the host for the mode
+    Mbedtls, ///< Portable software implementation
+    AesNi,   ///< Native CTR and XTS using the AES instructions of x86-64 hosts
+    Vaes,    ///< Native CTR and XTS processing two blocks per instruction with VAES
+};
+
+/// Returns true when the host can run the given backend
+[[nodiscard]] bool IsAesBackendSupported(AesBackend backend);
+
 template <typename Key, std::size_t KeySize = sizeof(Key)>
 class AESCipher {
     static_assert(std::is_same_v<Key, std::array<u8, KeySize>>, "Key must be std::array of u8.");
     static_assert(KeySize == 0x10 || KeySize == 0x20, "KeySize must be 128 or 256.");
 
 public:
-    AESCipher(Key key, Mode mode);
+    AESCipher(Key key, Mode mode, AesBackend backend = AesBackend::Auto);
     ~AESCipher();
 
+    /// Returns the backend running the cipher, modes without a native implementation use mbedtls
+    [[nodiscard]] AesBackend GetBackend() const;
+
     void SetIV(std::span<const u8> data);
 
     template <typename Source, typename Dest>
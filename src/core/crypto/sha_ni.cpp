@@ -0,0 +1,366 @@
+// SPDX-FileCopyrightText: Copyright 2026 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#ifdef ARCHITECTURE_x86_64
+#include <immintrin.h>
+#endif
+
+#include "common/assert.h"
+#include "core/crypto/sha_ni.h"
+
+#ifdef ARCHITECTURE_x86_64
+#include "common/x64/cpu_detect.h"
+#endif
+
+#if defined(ARCHITECTURE_x86_64) && !defined(_MSC_VER)
+#define SHANI_TARGET __attribute__((target("sha,sse4.1")))
+#define AVX2_TARGET __attribute__((target("avx2")))
+#define FORCE_INLINE __attribute__((always_inline)) inline
+#elif defined(_MSC_VER)
+#define SHANI_TARGET
+#define AVX2_TARGET
+#define FORCE_INLINE __forceinline
+#else
+#define SHANI_TARGET
+#define AVX2_TARGET
+#define FORCE_INLINE inline
+#endif
+
+namespace Core::Crypto::ShaNi {
+
+#ifdef ARCHITECTURE_x86_64
+namespace {
+
+constexpr std::size_t BLOCK_SIZE = 0x40;
+constexpr std::size_t NUM_ROUNDS = 64;
+constexpr std::size_t SHANI_LANES = 2;
+constexpr std::size_t AVX2_LANES = 8;
+
+using State = std::array<u32, 8>;
+
+constexpr State INITIAL_STATE{0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                              0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+
+alignas(16) constexpr std::array<u32, NUM_ROUNDS> ROUND_CONSTANTS{
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4,
+    0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe,
+    0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f,
+    0x4a7484aa, 0x5cb0a9dc, 0x76f988da, 0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7,
+    0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc,
+    0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+    0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070, 0x19a4c116,
+    0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7,
+    0xc67178f2};
+
+// Plain structs rather than std::array, which drops the alignment attributes of vector types
+struct ShaNiLane {
+    __m128i abef;
+    __m128i cdgh;
+    __m128i message[4];
+};
+
+struct Avx2Lanes {
+    __m256i state[8];
+    __m256i schedule[16];
+};
+
+SHANI_TARGET FORCE_INLINE void LoadLane(ShaNiLane& lane, const State& state) {
+    const __m128i abcd = _mm_shuffle_epi32(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(state.data())), 0xB1);
+    const __m128i efgh = _mm_shuffle_epi32(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(state.data() + 4)), 0x1B);
+    lane.abef = _mm_alignr_epi8(abcd, efgh, 8);
+    lane.cdgh = _mm_blend_epi16(efgh, abcd, 0xF0);
+}
+
+SHANI_TARGET FORCE_INLINE void StoreLane(const ShaNiLane& lane, State& state) {
+    const __m128i feba = _mm_shuffle_epi32(lane.abef, 0x1B);
+    const __m128i dchg = _mm_shuffle_epi32(lane.cdgh, 0xB1);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(state.data()), _mm_blend_epi16(feba, dchg, 0xF0));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(state.data() + 4), _mm_alignr_epi8(dchg, feba, 8));
+}
+
+SHANI_TARGET FORCE_INLINE void LoadMessage(ShaNiLane& lane, const u8* block) {
+    const __m128i byte_swap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+    for (std::size_t i = 0; i < 4; ++i) {
+        lane.message[i] = _mm_shuffle_epi8(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(block) + i), byte_swap);
+    }
+}
+
+/// Runs rounds 4 * Group to 4 * Group + 3, extending the message schedule past the first block
+template <std::size_t Group>
+SHANI_TARGET FORCE_INLINE void RoundGroup(ShaNiLane& lane) {
+    __m128i& words = lane.message[Group % 4];
+    if constexpr (Group >= 4) {
+        const __m128i previous = lane.message[(Group + 3) % 4];
+        words = _mm_sha256msg1_epu32(words, lane.message[(Group + 1) % 4]);
+        words = _mm_add_epi32(words, _mm_alignr_epi8(previous, lane.message[(Group + 2) % 4], 4));
+        words = _mm_sha256msg2_epu32(words, previous);
+    }
+    __m128i round_input = _mm_add_epi32(
+        words, _mm_load_si128(reinterpret_cast<const __m128i*>(ROUND_CONSTANTS.data()) + Group));
+    lane.cdgh = _mm_sha256rnds2_epu32(lane.cdgh, lane.abef, round_input);
+    round_input = _mm_shuffle_epi32(round_input, 0x0E);
+    lane.abef = _mm_sha256rnds2_epu32(lane.abef, lane.cdgh, round_input);
+}
+
+template <std::size_t Group, std::size_t... Lanes>
+SHANI_TARGET FORCE_INLINE void RoundGroupLanes(ShaNiLane* lanes, std::index_sequence<Lanes...>) {
+    (RoundGroup<Group>(lanes[Lanes]), ...);
+}
+
+template <std::size_t NumLanes, std::size_t... Groups>
+SHANI_TARGET FORCE_INLINE void AllRounds(ShaNiLane* lanes, std::index_sequence<Groups...>) {
+    (RoundGroupLanes<Groups>(lanes, std::make_index_sequence<NumLanes>{}), ...);
+}
+
+/// Compresses the blocks of each lane, interleaving the rounds of the lanes
+template <std::size_t NumLanes>
+SHANI_TARGET void CompressShaNi(State* states, const u8* const* data, std::size_t num_blocks) {
+    ShaNiLane lanes[NumLanes];
+    for (std::size_t i = 0; i < NumLanes; ++i) {
+        LoadLane(lanes[i], states[i]);
+    }
+    for (std::size_t block = 0; block < num_blocks; ++block) {
+        ShaNiLane saved[NumLanes];
+        for (std::size_t i = 0; i < NumLanes; ++i) {
+            saved[i] = lanes[i];
+            LoadMessage(lanes[i], data[i] + block * BLOCK_SIZE);
+        }
+        AllRounds<NumLanes>(lanes, std::make_index_sequence<NUM_ROUNDS / 4>{});
+        for (std::size_t i = 0; i < NumLanes; ++i) {
+            lanes[i].abef = _mm_add_epi32(lanes[i].abef, saved[i].abef);
+            lanes[i].cdgh = _mm_add_epi32(lanes[i].cdgh, saved[i].cdgh);
+        }
+    }
+    for (std::size_t i = 0; i < NumLanes; ++i) {
+        StoreLane(lanes[i], states[i]);
+    }
+}
+
+template <int Bits>
+AVX2_TARGET FORCE_INLINE __m256i RotateRight(__m256i value) {
+    return _mm256_or_si256(_mm256_srli_epi32(value, Bits), _mm256_slli_epi32(value, 32 - Bits));
+}
+
+AVX2_TARGET FORCE_INLINE __m256i Xor3(__m256i a, __m256i b, __m256i c) {
+    return _mm256_xor_si256(_mm256_xor_si256(a, b), c);
+}
+
+/// Loads eight words of each lane, transposed so each vector holds one word of every lane
+AVX2_TARGET FORCE_INLINE void LoadTransposed(__m256i* words, const u8* const* data,
+                                             std::size_t offset) {
+    const __m256i byte_swap = _mm256_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL,
+                                                0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+    __m256i rows[AVX2_LANES];
+    for (std::size_t i = 0; i < AVX2_LANES; ++i) {
+        rows[i] = _mm256_shuffle_epi8(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data[i] + offset)), byte_swap);
+    }
+    __m256i pairs[AVX2_LANES];
+    for (std::size_t i = 0; i < AVX2_LANES; i += 2) {
+        pairs[i] = _mm256_unpacklo_epi32(rows[i], rows[i + 1]);
+        pairs[i + 1] = _mm256_unpackhi_epi32(rows[i], rows[i + 1]);
+    }
+    __m256i quads[AVX2_LANES];
+    for (std::size_t i = 0; i < AVX2_LANES; i += 4) {
+        quads[i] = _mm256_unpacklo_epi64(pairs[i], pairs[i + 2]);
+        quads[i + 1] = _mm256_unpackhi_epi64(pairs[i], pairs[i + 2]);
+        quads[i + 2] = _mm256_unpacklo_epi64(pairs[i + 1], pairs[i + 3]);
+        quads[i + 3] = _mm256_unpackhi_epi64(pairs[i + 1], pairs[i + 3]);
+    }
+    for (std::size_t i = 0; i < 4; ++i) {
+        words[i] = _mm256_permute2x128_si256(quads[i], quads[i + 4], 0x20);
+        words[i + 4] = _mm256_permute2x128_si256(quads[i], quads[i + 4], 0x31);
+    }
+}
+
+/// Compresses the blocks of eight lanes at once, each 32-bit lane of the vectors is one message
+AVX2_TARGET void CompressAvx2(State* states, const u8* const* data, std::size_t num_blocks) {
+    Avx2Lanes lanes;
+    for (std::size_t word = 0; word < 8; ++word) {
+        lanes.state[word] = _mm256_set_epi32(
+            static_cast<int>(states[7][word]), static_cast<int>(states[6][word]),
+            static_cast<int>(states[5][word]), static_cast<int>(states[4][word]),
+            static_cast<int>(states[3][word]), static_cast<int>(states[2][word]),
+            static_cast<int>(states[1][word]), static_cast<int>(states[0][word]));
+    }
+
+    __m256i* const w = lanes.schedule;
+    for (std::size_t block = 0; block < num_blocks; ++block) {
+        LoadTransposed(w, data, block * BLOCK_SIZE);
+        LoadTransposed(w + 8, data, block * BLOCK_SIZE + 32);
+
+        __m256i a = lanes.state[0];
+        __m256i b = lanes.state[1];
+        __m256i c = lanes.state[2];
+        __m256i d = lanes.state[3];
+        __m256i e = lanes.state[4];
+        __m256i f = lanes.state[5];
+        __m256i g = lanes.state[6];
+        __m256i h = lanes.state[7];
+        for (std::size_t round = 0; round < NUM_ROUNDS; ++round) {
+            if (round >= 16) {
+                const __m256i w15 = w[(round - 15) % 16];
+                const __m256i w2 = w[(round - 2) % 16];
+                const __m256i s0 = Xor3(RotateRight<7>(w15), RotateRight<18>(w15),
+                                        _mm256_srli_epi32(w15, 3));
+                const __m256i s1 = Xor3(RotateRight<17>(w2), RotateRight<19>(w2),
+                                        _mm256_srli_epi32(w2, 10));
+                w[round % 16] = _mm256_add_epi32(_mm256_add_epi32(w[round % 16], s0),
+                                                 _mm256_add_epi32(w[(round - 7) % 16], s1));
+            }
+            const __m256i sum1 = Xor3(RotateRight<6>(e), RotateRight<11>(e), RotateRight<25>(e));
+            const __m256i choice = _mm256_xor_si256(g, _mm256_and_si256(e, _mm256_xor_si256(f, g)));
+            const __m256i t1 = _mm256_add_epi32(
+                _mm256_add_epi32(_mm256_add_epi32(h, sum1), choice),
+                _mm256_add_epi32(
+                    _mm256_set1_epi32(static_cast<int>(ROUND_CONSTANTS[round])), w[round % 16]));
+            const __m256i sum0 = Xor3(RotateRight<2>(a), RotateRight<13>(a), RotateRight<22>(a));
+            const __m256i majority =
+                _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(c, _mm256_or_si256(a, b)));
+            h = g;
+            g = f;
+            f = e;
+            e = _mm256_add_epi32(d, t1);
+            d = c;
+            c = b;
+            b = a;
+            a = _mm256_add_epi32(t1, _mm256_add_epi32(sum0, majority));
+        }
+        lanes.state[0] = _mm256_add_epi32(lanes.state[0], a);
+        lanes.state[1] = _mm256_add_epi32(lanes.state[1], b);
+        lanes.state[2] = _mm256_add_epi32(lanes.state[2], c);
+        lanes.state[3] = _mm256_add_epi32(lanes.state[3], d);
+        lanes.state[4] = _mm256_add_epi32(lanes.state[4], e);
+        lanes.state[5] = _mm256_add_epi32(lanes.state[5], f);
+        lanes.state[6] = _mm256_add_epi32(lanes.state[6], g);
+        lanes.state[7] = _mm256_add_epi32(lanes.state[7], h);
+    }
+
+    for (std::size_t word = 0; word < 8; ++word) {
+        alignas(32) std::array<u32, AVX2_LANES> values;
+        _mm256_store_si256(reinterpret_cast<__m256i*>(values.data()), lanes.state[word]);
+        for (std::size_t i = 0; i < AVX2_LANES; ++i) {
+            states[i][word] = values[i];
+        }
+    }
+}
+
+void StoreHash(const State& state, SHA256Hash& out) {
+    for (std::size_t i = 0; i < state.size(); ++i) {
+        out[i * 4] = static_cast<u8>(state[i] >> 24);
+        out[i * 4 + 1] = static_cast<u8>(state[i] >> 16);
+        out[i * 4 + 2] = static_cast<u8>(state[i] >> 8);
+        out[i * 4 + 3] = static_cast<u8>(state[i]);
+    }
+}
+
+/// Padded last blocks of a message, its bit length is stored big endian at the end
+struct Tail {
+    std::array<u8, BLOCK_SIZE * 2> data;
+    std::size_t num_blocks;
+};
+
+Tail MakeTail(const u8* message, std::size_t size) {
+    Tail tail{};
+    const std::size_t remaining = size % BLOCK_SIZE;
+    std::memcpy(tail.data.data(), message + size - remaining, remaining);
+    tail.data[remaining] = 0x80;
+    tail.num_blocks = remaining < BLOCK_SIZE - 8 ? 1 : 2;
+
+    const u64 bit_size = static_cast<u64>(size) * 8;
+    const std::size_t end = tail.num_blocks * BLOCK_SIZE;
+    for (std::size_t i = 0; i < 8; ++i) {
+        tail.data[end - 1 - i] = static_cast<u8>(bit_size >> (i * 8));
+    }
+    return tail;
+}
+
+/// Hashes NumLanes messages of the same size at once. Messages past num_messages repeat the
+/// last one and their hash is discarded.
+template <std::size_t NumLanes, typename CompressFunction>
+void HashLanes(const u8* data, std::size_t message_size, std::size_t num_messages,
+               SHA256Hash* out, CompressFunction&& compress) {
+    std::array<const u8*, NumLanes> messages;
+    std::array<State, NumLanes> states;
+    for (std::size_t i = 0; i < NumLanes; ++i) {
+        messages[i] = data + std::min(i, num_messages - 1) * message_size;
+        states[i] = INITIAL_STATE;
+    }
+    compress(states.data(), messages.data(), message_size / BLOCK_SIZE);
+
+    // Every lane has the same size, so their tails have the same number of blocks.
+    std::array<Tail, NumLanes> tails;
+    std::array<const u8*, NumLanes> tail_data;
+    for (std::size_t i = 0; i < NumLanes; ++i) {
+        tails[i] = MakeTail(messages[i], message_size);
+        tail_data[i] = tails[i].data.data();
+    }
+    compress(states.data(), tail_data.data(), tails[0].num_blocks);
+
+    for (std::size_t i = 0; i < std::min(NumLanes, num_messages); ++i) {
+        StoreHash(states[i], out[i]);
+    }
+}
+
+} // Anonymous namespace
+
+bool IsSupported() {
+    const auto& caps = Common::GetCPUCaps();
+    return caps.sha && caps.sse4_1;
+}
+
+bool IsAvx2Supported() {
+    return Common::GetCPUCaps().avx2;
+}
+
+void Compress(std::array<u32, 8>& state, const u8* data, std::size_t num_blocks) {
+    CompressShaNi<1>(&state, &data, num_blocks);
+}
+
+void HashMessages(const u8* data, std::size_t message_size, std::size_t num_messages,
+                  SHA256Hash* out, bool use_avx2) {
+    const std::size_t lanes = use_avx2 ? AVX2_LANES : SHANI_LANES;
+    for (std::size_t first = 0; first < num_messages; first += lanes) {
+        const u8* const messages = data + first * message_size;
+        const std::size_t count = std::min(lanes, num_messages - first);
+        if (use_avx2) {
+            HashLanes<AVX2_LANES>(messages, message_size, count, out + first, CompressAvx2);
+        } else if (count == SHANI_LANES) {
+            HashLanes<SHANI_LANES>(messages, message_size, count, out + first,
+                                   CompressShaNi<SHANI_LANES>);
+        } else {
+            HashLanes<1>(messages, message_size, count, out + first, CompressShaNi<1>);
+        }
+    }
+}
+
+#else
+
+bool IsSupported() {
+    return false;
+}
+
+bool IsAvx2Supported() {
+    return false;
+}
+
+void Compress(std::array<u32, 8>& state, const u8* data, std::size_t num_blocks) {
+    UNREACHABLE_MSG("SHA extensions are not available on this host");
+}
+
+void HashMessages(const u8* data, std::size_t message_size, std::size_t num_messages,
+                  SHA256Hash* out, bool use_avx2) {
+    UNREACHABLE_MSG("SHA extensions are not available on this host");
+}
+
+#endif
+
+} // namespace Core::Crypto::ShaNi
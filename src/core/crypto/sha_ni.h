@@ -0,0 +1,33 @@
+// SPDX-FileCopyrightText: Copyright 2026 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#include "common/common_types.h"
+#include "core/crypto/sha_util.h"
+
+// Native SHA-256 engines of x86-64 hosts. The SHA extensions hash one message, or two
+// independent messages interleaved to hide the latency of the round instructions. AVX2 hashes
+// eight independent messages at once, one per 32-bit lane.
+namespace Core::Crypto::ShaNi {
+
+/// Returns true when the host supports the SHA extensions
+[[nodiscard]] bool IsSupported();
+
+/// Returns true when the host supports AVX2 multi-buffer hashing
+[[nodiscard]] bool IsAvx2Supported();
+
+/// Compresses 64 bytes blocks into the state, the host must support the SHA extensions
+void Compress(std::array<u32, 8>& state, const u8* data, std::size_t num_blocks);
+
+/**
+ * Hashes num_messages consecutive messages of message_size bytes each, independently.
+ * The host must support the SHA extensions, or AVX2 when use_avx2 is set.
+ */
+void HashMessages(const u8* data, std::size_t message_size, std::size_t num_messages,
+                  SHA256Hash* out, bool use_avx2);
+
+} // namespace Core::Crypto::ShaNi
@@ -1,4 +1,184 @@
 // SPDX-FileCopyrightText: Copyright 2018 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
-namespace Crypto {} // namespace Crypto
+#include <algorithm>
+#include <cstring>
+#include <mbedtls/sha256.h>
+#include "core/crypto/sha_ni.h"
+#include "core/crypto/sha_util.h"
+
+namespace Core::Crypto {
+namespace {
+
+constexpr std::size_t BlockSize = 0x40;
+
+constexpr std::array<u32, 8> InitialState{0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                                          0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+
+/// Picks the backend hashing a single message, AVX2 only hashes several messages at once
+ShaBackend ResolveBackend(ShaBackend requested) {
+    if (requested == ShaBackend::Auto || requested == ShaBackend::ShaNi) {
+        return IsShaBackendSupported(ShaBackend::ShaNi) ? ShaBackend::ShaNi : ShaBackend::Mbedtls;
+    }
+    return ShaBackend::Mbedtls;
+}
+
+/// Picks the backend hashing blocks
+ShaBackend ResolveBlocksBackend(ShaBackend requested) {
+    if (requested == ShaBackend::Auto) {
+        for (const ShaBackend backend : {ShaBackend::ShaNi, ShaBackend::Avx2}) {
+            if (IsShaBackendSupported(backend)) {
+                return backend;
+            }
+        }
+        return ShaBackend::Mbedtls;
+    }
+    return IsShaBackendSupported(requested) ? requested : ShaBackend::Mbedtls;
+}
+
+} // Anonymous namespace
+
+bool IsShaBackendSupported(ShaBackend backend) {
+    switch (backend) {
+    case ShaBackend::Auto:
+    case ShaBackend::Mbedtls:
+        return true;
+    case ShaBackend::ShaNi:
+        return ShaNi::IsSupported();
+    case ShaBackend::Avx2:
+        return ShaNi::IsAvx2Supported();
+    }
+    return false;
+}
+
+struct HasherContext {
+    ShaBackend backend;
+    mbedtls_sha256_context mbedtls;
+
+    // State of the native backend
+    std::array<u32, 8> state;
+    std::array<u8, BlockSize> buffer;
+    std::size_t buffered;
+    u64 size;
+
+    void Reset() {
+        if (backend == ShaBackend::Mbedtls) {
+            mbedtls_sha256_starts_ret(&mbedtls, 0);
+            return;
+        }
+        state = InitialState;
+        buffered = 0;
+        size = 0;
+    }
+};
+
+SHA256Hasher::SHA256Hasher(ShaBackend backend) : ctx(std::make_unique<HasherContext>()) {
+    ctx->backend = ResolveBackend(backend);
+    mbedtls_sha256_init(&ctx->mbedtls);
+    ctx->Reset();
+}
+
+SHA256Hasher::~SHA256Hasher() {
+    mbedtls_sha256_free(&ctx->mbedtls);
+}
+
+ShaBackend SHA256Hasher::GetBackend() const {
+    return ctx->backend;
+}
+
+void SHA256Hasher::Update(const void* data, std::size_t size) {
+    if (ctx->backend == ShaBackend::Mbedtls) {
+        mbedtls_sha256_update_ret(&ctx->mbedtls, static_cast<const u8*>(data), size);
+        return;
+    }
+    if (size == 0) {
+        return;
+    }
+
+    const u8* src = static_cast<const u8*>(data);
+    ctx->size += size;
+
+    // Complete the buffered block first, then compress whole blocks straight from the source.
+    if (ctx->buffered > 0) {
+        const std::size_t copy_size = std::min(size, BlockSize - ctx->buffered);
+        std::memcpy(ctx->buffer.data() + ctx->buffered, src, copy_size);
+        ctx->buffered += copy_size;
+        src += copy_size;
+        size -= copy_size;
+        if (ctx->buffered < BlockSize) {
+            return;
+        }
+        ShaNi::Compress(ctx->state, ctx->buffer.data(), 1);
+        ctx->buffered = 0;
+    }
+
+    const std::size_t num_blocks = size / BlockSize;
+    if (num_blocks > 0) {
+        ShaNi::Compress(ctx->state, src, num_blocks);
+    }
+    std::memcpy(ctx->buffer.data(), src + num_blocks * BlockSize, size % BlockSize);
+    ctx->buffered = size % BlockSize;
+}
+
+SHA256Hash SHA256Hasher::Finish() {
+    SHA256Hash out;
+    if (ctx->backend == ShaBackend::Mbedtls) {
+        mbedtls_sha256_finish_ret(&ctx->mbedtls, out.data());
+        ctx->Reset();
+        return out;
+    }
+
+    // Pad with a one bit and zeros, then append the big endian bit length.
+    const u64 bit_size = ctx->size * 8;
+    std::array<u8, BlockSize * 2> tail{};
+    std::memcpy(tail.data(), ctx->buffer.data(), ctx->buffered);
+    tail[ctx->buffered] = 0x80;
+    const std::size_t num_blocks = ctx->buffered < BlockSize - 8 ? 1 : 2;
+    for (std::size_t i = 0; i < 8; ++i) {
+        tail[num_blocks * BlockSize - 1 - i] = static_cast<u8>(bit_size >> (i * 8));
+    }
+    ShaNi::Compress(ctx->state, tail.data(), num_blocks);
+
+    for (std::size_t i = 0; i < ctx->state.size(); ++i) {
+        out[i * 4] = static_cast<u8>(ctx->state[i] >> 24);
+        out[i * 4 + 1] = static_cast<u8>(ctx->state[i] >> 16);
+        out[i * 4 + 2] = static_cast<u8>(ctx->state[i] >> 8);
+        out[i * 4 + 3] = static_cast<u8>(ctx->state[i]);
+    }
+    ctx->Reset();
+    return out;
+}
+
+SHA256Hash CalculateSHA256(const void* data, std::size_t size, ShaBackend backend) {
+    if (ResolveBackend(backend) == ShaBackend::Mbedtls) {
+        SHA256Hash out;
+        mbedtls_sha256_ret(static_cast<const u8*>(data), size, out.data(), 0);
+        return out;
+    }
+    SHA256Hasher hasher{backend};
+    hasher.Update(data, size);
+    return hasher.Finish();
+}
+
+void CalculateSHA256Blocks(const void* data, std::size_t size, std::size_t block_size,
+                           SHA256Hash* out, ShaBackend backend) {
+    const u8* const src = static_cast<const u8*>(data);
+    const std::size_t num_blocks = size / block_size;
+    const ShaBackend resolved = ResolveBlocksBackend(backend);
+    if (resolved == ShaBackend::Mbedtls) {
+        for (std::size_t i = 0; i < num_blocks; ++i) {
+            mbedtls_sha256_ret(src + i * block_size, block_size, out[i].data(), 0);
+        }
+    } else if (num_blocks > 0) {
+        ShaNi::HashMessages(src, block_size, num_blocks, out, resolved == ShaBackend::Avx2);
+    }
+
+    // The shorter last block has no other block of its size to be hashed with.
+    if (size % block_size != 0) {
+        out[num_blocks] = CalculateSHA256(src + num_blocks * block_size, size % block_size,
+                                          resolved == ShaBackend::Avx2 ? ShaBackend::Auto
+                                                                       : resolved);
+    }
+}
+
+} // namespace Core::Crypto
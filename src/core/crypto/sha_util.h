@@ -3,17 +3,66 @@
 
 #pragma once
 
-#include "common/assert.h"
-#include "core/file_sys/vfs.h"
-#include "key_manager.h"
-#include "mbedtls/cipher.h"
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <span>
 
-namespace Crypto {
-typedef std::array<u8, 0x20> SHA256Hash;
+#include "common/common_types.h"
 
-inline SHA256Hash operator"" _HASH(const char* data, size_t len) {
-    if (len != 0x40)
-        return {};
+namespace Core::Crypto {
+
+using SHA256Hash = std::array<u8, 0x20>;
+
+struct HasherContext;
+
+/// Implementation used to compute hashes
+enum class ShaBackend {
+    Auto,    ///< Fastest backend supported by the host
+    Mbedtls, ///< Portable software implementation
+    ShaNi,   ///< SHA extensions of x86-64 hosts
+    Avx2,    ///< AVX2 multi-buffer hashing, only used to hash blocks, other hashes use mbedtls
+};
+
+/// Returns true when the host can run the given backend
+[[nodiscard]] bool IsShaBackendSupported(ShaBackend backend);
+
+/// Incremental SHA-256 hasher
+class SHA256Hasher {
+public:
+    explicit SHA256Hasher(ShaBackend backend = ShaBackend::Auto);
+    ~SHA256Hasher();
+
+    /// Returns the backend computing the hash
+    [[nodiscard]] ShaBackend GetBackend() const;
+
+    void Update(const void* data, std::size_t size);
+
+    void Update(std::span<const u8> data) {
+        Update(data.data(), data.size());
+    }
+
+    /// Returns the hash of the data passed so far, and starts a new hash
+    [[nodiscard]] SHA256Hash Finish();
+
+private:
+    std::unique_ptr<HasherContext> ctx;
+};
+
+[[nodiscard]] SHA256Hash CalculateSHA256(const void* data, std::size_t size,
+                                         ShaBackend backend = ShaBackend::Auto);
+
+[[nodiscard]] inline SHA256Hash CalculateSHA256(std::span<const u8> data,
+                                                ShaBackend backend = ShaBackend::Auto) {
+    return CalculateSHA256(data.data(), data.size(), backend);
 }
 
-} // namespace Crypto
+/**
+ * Hashes each block_size bytes block of data independently, the last block is shorter when size
+ * is not a multiple of block_size. Native backends hash several blocks at once.
+ * out must hold DivideUp(size, block_size) hashes.
+ */
+void CalculateSHA256Blocks(const void* data, std::size_t size, std::size_t block_size,
+                           SHA256Hash* out, ShaBackend backend = ShaBackend::Auto);
+
+} // namespace Core::Crypto
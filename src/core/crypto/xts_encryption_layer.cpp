@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <algorithm>
+#include <array>
 #include <cstring>
 #include "core/crypto/xts_encryption_layer.h"
 
@@ -19,19 +20,19 @@ std::size_t XTSEncryptionLayer::Read(u8* data, std::size_t length, std::size_t o
     const auto sector_offset = offset & 0x3FFF;
     if (sector_offset == 0) {
         if (length % XTS_SECTOR_SIZE == 0) {
-            std::vector<u8> raw = base->ReadBytes(length, offset);
-            cipher.XTSTranscode(raw.data(), raw.size(), data, offset / XTS_SECTOR_SIZE,
-                                XTS_SECTOR_SIZE, Op::Decrypt);
-            return raw.size();
+            // Decrypt in place in the destination, whole sectors need no bounce buffer
+            const std::size_t read = base->Read(data, length, offset);
+            cipher.XTSTranscode(data, read, data, offset / XTS_SECTOR_SIZE, XTS_SECTOR_SIZE,
+                                Op::Decrypt);
+            return read;
         }
         if (length > XTS_SECTOR_SIZE) {
             const auto rem = length % XTS_SECTOR_SIZE;
             const auto read = length - rem;
             return Read(data, read, offset) + Read(data + read, rem, offset + read);
         }
-        std::vector<u8> buffer = base->ReadBytes(XTS_SECTOR_SIZE, offset);
-        if (buffer.size() < XTS_SECTOR_SIZE)
-            buffer.resize(XTS_SECTOR_SIZE);
+        std::array<u8, XTS_SECTOR_SIZE> buffer{};
+        base->Read(buffer.data(), buffer.size(), offset);
         cipher.XTSTranscode(buffer.data(), buffer.size(), buffer.data(), offset / XTS_SECTOR_SIZE,
                             XTS_SECTOR_SIZE, Op::Decrypt);
         std::memcpy(data, buffer.data(), std::min(buffer.size(), length));
@@ -39,9 +40,8 @@ std::size_t XTSEncryptionLayer::Read(u8* data, std::size_t length, std::size_t o
     }
 
     // offset does not fall on block boundary (0x4000)
-    std::vector<u8> block = base->ReadBytes(0x4000, offset - sector_offset);
-    if (block.size() < XTS_SECTOR_SIZE)
-        block.resize(XTS_SECTOR_SIZE);
+    std::array<u8, XTS_SECTOR_SIZE> block{};
+    base->Read(block.data(), block.size(), offset - sector_offset);
     cipher.XTSTranscode(block.data(), block.size(), block.data(),
                         (offset - sector_offset) / XTS_SECTOR_SIZE, XTS_SECTOR_SIZE, Op::Decrypt);
     const std::size_t read = XTS_SECTOR_SIZE - sector_offset;
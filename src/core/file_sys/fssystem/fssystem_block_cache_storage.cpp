@@ -0,0 +1,268 @@
+// SPDX-FileCopyrightText: Copyright 2026 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <cstring>
+
+#include "common/alignment.h"
+#include "common/assert.h"
+#include "common/container_hash.h"
+#include "core/file_sys/fssystem/fssystem_block_cache_storage.h"
+#include "core/file_sys/fssystem/fssystem_pooled_buffer.h"
+
+namespace FileSys {
+
+size_t BlockCache::KeyHash::operator()(const Key& key) const {
+    size_t seed = 0;
+    Common::HashCombine(seed, key.storage_id);
+    Common::HashCombine(seed, key.block_index);
+    return seed;
+}
+
+BlockCache::BlockCache(size_t capacity, size_t num_shards)
+    : m_shard_capacity(capacity / num_shards) {
+    ASSERT(num_shards > 0);
+    m_shards.reserve(num_shards);
+    for (size_t i = 0; i < num_shards; ++i) {
+        m_shards.push_back(std::make_unique<Shard>());
+    }
+}
+
+BlockCache::~BlockCache() = default;
+
+BlockCache& BlockCache::Instance() {
+    static BlockCache instance;
+    return instance;
+}
+
+u64 BlockCache::AllocateStorageId() {
+    return m_next_storage_id.fetch_add(1, std::memory_order_relaxed);
+}
+
+BlockCache::Shard& BlockCache::GetShard(const Key& key) {
+    return *m_shards[KeyHash{}(key) % m_shards.size()];
+}
+
+bool BlockCache::Find(u64 storage_id, u64 block_index, u8* dst, size_t offset, size_t size) {
+    const Key key{storage_id, block_index};
+    Shard& shard = GetShard(key);
+    {
+        std::scoped_lock lk{shard.mutex};
+        const auto it = shard.entries.find(key);
+        if (it != shard.entries.end() && offset + size <= it->second->data.size()) {
+            // Mark the block as the most recently used.
+            shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+            std::memcpy(dst, it->second->data.data() + offset, size);
+            m_hits.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    m_misses.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+void BlockCache::SetCapacity(size_t capacity) {
+    const size_t shard_capacity = capacity / m_shards.size();
+    if (m_shard_capacity.exchange(shard_capacity, std::memory_order_relaxed) <= shard_capacity) {
+        return;
+    }
+    for (const auto& shard : m_shards) {
+        std::scoped_lock lk{shard->mutex};
+        while (shard->size > shard_capacity) {
+            Entry& victim = shard->lru.back();
+            shard->size -= victim.data.size();
+            shard->entries.erase(victim.key);
+            shard->lru.pop_back();
+            m_evictions.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+void BlockCache::Insert(u64 storage_id, u64 block_index, const u8* data, size_t size) {
+    const size_t shard_capacity = m_shard_capacity.load(std::memory_order_relaxed);
+    if (size > shard_capacity) {
+        return;
+    }
+    const Key key{storage_id, block_index};
+    Shard& shard = GetShard(key);
+    std::scoped_lock lk{shard.mutex};
+
+    // Another reader may have inserted the block meanwhile.
+    if (shard.entries.contains(key)) {
+        return;
+    }
+
+    // Evict the least recently used blocks, reusing the last allocation for the new block.
+    std::vector<u8> storage;
+    while (shard.size + size > shard_capacity) {
+        Entry& victim = shard.lru.back();
+        shard.size -= victim.data.size();
+        shard.entries.erase(victim.key);
+        storage = std::move(victim.data);
+        shard.lru.pop_back();
+        m_evictions.fetch_add(1, std::memory_order_relaxed);
+    }
+    storage.assign(data, data + size);
+
+    shard.lru.push_front(Entry{key, std::move(storage)});
+    shard.entries.emplace(key, shard.lru.begin());
+    shard.size += size;
+}
+
+void BlockCache::Invalidate(u64 storage_id) {
+    for (const auto& shard : m_shards) {
+        std::scoped_lock lk{shard->mutex};
+        for (auto it = shard->lru.begin(); it != shard->lru.end();) {
+            if (it->key.storage_id != storage_id) {
+                ++it;
+                continue;
+            }
+            shard->size -= it->data.size();
+            shard->entries.erase(it->key);
+            it = shard->lru.erase(it);
+        }
+    }
+}
+
+BlockCache::Statistics BlockCache::GetStatistics() const {
+    size_t size = 0;
+    for (const auto& shard : m_shards) {
+        std::scoped_lock lk{shard->mutex};
+        size += shard->size;
+    }
+    return Statistics{
+        .hits = m_hits.load(std::memory_order_relaxed),
+        .misses = m_misses.load(std::memory_order_relaxed),
+        .evictions = m_evictions.load(std::memory_order_relaxed),
+        .size = size,
+    };
+}
+
+BlockCacheStorage::BlockCacheStorage(VirtualFile base, BlockCache& cache)
+    : m_base_storage(std::move(base)), m_cache(cache), m_storage_id(cache.AllocateStorageId()) {
+    ASSERT(m_base_storage != nullptr);
+    m_size = m_base_storage->GetSize();
+}
+
+BlockCacheStorage::~BlockCacheStorage() {
+    // The identity is never reused, drop the blocks now rather than waiting for their eviction.
+    m_cache.Invalidate(m_storage_id);
+}
+
+size_t BlockCacheStorage::ReadBlocks(u8* buffer, u64 first_block, u64 num_blocks) const {
+    constexpr size_t BlockSize = BlockCache::BlockSize;
+
+    // Read the blocks straight into the destination, then copy them to the cache.
+    const size_t offset = first_block * BlockSize;
+    const size_t size = std::min(num_blocks * BlockSize, m_size - offset);
+    size_t read;
+    {
+        std::scoped_lock lk{m_mutex};
+        read = m_base_storage->Read(buffer, size, offset);
+    }
+    // Only cache whole blocks, a short read would be served as a partial block otherwise.
+    for (size_t block_offset = 0; block_offset < read; block_offset += BlockSize) {
+        const size_t block_size = std::min(BlockSize, size - block_offset);
+        if (read - block_offset < block_size) {
+            break;
+        }
+        m_cache.Insert(m_storage_id, first_block + block_offset / BlockSize, buffer + block_offset,
+                       block_size);
+    }
+    return read;
+}
+
+size_t BlockCacheStorage::Read(u8* buffer, size_t size, size_t offset) const {
+    constexpr size_t BlockSize = BlockCache::BlockSize;
+
+    // Allow zero-size reads, and clamp reads to the end of the storage.
+    if (size == 0 || offset >= m_size) {
+        return 0;
+    }
+    size = std::min(size, m_size - offset);
+
+    // Ensure buffer is valid.
+    ASSERT(buffer != nullptr);
+
+    // Blocks missing from the cache and fully covered by the read are read in runs. When the base
+    // storage comes up short, the read stops there and returns the bytes filled before it.
+    u64 run_first = 0;
+    u64 run_count = 0;
+    size_t filled = size;
+    const auto flush_run = [&] {
+        if (run_count == 0) {
+            return true;
+        }
+        const size_t run_offset = run_first * BlockSize;
+        const size_t run_size = std::min(run_count * BlockSize, m_size - run_offset);
+        const size_t read = this->ReadBlocks(buffer + (run_offset - offset), run_first, run_count);
+        run_count = 0;
+        if (read < run_size) {
+            filled = run_offset + read - offset;
+            return false;
+        }
+        return true;
+    };
+
+    // Only the first and last blocks can be partially covered, allocate their buffer on demand.
+    PooledBuffer pooled_buffer;
+    bool has_buffer = false;
+    const u64 end_block = Common::DivideUp(offset + size, BlockSize);
+    for (u64 block = offset / BlockSize; block < end_block; ++block) {
+        const size_t block_offset = block * BlockSize;
+        const size_t block_size = std::min(BlockSize, m_size - block_offset);
+        const size_t copy_begin = std::max(offset, block_offset);
+        const size_t copy_end = std::min(offset + size, block_offset + block_size);
+        u8* const dst = buffer + (copy_begin - offset);
+
+        if (m_cache.Find(m_storage_id, block, dst, copy_begin - block_offset,
+                         copy_end - copy_begin)) {
+            if (!flush_run()) {
+                return filled;
+            }
+            continue;
+        }
+
+        if (copy_begin == block_offset && copy_end == block_offset + block_size) {
+            if (run_count == 0) {
+                run_first = block;
+            }
+            ++run_count;
+            continue;
+        }
+
+        // The read only covers part of the block, decode all of it through a buffer.
+        if (!flush_run()) {
+            return filled;
+        }
+        if (!has_buffer) {
+            pooled_buffer.Allocate(BlockSize, BlockSize);
+            has_buffer = true;
+        }
+        u8* const block_buffer = reinterpret_cast<u8*>(pooled_buffer.GetBuffer());
+        size_t read;
+        {
+            std::scoped_lock lk{m_mutex};
+            read = m_base_storage->Read(block_buffer, block_size, block_offset);
+        }
+        const size_t read_end = std::min(copy_end, block_offset + read);
+        if (read_end > copy_begin) {
+            std::memcpy(dst, block_buffer + (copy_begin - block_offset), read_end - copy_begin);
+        }
+        if (read < block_size) {
+            return std::max(read_end, copy_begin) - offset;
+        }
+        m_cache.Insert(m_storage_id, block, block_buffer, read);
+    }
+    if (!flush_run()) {
+        return filled;
+    }
+
+    return size;
+}
+
+size_t BlockCacheStorage::GetSize() const {
+    return m_size;
+}
+
+} // namespace FileSys
@@ -0,0 +1,128 @@
+// SPDX-FileCopyrightText: Copyright 2026 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "common/common_funcs.h"
+#include "common/common_types.h"
+#include "common/literals.h"
+#include "core/file_sys/fssystem/fs_i_storage.h"
+
+namespace FileSys {
+
+using namespace Common::Literals;
+
+/**
+ * Size bounded cache of decoded storage blocks, shared by every storage of the process.
+ * Blocks are keyed by the identity of their storage and their index in it. The cache is split
+ * in shards with their own lock and LRU list, so storages read from several threads rarely
+ * contend.
+ */
+class BlockCache {
+    CITRON_NON_COPYABLE(BlockCache);
+    CITRON_NON_MOVEABLE(BlockCache);
+
+public:
+    static constexpr size_t BlockSize = 64_KiB;
+    static constexpr size_t DefaultCapacity = 128_MiB;
+    static constexpr size_t DefaultNumShards = 16;
+
+    struct Statistics {
+        u64 hits;
+        u64 misses;
+        u64 evictions;
+        size_t size;
+    };
+
+public:
+    explicit BlockCache(size_t capacity = DefaultCapacity, size_t num_shards = DefaultNumShards);
+    ~BlockCache();
+
+    /// Cache shared by the storages opened by the NCA file system driver
+    static BlockCache& Instance();
+
+    /// Changes the capacity, evicting the least recently used blocks that no longer fit
+    void SetCapacity(size_t capacity);
+
+    /// Returns an identity no other storage of this cache uses
+    u64 AllocateStorageId();
+
+    /// Copies the cached block to dst and returns true, or counts a miss and returns false
+    bool Find(u64 storage_id, u64 block_index, u8* dst, size_t offset, size_t size);
+
+    /// Inserts a block, evicting the least recently used blocks of its shard when full
+    void Insert(u64 storage_id, u64 block_index, const u8* data, size_t size);
+
+    /// Drops every block of the storage
+    void Invalidate(u64 storage_id);
+
+    Statistics GetStatistics() const;
+
+private:
+    struct Key {
+        u64 storage_id;
+        u64 block_index;
+
+        bool operator==(const Key&) const = default;
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key& key) const;
+    };
+
+    struct Entry {
+        Key key;
+        std::vector<u8> data;
+    };
+
+    struct Shard {
+        std::mutex mutex;
+        std::list<Entry> lru;
+        std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> entries;
+        size_t size{};
+    };
+
+    Shard& GetShard(const Key& key);
+
+    std::vector<std::unique_ptr<Shard>> m_shards;
+    std::atomic<size_t> m_shard_capacity;
+    std::atomic<u64> m_next_storage_id{};
+    std::atomic<u64> m_hits{};
+    std::atomic<u64> m_misses{};
+    std::atomic<u64> m_evictions{};
+};
+
+/**
+ * Read-only storage serving reads of its base storage through a block cache.
+ * Reads may come from several threads, the reads reaching the base storage are serialized since
+ * the decoding storages of an NCA keep per-read state.
+ */
+class BlockCacheStorage : public IReadOnlyStorage {
+    CITRON_NON_COPYABLE(BlockCacheStorage);
+    CITRON_NON_MOVEABLE(BlockCacheStorage);
+
+public:
+    BlockCacheStorage(VirtualFile base, BlockCache& cache);
+    ~BlockCacheStorage() override;
+
+    virtual size_t Read(u8* buffer, size_t size, size_t offset) const override;
+    virtual size_t GetSize() const override;
+
+private:
+    size_t ReadBlocks(u8* buffer, u64 first_block, u64 num_blocks) const;
+
+    VirtualFile m_base_storage;
+    mutable std::mutex m_mutex;
+    BlockCache& m_cache;
+    u64 m_storage_id;
+    size_t m_size;
+};
+
+} // namespace FileSys
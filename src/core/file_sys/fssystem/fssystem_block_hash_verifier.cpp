@@ -0,0 +1,136 @@
+// SPDX-FileCopyrightText: Copyright 2026 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <vector>
+
+#include "common/alignment.h"
+#include "common/assert.h"
+#include "common/logging/log.h"
+#include "core/file_sys/fssystem/fssystem_block_hash_verifier.h"
+
+namespace FileSys {
+
+void BlockHashVerifier::Initialize(s64 data_size, s64 block_size, bool pad_last_block) {
+    ASSERT(data_size >= 0);
+    ASSERT(block_size > 0);
+
+    m_data_size = data_size;
+    m_block_size = block_size;
+    m_num_blocks = Common::DivideUp(data_size, block_size);
+    m_pad_last_block = pad_last_block;
+
+    const size_t num_words = static_cast<size_t>(Common::DivideUp(m_num_blocks, s64{64}));
+    m_verified = std::make_unique<std::atomic<u64>[]>(std::max<size_t>(num_words, 1));
+}
+
+void BlockHashVerifier::Finalize() {
+    m_verified.reset();
+}
+
+size_t BlockHashVerifier::Verify(const VfsFile& data_storage,
+                                 const ExpectedHashReader& read_expected, u8* buffer, size_t size,
+                                 size_t offset) const {
+    if (!this->IsInitialized() || size == 0) {
+        return size;
+    }
+
+    const s64 first_block = static_cast<s64>(offset) / m_block_size;
+    const s64 end_block =
+        std::min(Common::DivideUp(static_cast<s64>(offset + size), m_block_size), m_num_blocks);
+
+    // Verify the runs of blocks not verified yet, in batches, up to the first corrupted block.
+    s64 block = first_block;
+    while (block < end_block) {
+        if (this->IsVerified(block)) {
+            ++block;
+            continue;
+        }
+
+        s64 batch_end = block + 1;
+        while (batch_end < end_block && batch_end - block < MaxBlocksPerBatch &&
+               !this->IsVerified(batch_end)) {
+            ++batch_end;
+        }
+        const s64 corrupted_block = this->VerifyBatch(data_storage, read_expected, buffer, size,
+                                                      offset, block, batch_end - block);
+        if (corrupted_block != batch_end) {
+            const s64 corrupted_offset = corrupted_block * m_block_size - static_cast<s64>(offset);
+            return static_cast<size_t>(std::max(corrupted_offset, s64{0}));
+        }
+        block = batch_end;
+    }
+    return size;
+}
+
+s64 BlockHashVerifier::VerifyBatch(const VfsFile& data_storage,
+                                   const ExpectedHashReader& read_expected, u8* buffer,
+                                   size_t size, size_t offset, s64 first_block,
+                                   s64 num_blocks) const {
+    const s64 read_begin = static_cast<s64>(offset);
+    const s64 read_end = static_cast<s64>(offset + size);
+
+    std::array<Core::Crypto::SHA256Hash, MaxBlocksPerBatch> expected;
+    std::array<Core::Crypto::SHA256Hash, MaxBlocksPerBatch> actual;
+    read_expected(expected.data(), first_block, num_blocks);
+
+    // Hash the blocks the buffer holds whole in place, all at once.
+    s64 whole_begin = first_block;
+    if (whole_begin * m_block_size < read_begin) {
+        ++whole_begin;
+    }
+    s64 whole_end = first_block + num_blocks;
+    if (whole_end > whole_begin && this->GetBlockEnd(whole_end - 1) > read_end) {
+        --whole_end;
+    }
+    if (whole_end > whole_begin) {
+        const s64 begin = whole_begin * m_block_size;
+        Core::Crypto::CalculateSHA256Blocks(
+            buffer + (begin - read_begin),
+            static_cast<size_t>(this->GetBlockEnd(whole_end - 1) - begin),
+            static_cast<size_t>(m_block_size), actual.data() + (whole_begin - first_block));
+    }
+
+    s64 corrupted_block = first_block + num_blocks;
+    for (s64 i = 0; i < num_blocks; ++i) {
+        const s64 block = first_block + i;
+
+        // The blocks the read only covers partially are read whole.
+        if (block < whole_begin || block >= whole_end) {
+            actual[i] = this->HashPartialBlock(data_storage, block);
+        }
+
+        if (actual[i] == expected[i]) {
+            this->SetVerified(block);
+            continue;
+        }
+
+        LOG_ERROR(Common_Filesystem, "Hash mismatch in block {} of a verified storage", block);
+        const s64 clear_begin = std::max(block * m_block_size, read_begin);
+        const s64 clear_end = std::min(this->GetBlockEnd(block), read_end);
+        std::memset(buffer + (clear_begin - read_begin), 0,
+                    static_cast<size_t>(clear_end - clear_begin));
+        corrupted_block = std::min(corrupted_block, block);
+    }
+    return corrupted_block;
+}
+
+Core::Crypto::SHA256Hash BlockHashVerifier::HashPartialBlock(const VfsFile& data_storage,
+                                                             s64 block) const {
+    const s64 begin = block * m_block_size;
+    const s64 end = this->GetBlockEnd(block);
+
+    std::vector<u8> data(static_cast<size_t>(end - begin));
+    data_storage.Read(data.data(), static_cast<size_t>(std::min(end, m_data_size) - begin),
+                      static_cast<size_t>(begin));
+    return Core::Crypto::CalculateSHA256(data.data(), data.size());
+}
+
+s64 BlockHashVerifier::GetBlockEnd(s64 block) const {
+    const s64 end = (block + 1) * m_block_size;
+    return m_pad_last_block ? end : std::min(end, m_data_size);
+}
+
+} // namespace FileSys
@@ -0,0 +1,85 @@
+// SPDX-FileCopyrightText: Copyright 2026 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+
+#include "common/common_funcs.h"
+#include "common/common_types.h"
+#include "core/crypto/sha_util.h"
+#include "core/file_sys/vfs/vfs.h"
+
+namespace FileSys {
+
+/**
+ * Verifies the blocks of a storage against their expected SHA-256 hashes as they are read.
+ * Blocks read whole are hashed in place, several at once, and a bitmap remembers the blocks
+ * that matched so each block is only hashed once per session. Blocks that do not match are
+ * cleared in the caller's buffer, like the integrity storages of the console do, and the read is
+ * cut short before the first of them.
+ */
+class BlockHashVerifier {
+    CITRON_NON_COPYABLE(BlockHashVerifier);
+    CITRON_NON_MOVEABLE(BlockHashVerifier);
+
+public:
+    /// Most blocks hashed by a single batch
+    static constexpr s64 MaxBlocksPerBatch = 64;
+
+    /// Writes the expected hashes of num_blocks consecutive blocks, starting at first_block
+    using ExpectedHashReader =
+        std::function<void(Core::Crypto::SHA256Hash* out, s64 first_block, s64 num_blocks)>;
+
+public:
+    BlockHashVerifier() = default;
+
+    /**
+     * When pad_last_block is set, the last block is hashed zero-padded to the block size as
+     * integrity storages do, otherwise it is hashed with its actual size.
+     */
+    void Initialize(s64 data_size, s64 block_size, bool pad_last_block);
+    void Finalize();
+
+    bool IsInitialized() const {
+        return m_verified != nullptr;
+    }
+
+    bool IsVerified(s64 block) const {
+        return (m_verified[block / 64].load(std::memory_order_relaxed) & (1ULL << (block % 64))) !=
+               0;
+    }
+
+    /**
+     * Verifies the blocks overlapping a read of the data storage, buffer holding the data read
+     * at offset. Returns the size of the data before the first block that did not match its
+     * hash, size when every block matched.
+     */
+    size_t Verify(const VfsFile& data_storage, const ExpectedHashReader& read_expected, u8* buffer,
+                size_t size, size_t offset) const;
+
+private:
+    /// Returns the first block of the batch that did not match, the end of the batch otherwise
+    s64 VerifyBatch(const VfsFile& data_storage, const ExpectedHashReader& read_expected,
+                    u8* buffer, size_t size, size_t offset, s64 first_block,
+                    s64 num_blocks) const;
+
+    Core::Crypto::SHA256Hash HashPartialBlock(const VfsFile& data_storage, s64 block) const;
+
+    s64 GetBlockEnd(s64 block) const;
+
+    void SetVerified(s64 block) const {
+        m_verified[block / 64].fetch_or(1ULL << (block % 64), std::memory_order_relaxed);
+    }
+
+private:
+    std::unique_ptr<std::atomic<u64>[]> m_verified;
+    s64 m_data_size{};
+    s64 m_block_size{};
+    s64 m_num_blocks{};
+    bool m_pad_last_block{};
+};
+
+} // namespace FileSys
@@ -1,6 +1,8 @@
 // SPDX-FileCopyrightText: Copyright 2023 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <cstring>
+
 #include "common/alignment.h"
 #include "common/scope_exit.h"
 #include "core/file_sys/fssystem/fssystem_hierarchical_sha256_storage.h"
@@ -23,7 +25,8 @@ s32 Log2(s32 value) {
 } // namespace
 
 Result HierarchicalSha256Storage::Initialize(VirtualFile* base_storages, s32 layer_count,
-                                             size_t htbs, void* hash_buf, size_t hash_buf_size) {
+                                             size_t htbs, void* hash_buf, size_t hash_buf_size,
+                                             bool verify) {
     // Validate preconditions.
     ASSERT(layer_count == LayerCount);
     ASSERT(Common::IsPowerOfTwo(htbs));
@@ -63,6 +66,14 @@ Result HierarchicalSha256Storage::Initialize(VirtualFile* base_storages, s32 lay
     base_storages[1]->Read(reinterpret_cast<u8*>(m_hash_buffer),
                            static_cast<size_t>(hash_storage_size), 0);
 
+    // Verify the hash layer, then track the verified data blocks.
+    if (verify) {
+        const auto hash_layer_hash =
+            Core::Crypto::CalculateSHA256(m_hash_buffer, static_cast<size_t>(hash_storage_size));
+        R_UNLESS(hash_layer_hash == master_hash, ResultHierarchicalSha256HashVerificationFailed);
+        m_verifier.Initialize(m_base_storage_size, m_hash_target_block_size, false);
+    }
+
     R_SUCCEED();
 }
 
@@ -76,7 +87,20 @@ size_t HierarchicalSha256Storage::Read(u8* buffer, size_t size, size_t offset) c
     ASSERT(buffer != nullptr);
 
     // Read the data.
-    return m_base_storage->Read(buffer, size, offset);
+    const size_t read = m_base_storage->Read(buffer, size, offset);
+
+    // Verify the blocks read, the last block is hashed with its actual size. The read stops before
+    // the first corrupted block.
+    if (m_verifier.IsInitialized()) {
+        return m_verifier.Verify(
+            *m_base_storage,
+            [this](Core::Crypto::SHA256Hash* out, s64 first_block, s64 num_blocks) {
+                std::memcpy(out, m_hash_buffer + first_block * HashSize,
+                            static_cast<size_t>(num_blocks) * HashSize);
+            },
+            buffer, read, offset);
+    }
+    return read;
 }
 
 } // namespace FileSys
@@ -7,6 +7,7 @@
 
 #include "core/file_sys/errors.h"
 #include "core/file_sys/fssystem/fs_i_storage.h"
+#include "core/file_sys/fssystem/fssystem_block_hash_verifier.h"
 #include "core/file_sys/vfs/vfs.h"
 
 namespace FileSys {
@@ -22,8 +23,10 @@ public:
 public:
     HierarchicalSha256Storage() : m_mutex() {}
 
+    /// When verify is set, the hash layer is checked against the master hash and data blocks
+    /// against the hash layer as they are read
     Result Initialize(VirtualFile* base_storages, s32 layer_count, size_t htbs, void* hash_buf,
-                      size_t hash_buf_size);
+                      size_t hash_buf_size, bool verify);
 
     virtual size_t GetSize() const override {
         return m_base_storage->GetSize();
@@ -39,6 +42,7 @@ private:
     s32 m_hash_target_block_size;
     s32 m_log_size_ratio;
     std::mutex m_mutex;
+    BlockHashVerifier m_verifier;
 };
 
 } // namespace FileSys
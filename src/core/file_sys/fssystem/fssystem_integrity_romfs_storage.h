@@ -22,7 +22,7 @@ public:
     Result Initialize(
         HierarchicalIntegrityVerificationInformation level_hash_info, Hash master_hash,
         HierarchicalIntegrityVerificationStorage::HierarchicalStorageInformation storage_info,
-        int max_data_cache_entries, int max_hash_cache_entries, s8 buffer_level);
+        int max_data_cache_entries, int max_hash_cache_entries, s8 buffer_level, bool verify);
     void Finalize();
 
     virtual size_t Read(u8* buffer, size_t size, size_t offset) const override {
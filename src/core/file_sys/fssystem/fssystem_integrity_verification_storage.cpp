@@ -1,6 +1,8 @@
 // SPDX-FileCopyrightText: Copyright 2023 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
+
 #include "common/alignment.h"
 #include "core/file_sys/fssystem/fssystem_integrity_verification_storage.h"
 
@@ -12,7 +14,8 @@ constexpr inline u32 ILog2(u32 val) {
 }
 
 void IntegrityVerificationStorage::Initialize(VirtualFile hs, VirtualFile ds, s64 verif_block_size,
-                                              s64 upper_layer_verif_block_size, bool is_real_data) {
+                                              s64 upper_layer_verif_block_size, bool is_real_data,
+                                              bool verify) {
     // Validate preconditions.
     ASSERT(verif_block_size >= HashSize);
 
@@ -40,9 +43,15 @@ void IntegrityVerificationStorage::Initialize(VirtualFile hs, VirtualFile ds, s6
 
     // Set data.
     m_is_real_data = is_real_data;
+
+    // Track the verified blocks, hashes cover whole blocks with the last one zero-padded.
+    if (verify) {
+        m_verifier.Initialize(m_data_storage->GetSize(), m_verification_block_size, true);
+    }
 }
 
 void IntegrityVerificationStorage::Finalize() {
+    m_verifier.Finalize();
     m_hash_storage = VirtualFile();
     m_data_storage = VirtualFile();
 }
@@ -67,10 +76,9 @@ size_t IntegrityVerificationStorage::Read(u8* buffer, size_t size, size_t offset
     // Determine the read extents.
     size_t read_size = size;
     if (static_cast<s64>(offset + read_size) > data_size) {
-        // Determine the padding sizes.
+        // Determine the padding sizes, reads may end before the block does.
         s64 padding_offset = data_size - offset;
-        size_t padding_size = static_cast<size_t>(
-            m_verification_block_size - (padding_offset & (m_verification_block_size - 1)));
+        size_t padding_size = size - static_cast<size_t>(padding_offset);
         ASSERT(static_cast<s64>(padding_size) < m_verification_block_size);
 
         // Clear the padding.
@@ -81,7 +89,22 @@ size_t IntegrityVerificationStorage::Read(u8* buffer, size_t size, size_t offset
     }
 
     // Perform the read.
-    return m_data_storage->Read(buffer, read_size, offset);
+    const size_t read = m_data_storage->Read(buffer, read_size, offset);
+
+    // Verify the blocks read, their hashes are read from the verified upper layer. The read stops
+    // before the first corrupted block.
+    if (m_verifier.IsInitialized()) {
+        const size_t verified = m_verifier.Verify(
+            *m_data_storage,
+            [this](Core::Crypto::SHA256Hash* out, s64 first_block, s64 num_blocks) {
+                m_hash_storage->Read(reinterpret_cast<u8*>(out),
+                                     static_cast<size_t>(num_blocks * HashSize),
+                                     static_cast<size_t>(first_block * HashSize));
+            },
+            buffer, size, offset);
+        return std::min(read, verified);
+    }
+    return read;
 }
 
 size_t IntegrityVerificationStorage::GetSize() const {
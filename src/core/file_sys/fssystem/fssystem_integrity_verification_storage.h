@@ -7,6 +7,7 @@
 
 #include "core/file_sys/fssystem/fs_i_storage.h"
 #include "core/file_sys/fssystem/fs_types.h"
+#include "core/file_sys/fssystem/fssystem_block_hash_verifier.h"
 
 namespace FileSys {
 
@@ -30,8 +31,9 @@ public:
         this->Finalize();
     }
 
+    /// When verify is set, data blocks are checked against their hashes as they are read
     void Initialize(VirtualFile hs, VirtualFile ds, s64 verif_block_size,
-                    s64 upper_layer_verif_block_size, bool is_real_data);
+                    s64 upper_layer_verif_block_size, bool is_real_data, bool verify);
     void Finalize();
 
     virtual size_t Read(u8* buffer, size_t size, size_t offset) const override;
@@ -60,6 +62,7 @@ private:
     s64 m_upper_layer_verification_block_size;
     s64 m_upper_layer_verification_block_order;
     bool m_is_real_data;
+    BlockHashVerifier m_verifier;
 };
 
 } // namespace FileSys
@@ -1,10 +1,12 @@
 // SPDX-FileCopyrightText: Copyright 2023 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include "common/settings.h"
 #include "core/file_sys/fssystem/fssystem_aes_ctr_counter_extended_storage.h"
 #include "core/file_sys/fssystem/fssystem_aes_ctr_storage.h"
 #include "core/file_sys/fssystem/fssystem_aes_xts_storage.h"
 #include "core/file_sys/fssystem/fssystem_alignment_matching_storage.h"
+#include "core/file_sys/fssystem/fssystem_block_cache_storage.h"
 #include "core/file_sys/fssystem/fssystem_compressed_storage.h"
 #include "core/file_sys/fssystem/fssystem_hierarchical_integrity_verification_storage.h"
 #include "core/file_sys/fssystem/fssystem_hierarchical_sha256_storage.h"
@@ -73,7 +75,16 @@ Result NcaFileSystemDriver::OpenStorageWithContext(VirtualFile* out,
                                                    NcaFsHeaderReader* out_header_reader,
                                                    s32 fs_index, StorageContext* ctx) {
     // Open storage.
-    R_RETURN(this->OpenStorageImpl(out, out_header_reader, fs_index, ctx));
+    R_TRY(this->OpenStorageImpl(out, out_header_reader, fs_index, ctx));
+
+    // Cache the decoded blocks, games read the same assets again every time they reopen them.
+    const u32 cache_size = Settings::values.nca_block_cache_size.GetValue();
+    if (cache_size != 0) {
+        BlockCache& cache = BlockCache::Instance();
+        cache.SetCapacity(static_cast<size_t>(cache_size) * 1_MiB);
+        *out = std::make_shared<BlockCacheStorage>(std::move(*out), cache);
+    }
+    R_SUCCEED();
 }
 
 Result NcaFileSystemDriver::OpenStorageImpl(VirtualFile* out, NcaFsHeaderReader* out_header_reader,
@@ -1150,7 +1161,8 @@ Result NcaFileSystemDriver::CreateSha256Storage(
     // Initialize the verification storage.
     R_TRY(verification_storage->Initialize(layer_storages.data(), VerificationStorage::LayerCount,
                                            hash_data.hash_block_size,
-                                           buffer_hold_storage->GetBuffer(), hash_buffer_size));
+                                           buffer_hold_storage->GetBuffer(), hash_buffer_size,
+                                           Settings::values.verify_romfs_integrity.GetValue()));
 
     // Set the output.
     *out = std::move(verification_storage);
@@ -1261,7 +1273,8 @@ Result NcaFileSystemDriver::CreateIntegrityVerificationStorageImpl(
     // Initialize the integrity storage.
     R_TRY(integrity_storage->Initialize(level_hash_info, meta_info.master_hash, storage_info,
                                         max_data_cache_entries, max_hash_cache_entries,
-                                        buffer_level));
+                                        buffer_level,
+                                        Settings::values.verify_romfs_integrity.GetValue()));
 
     // Set the output.
     *out = std::move(integrity_storage);
@@ -4,13 +4,13 @@
 #include <algorithm>
 #include <random>
 #include <regex>
-#include <mbedtls/sha256.h>
 #include "common/assert.h"
 #include "common/fs/path_util.h"
 #include "common/hex_util.h"
 #include "common/logging/log.h"
 #include "common/scope_exit.h"
 #include "core/crypto/key_manager.h"
+#include "core/crypto/sha_util.h"
 #include "core/file_sys/card_image.h"
 #include "core/file_sys/common_funcs.h"
 #include "core/file_sys/content_archive.h"
@@ -63,8 +63,7 @@ static std::string GetRelativePathFromNcaID(const std::array<u8, 16>& nca_id, bo
         return fmt::format(format_str, Common::HexToString(nca_id, second_hex_upper));
     }
 
-    Core::Crypto::SHA256Hash hash{};
-    mbedtls_sha256_ret(nca_id.data(), nca_id.size(), hash.data(), 0);
+    const auto hash = Core::Crypto::CalculateSHA256(nca_id);
 
     const auto format_str =
         fmt::runtime(cnmt_suffix ? "/000000{:02X}/{}.cnmt.nca" : "/000000{:02X}/{}.nca");
@@ -145,8 +144,7 @@ bool PlaceholderCache::Create(const NcaID& id, u64 size) const {
         return false;
     }
 
-    Core::Crypto::SHA256Hash hash{};
-    mbedtls_sha256_ret(id.data(), id.size(), hash.data(), 0);
+    const auto hash = Core::Crypto::CalculateSHA256(id);
     const auto dirname = fmt::format("000000{:02X}", hash[0]);
 
     const auto dir2 = GetOrCreateDirectoryRelative(dir, dirname);
@@ -169,8 +167,7 @@ bool PlaceholderCache::Delete(const NcaID& id) const {
         return false;
     }
 
-    Core::Crypto::SHA256Hash hash{};
-    mbedtls_sha256_ret(id.data(), id.size(), hash.data(), 0);
+    const auto hash = Core::Crypto::CalculateSHA256(id);
     const auto dirname = fmt::format("000000{:02X}", hash[0]);
 
     const auto dir2 = GetOrCreateDirectoryRelative(dir, dirname);
@@ -665,7 +662,7 @@ InstallResult RegisteredCache::InstallEntry(const NCA& nca, TitleType type,
     const OptionalHeader opt_header{0, 0};
     ContentRecord c_rec{{}, {}, {}, GetCRTypeFromNCAType(nca.GetType()), {}};
     const auto& data = nca.GetBaseFile()->ReadBytes(0x100000);
-    mbedtls_sha256_ret(data.data(), data.size(), c_rec.hash.data(), 0);
+    c_rec.hash = Core::Crypto::CalculateSHA256(data);
     std::memcpy(&c_rec.nca_id, &c_rec.hash, 16);
     const CNMT new_cnmt(header, opt_header, {c_rec}, {});
     if (!RawInstallCitronMeta(new_cnmt)) {
@@ -776,7 +773,7 @@ InstallResult RegisteredCache::RawInstallNCA(const NCA& nca, const VfsCopyFuncti
         id = *override_id;
     } else {
         const auto& data = in->ReadBytes(0x100000);
-        mbedtls_sha256_ret(data.data(), data.size(), hash.data(), 0);
+        hash = Core::Crypto::CalculateSHA256(data);
         memcpy(id.data(), hash.data(), 16);
     }
 
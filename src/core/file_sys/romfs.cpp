@@ -1,16 +1,19 @@
 // SPDX-FileCopyrightText: Copyright 2018 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <map>
 #include <memory>
+#include <string_view>
 
-#include "common/assert.h"
 #include "common/common_types.h"
-#include "common/string_util.h"
+#include "common/fs/path_util.h"
 #include "common/swap.h"
 #include "core/file_sys/fsmitm_romfsbuild.h"
 #include "core/file_sys/romfs.h"
 #include "core/file_sys/vfs/vfs.h"
-#include "core/file_sys/vfs/vfs_cached.h"
 #include "core/file_sys/vfs/vfs_concat.h"
 #include "core/file_sys/vfs/vfs_offset.h"
 #include "core/file_sys/vfs/vfs_vector.h"
@@ -55,105 +58,290 @@ struct FileEntry {
 };
 static_assert(sizeof(FileEntry) == 0x20, "FileEntry has incorrect size.");
 
-struct RomFSTraversalContext {
+/// Tables of a RomFS image, shared by the views of its directories
+struct RomFSTables {
     RomFSHeader header;
     VirtualFile file;
+    std::vector<u8> directory_hash;
     std::vector<u8> directory_meta;
+    std::vector<u8> file_hash;
     std::vector<u8> file_meta;
 };
 
-template <typename EntryType, auto Member>
-std::pair<EntryType, std::string> GetEntry(const RomFSTraversalContext& ctx, size_t offset) {
-    const size_t entry_end = offset + sizeof(EntryType);
-    const std::vector<u8>& vec = ctx.*Member;
-    const size_t size = vec.size();
-    const u8* data = vec.data();
-    EntryType entry{};
-
-    if (entry_end > size) {
-        return {};
+template <typename EntryType>
+bool GetEntry(const std::vector<u8>& table, u32 offset, EntryType& entry, std::string_view& name) {
+    if (offset > table.size() || table.size() - offset < sizeof(EntryType)) {
+        return false;
     }
-    std::memcpy(&entry, data + offset, sizeof(EntryType));
-
-    const size_t name_length = std::min(entry_end + entry.name_length, size) - entry_end;
-    std::string name(reinterpret_cast<const char*>(data + entry_end), name_length);
+    std::memcpy(&entry, table.data() + offset, sizeof(EntryType));
 
-    return {entry, std::move(name)};
+    const size_t name_offset = offset + sizeof(EntryType);
+    const size_t name_length = std::min<size_t>(entry.name_length, table.size() - name_offset);
+    name = {reinterpret_cast<const char*>(table.data() + name_offset), name_length};
+    return true;
 }
 
-std::pair<DirectoryEntry, std::string> GetDirectoryEntry(const RomFSTraversalContext& ctx,
-                                                         size_t directory_offset) {
-    return GetEntry<DirectoryEntry, &RomFSTraversalContext::directory_meta>(ctx, directory_offset);
+template <typename CharType>
+u32 CalculatePathHash(u32 parent, std::string_view name) {
+    u32 hash = parent ^ 123456789;
+    for (const char c : name) {
+        hash = std::rotr(hash, 5) ^ static_cast<u32>(static_cast<CharType>(c));
+    }
+    return hash;
 }
 
-std::pair<FileEntry, std::string> GetFileEntry(const RomFSTraversalContext& ctx,
-                                               size_t file_offset) {
-    return GetEntry<FileEntry, &RomFSTraversalContext::file_meta>(ctx, file_offset);
+/**
+ * Finds the entry named name in the parent directory through the hash table of its kind, whose
+ * buckets chain entries through their hash field. Images without a hash table are searched by
+ * walking the children of the directory instead.
+ */
+template <typename EntryType>
+u32 FindEntry(const std::vector<u8>& hash_table, const std::vector<u8>& meta, u32 parent,
+              u32 first_child, std::string_view name) {
+    if (name.empty()) {
+        return ROMFS_ENTRY_EMPTY;
+    }
+
+    // Bound the walks, so corrupted tables can not loop forever
+    const size_t max_steps = meta.size() / sizeof(EntryType);
+    const auto walk = [&](u32 offset, u32_le EntryType::*next) {
+        EntryType entry{};
+        std::string_view entry_name;
+        for (size_t step = 0; offset != ROMFS_ENTRY_EMPTY && step < max_steps; ++step) {
+            if (!GetEntry(meta, offset, entry, entry_name)) {
+                break;
+            }
+            if (entry.parent == parent && entry_name == name) {
+                return offset;
+            }
+            offset = entry.*next;
+        }
+        return ROMFS_ENTRY_EMPTY;
+    };
+
+    const size_t num_buckets = hash_table.size() / sizeof(u32);
+    if (num_buckets == 0) {
+        return walk(first_child, &EntryType::sibling);
+    }
+    const auto bucket = [&](u32 hash) {
+        u32_le head;
+        std::memcpy(&head, hash_table.data() + (hash % num_buckets) * sizeof(u32), sizeof(u32));
+        return static_cast<u32>(head);
+    };
+
+    // Nintendo hashes names as unsigned bytes, while images built on x86 hosts hash them signed
+    const u32 found = walk(bucket(CalculatePathHash<u8>(parent, name)), &EntryType::hash);
+    const bool is_ascii = std::all_of(name.begin(), name.end(),
+                                      [](char c) { return static_cast<u8>(c) < 0x80; });
+    if (found != ROMFS_ENTRY_EMPTY || is_ascii) {
+        return found;
+    }
+    return walk(bucket(CalculatePathHash<s8>(parent, name)), &EntryType::hash);
 }
 
-void ProcessFile(const RomFSTraversalContext& ctx, u32 this_file_offset,
-                 std::shared_ptr<VectorVfsDirectory>& parent) {
-    while (this_file_offset != ROMFS_ENTRY_EMPTY) {
-        auto entry = GetFileEntry(ctx, this_file_offset);
+/**
+ * Read-only view of a directory of a RomFS image. Entries are decoded from the tables of the
+ * image when they are accessed, so opening an image costs a few reads whatever its size, and
+ * names are looked up through the hash tables of the image.
+ */
+class RomFSDirectory final : public ReadOnlyVfsDirectory {
+public:
+    RomFSDirectory(std::shared_ptr<const RomFSTables> tables_, u32 offset_)
+        : tables(std::move(tables_)), offset(offset_) {}
+
+    std::vector<VirtualFile> GetFiles() const override {
+        std::vector<VirtualFile> files;
+        ForEachFile([&](u32, const FileEntry& entry, std::string_view name) {
+            files.push_back(MakeFile(entry, name));
+        });
+        return files;
+    }
 
-        parent->AddFile(std::make_shared<OffsetVfsFile>(ctx.file, entry.first.size,
-                                                        entry.first.offset + ctx.header.data_offset,
-                                                        std::move(entry.second)));
+    VirtualFile GetFile(std::string_view name) const override {
+        return FindFile(offset, name);
+    }
 
-        this_file_offset = entry.first.sibling;
+    VirtualFile GetFileRelative(std::string_view path) const override {
+        const auto components = Common::FS::SplitPathComponents(path);
+        if (components.empty()) {
+            return nullptr;
+        }
+        const u32 parent = WalkDirectories(components.begin(), components.end() - 1);
+        return parent == ROMFS_ENTRY_EMPTY ? nullptr : FindFile(parent, components.back());
     }
-}
 
-void ProcessDirectory(const RomFSTraversalContext& ctx, u32 this_dir_offset,
-                      std::shared_ptr<VectorVfsDirectory>& parent) {
-    while (this_dir_offset != ROMFS_ENTRY_EMPTY) {
-        auto entry = GetDirectoryEntry(ctx, this_dir_offset);
-        auto current = std::make_shared<VectorVfsDirectory>(
-            std::vector<VirtualFile>{}, std::vector<VirtualDir>{}, entry.second);
+    std::vector<VirtualDir> GetSubdirectories() const override {
+        std::vector<VirtualDir> dirs;
+        ForEachDirectory([&](u32 dir_offset, const DirectoryEntry&, std::string_view) {
+            dirs.push_back(std::make_shared<RomFSDirectory>(tables, dir_offset));
+        });
+        return dirs;
+    }
+
+    VirtualDir GetSubdirectory(std::string_view name) const override {
+        return MakeDirectory(FindDirectory(offset, name));
+    }
 
-        if (entry.first.child_file != ROMFS_ENTRY_EMPTY) {
-            ProcessFile(ctx, entry.first.child_file, current);
+    VirtualDir GetDirectoryRelative(std::string_view path) const override {
+        const auto components = Common::FS::SplitPathComponents(path);
+        if (components.empty()) {
+            return nullptr;
         }
+        return MakeDirectory(WalkDirectories(components.begin(), components.end()));
+    }
+
+    std::map<std::string, VfsEntryType, std::less<>> GetEntries() const override {
+        std::map<std::string, VfsEntryType, std::less<>> entries;
+        ForEachDirectory([&](u32, const DirectoryEntry&, std::string_view name) {
+            entries.emplace(name, VfsEntryType::Directory);
+        });
+        ForEachFile([&](u32, const FileEntry&, std::string_view name) {
+            entries.emplace(name, VfsEntryType::File);
+        });
+        return entries;
+    }
 
-        if (entry.first.child_dir != ROMFS_ENTRY_EMPTY) {
-            ProcessDirectory(ctx, entry.first.child_dir, current);
+    std::string GetName() const override {
+        DirectoryEntry entry{};
+        std::string_view name;
+        GetEntry(tables->directory_meta, offset, entry, name);
+        return std::string(name);
+    }
+
+    VirtualDir GetParentDirectory() const override {
+        if (offset == 0) {
+            return nullptr;
         }
+        DirectoryEntry entry{};
+        std::string_view name;
+        GetEntry(tables->directory_meta, offset, entry, name);
+        return std::make_shared<RomFSDirectory>(tables, entry.parent);
+    }
 
-        parent->AddDirectory(current);
-        this_dir_offset = entry.first.sibling;
+private:
+    DirectoryEntry GetDirectoryEntry(u32 dir_offset) const {
+        DirectoryEntry entry{};
+        std::string_view name;
+        if (!GetEntry(tables->directory_meta, dir_offset, entry, name)) {
+            entry.child_dir = ROMFS_ENTRY_EMPTY;
+            entry.child_file = ROMFS_ENTRY_EMPTY;
+        }
+        return entry;
     }
-}
+
+    template <typename Func>
+    void ForEachDirectory(Func&& func) const {
+        const size_t max_steps = tables->directory_meta.size() / sizeof(DirectoryEntry);
+        u32 dir_offset = GetDirectoryEntry(offset).child_dir;
+        DirectoryEntry entry{};
+        std::string_view name;
+        for (size_t step = 0; dir_offset != ROMFS_ENTRY_EMPTY && step < max_steps; ++step) {
+            if (!GetEntry(tables->directory_meta, dir_offset, entry, name)) {
+                break;
+            }
+            func(dir_offset, entry, name);
+            dir_offset = entry.sibling;
+        }
+    }
+
+    template <typename Func>
+    void ForEachFile(Func&& func) const {
+        const size_t max_steps = tables->file_meta.size() / sizeof(FileEntry);
+        u32 file_offset = GetDirectoryEntry(offset).child_file;
+        FileEntry entry{};
+        std::string_view name;
+        for (size_t step = 0; file_offset != ROMFS_ENTRY_EMPTY && step < max_steps; ++step) {
+            if (!GetEntry(tables->file_meta, file_offset, entry, name)) {
+                break;
+            }
+            func(file_offset, entry, name);
+            file_offset = entry.sibling;
+        }
+    }
+
+    u32 FindDirectory(u32 parent, std::string_view name) const {
+        return FindEntry<DirectoryEntry>(tables->directory_hash, tables->directory_meta, parent,
+                                         GetDirectoryEntry(parent).child_dir, name);
+    }
+
+    VirtualFile FindFile(u32 parent, std::string_view name) const {
+        const u32 file_offset = FindEntry<FileEntry>(tables->file_hash, tables->file_meta, parent,
+                                                     GetDirectoryEntry(parent).child_file, name);
+        FileEntry entry{};
+        std::string_view entry_name;
+        if (file_offset == ROMFS_ENTRY_EMPTY ||
+            !GetEntry(tables->file_meta, file_offset, entry, entry_name)) {
+            return nullptr;
+        }
+        return MakeFile(entry, entry_name);
+    }
+
+    /// Returns the directory reached by walking the components from this one
+    template <typename Iterator>
+    u32 WalkDirectories(Iterator begin, Iterator end) const {
+        u32 dir_offset = offset;
+        for (auto it = begin; it != end && dir_offset != ROMFS_ENTRY_EMPTY; ++it) {
+            dir_offset = FindDirectory(dir_offset, *it);
+        }
+        return dir_offset;
+    }
+
+    VirtualDir MakeDirectory(u32 dir_offset) const {
+        if (dir_offset == ROMFS_ENTRY_EMPTY) {
+            return nullptr;
+        }
+        return std::make_shared<RomFSDirectory>(tables, dir_offset);
+    }
+
+    VirtualFile MakeFile(const FileEntry& entry, std::string_view name) const {
+        return std::make_shared<OffsetVfsFile>(tables->file, entry.size,
+                                               entry.offset + tables->header.data_offset,
+                                               std::string(name));
+    }
+
+    std::shared_ptr<const RomFSTables> tables;
+    u32 offset;
+};
 } // Anonymous namespace
 
 VirtualDir ExtractRomFS(VirtualFile file) {
-    auto root_container = std::make_shared<VectorVfsDirectory>();
     if (!file) {
-        return root_container;
+        return std::make_shared<VectorVfsDirectory>();
     }
 
-    RomFSTraversalContext ctx{};
+    auto tables = std::make_shared<RomFSTables>();
+    RomFSHeader& header = tables->header;
 
-    if (file->ReadObject(&ctx.header) != sizeof(RomFSHeader)) {
+    if (file->ReadObject(&header) != sizeof(RomFSHeader)) {
         return nullptr;
     }
 
-    if (ctx.header.header_size != sizeof(RomFSHeader)) {
+    if (header.header_size != sizeof(RomFSHeader)) {
         return nullptr;
     }
 
-    ctx.file = file;
-    ctx.directory_meta =
-        file->ReadBytes(ctx.header.directory_meta.size, ctx.header.directory_meta.offset);
-    ctx.file_meta = file->ReadBytes(ctx.header.file_meta.size, ctx.header.file_meta.offset);
+    // Tables reaching past the end of the image would be read short
+    const u64 size = file->GetSize();
+    for (const TableLocation& table : {header.directory_hash, header.directory_meta,
+                                       header.file_hash, header.file_meta}) {
+        if (table.offset > size || table.size > size - table.offset) {
+            return nullptr;
+        }
+    }
 
-    ProcessDirectory(ctx, 0, root_container);
+    tables->file = file;
+    tables->directory_hash =
+        file->ReadBytes(header.directory_hash.size, header.directory_hash.offset);
+    tables->directory_meta =
+        file->ReadBytes(header.directory_meta.size, header.directory_meta.offset);
+    tables->file_hash = file->ReadBytes(header.file_hash.size, header.file_hash.offset);
+    tables->file_meta = file->ReadBytes(header.file_meta.size, header.file_meta.offset);
 
-    if (auto root = root_container->GetSubdirectory(""); root) {
-        return root;
+    // The root directory is the first entry of the directory table
+    if (tables->directory_meta.size() < sizeof(DirectoryEntry)) {
+        return nullptr;
     }
-
-    ASSERT(false);
-    return nullptr;
+    return std::make_shared<RomFSDirectory>(std::move(tables), 0);
 }
 
 VirtualFile CreateRomFS(VirtualDir dir, VirtualDir ext) {
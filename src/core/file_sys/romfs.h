@@ -7,7 +7,8 @@
 
 namespace FileSys {
 
-// Converts a RomFS binary blob to VFS Filesystem
+// Opens a RomFS binary blob as a read-only VFS Filesystem, whose entries are decoded from the
+// tables of the image when accessed
 // Returns nullptr on failure
 VirtualDir ExtractRomFS(VirtualFile file);
 
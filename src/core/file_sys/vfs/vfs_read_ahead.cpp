@@ -0,0 +1,215 @@
+// SPDX-FileCopyrightText: Copyright 2026 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include "common/assert.h"
+#include "common/thread_worker.h"
+#include "core/file_sys/vfs/vfs_read_ahead.h"
+
+namespace FileSys {
+
+namespace {
+
+Common::ThreadWorker& GetReadAheadWorker() {
+    static Common::ThreadWorker worker{2, "ReadAhead"};
+    return worker;
+}
+
+} // Anonymous namespace
+
+ReadAheadVfsFile::ReadAheadVfsFile(VirtualFile base, std::size_t depth, std::size_t chunk_size)
+    : state{std::make_shared<State>()} {
+    ASSERT(base != nullptr && chunk_size > 0);
+    state->size = base->GetSize();
+    state->base = std::move(base);
+    state->depth = depth;
+    state->chunk_size = chunk_size;
+}
+
+ReadAheadVfsFile::~ReadAheadVfsFile() {
+    // Prefetches still queued are skipped, the ones already loading finish on their own.
+    std::scoped_lock lk{state->mutex};
+    for (Stream& stream : state->streams) {
+        DropChunks(stream);
+    }
+}
+
+std::string ReadAheadVfsFile::GetName() const {
+    return state->base->GetName();
+}
+
+std::size_t ReadAheadVfsFile::GetSize() const {
+    return state->size;
+}
+
+bool ReadAheadVfsFile::Resize(std::size_t new_size) {
+    return false;
+}
+
+VirtualDir ReadAheadVfsFile::GetContainingDirectory() const {
+    return state->base->GetContainingDirectory();
+}
+
+bool ReadAheadVfsFile::IsWritable() const {
+    return false;
+}
+
+bool ReadAheadVfsFile::IsReadable() const {
+    return state->base->IsReadable();
+}
+
+std::size_t ReadAheadVfsFile::Read(u8* data, std::size_t length, std::size_t offset) const {
+    if (offset >= state->size) {
+        return 0;
+    }
+    length = std::min(length, state->size - offset);
+    if (length == 0) {
+        return 0;
+    }
+
+    std::unique_lock lk{state->mutex};
+    Stream& stream = FindStream(*state, offset, length);
+    while (!stream.chunks.empty() &&
+           stream.chunks.front()->offset + stream.chunks.front()->size <= offset) {
+        stream.chunks.pop_front();
+    }
+
+    // Serve the read from the chunks of the stream, loading the next one here if no worker
+    // picked it up yet.
+    std::size_t done = 0;
+    while (done < length && !stream.chunks.empty()) {
+        const std::shared_ptr<Chunk> chunk = stream.chunks.front();
+        const std::size_t position = offset + done;
+        if (chunk->offset > position) {
+            break;
+        }
+        if (chunk->state == ChunkState::Queued) {
+            chunk->state = ChunkState::Loading;
+            lk.unlock();
+            LoadChunk(*state, *chunk);
+            lk.lock();
+            chunk->state = ChunkState::Ready;
+            state->chunk_ready.notify_all();
+        }
+        state->chunk_ready.wait(lk, [&] { return chunk->state == ChunkState::Ready; });
+
+        // A short read of the base file leaves the rest to the fallback below.
+        const std::size_t chunk_offset = position - chunk->offset;
+        if (chunk_offset >= chunk->data.size()) {
+            break;
+        }
+        const std::size_t copy_size = std::min(length - done, chunk->data.size() - chunk_offset);
+
+        // Ready chunks are never modified again, copy them without holding the lock.
+        lk.unlock();
+        std::memcpy(data + done, chunk->data.data() + chunk_offset, copy_size);
+        lk.lock();
+        done += copy_size;
+
+        if (chunk_offset + copy_size == chunk->size && !stream.chunks.empty() &&
+            stream.chunks.front() == chunk) {
+            stream.chunks.pop_front();
+        }
+    }
+
+    if (stream.sequential_reads >= SequentialThreshold) {
+        Prefetch(state, stream);
+    }
+    lk.unlock();
+
+    if (done < length) {
+        done += state->base->Read(data + done, length - done, offset + done);
+    }
+    return done;
+}
+
+std::size_t ReadAheadVfsFile::Write(const u8* data, std::size_t length, std::size_t offset) {
+    return 0;
+}
+
+bool ReadAheadVfsFile::Rename(std::string_view new_name) {
+    return false;
+}
+
+void ReadAheadVfsFile::LoadChunk(State& state_, Chunk& chunk) {
+    chunk.data.resize(chunk.size);
+    chunk.data.resize(state_.base->Read(chunk.data.data(), chunk.size, chunk.offset));
+}
+
+void ReadAheadVfsFile::DropChunks(Stream& stream) {
+    // Marking queued chunks as ready makes their prefetch skip the read.
+    for (const auto& chunk : stream.chunks) {
+        if (chunk->state == ChunkState::Queued) {
+            chunk->state = ChunkState::Ready;
+        }
+    }
+    stream.chunks.clear();
+}
+
+ReadAheadVfsFile::Stream& ReadAheadVfsFile::FindStream(State& state_, std::size_t offset,
+                                                       std::size_t length) {
+    const u64 use = ++state_.use_counter;
+    for (Stream& stream : state_.streams) {
+        if (stream.last_use != 0 && stream.next_offset == offset) {
+            ++stream.sequential_reads;
+            stream.next_offset = offset + length;
+            stream.last_use = use;
+            return stream;
+        }
+    }
+
+    // The read does not continue any stream, it starts a new one in place of the least recently
+    // used stream.
+    Stream& stream = *std::min_element(
+        std::begin(state_.streams), std::end(state_.streams),
+        [](const Stream& lhs, const Stream& rhs) { return lhs.last_use < rhs.last_use; });
+    DropChunks(stream);
+    stream.sequential_reads = 1;
+    stream.next_offset = offset + length;
+    stream.last_use = use;
+    return stream;
+}
+
+void ReadAheadVfsFile::Prefetch(const std::shared_ptr<State>& state_, Stream& stream) {
+    std::size_t next = stream.next_offset;
+    if (!stream.chunks.empty()) {
+        next = stream.chunks.back()->offset + stream.chunks.back()->size;
+    }
+
+    while (stream.chunks.size() < state_->depth && next < state_->size) {
+        auto chunk = std::make_shared<Chunk>(
+            Chunk{.offset = next, .size = std::min(state_->chunk_size, state_->size - next)});
+        next += chunk->size;
+        stream.chunks.push_back(chunk);
+
+        GetReadAheadWorker().QueueWork([state_, chunk] {
+            {
+                std::scoped_lock lk{state_->mutex};
+                if (chunk->state != ChunkState::Queued) {
+                    return;
+                }
+                chunk->state = ChunkState::Loading;
+            }
+            LoadChunk(*state_, *chunk);
+            {
+                std::scoped_lock lk{state_->mutex};
+                chunk->state = ChunkState::Ready;
+            }
+            state_->chunk_ready.notify_all();
+        });
+    }
+}
+
+VirtualFile CreateReadAheadFile(VirtualFile file, std::size_t depth) {
+    // Files read in a single chunk gain nothing from prefetching.
+    if (file == nullptr || depth == 0 || file->IsWritable() ||
+        file->GetSize() <= ReadAheadVfsFile::DefaultChunkSize) {
+        return file;
+    }
+    return std::make_shared<ReadAheadVfsFile>(std::move(file), depth);
+}
+
+} // namespace FileSys
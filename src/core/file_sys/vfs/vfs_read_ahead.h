@@ -0,0 +1,92 @@
+// SPDX-FileCopyrightText: Copyright 2026 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "common/literals.h"
+#include "core/file_sys/vfs/vfs.h"
+
+namespace FileSys {
+
+using namespace Common::Literals;
+
+// A read-only VfsFile that detects sequential reads of its base file and prefetches the data
+// following them on a background thread, so the next reads are served from memory while the
+// guest processes the previous ones. Up to MaxStreams interleaved sequential streams are tracked,
+// since a whole RomFS image is usually read through a single storage.
+// The base file must support reads from several threads at once.
+class ReadAheadVfsFile : public VfsFile {
+public:
+    static constexpr std::size_t DefaultChunkSize = 256_KiB;
+    static constexpr std::size_t MaxStreams = 4;
+
+    // Number of back-to-back reads after which a stream is considered sequential
+    static constexpr u32 SequentialThreshold = 2;
+
+    ReadAheadVfsFile(VirtualFile base, std::size_t depth,
+                     std::size_t chunk_size = DefaultChunkSize);
+    ~ReadAheadVfsFile() override;
+
+    std::string GetName() const override;
+    std::size_t GetSize() const override;
+    bool Resize(std::size_t new_size) override;
+    VirtualDir GetContainingDirectory() const override;
+    bool IsWritable() const override;
+    bool IsReadable() const override;
+    std::size_t Read(u8* data, std::size_t length, std::size_t offset) const override;
+    std::size_t Write(const u8* data, std::size_t length, std::size_t offset) override;
+    bool Rename(std::string_view new_name) override;
+
+private:
+    enum class ChunkState {
+        Queued,
+        Loading,
+        Ready,
+    };
+
+    struct Chunk {
+        std::size_t offset;
+        std::size_t size;
+        ChunkState state{ChunkState::Queued};
+        std::vector<u8> data;
+    };
+
+    struct Stream {
+        std::size_t next_offset{};
+        u32 sequential_reads{};
+        u64 last_use{};
+        std::deque<std::shared_ptr<Chunk>> chunks;
+    };
+
+    // Shared with the queued prefetches, which may outlive the file
+    struct State {
+        VirtualFile base;
+        std::size_t size;
+        std::size_t depth;
+        std::size_t chunk_size;
+
+        std::mutex mutex;
+        std::condition_variable chunk_ready;
+        Stream streams[MaxStreams];
+        u64 use_counter{};
+    };
+
+    static void LoadChunk(State& state_, Chunk& chunk);
+    static void DropChunks(Stream& stream);
+    static Stream& FindStream(State& state_, std::size_t offset, std::size_t length);
+    static void Prefetch(const std::shared_ptr<State>& state_, Stream& stream);
+
+    std::shared_ptr<State> state;
+};
+
+// Wraps read-only files in a ReadAheadVfsFile prefetching depth chunks, a depth of zero leaves
+// the file as is.
+VirtualFile CreateReadAheadFile(VirtualFile file, std::size_t depth);
+
+} // namespace FileSys
@@ -43,6 +43,7 @@
 #include "core/hle/kernel/physical_core.h"
 #include "core/hle/result.h"
 #include "core/hle/service/server_manager.h"
+#include "core/hle/service/session_executor.h"
 #include "core/hle/service/sm/sm.h"
 #include "core/memory.h"
 
@@ -95,6 +96,11 @@ struct KernelCore::Impl {
 
         InitializeHackSharedMemory(kernel);
         RegisterHostThread(nullptr);
+
+        {
+            std::scoped_lock lk{session_executor_lock};
+            is_session_executor_closed = false;
+        }
     }
 
     void TerminateAllProcesses() {
@@ -185,8 +191,20 @@ struct KernelCore::Impl {
 
     void CloseServices() {
         // Ensures all servers gracefully shutdown.
-        std::scoped_lock lk{server_lock};
-        server_managers.clear();
+        {
+            std::scoped_lock lk{server_lock};
+            server_managers.clear();
+        }
+
+        // The server managers waited for their tasks, the workers can be stopped. They finish the
+        // queued tasks first, which must not wait on server_lock nor create another executor.
+        std::unique_ptr<Service::SessionExecutor> executor;
+        {
+            std::scoped_lock lk{session_executor_lock};
+            is_session_executor_closed = true;
+            executor = std::move(session_executor);
+        }
+        executor.reset();
     }
 
     void InitializePhysicalCores() {
@@ -800,6 +818,10 @@ struct KernelCore::Impl {
     std::mutex server_lock;
     std::vector<std::unique_ptr<Service::ServerManager>> server_managers;
 
+    std::mutex session_executor_lock;
+    std::unique_ptr<Service::SessionExecutor> session_executor;
+    bool is_session_executor_closed{};
+
     std::array<std::unique_ptr<Kernel::PhysicalCore>, Core::Hardware::NUM_CPU_CORES> cores;
 
     // Next host thead ID to use, 0-3 IDs represent core threads, >3 represent others
@@ -1102,6 +1124,37 @@ std::jthread KernelCore::RunOnHostCoreThread(std::string&& thread_name,
     return RunHostThreadFunc(*this, process, std::move(thread_name), std::move(func));
 }
 
+Service::SessionExecutor* KernelCore::GetSessionExecutor() {
+    std::scoped_lock lk{impl->session_executor_lock};
+    if (impl->is_shutting_down || impl->is_session_executor_closed) {
+        return nullptr;
+    }
+    if (impl->session_executor) {
+        return impl->session_executor.get();
+    }
+
+    // Make a process for the workers.
+    KProcess* process = KProcess::Create(*this);
+    ASSERT(R_SUCCEEDED(
+        process->Initialize(Svc::CreateProcessParameter{}, GetSystemResourceLimit(), false)));
+
+    // Ensure that we don't hold onto any extra references, the workers keep the process alive.
+    SCOPE_EXIT {
+        process->Close();
+    };
+
+    // Register the new process.
+    KProcess::Register(*this, process);
+
+    // Start the workers.
+    impl->session_executor = std::make_unique<Service::SessionExecutor>(
+        Service::SessionExecutor::DefaultNumWorkers(),
+        [this, process](std::string&& thread_name, std::function<void()>&& func) {
+            return RunHostThreadFunc(*this, process, std::move(thread_name), std::move(func));
+        });
+    return impl->session_executor.get();
+}
+
 void KernelCore::RunOnGuestCoreProcess(std::string&& process_name, std::function<void()> func) {
     constexpr s32 ServiceThreadPriority = 16;
     constexpr s32 ServiceThreadCore = 3;
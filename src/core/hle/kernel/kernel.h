@@ -30,7 +30,8 @@ struct EventType;
 
 namespace Service {
 class ServerManager;
-}
+class SessionExecutor;
+} // namespace Service
 
 namespace Service::SM {
 class ServiceManager;
@@ -213,6 +214,10 @@ public:
 
     std::jthread RunOnHostCoreThread(std::string&& thread_name, std::function<void()> func);
 
+    /// Gets the host thread pool shared by the server managers, creating it on first use.
+    /// Returns nullptr while the kernel is shutting down and once the services are closed.
+    Service::SessionExecutor* GetSessionExecutor();
+
     /// Gets global data for KObjectName.
     KObjectNameGlobalData& ObjectNameGlobalData();
 
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include "common/alignment.h"
 #include "common/div_ceil.h"
 
 #include "core/hle/service/cmif_types.h"
@@ -239,7 +240,11 @@ constexpr RequestLayout GetReplyOutLayout(bool is_domain) {
     return is_domain ? GetDomainReplyOutLayout<MethodArguments>() : GetNonDomainReplyOutLayout<MethodArguments>();
 }
 
-using OutTemporaryBuffers = std::array<Common::ScratchBuffer<u8>, 3>;
+struct OutTemporaryBuffers {
+    std::array<Common::ScratchBuffer<u8>, 3> scratch;
+    // Output buffers aliasing guest memory, written in place by the handler
+    std::array<bool, 3> in_place{};
+};
 
 template <typename MethodArguments, typename CallArguments, size_t PrevAlign = 1, size_t DataOffset = 0, size_t HandleIndex = 0, size_t InBufferIndex = 0, size_t OutBufferIndex = 0, bool RawDataFinished = false, size_t ArgIndex = 0>
 void ReadInArgument(bool is_domain, CallArguments& args, const u8* raw_data, HLERequestContext& ctx, OutTemporaryBuffers& temp) {
@@ -338,16 +343,36 @@ void ReadInArgument(bool is_domain, CallArguments& args, const u8* raw_data, HLE
         } else if constexpr (ArgumentTraits<ArgType>::Type == ArgumentType::OutBuffer) {
             using ElementType = typename ArgType::Type;
 
-            // Set up scratch buffer.
-            auto& buffer = temp[OutBufferIndex];
+            // Let the handler write in place when the guest buffer is contiguous in host memory
+            // and does not alias an input buffer.
+            std::span<u8> target{};
             if (ctx.CanWriteBuffer(OutBufferIndex)) {
-                buffer.resize_destructive(ctx.GetWriteBufferSize(OutBufferIndex));
-            } else {
-                buffer.resize_destructive(0);
+                if constexpr (ArgType::Attr & BufferAttr_HipcAutoSelect) {
+                    target = ctx.GetWriteBufferSpan(OutBufferIndex);
+                } else if constexpr (ArgType::Attr & BufferAttr_HipcMapAlias) {
+                    target = ctx.GetWriteBufferSpanB(OutBufferIndex);
+                } else /* if (ArgType::Attr & BufferAttr_HipcPointer) */ {
+                    target = ctx.GetWriteBufferSpanC(OutBufferIndex);
+                }
+                if (!Common::IsAligned(reinterpret_cast<uintptr_t>(target.data()), alignof(ElementType))) {
+                    target = {};
+                }
+            }
+            temp.in_place[OutBufferIndex] = !target.empty();
+
+            // Otherwise set up scratch buffer.
+            if (target.empty()) {
+                auto& buffer = temp.scratch[OutBufferIndex];
+                if (ctx.CanWriteBuffer(OutBufferIndex)) {
+                    buffer.resize_destructive(ctx.GetWriteBufferSize(OutBufferIndex));
+                } else {
+                    buffer.resize_destructive(0);
+                }
+                target = std::span(buffer.data(), buffer.size());
             }
 
-            ElementType* ptr = (ElementType*) buffer.data();
-            size_t size = buffer.size() / sizeof(ElementType);
+            ElementType* ptr = (ElementType*) target.data();
+            size_t size = target.size() / sizeof(ElementType);
 
             std::get<ArgIndex>(args) = std::span(ptr, size);
 
@@ -412,10 +437,18 @@ void WriteOutArgument(bool is_domain, CallArguments& args, u8* raw_data, HLERequ
 
             return WriteOutArgument<MethodArguments, CallArguments, PrevAlign, DataOffset, OutBufferIndex + 1, RawDataFinished, ArgIndex + 1>(is_domain, args, raw_data, ctx, temp);
         } else if constexpr (ArgumentTraits<ArgType>::Type == ArgumentType::OutBuffer) {
-            auto& buffer = temp[OutBufferIndex];
+            auto& buffer = temp.scratch[OutBufferIndex];
             const size_t size = buffer.size();
 
-            if (size > 0 && ctx.CanWriteBuffer(OutBufferIndex)) {
+            if (temp.in_place[OutBufferIndex]) {
+                if constexpr (ArgType::Attr & BufferAttr_HipcAutoSelect) {
+                    ctx.CommitWriteBufferSpan(OutBufferIndex);
+                } else if constexpr (ArgType::Attr & BufferAttr_HipcMapAlias) {
+                    ctx.CommitWriteBufferSpanB(OutBufferIndex);
+                } else /* if (ArgType::Attr & BufferAttr_HipcPointer) */ {
+                    ctx.CommitWriteBufferSpanC(OutBufferIndex);
+                }
+            } else if (size > 0 && ctx.CanWriteBuffer(OutBufferIndex)) {
                 if constexpr (ArgType::Attr & BufferAttr_HipcAutoSelect) {
                     ctx.WriteBuffer(buffer.data(), size, OutBufferIndex);
                 } else if constexpr (ArgType::Attr & BufferAttr_HipcMapAlias) {
@@ -0,0 +1,86 @@
+// SPDX-FileCopyrightText: Copyright 2026 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <bit>
+
+#include "common/logging/log.h"
+#include "core/hle/service/command_profiler.h"
+
+namespace Service {
+
+void CommandProfiler::Record(std::string_view service, u32 command, std::string_view function,
+                             u64 ns) {
+    std::scoped_lock lk{mutex};
+    auto [it, inserted] = entries.try_emplace(std::make_pair(std::string{service}, command));
+    Entry& entry = it->second;
+    if (inserted) {
+        entry.service = service;
+        entry.command = command;
+        entry.function = function;
+    }
+    ++entry.calls;
+    entry.total_ns += ns;
+    entry.max_ns = std::max(entry.max_ns, ns);
+    ++entry.buckets[BucketOf(ns)];
+}
+
+std::vector<CommandProfiler::Entry> CommandProfiler::Report() const {
+    std::vector<Entry> report;
+    {
+        std::scoped_lock lk{mutex};
+        report.reserve(entries.size());
+        for (const auto& [key, entry] : entries) {
+            report.push_back(entry);
+        }
+    }
+    std::ranges::stable_sort(report, [](const Entry& lhs, const Entry& rhs) {
+        return lhs.total_ns > rhs.total_ns;
+    });
+    return report;
+}
+
+void CommandProfiler::LogReport(size_t max_entries) const {
+    const std::vector<Entry> report = Report();
+    u64 total_ns = 0;
+    u64 total_calls = 0;
+    for (const Entry& entry : report) {
+        total_ns += entry.total_ns;
+        total_calls += entry.calls;
+    }
+    LOG_INFO(Service, "Service command profile: {} commands, {} calls, {:.3f} ms", report.size(),
+             total_calls, static_cast<double>(total_ns) / 1e6);
+    for (size_t i = 0; i < std::min(max_entries, report.size()); ++i) {
+        const Entry& entry = report[i];
+        LOG_INFO(Service,
+                 "  {}:{} ({}): {} calls, {:.3f} ms, {:.0f} ns/call, p50 <= {} ns, p99 <= {} ns, "
+                 "max {} ns",
+                 entry.service, entry.command, entry.function, entry.calls,
+                 static_cast<double>(entry.total_ns) / 1e6,
+                 static_cast<double>(entry.total_ns) /
+                     static_cast<double>(std::max<u64>(entry.calls, 1)),
+                 Percentile(entry, 50), Percentile(entry, 99), entry.max_ns);
+    }
+}
+
+size_t CommandProfiler::BucketOf(u64 ns) {
+    if (ns == 0) {
+        return 0;
+    }
+    return std::min<size_t>(static_cast<size_t>(std::bit_width(ns)) - 1, NUM_BUCKETS - 1);
+}
+
+u64 CommandProfiler::Percentile(const Entry& entry, u32 percent) {
+    // Smallest bucket reaching the requested share of the calls, rounded up
+    const u64 target = (entry.calls * percent + 99) / 100;
+    u64 count = 0;
+    for (size_t bucket = 0; bucket < NUM_BUCKETS; ++bucket) {
+        count += entry.buckets[bucket];
+        if (count >= target && count != 0) {
+            return std::min(u64{2} << bucket, entry.max_ns);
+        }
+    }
+    return entry.max_ns;
+}
+
+} // namespace Service
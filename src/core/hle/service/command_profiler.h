@@ -0,0 +1,56 @@
+// SPDX-FileCopyrightText: Copyright 2026 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "common/common_types.h"
+
+namespace Service {
+
+/**
+ * Records a latency histogram for each command of the HLE services.
+ * Bucket i of a histogram counts the commands that took between 2^i and 2^(i+1) nanoseconds.
+ */
+class CommandProfiler {
+public:
+    static constexpr size_t NUM_BUCKETS = 40;
+
+    struct Entry {
+        std::string service;
+        u32 command{};
+        std::string function;
+        u64 calls{};
+        u64 total_ns{};
+        u64 max_ns{};
+        std::array<u64, NUM_BUCKETS> buckets{};
+    };
+
+    /// Records a command of a service taking the given host time
+    void Record(std::string_view service, u32 command, std::string_view function, u64 ns);
+
+    /// Returns the recorded commands sorted by decreasing host time
+    [[nodiscard]] std::vector<Entry> Report() const;
+
+    /// Logs the report, up to max_entries commands
+    void LogReport(size_t max_entries) const;
+
+    /// Returns the bucket index of the given latency
+    [[nodiscard]] static size_t BucketOf(u64 ns);
+
+    /// Returns an upper bound of the given percentile of the latencies of a command
+    [[nodiscard]] static u64 Percentile(const Entry& entry, u32 percent);
+
+private:
+    mutable std::mutex mutex;
+    std::map<std::pair<std::string, u32>, Entry, std::less<>> entries;
+};
+
+} // namespace Service
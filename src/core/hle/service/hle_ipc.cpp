@@ -450,6 +450,91 @@ std::size_t HLERequestContext::WriteBufferC(const void* buffer, std::size_t size
     return size;
 }
 
+std::span<u8> HLERequestContext::GetWriteBufferSpan(std::size_t buffer_index) const {
+    const bool is_buffer_b{BufferDescriptorB().size() > buffer_index &&
+                           BufferDescriptorB()[buffer_index].Size()};
+    return is_buffer_b ? GetWriteBufferSpanB(buffer_index) : GetWriteBufferSpanC(buffer_index);
+}
+
+std::span<u8> HLERequestContext::GetWriteBufferSpanB(std::size_t buffer_index) const {
+    if (buffer_index >= BufferDescriptorB().size()) {
+        return {};
+    }
+    return GetContiguousSpan(BufferDescriptorB()[buffer_index].Address(),
+                             BufferDescriptorB()[buffer_index].Size());
+}
+
+std::span<u8> HLERequestContext::GetWriteBufferSpanC(std::size_t buffer_index) const {
+    if (buffer_index >= BufferDescriptorC().size()) {
+        return {};
+    }
+    return GetContiguousSpan(BufferDescriptorC()[buffer_index].Address(),
+                             BufferDescriptorC()[buffer_index].Size());
+}
+
+void HLERequestContext::CommitWriteBufferSpan(std::size_t buffer_index) const {
+    const bool is_buffer_b{BufferDescriptorB().size() > buffer_index &&
+                           BufferDescriptorB()[buffer_index].Size()};
+    if (is_buffer_b) {
+        CommitWriteBufferSpanB(buffer_index);
+    } else {
+        CommitWriteBufferSpanC(buffer_index);
+    }
+}
+
+void HLERequestContext::CommitWriteBufferSpanB(std::size_t buffer_index) const {
+    if (buffer_index < BufferDescriptorB().size()) {
+        CommitContiguousSpan(BufferDescriptorB()[buffer_index].Address(),
+                             BufferDescriptorB()[buffer_index].Size());
+    }
+}
+
+void HLERequestContext::CommitWriteBufferSpanC(std::size_t buffer_index) const {
+    if (buffer_index < BufferDescriptorC().size()) {
+        CommitContiguousSpan(BufferDescriptorC()[buffer_index].Address(),
+                             BufferDescriptorC()[buffer_index].Size());
+    }
+}
+
+std::span<u8> HLERequestContext::GetContiguousSpan(u64 address, std::size_t size) const {
+    if (size == 0) {
+        return {};
+    }
+    // Input buffers are read straight from guest memory too, writing an output that aliases one of
+    // them in place would clobber the input while the handler still reads it
+    if (OverlapsReadBuffers(address, size)) {
+        return {};
+    }
+    u8* const pointer = memory.GetSpan(address, size);
+    if (!pointer) {
+        return {};
+    }
+    return {pointer, size};
+}
+
+bool HLERequestContext::OverlapsReadBuffers(u64 address, std::size_t size) const {
+    const auto overlaps = [address, size](u64 other_address, u64 other_size) {
+        return other_size != 0 && address < other_address + other_size &&
+               other_address < address + size;
+    };
+    return std::ranges::any_of(BufferDescriptorA(),
+                               [&](const IPC::BufferDescriptorABW& descriptor) {
+                                   return overlaps(descriptor.Address(), descriptor.Size());
+                               }) ||
+           std::ranges::any_of(BufferDescriptorX(), [&](const IPC::BufferDescriptorX& descriptor) {
+               return overlaps(descriptor.Address(), descriptor.Size());
+           });
+}
+
+void HLERequestContext::CommitContiguousSpan(u64 address, std::size_t size) const {
+    if (size == 0) {
+        return;
+    }
+    // Same as the rasterizer notification of WriteBlock, GPU caches of the pages are invalidated
+    // and the GPU dirty memory managers collect the written range
+    static_cast<void>(memory.StoreDataCache(address, size));
+}
+
 std::size_t HLERequestContext::GetReadBufferSize(std::size_t buffer_index) const {
     const bool is_buffer_a{BufferDescriptorA().size() > buffer_index &&
                            BufferDescriptorA()[buffer_index].Size()};
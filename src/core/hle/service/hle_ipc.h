@@ -281,6 +281,32 @@ public:
     std::size_t WriteBufferC(const void* buffer, std::size_t size,
                              std::size_t buffer_index = 0) const;
 
+    /**
+     * Helper function to get the guest memory of the output buffer, using the appropriate
+     * buffer descriptor, as a host span. This lets handlers write their output in place instead
+     * of going through WriteBuffer.
+     *
+     * @returns An empty span when the buffer is not contiguous in host memory or overlaps an input
+     *          buffer of the request. Otherwise the writes must be committed with
+     *          CommitWriteBufferSpan.
+     */
+    [[nodiscard]] std::span<u8> GetWriteBufferSpan(std::size_t buffer_index = 0) const;
+
+    /// Helper function to get buffer B as a host span, see GetWriteBufferSpan
+    [[nodiscard]] std::span<u8> GetWriteBufferSpanB(std::size_t buffer_index = 0) const;
+
+    /// Helper function to get buffer C as a host span, see GetWriteBufferSpan
+    [[nodiscard]] std::span<u8> GetWriteBufferSpanC(std::size_t buffer_index = 0) const;
+
+    /// Helper function to notify the GPU of the writes made through GetWriteBufferSpan
+    void CommitWriteBufferSpan(std::size_t buffer_index = 0) const;
+
+    /// Helper function to notify the GPU of the writes made through GetWriteBufferSpanB
+    void CommitWriteBufferSpanB(std::size_t buffer_index = 0) const;
+
+    /// Helper function to notify the GPU of the writes made through GetWriteBufferSpanC
+    void CommitWriteBufferSpanC(std::size_t buffer_index = 0) const;
+
     /* Helper function to write a buffer using the appropriate buffer descriptor
      *
      * @tparam T an arbitrary container that satisfies the
@@ -394,6 +420,10 @@ private:
 
     void ParseCommandBuffer(u32_le* src_cmdbuf, bool incoming);
 
+    [[nodiscard]] std::span<u8> GetContiguousSpan(u64 address, std::size_t size) const;
+    [[nodiscard]] bool OverlapsReadBuffers(u64 address, std::size_t size) const;
+    void CommitContiguousSpan(u64 address, std::size_t size) const;
+
     std::array<u32, IPC::COMMAND_BUFFER_LENGTH> cmd_buf;
     Kernel::KServerSession* server_session{};
     Kernel::KHandleTable* client_handle_table{};
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include "common/scope_exit.h"
+#include "common/settings.h"
 
 #include "core/core.h"
 #include "core/hle/kernel/k_client_port.h"
@@ -12,6 +13,7 @@
 #include "core/hle/kernel/k_server_port.h"
 #include "core/hle/kernel/k_server_session.h"
 #include "core/hle/kernel/k_synchronization_object.h"
+#include "core/hle/kernel/k_thread.h"
 #include "core/hle/kernel/svc_results.h"
 #include "core/hle/service/hle_ipc.h"
 #include "core/hle/service/ipc_helpers.h"
@@ -81,6 +83,16 @@ ServerManager::ServerManager(Core::System& system) : m_system{system}, m_selecti
     // Link to holder.
     m_wakeup_holder.emplace(std::addressof(m_wakeup_event->GetReadableEvent()));
     m_wakeup_holder->LinkToMultiWait(std::addressof(m_deferred_list));
+
+    // Hand the requests over to the shared executor, if enabled. Servers are created on the thread
+    // running them, the ones on a guest core keep running their requests there, with the
+    // priority and the current thread the guest scheduler gave them.
+    const bool is_host_thread = Kernel::GetCurrentThread(system.Kernel()).IsDummyThread();
+    if (Settings::values.use_session_executor.GetValue() && is_host_thread) {
+        if (auto* const executor = system.Kernel().GetSessionExecutor(); executor != nullptr) {
+            m_task_group = std::make_unique<SessionExecutor::Group>(*executor);
+        }
+    }
 }
 
 ServerManager::~ServerManager() {
@@ -91,6 +103,7 @@ ServerManager::~ServerManager() {
     // Wait for processing to stop.
     m_stopped.Wait();
     m_threads.clear();
+    m_task_group.reset();
 
     // Clean up ports.
     auto port_it = m_servers.begin();
@@ -235,6 +248,11 @@ Result ServerManager::ManageDeferral(Kernel::KEvent** out_event) {
 }
 
 void ServerManager::StartAdditionalHostThreads(const char* name, size_t num_threads) {
+    if (m_task_group) {
+        m_task_group->SetMaxConcurrency(m_task_group->GetMaxConcurrency() + num_threads);
+        return;
+    }
+
     for (size_t i = 0; i < num_threads; i++) {
         auto thread_name = fmt::format("{}:{}", name, i + 1);
         m_threads.emplace_back(m_system.Kernel().RunOnHostCoreThread(
@@ -305,7 +323,13 @@ Result ServerManager::Process(MultiWaitHolder* holder) {
 
 bool ServerManager::WaitAndProcessImpl() {
     if (auto* signaled_holder = this->WaitSignaled(); signaled_holder != nullptr) {
-        R_ASSERT(this->Process(signaled_holder));
+        if (m_task_group) {
+            // The holder is unlinked until processed, go back to waiting on the others.
+            m_task_group->Submit(
+                [this, signaled_holder] { R_ASSERT(this->Process(signaled_holder)); });
+        } else {
+            R_ASSERT(this->Process(signaled_holder));
+        }
         return true;
     } else {
         return false;
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <list>
+#include <memory>
 #include <mutex>
 #include <optional>
 #include <vector>
@@ -14,6 +15,7 @@
 #include "core/hle/service/hle_ipc.h"
 #include "core/hle/service/os/multi_wait.h"
 #include "core/hle/service/os/mutex.h"
+#include "core/hle/service/session_executor.h"
 
 namespace Core {
 class System;
@@ -48,6 +50,9 @@ public:
     Result ManageDeferral(Kernel::KEvent** out_event);
 
     Result LoopProcess();
+
+    /// Allows num_threads more requests to be processed at the same time. With the shared session
+    /// executor this raises the concurrency limit of the server instead of starting threads.
     void StartAdditionalHostThreads(const char* name, size_t num_threads);
 
     static void RunServer(std::unique_ptr<ServerManager>&& server);
@@ -92,6 +97,9 @@ private:
     Common::Event m_stopped{};
     std::vector<std::jthread> m_threads{};
     std::stop_source m_stop_source{};
+
+    // Requests run on the shared session executor when it is enabled
+    std::unique_ptr<SessionExecutor::Group> m_task_group{};
 };
 
 } // namespace Service
@@ -1,6 +1,8 @@
 // SPDX-FileCopyrightText: Copyright 2018 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <chrono>
+
 #include <fmt/ranges.h>
 #include "common/assert.h"
 #include "common/logging/log.h"
@@ -91,7 +93,7 @@ void ServiceFrameworkBase::InvokeRequest(HLERequestContext& ctx) {
     }
 
     LOG_TRACE(Service, "{}", MakeFunctionString(info->name, GetServiceName(), ctx.CommandBuffer()));
-    handler_invoker(this, info->handler_callback, ctx);
+    InvokeHandler(ctx, *info);
 }
 
 void ServiceFrameworkBase::InvokeRequestTipc(HLERequestContext& ctx) {
@@ -105,7 +107,22 @@ void ServiceFrameworkBase::InvokeRequestTipc(HLERequestContext& ctx) {
     }
 
     LOG_TRACE(Service, "{}", MakeFunctionString(info->name, GetServiceName(), ctx.CommandBuffer()));
-    handler_invoker(this, info->handler_callback, ctx);
+    InvokeHandler(ctx, *info);
+}
+
+void ServiceFrameworkBase::InvokeHandler(HLERequestContext& ctx, const FunctionInfoBase& info) {
+    auto* const profiler = system.ServiceManager().GetCommandProfiler();
+    if (profiler == nullptr) {
+        handler_invoker(this, info.handler_callback, ctx);
+        return;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    handler_invoker(this, info.handler_callback, ctx);
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    profiler->Record(service_name, ctx.GetCommand(), info.name,
+                     static_cast<u64>(
+                         std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
 }
 
 Result ServiceFrameworkBase::HandleSyncRequest(Kernel::KServerSession& session,
@@ -0,0 +1,190 @@
+// SPDX-FileCopyrightText: Copyright 2026 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <thread>
+
+#include <fmt/format.h>
+
+#include "common/assert.h"
+#include "core/hle/service/session_executor.h"
+
+namespace Service {
+namespace {
+
+// Worker running on the current thread, used to queue nested tasks locally
+thread_local const SessionExecutor* current_executor{};
+thread_local size_t current_worker{};
+
+} // Anonymous namespace
+
+SessionExecutor::Group::Group(SessionExecutor& executor_, size_t max_concurrency)
+    : executor{executor_}, max_running{std::max<size_t>(max_concurrency, 1)} {}
+
+SessionExecutor::Group::~Group() {
+    Wait();
+}
+
+void SessionExecutor::Group::Submit(Task&& task) {
+    {
+        std::scoped_lock lk{mutex};
+        if (running >= max_running) {
+            pending.push_back(std::move(task));
+            return;
+        }
+        ++running;
+    }
+    Launch(std::move(task));
+}
+
+void SessionExecutor::Group::SetMaxConcurrency(size_t max_concurrency) {
+    std::vector<Task> to_launch;
+    {
+        std::scoped_lock lk{mutex};
+        max_running = std::max<size_t>(max_concurrency, 1);
+        while (running < max_running && !pending.empty()) {
+            to_launch.push_back(std::move(pending.front()));
+            pending.pop_front();
+            ++running;
+        }
+    }
+    for (Task& task : to_launch) {
+        Launch(std::move(task));
+    }
+}
+
+size_t SessionExecutor::Group::GetMaxConcurrency() const {
+    std::scoped_lock lk{mutex};
+    return max_running;
+}
+
+void SessionExecutor::Group::Wait() {
+    // Queued tasks are only left while others are running, they are started as those finish
+    std::unique_lock lk{mutex};
+    idle_condition.wait(lk, [this] { return running == 0; });
+}
+
+void SessionExecutor::Group::Launch(Task&& task) {
+    executor.Submit([this, task = std::move(task)]() mutable {
+        task();
+        Finish();
+    });
+}
+
+void SessionExecutor::Group::Finish() {
+    Task next;
+    {
+        std::scoped_lock lk{mutex};
+        if (pending.empty() || running > max_running) {
+            if (--running == 0) {
+                idle_condition.notify_all();
+            }
+            return;
+        }
+        // Hand over the slot to the oldest queued task
+        next = std::move(pending.front());
+        pending.pop_front();
+    }
+    Launch(std::move(next));
+}
+
+SessionExecutor::SessionExecutor(size_t num_workers, ThreadLauncher launcher) {
+    ASSERT(num_workers > 0);
+    workers.reserve(num_workers);
+    for (size_t i = 0; i < num_workers; ++i) {
+        workers.push_back(std::make_unique<Worker>());
+    }
+    threads.reserve(num_workers);
+    for (size_t i = 0; i < num_workers; ++i) {
+        threads.push_back(
+            launcher(fmt::format("HLE:Worker:{}", i), [this, i] { this->WorkerLoop(i); }));
+    }
+}
+
+SessionExecutor::~SessionExecutor() {
+    {
+        std::scoped_lock lk{wait_mutex};
+        stopping = true;
+    }
+    wait_condition.notify_all();
+
+    // Workers finish the queued tasks before exiting
+    threads.clear();
+}
+
+size_t SessionExecutor::DefaultNumWorkers() {
+    // Service handlers spend most of their time blocked rather than computing, so the pool is
+    // sized to keep a few servers blocked at once without starving the others
+    return std::max<size_t>(std::thread::hardware_concurrency(), 8);
+}
+
+void SessionExecutor::Submit(Task&& task) {
+    const size_t index = current_executor == this
+                             ? current_worker
+                             : next_worker.fetch_add(1, std::memory_order_relaxed) % workers.size();
+    // Count the task before it can be popped, so the count never goes below zero. A worker woken
+    // before the push finds no task and retries.
+    {
+        std::scoped_lock lk{wait_mutex};
+        num_pending.fetch_add(1, std::memory_order_relaxed);
+    }
+    {
+        Worker& worker = *workers[index];
+        std::scoped_lock lk{worker.mutex};
+        worker.tasks.push_back(std::move(task));
+    }
+    wait_condition.notify_one();
+}
+
+void SessionExecutor::WorkerLoop(size_t index) {
+    current_executor = this;
+    current_worker = index;
+
+    while (true) {
+        {
+            std::unique_lock lk{wait_mutex};
+            wait_condition.wait(lk, [this] {
+                return stopping || num_pending.load(std::memory_order_relaxed) != 0;
+            });
+            if (stopping && num_pending.load(std::memory_order_relaxed) == 0) {
+                break;
+            }
+        }
+        Task task;
+        if (!TryPop(index, task)) {
+            // Another worker took the task between the wakeup and the pop, or it is being pushed
+            std::this_thread::yield();
+            continue;
+        }
+        task();
+    }
+
+    current_executor = nullptr;
+}
+
+bool SessionExecutor::TryPop(size_t index, Task& task) {
+    {
+        Worker& worker = *workers[index];
+        std::scoped_lock lk{worker.mutex};
+        if (!worker.tasks.empty()) {
+            task = std::move(worker.tasks.back());
+            worker.tasks.pop_back();
+            num_pending.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    for (size_t offset = 1; offset < workers.size(); ++offset) {
+        Worker& victim = *workers[(index + offset) % workers.size()];
+        std::scoped_lock lk{victim.mutex};
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            num_pending.fetch_sub(1, std::memory_order_relaxed);
+            num_steals.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace Service
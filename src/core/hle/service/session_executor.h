@@ -0,0 +1,107 @@
+// SPDX-FileCopyrightText: Copyright 2026 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "common/common_types.h"
+#include "common/polyfill_thread.h"
+#include "common/unique_function.h"
+
+namespace Service {
+
+/**
+ * Pool of host threads shared by the server managers of the HLE services.
+ * Each worker has its own task deque: tasks submitted from a worker are pushed to its deque and
+ * popped in LIFO order, idle workers steal the oldest tasks of the other workers.
+ * The number of tasks of a server running at once is bounded with a Group, so servers keep the
+ * amount of concurrency they were written for.
+ */
+class SessionExecutor {
+public:
+    using Task = Common::UniqueFunction<void>;
+
+    /// Starts a host thread with the given name running the given function
+    using ThreadLauncher = std::function<std::jthread(std::string&&, std::function<void()>&&)>;
+
+    /// Runs tasks on the executor, with at most max_concurrency of them running at once
+    class Group {
+    public:
+        explicit Group(SessionExecutor& executor, size_t max_concurrency = 1);
+        ~Group();
+
+        Group(const Group&) = delete;
+        Group& operator=(const Group&) = delete;
+
+        /// Runs the task on the executor, or queues it until a task of the group finishes
+        void Submit(Task&& task);
+
+        /// Sets the number of tasks allowed to run at once, starting the queued tasks it allows
+        void SetMaxConcurrency(size_t max_concurrency);
+
+        [[nodiscard]] size_t GetMaxConcurrency() const;
+
+        /// Waits until every submitted task has finished
+        void Wait();
+
+    private:
+        void Launch(Task&& task);
+        void Finish();
+
+        SessionExecutor& executor;
+        mutable std::mutex mutex;
+        std::condition_variable idle_condition;
+        std::deque<Task> pending;
+        size_t running{};
+        size_t max_running;
+    };
+
+    explicit SessionExecutor(size_t num_workers, ThreadLauncher launcher);
+    ~SessionExecutor();
+
+    SessionExecutor(const SessionExecutor&) = delete;
+    SessionExecutor& operator=(const SessionExecutor&) = delete;
+
+    /// Number of workers used when none is specified
+    [[nodiscard]] static size_t DefaultNumWorkers();
+
+    /// Runs the task on one of the workers
+    void Submit(Task&& task);
+
+    [[nodiscard]] size_t NumWorkers() const {
+        return workers.size();
+    }
+
+    /// Returns the number of tasks run by a worker other than the one they were queued to
+    [[nodiscard]] u64 NumSteals() const {
+        return num_steals.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct Worker {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void WorkerLoop(size_t index);
+    bool TryPop(size_t index, Task& task);
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::mutex wait_mutex;
+    std::condition_variable wait_condition;
+    std::atomic<size_t> num_pending{};
+    std::atomic<size_t> next_worker{};
+    std::atomic<u64> num_steals{};
+    bool stopping{};
+    std::vector<std::jthread> threads;
+};
+
+} // namespace Service
@@ -4,6 +4,7 @@
 #include <tuple>
 #include "common/assert.h"
 #include "common/scope_exit.h"
+#include "common/settings.h"
 #include "core/core.h"
 #include "core/hle/kernel/k_client_port.h"
 #include "core/hle/kernel/k_client_session.h"
@@ -24,11 +25,21 @@ constexpr Result ResultAlreadyRegistered(ErrorModule::SM, 4);
 constexpr Result ResultInvalidServiceName(ErrorModule::SM, 6);
 constexpr Result ResultNotRegistered(ErrorModule::SM, 7);
 
+/// Number of commands listed in the profile report logged at shutdown
+constexpr size_t MAX_PROFILE_REPORT_ENTRIES = 64;
+
 ServiceManager::ServiceManager(Kernel::KernelCore& kernel_) : kernel{kernel_} {
     controller_interface = std::make_unique<Controller>(kernel.System());
+    if (Settings::values.profile_services) {
+        command_profiler = std::make_unique<CommandProfiler>();
+    }
 }
 
 ServiceManager::~ServiceManager() {
+    if (command_profiler) {
+        command_profiler->LogReport(MAX_PROFILE_REPORT_ENTRIES);
+    }
+
     for (auto& [name, port] : service_ports) {
         port->Close();
     }
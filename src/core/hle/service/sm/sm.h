@@ -13,6 +13,7 @@
 #include "core/hle/kernel/k_port.h"
 #include "core/hle/kernel/svc.h"
 #include "core/hle/result.h"
+#include "core/hle/service/command_profiler.h"
 #include "core/hle/service/service.h"
 
 namespace Core {
@@ -90,6 +91,11 @@ public:
         deferral_event = deferral_event_;
     }
 
+    /// Returns the profiler of the service commands, or nullptr when profiling is disabled
+    CommandProfiler* GetCommandProfiler() {
+        return command_profiler.get();
+    }
+
 private:
     std::shared_ptr<SM> sm_interface;
     std::unique_ptr<Controller> controller_interface;
@@ -102,6 +108,8 @@ private:
     /// Kernel context
     Kernel::KernelCore& kernel;
     Kernel::KEvent* deferral_event{};
+
+    std::unique_ptr<CommandProfiler> command_profiler;
 };
 
 /// Runs SM services.
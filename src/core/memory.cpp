@@ -257,12 +257,12 @@ struct Memory::Impl {
         }
 
         while (remaining_size) {
-            const std::size_t copy_amount =
-                std::min(static_cast<std::size_t>(CITRON_PAGESIZE) - page_offset, remaining_size);
             const auto current_vaddr =
                 static_cast<u64>((page_index << CITRON_PAGEBITS) + page_offset);
 
-            const auto [pointer, type] = page_table.pointers[page_index].PointerType();
+            // Contiguous Memory and Unmapped pages are handled as a single block
+            const auto [pointer, type, copy_amount] =
+                page_table.ResolveRun(current_vaddr, remaining_size);
             switch (type) {
             case Common::PageType::Unmapped: {
                 user_accessible = false;
@@ -289,7 +289,7 @@ struct Memory::Impl {
                 UNREACHABLE();
             }
 
-            page_index++;
+            page_index = (current_vaddr + copy_amount) >> CITRON_PAGEBITS;
             page_offset = 0;
             increment(copy_amount);
             remaining_size -= copy_amount;
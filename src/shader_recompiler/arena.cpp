@@ -0,0 +1,73 @@
+// SPDX-FileCopyrightText: Copyright 2026 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+
+#include "shader_recompiler/arena.h"
+
+namespace Shader {
+namespace {
+thread_local Arena* current_arena{};
+} // Anonymous namespace
+
+void Arena::Reset() {
+    if (block_index != 0) {
+        // The last program did not fit in the first block, squash the blocks into one so the
+        // next programs are served from a single block
+        size_t total_size{};
+        for (const Block& block : blocks) {
+            total_size += block.size;
+        }
+        blocks.clear();
+        blocks.push_back(Block{
+            .memory = std::make_unique_for_overwrite<u8[]>(total_size),
+            .size = total_size,
+        });
+        ++statistics.system_allocations;
+    }
+    if (!blocks.empty()) {
+        UseBlock(0);
+    }
+}
+
+Arena* Arena::Current() noexcept {
+    return current_arena;
+}
+
+void* Arena::AllocateSlow(size_t size, size_t alignment) {
+    const size_t required_size{size + alignment - 1};
+    // Continue on the next retained block that fits the allocation
+    size_t index{cursor ? block_index + 1 : 0};
+    while (index < blocks.size() && blocks[index].size < required_size) {
+        ++index;
+    }
+    if (index == blocks.size()) {
+        const size_t new_size{std::max(block_size, required_size)};
+        blocks.push_back(Block{
+            .memory = std::make_unique_for_overwrite<u8[]>(new_size),
+            .size = new_size,
+        });
+        ++statistics.system_allocations;
+    }
+    UseBlock(index);
+
+    const uintptr_t address{Common::AlignUp(reinterpret_cast<uintptr_t>(cursor), alignment)};
+    cursor = reinterpret_cast<u8*>(address + size);
+    return reinterpret_cast<void*>(address);
+}
+
+void Arena::UseBlock(size_t index) noexcept {
+    block_index = index;
+    cursor = blocks[index].memory.get();
+    end = cursor + blocks[index].size;
+}
+
+ScopedArena::ScopedArena(Arena& arena) : previous{current_arena} {
+    current_arena = &arena;
+}
+
+ScopedArena::~ScopedArena() {
+    current_arena = previous;
+}
+
+} // namespace Shader
@@ -0,0 +1,154 @@
+// SPDX-FileCopyrightText: Copyright 2026 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <map>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "common/alignment.h"
+#include "common/common_types.h"
+
+namespace Shader {
+
+/**
+ * Bump allocator backing the temporary allocations made while a program is translated.
+ * Memory is never returned individually, Reset rewinds the arena and keeps its memory for the next
+ * program. Once the arena has grown to fit the largest program, Reset runs in constant time and
+ * translation does not allocate from the system at all.
+ *
+ * The arena is installed on the translating thread with ScopedArena, and ArenaAllocator
+ * containers created while it is installed allocate from it.
+ */
+class Arena {
+public:
+    struct Statistics {
+        u64 allocations{};        ///< Number of allocations served by the arena
+        u64 allocated_bytes{};    ///< Bytes requested from the arena
+        u64 system_allocations{}; ///< Number of blocks allocated from the system
+    };
+
+    Arena() = default;
+    explicit Arena(size_t block_size_) : block_size{block_size_} {}
+
+    /// Returns size bytes aligned to alignment, valid until the next call to Reset
+    [[nodiscard]] void* Allocate(size_t size, size_t alignment) {
+        ++statistics.allocations;
+        statistics.allocated_bytes += size;
+
+        const uintptr_t address{Common::AlignUp(reinterpret_cast<uintptr_t>(cursor), alignment)};
+        if (cursor == nullptr || address + size > reinterpret_cast<uintptr_t>(end)) {
+            return AllocateSlow(size, alignment);
+        }
+        cursor = reinterpret_cast<u8*>(address + size);
+        return reinterpret_cast<void*>(address);
+    }
+
+    /// Releases every allocation of the arena at once
+    void Reset();
+
+    [[nodiscard]] const Statistics& GetStatistics() const noexcept {
+        return statistics;
+    }
+
+    /// Returns the arena installed on the current thread, or null when there is none
+    [[nodiscard]] static Arena* Current() noexcept;
+
+private:
+    struct Block {
+        std::unique_ptr<u8[]> memory;
+        size_t size{};
+    };
+
+    [[nodiscard]] void* AllocateSlow(size_t size, size_t alignment);
+
+    void UseBlock(size_t index) noexcept;
+
+    std::vector<Block> blocks;
+    size_t block_index{};
+    u8* cursor{};
+    u8* end{};
+    size_t block_size{64 * 1024};
+    Statistics statistics;
+};
+
+/// Installs an arena on the current thread for the lifetime of the object
+class ScopedArena {
+public:
+    explicit ScopedArena(Arena& arena);
+    ~ScopedArena();
+
+    ScopedArena(const ScopedArena&) = delete;
+    ScopedArena& operator=(const ScopedArena&) = delete;
+
+private:
+    Arena* previous;
+};
+
+/**
+ * Allocator drawing from the arena installed on the thread when it was constructed, or from the
+ * heap when there was none.
+ * Containers using it must not outlive the next Reset of their arena.
+ */
+template <typename T>
+class ArenaAllocator {
+public:
+    using value_type = T;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    ArenaAllocator() noexcept : arena{Arena::Current()} {}
+
+    explicit ArenaAllocator(Arena* arena_) noexcept : arena{arena_} {}
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept : arena{other.arena} {}
+
+    [[nodiscard]] T* allocate(size_t n) {
+        if (!arena) {
+            return std::allocator<T>{}.allocate(n);
+        }
+        if (n > std::numeric_limits<size_t>::max() / sizeof(T)) {
+            throw std::bad_array_new_length{};
+        }
+        return static_cast<T*>(arena->Allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* pointer, size_t n) noexcept {
+        if (!arena) {
+            std::allocator<T>{}.deallocate(pointer, n);
+        }
+    }
+
+    template <typename U>
+    [[nodiscard]] bool operator==(const ArenaAllocator<U>& rhs) const noexcept {
+        return arena == rhs.arena;
+    }
+
+private:
+    template <typename U>
+    friend class ArenaAllocator;
+
+    Arena* arena;
+};
+
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+template <typename Key, typename T, typename Compare = std::less<Key>>
+using ArenaMap = std::map<Key, T, Compare, ArenaAllocator<std::pair<const Key, T>>>;
+
+template <typename Key, typename T, typename Hash = std::hash<Key>>
+using ArenaUnorderedMap =
+    std::unordered_map<Key, T, Hash, std::equal_to<Key>, ArenaAllocator<std::pair<const Key, T>>>;
+
+} // namespace Shader
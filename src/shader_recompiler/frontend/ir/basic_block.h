@@ -12,6 +12,7 @@
 
 #include "common/bit_cast.h"
 #include "common/common_types.h"
+#include "shader_recompiler/arena.h"
 #include "shader_recompiler/frontend/ir/condition.h"
 #include "shader_recompiler/frontend/ir/value.h"
 #include "shader_recompiler/object_pool.h"
@@ -173,9 +174,9 @@ private:
     InstructionList instructions;
 
     /// Block immediate predecessors
-    std::vector<Block*> imm_predecessors;
+    ArenaVector<Block*> imm_predecessors;
     /// Block immediate successors
-    std::vector<Block*> imm_successors;
+    ArenaVector<Block*> imm_successors;
 
     /// Intrusively store the value of a register in the block.
     std::array<Value, NUM_REGS> ssa_reg_values;
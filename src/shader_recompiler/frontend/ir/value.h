@@ -16,6 +16,7 @@
 #include "common/assert.h"
 #include "common/bit_cast.h"
 #include "common/common_types.h"
+#include "shader_recompiler/arena.h"
 #include "shader_recompiler/exception.h"
 #include "shader_recompiler/frontend/ir/attribute.h"
 #include "shader_recompiler/frontend/ir/opcodes.h"
@@ -241,7 +242,9 @@ private:
     u32 definition{};
     union {
         NonTriviallyDummy dummy{};
-        boost::container::small_vector<std::pair<Block*, Value>, 2> phi_args;
+        boost::container::small_vector<std::pair<Block*, Value>, 2,
+                                        ArenaAllocator<std::pair<Block*, Value>>>
+            phi_args;
         std::array<Value, 5> args;
     };
     std::unique_ptr<AssociatedInsts> associated_insts;
@@ -16,6 +16,7 @@
 #include "shader_recompiler/frontend/maxwell/translate_program.h"
 #include "shader_recompiler/host_translate_info.h"
 #include "shader_recompiler/ir_opt/passes.h"
+#include "shader_recompiler/profiler.h"
 
 namespace Shader::Maxwell {
 namespace {
@@ -241,8 +242,10 @@ IR::Program TranslateProgram(ObjectPool<IR::Inst>& inst_pool, ObjectPool<IR::Blo
                              Environment& env, Flow::CFG& cfg, const HostTranslateInfo& host_info) {
     IR::Program program;
     program.syntax_list = BuildASL(inst_pool, block_pool, env, cfg, host_info);
-    program.blocks = GenerateBlocks(program.syntax_list);
-    program.post_order_blocks = PostOrder(program.syntax_list.front());
+    ProfilePhase("Blocks", [&] {
+        program.blocks = GenerateBlocks(program.syntax_list);
+        program.post_order_blocks = PostOrder(program.syntax_list.front());
+    });
     program.stage = env.ShaderStage();
     program.local_memory_size = env.LocalMemorySize();
     switch (program.stage) {
@@ -277,43 +280,47 @@ IR::Program TranslateProgram(ObjectPool<IR::Inst>& inst_pool, ObjectPool<IR::Blo
     default:
         break;
     }
-    RemoveUnreachableBlocks(program);
+    ProfilePhase("RemoveUnreachableBlocks", [&] { RemoveUnreachableBlocks(program); });
 
     // Replace instructions before the SSA rewrite
     if (!host_info.support_float64) {
-        Optimization::LowerFp64ToFp32(program);
+        ProfilePhase("LowerFp64ToFp32", [&] { Optimization::LowerFp64ToFp32(program); });
     }
     if (!host_info.support_float16) {
-        Optimization::LowerFp16ToFp32(program);
+        ProfilePhase("LowerFp16ToFp32", [&] { Optimization::LowerFp16ToFp32(program); });
     }
     if (!host_info.support_int64) {
-        Optimization::LowerInt64ToInt32(program);
+        ProfilePhase("LowerInt64ToInt32", [&] { Optimization::LowerInt64ToInt32(program); });
     }
     if (!host_info.support_conditional_barrier) {
-        Optimization::ConditionalBarrierPass(program);
+        ProfilePhase("ConditionalBarrier", [&] { Optimization::ConditionalBarrierPass(program); });
     }
-    Optimization::SsaRewritePass(program);
+    ProfilePhase("SsaRewrite", [&] { Optimization::SsaRewritePass(program); });
 
-    Optimization::ConstantPropagationPass(env, program);
+    ProfilePhase("ConstantPropagation",
+                 [&] { Optimization::ConstantPropagationPass(env, program); });
 
-    Optimization::PositionPass(env, program);
+    ProfilePhase("Position", [&] { Optimization::PositionPass(env, program); });
 
-    Optimization::GlobalMemoryToStorageBufferPass(program, host_info);
-    Optimization::TexturePass(env, program, host_info);
+    ProfilePhase("GlobalMemoryToStorageBuffer",
+                 [&] { Optimization::GlobalMemoryToStorageBufferPass(program, host_info); });
+    ProfilePhase("Texture", [&] { Optimization::TexturePass(env, program, host_info); });
 
     if (Settings::values.resolution_info.active) {
-        Optimization::RescalingPass(program);
+        ProfilePhase("Rescaling", [&] { Optimization::RescalingPass(program); });
     }
-    Optimization::DeadCodeEliminationPass(program);
+    ProfilePhase("DeadCodeElimination", [&] { Optimization::DeadCodeEliminationPass(program); });
     if (Settings::values.renderer_debug) {
-        Optimization::VerificationPass(program);
+        ProfilePhase("Verification", [&] { Optimization::VerificationPass(program); });
     }
-    Optimization::CollectShaderInfoPass(env, program);
-    Optimization::LayerPass(program, host_info);
-    Optimization::VendorWorkaroundPass(program);
-
-    CollectInterpolationInfo(env, program);
-    AddNVNStorageBuffers(program);
+    ProfilePhase("CollectShaderInfo", [&] { Optimization::CollectShaderInfoPass(env, program); });
+    ProfilePhase("Layer", [&] { Optimization::LayerPass(program, host_info); });
+    ProfilePhase("VendorWorkaround", [&] { Optimization::VendorWorkaroundPass(program); });
+
+    ProfilePhase("InterpolationInfo", [&] {
+        CollectInterpolationInfo(env, program);
+        AddNVNStorageBuffers(program);
+    });
     return program;
 }
 
@@ -6,15 +6,23 @@
 #include <memory>
 #include <type_traits>
 #include <utility>
+#include <vector>
+
+#include "shader_recompiler/arena.h"
 
 namespace Shader {
 
+/**
+ * Pool of objects released all at once.
+ * Pools created while an arena is installed on the thread allocate their chunks from it, and must
+ * not outlive the next Reset of that arena.
+ */
 template <typename T>
     requires std::is_destructible_v<T>
 class ObjectPool {
 public:
     explicit ObjectPool(size_t chunk_size = 8192) : new_chunk_size{chunk_size} {
-        node = &chunks.emplace_back(new_chunk_size);
+        node = &chunks.emplace_back(new_chunk_size, allocator);
     }
 
     template <typename... Args>
@@ -32,7 +40,7 @@ public:
             // Root chunk has been filled, squash allocations into it
             const size_t total_objects{root.num_objects + new_chunk_size * (chunks.size() - 1)};
             chunks.clear();
-            chunks.emplace_back(total_objects);
+            chunks.emplace_back(total_objects, allocator);
         } else {
             root.Release();
             chunks.resize(1);
@@ -56,33 +64,46 @@ private:
 
     struct Chunk {
         explicit Chunk() = default;
-        explicit Chunk(size_t size)
-            : num_objects{size}, storage{std::make_unique<Storage[]>(size)} {}
+        explicit Chunk(size_t size, const ArenaAllocator<Storage>& allocator_)
+            : num_objects{size}, allocator{allocator_}, storage{allocator.allocate(size)} {
+            std::uninitialized_default_construct_n(storage, size);
+        }
 
         Chunk& operator=(Chunk&& rhs) noexcept {
-            Release();
+            Free();
             used_objects = std::exchange(rhs.used_objects, 0);
             num_objects = std::exchange(rhs.num_objects, 0);
-            storage = std::move(rhs.storage);
+            allocator = rhs.allocator;
+            storage = std::exchange(rhs.storage, nullptr);
             return *this;
         }
 
         Chunk(Chunk&& rhs) noexcept
             : used_objects{std::exchange(rhs.used_objects, 0)},
-              num_objects{std::exchange(rhs.num_objects, 0)}, storage{std::move(rhs.storage)} {}
+              num_objects{std::exchange(rhs.num_objects, 0)}, allocator{rhs.allocator},
+              storage{std::exchange(rhs.storage, nullptr)} {}
 
         ~Chunk() {
-            Release();
+            Free();
         }
 
         void Release() {
-            std::destroy_n(storage.get(), used_objects);
+            std::destroy_n(storage, used_objects);
             used_objects = 0;
         }
 
+        void Free() {
+            if (storage) {
+                Release();
+                allocator.deallocate(storage, num_objects);
+                storage = nullptr;
+            }
+        }
+
         size_t used_objects{};
         size_t num_objects{};
-        std::unique_ptr<Storage[]> storage;
+        ArenaAllocator<Storage> allocator{nullptr};
+        Storage* storage{};
     };
 
     [[nodiscard]] T* Memory() {
@@ -94,10 +115,11 @@ private:
         if (node->used_objects != node->num_objects) {
             return node;
         }
-        node = &chunks.emplace_back(new_chunk_size);
+        node = &chunks.emplace_back(new_chunk_size, allocator);
         return node;
     }
 
+    ArenaAllocator<Storage> allocator;
     Chunk* node{};
     std::vector<Chunk> chunks;
     size_t new_chunk_size{};
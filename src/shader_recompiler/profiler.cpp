@@ -0,0 +1,58 @@
+// SPDX-FileCopyrightText: Copyright 2026 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+
+#include "shader_recompiler/profiler.h"
+
+namespace Shader {
+namespace {
+thread_local Profiler* current_profiler{};
+} // Anonymous namespace
+
+void Profiler::Record(std::string_view name, std::chrono::nanoseconds time) {
+    Phase& phase{GetPhase(name)};
+    phase.time += time;
+    ++phase.count;
+}
+
+void Profiler::Merge(const Profiler& other) {
+    for (const Phase& other_phase : other.phases) {
+        Phase& phase{GetPhase(other_phase.name)};
+        phase.time += other_phase.time;
+        phase.count += other_phase.count;
+    }
+}
+
+void Profiler::Reset() {
+    phases.clear();
+}
+
+Profiler::Phase& Profiler::GetPhase(std::string_view name) {
+    // There are few phases, a linear search is faster than hashing their names
+    const auto it{std::ranges::find(phases, name, &Phase::name)};
+    return it != phases.end() ? *it : phases.emplace_back(Phase{.name = name});
+}
+
+ScopedProfiler::ScopedProfiler(Profiler& profiler) : previous{current_profiler} {
+    current_profiler = &profiler;
+}
+
+ScopedProfiler::~ScopedProfiler() {
+    current_profiler = previous;
+}
+
+ProfileScope::ProfileScope(std::string_view name_) noexcept
+    : profiler{current_profiler}, name{name_} {
+    if (profiler) {
+        start = std::chrono::steady_clock::now();
+    }
+}
+
+ProfileScope::~ProfileScope() {
+    if (profiler) {
+        profiler->Record(name, std::chrono::steady_clock::now() - start);
+    }
+}
+
+} // namespace Shader
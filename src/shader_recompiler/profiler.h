@@ -0,0 +1,81 @@
+// SPDX-FileCopyrightText: Copyright 2026 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <chrono>
+#include <string_view>
+#include <vector>
+
+#include "common/common_types.h"
+
+namespace Shader {
+
+/**
+ * Accumulates the time spent in each phase of shader compilation.
+ * Phases are recorded into the profiler installed on the compiling thread with ScopedProfiler,
+ * and are not timed at all when there is none.
+ */
+class Profiler {
+public:
+    struct Phase {
+        std::string_view name;
+        std::chrono::nanoseconds time{};
+        u64 count{};
+    };
+
+    /// Adds time to a phase, name must be a string literal
+    void Record(std::string_view name, std::chrono::nanoseconds time);
+
+    /// Adds the phases of another profiler
+    void Merge(const Profiler& other);
+
+    void Reset();
+
+    /// Returns the phases in the order they were first recorded
+    [[nodiscard]] const std::vector<Phase>& Phases() const noexcept {
+        return phases;
+    }
+
+private:
+    Phase& GetPhase(std::string_view name);
+
+    std::vector<Phase> phases;
+};
+
+/// Installs a profiler on the current thread for the lifetime of the object
+class ScopedProfiler {
+public:
+    explicit ScopedProfiler(Profiler& profiler);
+    ~ScopedProfiler();
+
+    ScopedProfiler(const ScopedProfiler&) = delete;
+    ScopedProfiler& operator=(const ScopedProfiler&) = delete;
+
+private:
+    Profiler* previous;
+};
+
+/// Times the enclosing scope as a phase of the profiler installed on the current thread
+class ProfileScope {
+public:
+    explicit ProfileScope(std::string_view name_) noexcept;
+    ~ProfileScope();
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    Profiler* profiler;
+    std::string_view name;
+    std::chrono::steady_clock::time_point start;
+};
+
+/// Runs func as a phase of the profiler installed on the current thread
+template <typename Func>
+void ProfilePhase(std::string_view name, Func&& func) {
+    const ProfileScope scope{name};
+    func();
+}
+
+} // namespace Shader
@@ -0,0 +1,550 @@
+// SPDX-FileCopyrightText: Copyright 2026 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <new>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#include <fmt/format.h>
+
+#include "common/common_types.h"
+#include "common/logging/backend.h"
+#include "common/logging/log.h"
+#include "common/scm_rev.h"
+#include "shader_recompiler/arena.h"
+#include "shader_recompiler/backend/bindings.h"
+#include "shader_recompiler/backend/glasm/emit_glasm.h"
+#include "shader_recompiler/backend/glsl/emit_glsl.h"
+#include "shader_recompiler/backend/spirv/emit_spirv.h"
+#include "shader_recompiler/exception.h"
+#include "shader_recompiler/frontend/ir/basic_block.h"
+#include "shader_recompiler/frontend/ir/program.h"
+#include "shader_recompiler/frontend/maxwell/control_flow.h"
+#include "shader_recompiler/frontend/maxwell/translate_program.h"
+#include "shader_recompiler/host_translate_info.h"
+#include "shader_recompiler/object_pool.h"
+#include "shader_recompiler/profile.h"
+#include "shader_recompiler/profiler.h"
+#include "shader_recompiler/program_header.h"
+#include "shader_recompiler/runtime_info.h"
+#include "video_core/shader_environment.h"
+
+#undef _UNICODE
+#include <getopt.h>
+#ifndef _MSC_VER
+#include <unistd.h>
+#endif
+
+namespace {
+using VideoCommon::FileEnvironment;
+
+enum class Backend {
+    SPIRV,
+    GLSL,
+    GLASM,
+};
+
+constexpr std::array ALL_BACKENDS{Backend::SPIRV, Backend::GLSL, Backend::GLASM};
+
+/// Number of allocations made from the heap by the process, see operator new below
+std::atomic<u64> num_heap_allocations;
+
+struct ShaderPools {
+    void ReleaseContents() {
+        flow_block.ReleaseContents();
+        block.ReleaseContents();
+        inst.ReleaseContents();
+        arena.Reset();
+    }
+
+    Shader::Arena arena;
+    Shader::ObjectPool<Shader::IR::Inst> inst{8192};
+    Shader::ObjectPool<Shader::IR::Block> block{32};
+    Shader::ObjectPool<Shader::Maxwell::Flow::Block> flow_block{32};
+};
+
+struct ReplayResult {
+    std::chrono::nanoseconds time{};
+    u64 num_pipelines{};
+    u64 num_shaders{};
+    u64 num_instructions{};
+    u64 num_failures{};
+    u64 output_size{};
+    u64 num_heap_allocations{};
+    Shader::Arena::Statistics arena_statistics;
+};
+
+std::string_view BackendName(Backend backend) {
+    switch (backend) {
+    case Backend::SPIRV:
+        return "SPIR-V";
+    case Backend::GLSL:
+        return "GLSL";
+    case Backend::GLASM:
+        return "GLASM";
+    }
+    return "Unknown";
+}
+
+std::string_view EmitPhaseName(Backend backend) {
+    switch (backend) {
+    case Backend::SPIRV:
+        return "Emit SPIR-V";
+    case Backend::GLSL:
+        return "Emit GLSL";
+    case Backend::GLASM:
+        return "Emit GLASM";
+    }
+    return "Emit";
+}
+
+/// Profile of a capable desktop host, so every backend feature is exercised
+Shader::Profile MakeProfile() {
+    return Shader::Profile{
+        .supported_spirv = 0x00010600,
+        .unified_descriptor_binding = true,
+        .support_descriptor_aliasing = true,
+        .support_int8 = true,
+        .support_int16 = true,
+        .support_int64 = true,
+        .support_vertex_instance_id = false,
+        .support_float_controls = true,
+        .support_separate_denorm_behavior = true,
+        .support_separate_rounding_mode = true,
+        .support_fp16_denorm_preserve = true,
+        .support_fp32_denorm_preserve = true,
+        .support_fp16_denorm_flush = true,
+        .support_fp32_denorm_flush = true,
+        .support_fp16_signed_zero_nan_preserve = true,
+        .support_fp32_signed_zero_nan_preserve = true,
+        .support_fp64_signed_zero_nan_preserve = true,
+        .support_explicit_workgroup_layout = true,
+        .support_vote = true,
+        .support_viewport_index_layer_non_geometry = true,
+        .support_viewport_mask = true,
+        .support_typeless_image_loads = true,
+        .support_demote_to_helper_invocation = true,
+        .support_int64_atomics = true,
+        .support_derivative_control = true,
+        .support_geometry_shader_passthrough = true,
+        .support_native_ndc = true,
+        .support_gl_nv_gpu_shader_5 = true,
+        .support_gl_amd_gpu_shader_half_float = false,
+        .support_gl_texture_shadow_lod = true,
+        .support_gl_warp_intrinsics = true,
+        .support_gl_variable_aoffi = true,
+        .support_gl_sparse_textures = true,
+        .support_gl_derivative_control = true,
+        .support_scaled_attributes = true,
+        .support_multi_viewport = true,
+        .support_geometry_streams = true,
+        .warp_size_potentially_larger_than_guest = false,
+        .lower_left_origin_mode = false,
+        .need_declared_frag_colors = false,
+        .need_fastmath_off = false,
+        .need_gather_subpixel_offset = false,
+        .has_broken_spirv_clamp = false,
+        .has_broken_spirv_position_input = false,
+        .has_broken_unsigned_image_offsets = false,
+        .has_broken_signed_operations = false,
+        .has_broken_fp16_float_controls = false,
+        .has_gl_component_indexing_bug = false,
+        .has_gl_precise_bug = false,
+        .has_gl_cbuf_ftou_bug = false,
+        .has_gl_bool_ref_bug = false,
+        .ignore_nan_fp_comparisons = false,
+        .has_broken_spirv_subgroup_mask_vector_extract_dynamic = false,
+        .gl_max_compute_smem_size = 0xC000,
+        .has_broken_robust = false,
+        .min_ssbo_alignment = 16,
+        .max_user_clip_distances = 8,
+    };
+}
+
+Shader::HostTranslateInfo MakeHostInfo() {
+    return Shader::HostTranslateInfo{
+        .support_float64 = true,
+        .support_float16 = true,
+        .support_int64 = true,
+        .needs_demote_reorder = false,
+        .support_snorm_render_buffer = true,
+        .support_viewport_index_layer = true,
+        .min_ssbo_alignment = 16,
+        .support_geometry_shader_passthrough = true,
+        .support_conditional_barrier = true,
+    };
+}
+
+/// Counts the guest instructions reachable in the control flow graph, skipping scheduling words
+u64 CountInstructions(const Shader::Maxwell::Flow::CFG& cfg) {
+    u64 count{};
+    for (const Shader::Maxwell::Flow::Function& function : cfg.Functions()) {
+        for (const Shader::Maxwell::Flow::Block& block : function.blocks) {
+            if (block.begin.IsVirtual()) {
+                continue;
+            }
+            for (Shader::Maxwell::Location pc = block.begin; pc < block.end; ++pc) {
+                ++count;
+            }
+        }
+    }
+    return count;
+}
+
+/// Returns the peak resident memory of the process in bytes
+u64 PeakMemoryUsage() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters{};
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return 0;
+    }
+    return counters.PeakWorkingSetSize;
+#else
+    rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+#ifdef __APPLE__
+    return static_cast<u64>(usage.ru_maxrss);
+#else
+    return static_cast<u64>(usage.ru_maxrss) * 1024;
+#endif
+#endif
+}
+
+/// Recompiles pipelines from the cache the way the renderers do, without a host GPU
+class Replayer {
+public:
+    explicit Replayer(Backend backend_, bool use_arena_)
+        : backend{backend_}, use_arena{use_arena_} {}
+
+    void Compile(std::vector<FileEnvironment>& envs, ReplayResult& result) try {
+        std::optional<Shader::ScopedArena> scoped_arena;
+        if (use_arena) {
+            pools.ReleaseContents();
+            scoped_arena.emplace(pools.arena);
+        } else {
+            // Allocate every pipeline from the heap, the way pipelines were built without an arena
+            pools = ShaderPools{};
+        }
+        if (envs.size() == 1 && envs[0].ShaderStage() == Shader::Stage::Compute) {
+            CompileCompute(envs[0], result);
+        } else {
+            CompileGraphics(envs, result);
+        }
+        ++result.num_pipelines;
+    } catch (const Shader::Exception& exception) {
+        LOG_ERROR(Shader, "{}", exception.what());
+        ++result.num_failures;
+    }
+
+    [[nodiscard]] const Shader::Arena::Statistics& ArenaStatistics() const noexcept {
+        return pools.arena.GetStatistics();
+    }
+
+private:
+    Shader::IR::Program Translate(Shader::Environment& env, u32 start_address,
+                                  bool exits_to_dispatcher, ReplayResult& result) {
+        std::optional<Shader::Maxwell::Flow::CFG> cfg;
+        Shader::ProfilePhase("CFG", [&] {
+            cfg.emplace(env, pools.flow_block, start_address, exits_to_dispatcher);
+        });
+        result.num_instructions += CountInstructions(*cfg);
+        ++result.num_shaders;
+        return Shader::Maxwell::TranslateProgram(pools.inst, pools.block, env, *cfg, host_info);
+    }
+
+    void CompileCompute(FileEnvironment& env, ReplayResult& result) {
+        Shader::IR::Program program{Translate(env, env.StartAddress(), false, result)};
+        Shader::RuntimeInfo runtime_info{};
+        runtime_info.glasm_use_storage_buffers = true;
+        Emit(program, runtime_info, result);
+    }
+
+    void CompileGraphics(std::vector<FileEnvironment>& envs, ReplayResult& result) {
+        std::vector<Shader::IR::Program> programs;
+        programs.reserve(envs.size());
+        for (FileEnvironment& env : envs) {
+            const Shader::Stage stage{env.ShaderStage()};
+            const u32 start_address{
+                static_cast<u32>(env.StartAddress() + sizeof(Shader::ProgramHeader))};
+            Shader::IR::Program program{
+                Translate(env, start_address, stage == Shader::Stage::VertexA, result)};
+            if (stage == Shader::Stage::VertexB && !programs.empty() &&
+                programs.back().stage == Shader::Stage::VertexA) {
+                Shader::ProfilePhase("MergeDualVertex", [&] {
+                    programs.back() =
+                        Shader::Maxwell::MergeDualVertexPrograms(programs.back(), program, env);
+                });
+                continue;
+            }
+            programs.push_back(std::move(program));
+        }
+        // Fixed function state lives in the pipeline key, emission uses the default state
+        const Shader::IR::Program* previous_program{};
+        for (Shader::IR::Program& program : programs) {
+            Shader::RuntimeInfo runtime_info{};
+            if (previous_program) {
+                runtime_info.previous_stage_stores = previous_program->info.stores;
+                runtime_info.previous_stage_legacy_stores_mapping =
+                    previous_program->info.legacy_stores_mapping;
+            } else {
+                runtime_info.previous_stage_stores.mask.set();
+            }
+            runtime_info.glasm_use_storage_buffers = true;
+            Emit(program, runtime_info, result);
+            previous_program = &program;
+        }
+    }
+
+    void Emit(Shader::IR::Program& program, const Shader::RuntimeInfo& runtime_info,
+              ReplayResult& result) {
+        Shader::ProfilePhase(EmitPhaseName(backend), [&] {
+            switch (backend) {
+            case Backend::SPIRV:
+                Shader::Maxwell::ConvertLegacyToGeneric(program, runtime_info);
+                result.output_size +=
+                    Shader::Backend::SPIRV::EmitSPIRV(profile, runtime_info, program, bindings)
+                        .size() *
+                    sizeof(u32);
+                break;
+            case Backend::GLSL:
+                Shader::Maxwell::ConvertLegacyToGeneric(program, runtime_info);
+                result.output_size +=
+                    Shader::Backend::GLSL::EmitGLSL(profile, runtime_info, program, bindings)
+                        .size();
+                break;
+            case Backend::GLASM:
+                result.output_size +=
+                    Shader::Backend::GLASM::EmitGLASM(profile, runtime_info, program, bindings)
+                        .size();
+                break;
+            }
+        });
+    }
+
+    Backend backend;
+    bool use_arena;
+    Shader::Profile profile{MakeProfile()};
+    Shader::HostTranslateInfo host_info{MakeHostInfo()};
+    Shader::Backend::Bindings bindings;
+    ShaderPools pools;
+};
+
+double Milliseconds(std::chrono::nanoseconds time) {
+    return std::chrono::duration<double, std::milli>(time).count();
+}
+
+double PerSecond(u64 count, std::chrono::nanoseconds time) {
+    const double seconds = std::chrono::duration<double>(time).count();
+    return seconds > 0.0 ? static_cast<double>(count) / seconds : 0.0;
+}
+
+void PrintReport(Backend backend, const ReplayResult& result, const Shader::Profiler& profiler) {
+    fmt::print("\n{} backend\n", BackendName(backend));
+    fmt::print("  {} pipelines, {} shaders, {} guest instructions, {} failed\n",
+               result.num_pipelines, result.num_shaders, result.num_instructions,
+               result.num_failures);
+    fmt::print("  {:.2f} ms total, {:.1f} pipelines/s, {:.1f} shaders/s, {:.0f} instructions/s\n",
+               Milliseconds(result.time), PerSecond(result.num_pipelines, result.time),
+               PerSecond(result.num_shaders, result.time),
+               PerSecond(result.num_instructions, result.time));
+    fmt::print("  {:.2f} MiB of host code\n",
+               static_cast<double>(result.output_size) / (1024.0 * 1024.0));
+    fmt::print("  {} heap allocations, {:.1f} per pipeline\n", result.num_heap_allocations,
+               static_cast<double>(result.num_heap_allocations) /
+                   static_cast<double>(std::max<u64>(result.num_pipelines, 1)));
+    if (result.arena_statistics.allocations != 0) {
+        fmt::print("  {} arena allocations, {:.2f} MiB, {} arena blocks\n",
+                   result.arena_statistics.allocations,
+                   static_cast<double>(result.arena_statistics.allocated_bytes) /
+                       (1024.0 * 1024.0),
+                   result.arena_statistics.system_allocations);
+    }
+
+    fmt::print("  {:<28}{:>12}{:>9}{:>10}{:>12}\n", "Phase", "Total (ms)", "Share", "Calls",
+               "Mean (us)");
+    for (const Shader::Profiler::Phase& phase : profiler.Phases()) {
+        const double share = result.time.count() > 0
+                                 ? 100.0 * static_cast<double>(phase.time.count()) /
+                                       static_cast<double>(result.time.count())
+                                 : 0.0;
+        const double mean = std::chrono::duration<double, std::micro>(phase.time).count() /
+                            static_cast<double>(std::max<u64>(phase.count, 1));
+        fmt::print("  {:<28}{:>12.2f}{:>8.1f}%{:>10}{:>12.2f}\n", phase.name,
+                   Milliseconds(phase.time), share, phase.count, mean);
+    }
+}
+
+void PrintHelp(const char* argv0) {
+    fmt::print("Usage: {} [options] <pipeline cache>\n"
+               "Recompiles every pipeline in a pipeline cache and reports where the time goes\n"
+               "-b, --backend     spirv, glsl, glasm or all (default: spirv)\n"
+               "-i, --iterations  Number of times each pipeline is recompiled (default: 1)\n"
+               "-n, --no-arena    Allocate from the heap instead of a reused arena\n"
+               "-h, --help        Display this help and exit\n"
+               "-v, --version     Output version information and exit\n",
+               argv0);
+}
+
+void PrintVersion() {
+    fmt::print("citron shader replay {} {}\n", Common::g_scm_branch, Common::g_scm_desc);
+}
+
+std::optional<std::vector<Backend>> ParseBackends(std::string_view name) {
+    if (name == "spirv") {
+        return std::vector{Backend::SPIRV};
+    }
+    if (name == "glsl") {
+        return std::vector{Backend::GLSL};
+    }
+    if (name == "glasm") {
+        return std::vector{Backend::GLASM};
+    }
+    if (name == "all") {
+        return std::vector(ALL_BACKENDS.begin(), ALL_BACKENDS.end());
+    }
+    return std::nullopt;
+}
+} // Anonymous namespace
+
+// Count the allocations of the recompiler, aligned allocations are rare enough to be left out
+void* operator new(std::size_t size) {
+    ++num_heap_allocations;
+    if (void* const pointer = std::malloc(size != 0 ? size : 1)) {
+        return pointer;
+    }
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+/// Application entry point
+int main(int argc, char** argv) {
+    Common::Log::Initialize();
+    Common::Log::SetColorConsoleBackendEnabled(true);
+    Common::Log::Start();
+
+    std::vector<Backend> backends{Backend::SPIRV};
+    u32 iterations = 1;
+    bool use_arena = true;
+
+    static struct option long_options[] = {
+        {"backend", required_argument, 0, 'b'},
+        {"iterations", required_argument, 0, 'i'},
+        {"no-arena", no_argument, 0, 'n'},
+        {"help", no_argument, 0, 'h'},
+        {"version", no_argument, 0, 'v'},
+        {0, 0, 0, 0},
+    };
+
+    int option_index = 0;
+    int arg;
+    while ((arg = getopt_long(argc, argv, "b:i:nhv", long_options, &option_index)) != -1) {
+        switch (static_cast<char>(arg)) {
+        case 'b': {
+            const auto parsed = ParseBackends(optarg);
+            if (!parsed) {
+                LOG_CRITICAL(Shader, "Unknown backend: {}", optarg);
+                return EXIT_FAILURE;
+            }
+            backends = *parsed;
+            break;
+        }
+        case 'i': {
+            char* endarg;
+            iterations = static_cast<u32>(std::strtoul(optarg, &endarg, 0));
+            if (*endarg != '\0' || iterations == 0) {
+                LOG_CRITICAL(Shader, "Invalid number of iterations: {}", optarg);
+                return EXIT_FAILURE;
+            }
+            break;
+        }
+        case 'n':
+            use_arena = false;
+            break;
+        case 'h':
+            PrintHelp(argv[0]);
+            return EXIT_SUCCESS;
+        case 'v':
+            PrintVersion();
+            return EXIT_SUCCESS;
+        default:
+            PrintHelp(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    if (optind + 1 != argc) {
+        PrintHelp(argv[0]);
+        return EXIT_FAILURE;
+    }
+    const std::filesystem::path cache_path{argv[optind]};
+    if (!std::filesystem::exists(cache_path)) {
+        LOG_CRITICAL(Shader, "Pipeline cache not found: {}", argv[optind]);
+        return EXIT_FAILURE;
+    }
+
+    // Decompress every pipeline ahead of time, so only the recompiler is measured
+    const auto load_start = std::chrono::steady_clock::now();
+    std::vector<std::vector<FileEnvironment>> pipelines;
+    const auto load = [&pipelines](VideoCommon::SerializedPipeline serialized) {
+        std::vector<FileEnvironment> envs = serialized.Deserialize();
+        if (!envs.empty()) {
+            pipelines.push_back(std::move(envs));
+        }
+    };
+    VideoCommon::ReadPipelines(cache_path, load, load);
+    const auto load_time = std::chrono::steady_clock::now() - load_start;
+    if (pipelines.empty()) {
+        LOG_CRITICAL(Shader, "No pipelines could be read from {}", argv[optind]);
+        return EXIT_FAILURE;
+    }
+    fmt::print("Loaded {} pipelines in {:.2f} ms\n", pipelines.size(), Milliseconds(load_time));
+
+    for (const Backend backend : backends) {
+        Replayer replayer{backend, use_arena};
+        Shader::Profiler profiler;
+        ReplayResult result;
+        {
+            const Shader::ScopedProfiler scoped_profiler{profiler};
+            const u64 heap_allocations_start = num_heap_allocations;
+            const auto start = std::chrono::steady_clock::now();
+            for (u32 iteration = 0; iteration < iterations; ++iteration) {
+                for (std::vector<FileEnvironment>& envs : pipelines) {
+                    replayer.Compile(envs, result);
+                }
+            }
+            result.time = std::chrono::steady_clock::now() - start;
+            result.num_heap_allocations = num_heap_allocations - heap_allocations_start;
+            result.arena_statistics = replayer.ArenaStatistics();
+        }
+        PrintReport(backend, result, profiler);
+    }
+    fmt::print("\nPeak memory: {:.2f} MiB\n",
+               static_cast<double>(PeakMemoryUsage()) / (1024.0 * 1024.0));
+
+    Common::Log::Stop();
+    return EXIT_SUCCESS;
+}
@@ -1,6 +1,7 @@
 // SPDX-FileCopyrightText: 2016 Dolphin Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
 
 #include <array>
@@ -9,10 +10,14 @@
 #include <cstdlib>
 #include <memory>
 #include <optional>
+#include <random>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "core/core.h"
 #include "core/core_timing.h"
+#include "core/core_timing_queue.h"
 
 namespace {
 // Numbers are chosen randomly to make sure the correct one is given.
@@ -31,8 +36,17 @@ std::optional<std::chrono::nanoseconds> HostCallbackTemplate(s64 time,
     return std::nullopt;
 }
 
+constexpr std::array QUEUE_TYPES{
+    Core::Timing::EventQueueType::Heap,
+    Core::Timing::EventQueueType::TimingWheel,
+};
+
+const char* NameOf(Core::Timing::EventQueueType queue_type) {
+    return queue_type == Core::Timing::EventQueueType::Heap ? "Heap" : "TimingWheel";
+}
+
 struct ScopeInit final {
-    ScopeInit() {
+    explicit ScopeInit(Core::Timing::EventQueueType queue_type) : core_timing{queue_type} {
         core_timing.SetMulticore(true);
         core_timing.Initialize([]() {});
     }
@@ -50,10 +64,8 @@ u64 TestTimerSpeed(Core::Timing::CoreTiming& core_timing) {
     return end - start;
 }
 
-} // Anonymous namespace
-
-TEST_CASE("CoreTiming[BasicOrder]", "[core]") {
-    ScopeInit guard;
+void BasicOrder(Core::Timing::EventQueueType queue_type) {
+    ScopeInit guard{queue_type};
     auto& core_timing = guard.core_timing;
     std::vector<std::shared_ptr<Core::Timing::EventType>> events{
         Core::Timing::CreateEvent("callbackA", HostCallbackTemplate<0>),
@@ -64,6 +76,7 @@ TEST_CASE("CoreTiming[BasicOrder]", "[core]") {
     };
 
     expected_callback = 0;
+    callbacks_ran_flags.reset();
 
     core_timing.SyncPause(true);
 
@@ -88,12 +101,12 @@ TEST_CASE("CoreTiming[BasicOrder]", "[core]") {
         const double delay = static_cast<double>(delays[i]);
         const double micro = delay / 1000.0f;
         const double mili = micro / 1000.0f;
-        printf("HostTimer Pausing Delay[%zu]: %.3f %.6f\n", i, micro, mili);
+        printf("HostTimer %s Pausing Delay[%zu]: %.3f %.6f\n", NameOf(queue_type), i, micro, mili);
     }
 }
 
-TEST_CASE("CoreTiming[BasicOrderNoPausing]", "[core]") {
-    ScopeInit guard;
+void BasicOrderNoPausing(Core::Timing::EventQueueType queue_type) {
+    ScopeInit guard{queue_type};
     auto& core_timing = guard.core_timing;
     std::vector<std::shared_ptr<Core::Timing::EventType>> events{
         Core::Timing::CreateEvent("callbackA", HostCallbackTemplate<0>),
@@ -107,6 +120,7 @@ TEST_CASE("CoreTiming[BasicOrderNoPausing]", "[core]") {
     core_timing.SyncPause(false);
 
     expected_callback = 0;
+    callbacks_ran_flags.reset();
 
     const u64 start = core_timing.GetGlobalTimeNs().count();
     const u64 one_micro = 1000U;
@@ -130,12 +144,132 @@ TEST_CASE("CoreTiming[BasicOrderNoPausing]", "[core]") {
         const double delay = static_cast<double>(delays[i]);
         const double micro = delay / 1000.0f;
         const double mili = micro / 1000.0f;
-        printf("HostTimer No Pausing Delay[%zu]: %.3f %.6f\n", i, micro, mili);
+        printf("HostTimer %s No Pausing Delay[%zu]: %.3f %.6f\n", NameOf(queue_type), i, micro,
+               mili);
     }
 
     const double micro = scheduling_time / 1000.0f;
     const double mili = micro / 1000.0f;
-    printf("HostTimer No Pausing Scheduling Time: %.3f %.6f\n", micro, mili);
-    printf("HostTimer No Pausing Timer Time: %.3f %.6f\n", timer_time / 1000.f,
-           timer_time / 1000000.f);
+    printf("HostTimer %s No Pausing Scheduling Time: %.3f %.6f\n", NameOf(queue_type), micro,
+           mili);
+    printf("HostTimer %s No Pausing Timer Time: %.3f %.6f\n", NameOf(queue_type),
+           timer_time / 1000.f, timer_time / 1000000.f);
+}
+
+} // Anonymous namespace
+
+TEST_CASE("CoreTiming[BasicOrder]", "[core]") {
+    for (const auto queue_type : QUEUE_TYPES) {
+        BasicOrder(queue_type);
+    }
+}
+
+TEST_CASE("CoreTiming[BasicOrderNoPausing]", "[core]") {
+    for (const auto queue_type : QUEUE_TYPES) {
+        BasicOrderNoPausing(queue_type);
+    }
+}
+
+TEST_CASE("CoreTiming[EventQueues match]", "[core]") {
+    using Core::Timing::EventQueueType;
+    const auto heap = Core::Timing::CreateEventQueue(EventQueueType::Heap);
+    const auto wheel = Core::Timing::CreateEventQueue(EventQueueType::TimingWheel);
+
+    std::vector<std::shared_ptr<Core::Timing::EventType>> types;
+    for (size_t i = 0; i < 16; ++i) {
+        types.push_back(Core::Timing::CreateEvent("event" + std::to_string(i),
+                                                  HostCallbackTemplate<0>));
+    }
+
+    std::mt19937_64 rng{1234};
+    // Delays from a single tick to past the last level of the wheel
+    const auto random_delay = [&rng] {
+        const u64 bits = rng() % 52;
+        return static_cast<s64>(rng() & ((u64{1} << bits) - 1));
+    };
+    s64 now = 1'000'000;
+    u64 fifo_order = 0;
+    for (size_t step = 0; step < 200'000; ++step) {
+        const u64 action = rng() % 16;
+        if (action < 9) {
+            const auto& type = types[rng() % types.size()];
+            // Some events are scheduled in the past, or at the same time as others
+            const s64 time = action == 0 ? now - random_delay() : now + random_delay();
+            heap->Push(type, time, fifo_order, 0);
+            wheel->Push(type, time, fifo_order, 0);
+            ++fifo_order;
+        } else if (action < 10) {
+            const auto& type = types[rng() % types.size()];
+            heap->Remove(type.get());
+            wheel->Remove(type.get());
+        } else {
+            if (rng() % 64 == 0) {
+                // Jump straight to the next event, however far it is
+                now = std::max(now, heap->NextTime().value_or(now));
+            } else {
+                now += random_delay() >> (rng() % 40);
+            }
+            while (true) {
+                const auto expected = heap->PopDue(now);
+                const auto actual = wheel->PopDue(now);
+                REQUIRE(expected.has_value() == actual.has_value());
+                if (!expected) {
+                    break;
+                }
+                REQUIRE(expected->time == actual->time);
+                REQUIRE(expected->fifo_order == actual->fifo_order);
+                REQUIRE(expected->type.lock() == actual->type.lock());
+            }
+        }
+        REQUIRE(heap->Empty() == wheel->Empty());
+        REQUIRE(heap->NextTime() == wheel->NextTime());
+    }
+
+    heap->Clear();
+    wheel->Clear();
+    REQUIRE(wheel->Empty());
+    REQUIRE(!wheel->NextTime());
+}
+
+TEST_CASE("CoreTiming[Benchmark]", "[core][.benchmark]") {
+    constexpr size_t num_threads = 4;
+    constexpr size_t num_iterations = 2'000;
+    constexpr size_t num_background_events = 4'096;
+
+    for (const auto queue_type : QUEUE_TYPES) {
+        ScopeInit guard{queue_type};
+        auto& core_timing = guard.core_timing;
+
+        // Keep the queue populated like a running system, far enough not to fire
+        const auto background = Core::Timing::CreateEvent("background", HostCallbackTemplate<0>);
+        for (size_t i = 0; i < num_background_events; ++i) {
+            core_timing.ScheduleEvent(std::chrono::seconds{3600 + static_cast<s64>(i)},
+                                      background);
+        }
+
+        std::vector<std::shared_ptr<Core::Timing::EventType>> events;
+        for (size_t i = 0; i < num_threads; ++i) {
+            events.push_back(
+                Core::Timing::CreateEvent("stress" + std::to_string(i), HostCallbackTemplate<1>));
+        }
+
+        BENCHMARK(std::string{"Schedule and unschedule from "} + std::to_string(num_threads) +
+                  " threads (" + NameOf(queue_type) + ")") {
+            std::vector<std::jthread> threads;
+            for (size_t i = 0; i < num_threads; ++i) {
+                threads.emplace_back([&core_timing, &event = events[i]] {
+                    for (size_t iteration = 0; iteration < num_iterations; ++iteration) {
+                        const auto delay = std::chrono::milliseconds{
+                            static_cast<s64>(1 + iteration % 1000)};
+                        core_timing.ScheduleEvent(delay, event);
+                        core_timing.ScheduleEvent(delay * 2, event);
+                        core_timing.UnscheduleEvent(event,
+                                                    Core::Timing::UnscheduleEventType::NoWait);
+                    }
+                });
+            }
+        };
+
+        core_timing.UnscheduleEvent(background);
+    }
 }
@@ -0,0 +1,187 @@
+// SPDX-FileCopyrightText: Copyright 2026 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <string>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "core/crypto/aes_util.h"
+#include "core/crypto/key_manager.h"
+#include "tests/test_data.h"
+
+using Core::Crypto::AESCipher;
+using Core::Crypto::AesBackend;
+using Core::Crypto::Key128;
+using Core::Crypto::Key256;
+using Core::Crypto::Mode;
+using Core::Crypto::Op;
+using Tests::MakeData;
+
+namespace {
+
+constexpr std::array NATIVE_BACKENDS{AesBackend::AesNi, AesBackend::Vaes};
+
+template <size_t N>
+std::array<u8, N> MakeArray(u32 seed) {
+    const std::vector<u8> data = MakeData(N, seed);
+    std::array<u8, N> out;
+    std::copy(data.begin(), data.end(), out.begin());
+    return out;
+}
+
+const char* BackendName(AesBackend backend) {
+    switch (backend) {
+    case AesBackend::Auto:
+        return "Auto";
+    case AesBackend::Mbedtls:
+        return "mbedtls";
+    case AesBackend::AesNi:
+        return "AES-NI";
+    case AesBackend::Vaes:
+        return "VAES";
+    }
+    return "Unknown";
+}
+
+} // Anonymous namespace
+
+TEST_CASE("AES[Known answers]", "[core]") {
+    for (const AesBackend backend : {AesBackend::Mbedtls, AesBackend::AesNi, AesBackend::Vaes}) {
+        if (!Core::Crypto::IsAesBackendSupported(backend)) {
+            continue;
+        }
+        // NIST SP 800-38A F.5.1, the second block carries into the next counter byte
+        AESCipher<Key128> ctr(Key128{0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7,
+                                     0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c},
+                              Mode::CTR, backend);
+        REQUIRE(ctr.GetBackend() == backend);
+        ctr.SetIV(std::array<u8, 16>{0xf0, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8, 0xf9,
+                                     0xfa, 0xfb, 0xfc, 0xfd, 0xfe, 0xff});
+        const std::array<u8, 32> plaintext{
+            0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e,
+            0x11, 0x73, 0x93, 0x17, 0x2a, 0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03,
+            0xac, 0x9c, 0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51};
+        const std::array<u8, 32> ctr_expected{
+            0x87, 0x4d, 0x61, 0x91, 0xb6, 0x20, 0xe3, 0x26, 0x1b, 0xef, 0x68,
+            0x64, 0x99, 0x0d, 0xb6, 0xce, 0x98, 0x06, 0xf6, 0x6b, 0x79, 0x70,
+            0xfd, 0xff, 0x86, 0x17, 0x18, 0x7b, 0xb9, 0xff, 0xfd, 0xff};
+        std::array<u8, 32> out{};
+        ctr.Transcode(plaintext.data(), plaintext.size(), out.data(), Op::Encrypt);
+        REQUIRE(out == ctr_expected);
+
+        // IEEE P1619 XTS-AES-128 vector 1, all zero keys, tweak and data
+        AESCipher<Key256> xts(Key256{}, Mode::XTS, backend);
+        REQUIRE(xts.GetBackend() == backend);
+        xts.SetIV(std::array<u8, 16>{});
+        const std::array<u8, 32> xts_expected{
+            0x91, 0x7c, 0xf6, 0x9e, 0xbd, 0x68, 0xb2, 0xec, 0x9b, 0x9f, 0xe9,
+            0xa3, 0xea, 0xdd, 0xa6, 0x92, 0xcd, 0x43, 0xd2, 0xf5, 0x95, 0x98,
+            0xed, 0x85, 0x8c, 0x02, 0xc2, 0x65, 0x2f, 0xbf, 0x92, 0x2e};
+        const std::array<u8, 32> zeros{};
+        xts.Transcode(zeros.data(), zeros.size(), out.data(), Op::Encrypt);
+        REQUIRE(out == xts_expected);
+        xts.Transcode(out.data(), out.size(), out.data(), Op::Decrypt);
+        REQUIRE(out == zeros);
+    }
+}
+
+TEST_CASE("AES[CTR backends]", "[core]") {
+    const Key128 key = MakeArray<16>(1);
+    const std::vector<u8> data = MakeData(0x1000, 2);
+    for (const AesBackend backend : NATIVE_BACKENDS) {
+        if (!Core::Crypto::IsAesBackendSupported(backend)) {
+            continue;
+        }
+        AESCipher<Key128> reference(key, Mode::CTR, AesBackend::Mbedtls);
+        AESCipher<Key128> native(key, Mode::CTR, backend);
+        REQUIRE(native.GetBackend() == backend);
+
+        // The last counter overflows its low 64 bits while transcoding
+        std::array<u8, 16> iv = MakeArray<16>(3);
+        std::fill(iv.begin() + 8, iv.end(), u8{0xff});
+        iv[15] = 0xf0;
+        for (const size_t size :
+             {0x1ULL, 0xfULL, 0x10ULL, 0x11ULL, 0x7fULL, 0x80ULL, 0x81ULL, 0x100ULL, 0x1000ULL}) {
+            std::vector<u8> expected(size);
+            std::vector<u8> actual(size);
+            reference.SetIV(iv);
+            native.SetIV(iv);
+            reference.Transcode(data.data(), size, expected.data(), Op::Decrypt);
+            native.Transcode(data.data(), size, actual.data(), Op::Decrypt);
+            REQUIRE(expected == actual);
+
+            // Both keep transcoding from the counter they stopped at
+            reference.Transcode(data.data(), size, expected.data(), Op::Decrypt);
+            native.Transcode(data.data(), size, actual.data(), Op::Decrypt);
+            REQUIRE(expected == actual);
+        }
+    }
+}
+
+TEST_CASE("AES[XTS backends]", "[core]") {
+    const Key256 key = MakeArray<32>(4);
+    const std::vector<u8> data = MakeData(0x10000, 5);
+    for (const AesBackend backend : NATIVE_BACKENDS) {
+        if (!Core::Crypto::IsAesBackendSupported(backend)) {
+            continue;
+        }
+        AESCipher<Key256> reference(key, Mode::XTS, AesBackend::Mbedtls);
+        AESCipher<Key256> native(key, Mode::XTS, backend);
+        REQUIRE(native.GetBackend() == backend);
+
+        for (const size_t sector_size : {0x10ULL, 0x90ULL, 0x200ULL, 0x4000ULL}) {
+            const size_t size = sector_size * 4;
+            for (const Op op : {Op::Encrypt, Op::Decrypt}) {
+                std::vector<u8> expected(size);
+                std::vector<u8> actual(size);
+                reference.XTSTranscode(data.data(), size, expected.data(), 7, sector_size, op);
+                native.XTSTranscode(data.data(), size, actual.data(), 7, sector_size, op);
+                REQUIRE(expected == actual);
+            }
+        }
+
+        // Sizes that are not a multiple of the block size use ciphertext stealing
+        const std::array<u8, 16> iv = MakeArray<16>(6);
+        std::vector<u8> expected(0x31);
+        std::vector<u8> actual(0x31);
+        reference.SetIV(iv);
+        native.SetIV(iv);
+        reference.Transcode(data.data(), expected.size(), expected.data(), Op::Decrypt);
+        native.Transcode(data.data(), actual.size(), actual.data(), Op::Decrypt);
+        REQUIRE(expected == actual);
+    }
+}
+
+TEST_CASE("AES[Benchmark]", "[core][.benchmark]") {
+    // Large reads of a game's RomFS go through these ciphers, 16 MiB per measurement
+    constexpr size_t size = 16ULL << 20;
+    const std::vector<u8> data = MakeData(size, 7);
+    std::vector<u8> buffer(size);
+
+    for (const AesBackend backend : {AesBackend::Mbedtls, AesBackend::AesNi, AesBackend::Vaes}) {
+        if (!Core::Crypto::IsAesBackendSupported(backend)) {
+            continue;
+        }
+        const std::string name = BackendName(backend);
+        AESCipher<Key128> ctr(MakeArray<16>(8), Mode::CTR, backend);
+        AESCipher<Key256> xts(MakeArray<32>(9), Mode::XTS, backend);
+
+        BENCHMARK(name + " CTR, 16 MiB") {
+            ctr.SetIV(std::array<u8, 16>{});
+            ctr.Transcode(data.data(), size, buffer.data(), Op::Decrypt);
+            return buffer[size - 1];
+        };
+        for (const size_t sector_size : {0x200ULL, 0x4000ULL}) {
+            const std::string suffix = std::to_string(sector_size) + " bytes sectors, 16 MiB";
+            BENCHMARK(name + " XTS with " + suffix) {
+                xts.XTSTranscode(data.data(), size, buffer.data(), 0, sector_size, Op::Decrypt);
+                return buffer[size - 1];
+            };
+        }
+    }
+}
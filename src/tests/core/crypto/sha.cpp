@@ -0,0 +1,142 @@
+// SPDX-FileCopyrightText: Copyright 2026 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "core/crypto/sha_util.h"
+#include "tests/test_data.h"
+
+using Core::Crypto::SHA256Hash;
+using Core::Crypto::SHA256Hasher;
+using Core::Crypto::ShaBackend;
+using Tests::MakeData;
+
+namespace {
+
+constexpr std::array ALL_BACKENDS{ShaBackend::Mbedtls, ShaBackend::ShaNi, ShaBackend::Avx2};
+
+const char* BackendName(ShaBackend backend) {
+    switch (backend) {
+    case ShaBackend::Auto:
+        return "Auto";
+    case ShaBackend::Mbedtls:
+        return "mbedtls";
+    case ShaBackend::ShaNi:
+        return "SHA-NI";
+    case ShaBackend::Avx2:
+        return "AVX2";
+    }
+    return "Unknown";
+}
+
+} // Anonymous namespace
+
+TEST_CASE("SHA[Known answers]", "[core]") {
+    // FIPS 180-2 appendix B vectors
+    const std::string abc = "abc";
+    const SHA256Hash abc_expected{0xba, 0x78, 0x16, 0xbf, 0x8f, 0x01, 0xcf, 0xea, 0x41, 0x41, 0x40,
+                                  0xde, 0x5d, 0xae, 0x22, 0x23, 0xb0, 0x03, 0x61, 0xa3, 0x96, 0x17,
+                                  0x7a, 0x9c, 0xb4, 0x10, 0xff, 0x61, 0xf2, 0x00, 0x15, 0xad};
+    const std::string two_blocks = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+    const SHA256Hash two_blocks_expected{
+        0x24, 0x8d, 0x6a, 0x61, 0xd2, 0x06, 0x38, 0xb8, 0xe5, 0xc0, 0x26,
+        0x93, 0x0c, 0x3e, 0x60, 0x39, 0xa3, 0x3c, 0xe4, 0x59, 0x64, 0xff,
+        0x21, 0x67, 0xf6, 0xec, 0xed, 0xd4, 0x19, 0xdb, 0x06, 0xc1};
+    const SHA256Hash empty_expected{
+        0xe3, 0xb0, 0xc4, 0x42, 0x98, 0xfc, 0x1c, 0x14, 0x9a, 0xfb, 0xf4,
+        0xc8, 0x99, 0x6f, 0xb9, 0x24, 0x27, 0xae, 0x41, 0xe4, 0x64, 0x9b,
+        0x93, 0x4c, 0xa4, 0x95, 0x99, 0x1b, 0x78, 0x52, 0xb8, 0x55};
+
+    for (const ShaBackend backend : ALL_BACKENDS) {
+        if (!Core::Crypto::IsShaBackendSupported(backend)) {
+            continue;
+        }
+        REQUIRE(Core::Crypto::CalculateSHA256(abc.data(), abc.size(), backend) == abc_expected);
+        REQUIRE(Core::Crypto::CalculateSHA256(two_blocks.data(), two_blocks.size(), backend) ==
+                two_blocks_expected);
+        REQUIRE(Core::Crypto::CalculateSHA256(nullptr, 0, backend) == empty_expected);
+
+        // Three blocks of "abc" hashed at once
+        const std::string blocks = abc + abc + abc;
+        std::array<SHA256Hash, 3> hashes{};
+        Core::Crypto::CalculateSHA256Blocks(blocks.data(), blocks.size(), abc.size(),
+                                            hashes.data(), backend);
+        for (const SHA256Hash& hash : hashes) {
+            REQUIRE(hash == abc_expected);
+        }
+    }
+}
+
+TEST_CASE("SHA[Backends]", "[core]") {
+    const std::vector<u8> data = MakeData(0x10000, 1);
+    for (const ShaBackend backend : ALL_BACKENDS) {
+        if (!Core::Crypto::IsShaBackendSupported(backend)) {
+            continue;
+        }
+
+        // Sizes around the padding boundaries of one and two blocks
+        for (const size_t size : {1ULL, 55ULL, 56ULL, 63ULL, 64ULL, 65ULL, 119ULL, 120ULL, 128ULL,
+                                  0x1000ULL, 0x10000ULL}) {
+            REQUIRE(Core::Crypto::CalculateSHA256(data.data(), size, backend) ==
+                    Core::Crypto::CalculateSHA256(data.data(), size, ShaBackend::Mbedtls));
+        }
+
+        // Every lane count of the multi-buffer paths, with a shorter last block
+        for (const size_t block_size : {0x40ULL, 0x77ULL, 0x200ULL, 0x1000ULL}) {
+            for (size_t num_blocks = 1; num_blocks <= 11; ++num_blocks) {
+                const size_t size = num_blocks * block_size - (num_blocks % 3 == 0 ? 5 : 0);
+                std::vector<SHA256Hash> expected(num_blocks);
+                std::vector<SHA256Hash> actual(num_blocks);
+                Core::Crypto::CalculateSHA256Blocks(data.data(), size, block_size,
+                                                    expected.data(), ShaBackend::Mbedtls);
+                Core::Crypto::CalculateSHA256Blocks(data.data(), size, block_size, actual.data(),
+                                                    backend);
+                REQUIRE(expected == actual);
+            }
+        }
+
+        // Incremental updates split across block boundaries
+        SHA256Hasher hasher{backend};
+        size_t offset = 0;
+        for (const size_t size : {3ULL, 61ULL, 64ULL, 1ULL, 200ULL, 0ULL, 0x1000ULL}) {
+            hasher.Update(data.data() + offset, size);
+            offset += size;
+        }
+        REQUIRE(hasher.Finish() ==
+                Core::Crypto::CalculateSHA256(data.data(), offset, ShaBackend::Mbedtls));
+
+        // Finish starts a new hash
+        hasher.Update(data.data(), 100);
+        REQUIRE(hasher.Finish() ==
+                Core::Crypto::CalculateSHA256(data.data(), 100, ShaBackend::Mbedtls));
+    }
+}
+
+TEST_CASE("SHA[Benchmark]", "[core][.benchmark]") {
+    // Integrity storages hash each 16 KiB block of a game's RomFS, 16 MiB per measurement
+    constexpr size_t size = 16ULL << 20;
+    constexpr size_t block_size = 0x4000;
+    const std::vector<u8> data = MakeData(size, 2);
+    std::vector<SHA256Hash> hashes(size / block_size);
+
+    for (const ShaBackend backend : ALL_BACKENDS) {
+        if (!Core::Crypto::IsShaBackendSupported(backend)) {
+            continue;
+        }
+        const std::string name = BackendName(backend);
+        BENCHMARK(name + " single message, 16 MiB") {
+            return Core::Crypto::CalculateSHA256(data.data(), size, backend)[0];
+        };
+        BENCHMARK(name + " 16 KiB blocks, 16 MiB") {
+            Core::Crypto::CalculateSHA256Blocks(data.data(), size, block_size, hashes.data(),
+                                                backend);
+            return hashes.back()[0];
+        };
+    }
+}
@@ -0,0 +1,210 @@
+// SPDX-FileCopyrightText: Copyright 2026 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "common/literals.h"
+#include "core/file_sys/fssystem/fssystem_aes_ctr_storage.h"
+#include "core/file_sys/fssystem/fssystem_block_cache_storage.h"
+#include "core/file_sys/vfs/vfs_vector.h"
+#include "tests/test_data.h"
+
+using namespace Common::Literals;
+using Tests::MakeData;
+
+namespace {
+
+constexpr size_t BlockSize = FileSys::BlockCache::BlockSize;
+
+/// Storage counting the reads reaching it
+class CountingStorage : public FileSys::IReadOnlyStorage {
+public:
+    explicit CountingStorage(std::vector<u8> data_) : data(std::move(data_)) {}
+
+    size_t Read(u8* buffer, size_t size, size_t offset) const override {
+        ++num_reads;
+        const size_t read = std::min(size, data.size() - std::min(offset, data.size()));
+        std::memcpy(buffer, data.data() + offset, read);
+        return read;
+    }
+
+    size_t GetSize() const override {
+        return data.size();
+    }
+
+    std::vector<u8> data;
+    mutable size_t num_reads{};
+};
+
+struct Asset {
+    size_t offset;
+    size_t size;
+};
+
+/// Assets of 256 KiB to 2 MiB spread over 64 MiB, like the files of a game's RomFS
+std::vector<Asset> MakeAssets() {
+    std::vector<Asset> assets;
+    for (size_t i = 0; i < 32; ++i) {
+        assets.push_back({i * 2_MiB + (i % 3) * 4_KiB, 256_KiB + (i * 37 % 7) * 256_KiB});
+    }
+    return assets;
+}
+
+/// Loads eight scenes, each streaming twelve assets with 128 KiB reads, neighbouring scenes
+/// share most of their assets
+void ReplayScenes(const FileSys::VfsFile& storage, const std::vector<Asset>& assets,
+                  std::vector<u8>& buffer) {
+    constexpr size_t read_size = 128_KiB;
+    for (size_t scene = 0; scene < 8; ++scene) {
+        for (size_t i = 0; i < 12; ++i) {
+            const Asset& asset = assets[(scene * 5 + i) % assets.size()];
+            for (size_t offset = 0; offset < asset.size; offset += read_size) {
+                const size_t size = std::min(read_size, asset.size - offset);
+                storage.Read(buffer.data() + offset, size, asset.offset + offset);
+            }
+        }
+    }
+}
+
+} // Anonymous namespace
+
+TEST_CASE("BlockCache[Read]", "[core]") {
+    const size_t storage_size = 32 * BlockSize + 0x1230;
+    const auto base = std::make_shared<CountingStorage>(MakeData(storage_size, 1));
+    FileSys::BlockCache cache{64_MiB, 4};
+    const FileSys::BlockCacheStorage storage{base, cache};
+    REQUIRE(storage.GetSize() == storage_size);
+
+    // Reads of every shape return the base data, whether they hit the cache or not
+    std::vector<u8> buffer(storage_size);
+    for (size_t pass = 0; pass < 2; ++pass) {
+        for (size_t offset = 0; offset < storage_size; offset += 0x7777) {
+            const size_t size = std::min<size_t>(storage_size - offset, offset / 5 + 1);
+            REQUIRE(storage.Read(buffer.data(), size, offset) == size);
+            REQUIRE(std::equal(buffer.begin(), buffer.begin() + size, base->data.begin() + offset));
+        }
+    }
+    REQUIRE(cache.GetStatistics().size == storage_size);
+
+    // Once every block is cached, reads no longer reach the base storage
+    const size_t num_reads = base->num_reads;
+    const u64 hits = cache.GetStatistics().hits;
+    REQUIRE(storage.Read(buffer.data(), storage_size, 0) == storage_size);
+    REQUIRE(buffer == base->data);
+    REQUIRE(base->num_reads == num_reads);
+    REQUIRE(cache.GetStatistics().hits == hits + 33);
+
+    // Reads past the end are clamped
+    REQUIRE(storage.Read(buffer.data(), 0x100, storage_size - 0x10) == 0x10);
+    REQUIRE(storage.Read(buffer.data(), 0x100, storage_size) == 0);
+}
+
+TEST_CASE("BlockCache[Short base read]", "[core]") {
+    const size_t storage_size = 8 * BlockSize;
+    const auto base = std::make_shared<CountingStorage>(MakeData(storage_size, 3));
+    const std::vector<u8> data = base->data;
+    FileSys::BlockCache cache{64_MiB, 4};
+    const FileSys::BlockCacheStorage storage{base, cache};
+    std::vector<u8> buffer(storage_size);
+
+    // Cache block 1, then cut the base storage in the middle of block 5
+    REQUIRE(storage.Read(buffer.data(), BlockSize, BlockSize) == BlockSize);
+    const size_t base_size = 5 * BlockSize + 0x345;
+    base->data.resize(base_size);
+
+    // Runs of whole blocks stop at the end of the base data
+    REQUIRE(storage.Read(buffer.data(), storage_size, 0) == base_size);
+    REQUIRE(std::equal(buffer.begin(), buffer.begin() + base_size, data.begin()));
+
+    // Partially covered blocks, the first one reaching past the end of the base data
+    REQUIRE(storage.Read(buffer.data(), 0x1000, base_size - 0x100) == 0x100);
+    REQUIRE(std::equal(buffer.begin(), buffer.begin() + 0x100, data.begin() + base_size - 0x100));
+    REQUIRE(storage.Read(buffer.data(), 0x100, base_size + 0x100) == 0);
+    REQUIRE(storage.Read(buffer.data(), 0x100, 5 * BlockSize + 0x10) == 0x100);
+    REQUIRE(storage.Read(buffer.data(), 0x10, 7 * BlockSize + 0x10) == 0);
+
+    // The truncated block was not cached, restoring the data makes it readable again
+    base->data = data;
+    REQUIRE(storage.Read(buffer.data(), storage_size, 0) == storage_size);
+    REQUIRE(buffer == data);
+}
+
+TEST_CASE("BlockCache[Eviction]", "[core]") {
+    const auto base = std::make_shared<CountingStorage>(MakeData(8 * BlockSize, 2));
+    FileSys::BlockCache cache{4 * BlockSize, 1};
+    const FileSys::BlockCacheStorage storage{base, cache};
+    std::vector<u8> buffer(BlockSize);
+
+    // Fill the cache, then touch block 0 so block 1 is the least recently used one
+    for (size_t block = 0; block < 4; ++block) {
+        storage.Read(buffer.data(), BlockSize, block * BlockSize);
+    }
+    storage.Read(buffer.data(), 0x10, 0);
+    storage.Read(buffer.data(), BlockSize, 4 * BlockSize);
+
+    auto statistics = cache.GetStatistics();
+    REQUIRE(statistics.evictions == 1);
+    REQUIRE(statistics.size == 4 * BlockSize);
+
+    const size_t num_reads = base->num_reads;
+    storage.Read(buffer.data(), BlockSize, 0);
+    REQUIRE(base->num_reads == num_reads);
+    storage.Read(buffer.data(), BlockSize, BlockSize);
+    REQUIRE(base->num_reads == num_reads + 1);
+    REQUIRE(std::equal(buffer.begin(), buffer.end(), base->data.begin() + BlockSize));
+
+    // Blocks of a destroyed storage are dropped
+    {
+        const FileSys::BlockCacheStorage other{base, cache};
+        other.Read(buffer.data(), BlockSize, 0);
+    }
+    statistics = cache.GetStatistics();
+    REQUIRE(statistics.size == 3 * BlockSize);
+
+    // Shrinking the cache evicts down to the new capacity, keeping the recently used blocks
+    cache.SetCapacity(2 * BlockSize);
+    statistics = cache.GetStatistics();
+    REQUIRE(statistics.size == 2 * BlockSize);
+    const size_t num_reads_after_shrink = base->num_reads;
+    storage.Read(buffer.data(), BlockSize, BlockSize);
+    REQUIRE(base->num_reads == num_reads_after_shrink);
+}
+
+TEST_CASE("BlockCache[Benchmark]", "[core][.benchmark]") {
+    // Decrypting is the main cost of the NCA storages cached by the driver
+    const std::array<u8, 16> key{};
+    const std::array<u8, 16> iv{};
+    const auto encrypted = std::make_shared<FileSys::VectorVfsFile>(MakeData(64_MiB, 3));
+    const auto decrypted = std::make_shared<FileSys::AesCtrStorage>(encrypted, key.data(),
+                                                                    key.size(), iv.data(),
+                                                                    iv.size());
+    const std::vector<Asset> assets = MakeAssets();
+    std::vector<u8> buffer(2_MiB);
+
+    BENCHMARK("Replay scenes without cache") {
+        ReplayScenes(*decrypted, assets, buffer);
+        return buffer[0];
+    };
+
+    BENCHMARK("Replay scenes with a 32 MiB block cache") {
+        FileSys::BlockCache cache{32_MiB};
+        const FileSys::BlockCacheStorage storage{decrypted, cache};
+        ReplayScenes(storage, assets, buffer);
+        return buffer[0];
+    };
+
+    BENCHMARK("Replay scenes with a 128 MiB block cache") {
+        FileSys::BlockCache cache{128_MiB};
+        const FileSys::BlockCacheStorage storage{decrypted, cache};
+        ReplayScenes(storage, assets, buffer);
+        return buffer[0];
+    };
+}
@@ -0,0 +1,238 @@
+// SPDX-FileCopyrightText: Copyright 2026 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/alignment.h"
+#include "common/common_types.h"
+#include "common/literals.h"
+#include "core/crypto/sha_util.h"
+#include "core/file_sys/fssystem/fssystem_hierarchical_sha256_storage.h"
+#include "core/file_sys/fssystem/fssystem_integrity_romfs_storage.h"
+#include "tests/test_data.h"
+
+using namespace Common::Literals;
+using Tests::MakeData;
+
+namespace {
+
+constexpr s32 BlockOrder = 14;
+constexpr size_t BlockSize = size_t{1} << BlockOrder;
+
+/// Storage over a buffer the test can corrupt, counting the reads reaching it
+class MemoryStorage : public FileSys::IReadOnlyStorage {
+public:
+    explicit MemoryStorage(std::vector<u8> data_) : data(std::move(data_)) {}
+
+    size_t Read(u8* buffer, size_t size, size_t offset) const override {
+        ++num_reads;
+        const size_t read = std::min(size, data.size() - std::min(offset, data.size()));
+        std::memcpy(buffer, data.data() + offset, read);
+        return read;
+    }
+
+    size_t GetSize() const override {
+        return data.size();
+    }
+
+    std::vector<u8> data;
+    mutable std::atomic<size_t> num_reads{};
+};
+
+/// Hashes each block of data, zero-padding the last one when padded is set
+std::vector<u8> HashLevel(const std::vector<u8>& data, size_t block_size, bool padded) {
+    std::vector<u8> blocks = data;
+    if (padded) {
+        blocks.resize(Common::AlignUp(data.size(), block_size));
+    }
+    std::vector<u8> hashes(Common::DivideUp(data.size(), block_size) * sizeof(FileSys::Hash));
+    Core::Crypto::CalculateSHA256Blocks(blocks.data(), blocks.size(), block_size,
+                                        reinterpret_cast<Core::Crypto::SHA256Hash*>(hashes.data()));
+    return hashes;
+}
+
+/// Four layer IVFC tree, the master hash covers the first hash layer
+struct IntegrityTree {
+    explicit IntegrityTree(std::vector<u8> data_)
+        : data(std::make_shared<MemoryStorage>(std::move(data_))),
+          layer2(std::make_shared<MemoryStorage>(HashLevel(data->data, BlockSize, true))),
+          layer1(std::make_shared<MemoryStorage>(HashLevel(layer2->data, BlockSize, true))) {
+        std::memcpy(master_hash.value.data(), HashLevel(layer1->data, BlockSize, true).data(),
+                    sizeof(master_hash));
+        REQUIRE(layer1->GetSize() <= BlockSize);
+    }
+
+    std::shared_ptr<FileSys::IntegrityRomFsStorage> Open(bool verify) const {
+        FileSys::HierarchicalIntegrityVerificationInformation info{};
+        info.max_layers = 4;
+        const std::array<std::shared_ptr<MemoryStorage>, 3> layers{layer1, layer2, data};
+        s64 offset = 0;
+        for (size_t i = 0; i < layers.size(); ++i) {
+            info.info[i].offset = offset;
+            info.info[i].size = static_cast<s64>(layers[i]->GetSize());
+            info.info[i].block_order = BlockOrder;
+            offset += static_cast<s64>(layers[i]->GetSize());
+        }
+
+        FileSys::HierarchicalIntegrityVerificationStorage::HierarchicalStorageInformation storages;
+        storages.SetLayer1HashStorage(layer1);
+        storages.SetLayer2HashStorage(layer2);
+        storages[3] = data;
+
+        auto storage = std::make_shared<FileSys::IntegrityRomFsStorage>();
+        REQUIRE(R_SUCCEEDED(storage->Initialize(info, master_hash, storages, 0, 0, 0, verify)));
+        return storage;
+    }
+
+    std::shared_ptr<MemoryStorage> data;
+    std::shared_ptr<MemoryStorage> layer2;
+    std::shared_ptr<MemoryStorage> layer1;
+    FileSys::Hash master_hash;
+};
+
+std::vector<u8> ReadRange(const FileSys::VfsFile& file, size_t size, size_t offset) {
+    std::vector<u8> buffer(size);
+    buffer.resize(file.Read(buffer.data(), size, offset));
+    return buffer;
+}
+
+std::vector<u8> Expected(const std::vector<u8>& data, size_t size, size_t offset) {
+    const size_t end = std::min(offset + size, data.size());
+    return {data.begin() + offset, data.begin() + end};
+}
+
+} // Anonymous namespace
+
+TEST_CASE("Integrity[Verification]", "[core]") {
+    const std::vector<u8> data = MakeData(40 * BlockSize + 0x1234, 1);
+    const IntegrityTree tree{data};
+    const auto storage = tree.Open(true);
+    REQUIRE(storage->GetSize() == data.size());
+
+    // Unaligned reads verify the blocks they cover partially
+    for (const auto& [size, offset] : std::array<std::pair<size_t, size_t>, 5>{{
+             {0x3000, 0x1001},
+             {BlockSize * 3 + 0x10, BlockSize - 0x8},
+             {0x20, 20 * BlockSize},
+             {data.size() - 0x10000, 0x8000},
+             {0x1234, 40 * BlockSize},
+         }}) {
+        REQUIRE(ReadRange(*storage, size, offset) == Expected(data, size, offset));
+    }
+
+    // Reads stop before corrupted blocks, which are cleared in the buffer
+    const size_t corrupted = 25 * BlockSize + 0x100;
+    tree.data->data[corrupted] ^= 0xff;
+    const auto fresh = tree.Open(true);
+    std::vector<u8> buffer(4 * BlockSize, 0xcc);
+    REQUIRE(fresh->Read(buffer.data(), buffer.size(), 24 * BlockSize) == BlockSize);
+    REQUIRE(std::equal(buffer.begin(), buffer.begin() + BlockSize, data.begin() + 24 * BlockSize));
+    REQUIRE(std::all_of(buffer.begin() + BlockSize, buffer.begin() + 2 * BlockSize,
+                        [](u8 value) { return value == 0; }));
+    REQUIRE(ReadRange(*fresh, 0x10, corrupted).empty());
+    REQUIRE(ReadRange(*fresh, 0x10, 26 * BlockSize) == Expected(data, 0x10, 26 * BlockSize));
+
+    // Without verification the corrupted data is returned
+    const auto unverified = tree.Open(false);
+    REQUIRE(ReadRange(*unverified, 1, corrupted)[0] == static_cast<u8>(data[corrupted] ^ 0xff));
+
+    // A corrupted hash layer fails every block it covers
+    tree.data->data[corrupted] ^= 0xff;
+    tree.layer2->data[0] ^= 0x1;
+    const auto bad_hashes = tree.Open(true);
+    REQUIRE(ReadRange(*bad_hashes, 0x100, 0).empty());
+    REQUIRE(ReadRange(*bad_hashes, 0x100, 30 * BlockSize).empty());
+}
+
+TEST_CASE("Integrity[Verified once]", "[core]") {
+    const std::vector<u8> data = MakeData(200 * BlockSize, 2);
+    const IntegrityTree tree{data};
+    const auto storage = tree.Open(true);
+
+    REQUIRE(ReadRange(*storage, data.size(), 0) == data);
+    const size_t hash_reads = tree.layer2->num_reads;
+
+    // Verified blocks are not hashed again, so their hashes are not read again
+    for (size_t offset = 0; offset < data.size(); offset += 0x3456) {
+        const size_t size = std::min<size_t>(0x3456, data.size() - offset);
+        REQUIRE(ReadRange(*storage, size, offset) == Expected(data, size, offset));
+    }
+    REQUIRE(tree.layer2->num_reads == hash_reads);
+}
+
+TEST_CASE("Integrity[Hierarchical SHA-256]", "[core]") {
+    using FileSys::HierarchicalSha256Storage;
+    constexpr size_t hash_block_size = 0x1000;
+    const std::vector<u8> data = MakeData(100 * hash_block_size + 0x123, 3);
+    const auto data_storage = std::make_shared<MemoryStorage>(data);
+
+    // The last block of these storages is hashed with its actual size
+    const std::vector<u8> hashes = HashLevel(data, hash_block_size, false);
+    std::vector<u8> master_hash = HashLevel(hashes, hashes.size(), false);
+    const auto open = [&](bool verify, std::vector<u8>& hash_buffer) {
+        std::array<FileSys::VirtualFile, HierarchicalSha256Storage::LayerCount> layers{
+            std::make_shared<MemoryStorage>(master_hash),
+            std::make_shared<MemoryStorage>(hashes),
+            data_storage,
+        };
+        auto storage = std::make_shared<HierarchicalSha256Storage>();
+        const Result result =
+            storage->Initialize(layers.data(), HierarchicalSha256Storage::LayerCount,
+                                hash_block_size, hash_buffer.data(), hash_buffer.size(), verify);
+        return std::make_pair(result, storage);
+    };
+
+    std::vector<u8> hash_buffer(hashes.size());
+    const auto [result, storage] = open(true, hash_buffer);
+    REQUIRE(R_SUCCEEDED(result));
+    REQUIRE(ReadRange(*storage, data.size(), 0) == data);
+    REQUIRE(ReadRange(*storage, 0x2000, 0x800) == Expected(data, 0x2000, 0x800));
+
+    data_storage->data[0x1800] ^= 0xff;
+    const auto [corrupted_result, corrupted] = open(true, hash_buffer);
+    REQUIRE(R_SUCCEEDED(corrupted_result));
+    REQUIRE(ReadRange(*corrupted, 0x10, 0x1800).empty());
+    REQUIRE(ReadRange(*corrupted, 0x10, 0x2000) == Expected(data, 0x10, 0x2000));
+    REQUIRE(ReadRange(*corrupted, 0x2000, 0x800) == Expected(data, 0x800, 0x800));
+
+    // The hash layer is checked against the master hash when the storage is opened
+    master_hash[0] ^= 0xff;
+    REQUIRE(open(true, hash_buffer).first ==
+            FileSys::ResultHierarchicalSha256HashVerificationFailed);
+    REQUIRE(R_SUCCEEDED(open(false, hash_buffer).first));
+}
+
+TEST_CASE("Integrity[Benchmark]", "[core][.benchmark]") {
+    // A 64 MiB RomFS read in 1 MiB chunks, the first pass hashes every block, the second one
+    // finds them all verified
+    const std::vector<u8> data = MakeData(64_MiB, 4);
+    const IntegrityTree tree{data};
+    std::vector<u8> buffer(1_MiB);
+    const auto read_all = [&](const FileSys::VfsFile& storage) {
+        for (size_t offset = 0; offset < data.size(); offset += buffer.size()) {
+            storage.Read(buffer.data(), buffer.size(), offset);
+        }
+        return buffer[0];
+    };
+
+    BENCHMARK("Read 64 MiB, not verified") {
+        return read_all(*tree.Open(false));
+    };
+    BENCHMARK("Read 64 MiB, verified") {
+        return read_all(*tree.Open(true));
+    };
+    const auto verified = tree.Open(true);
+    read_all(*verified);
+    BENCHMARK("Read 64 MiB, already verified") {
+        return read_all(*verified);
+    };
+}
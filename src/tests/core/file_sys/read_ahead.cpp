@@ -0,0 +1,210 @@
+// SPDX-FileCopyrightText: Copyright 2026 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "common/literals.h"
+#include "core/file_sys/fssystem/fssystem_aes_ctr_storage.h"
+#include "core/file_sys/fssystem/fssystem_block_cache_storage.h"
+#include "core/file_sys/vfs/vfs_read_ahead.h"
+#include "core/file_sys/vfs/vfs_vector.h"
+#include "tests/test_data.h"
+
+using namespace Common::Literals;
+using namespace std::chrono_literals;
+using Tests::MakeData;
+
+namespace {
+
+constexpr size_t ChunkSize = 64_KiB;
+
+/// Storage recording the size of the reads reaching it
+class RecordingStorage : public FileSys::IReadOnlyStorage {
+public:
+    explicit RecordingStorage(std::vector<u8> data_) : data(std::move(data_)) {}
+
+    size_t Read(u8* buffer, size_t size, size_t offset) const override {
+        {
+            std::scoped_lock lk{mutex};
+            read_sizes.push_back(size);
+        }
+        const size_t read = std::min(size, data.size() - std::min(offset, data.size()));
+        std::memcpy(buffer, data.data() + offset, read);
+        return read;
+    }
+
+    size_t GetSize() const override {
+        return data.size();
+    }
+
+    std::vector<size_t> ReadSizes() const {
+        std::scoped_lock lk{mutex};
+        return read_sizes;
+    }
+
+    std::vector<u8> data;
+
+private:
+    mutable std::mutex mutex;
+    mutable std::vector<size_t> read_sizes;
+};
+
+/// Storage answering each read after a fixed latency, like a disk
+class LatencyStorage : public FileSys::IReadOnlyStorage {
+public:
+    LatencyStorage(FileSys::VirtualFile base_, std::chrono::microseconds latency_)
+        : base(std::move(base_)), latency(latency_) {}
+
+    size_t Read(u8* buffer, size_t size, size_t offset) const override {
+        std::this_thread::sleep_for(latency);
+        return base->Read(buffer, size, offset);
+    }
+
+    size_t GetSize() const override {
+        return base->GetSize();
+    }
+
+private:
+    FileSys::VirtualFile base;
+    std::chrono::microseconds latency;
+};
+
+bool ReadMatches(const FileSys::VfsFile& file, const std::vector<u8>& expected, size_t size,
+                 size_t offset) {
+    std::vector<u8> buffer(size);
+    const size_t read = file.Read(buffer.data(), size, offset);
+    const size_t expected_size =
+        std::min(size, expected.size() - std::min(offset, expected.size()));
+    return read == expected_size &&
+           std::equal(buffer.begin(), buffer.begin() + read, expected.begin() + offset);
+}
+
+/// Spins for the given time, standing for the guest decompressing what it read
+void Process(std::chrono::microseconds duration) {
+    const auto end = std::chrono::steady_clock::now() + duration;
+    while (std::chrono::steady_clock::now() < end) {
+    }
+}
+
+/// Streams every 2 MiB asset of the image with reads of the given size, processing each read
+void StreamAssets(const FileSys::VfsFile& image, size_t read_size,
+                  std::chrono::microseconds processing, std::vector<u8>& buffer) {
+    constexpr size_t asset_size = 2_MiB;
+    for (size_t asset = 0; asset + asset_size <= image.GetSize(); asset += asset_size) {
+        for (size_t offset = 0; offset < asset_size; offset += read_size) {
+            image.Read(buffer.data(), read_size, asset + offset);
+            Process(processing);
+        }
+    }
+}
+
+} // Anonymous namespace
+
+TEST_CASE("ReadAhead[Sequential]", "[core]") {
+    const size_t size = 32 * ChunkSize + 0x1230;
+    const auto base = std::make_shared<RecordingStorage>(MakeData(size, 1));
+    const FileSys::ReadAheadVfsFile file{base, 4, ChunkSize};
+    REQUIRE(file.GetSize() == size);
+    REQUIRE(!file.IsWritable());
+
+    // The first reads reach the base file, the following ones are served from prefetched chunks
+    for (size_t offset = 0; offset < size; offset += 0x3000) {
+        REQUIRE(ReadMatches(file, base->data, 0x3000, offset));
+    }
+    // Prefetching starts after the second read, the last chunk ends with the file
+    const std::vector<size_t> read_sizes = base->ReadSizes();
+    const auto count = [&](size_t read_size) {
+        return static_cast<size_t>(std::count(read_sizes.begin(), read_sizes.end(), read_size));
+    };
+    REQUIRE(count(0x3000) == 2);
+    REQUIRE(count((size - 0x6000) % ChunkSize) == 1);
+    REQUIRE(count(ChunkSize) == read_sizes.size() - 3);
+
+    // Reads past the end are clamped
+    std::array<u8, 0x100> buffer{};
+    REQUIRE(file.Read(buffer.data(), buffer.size(), size - 0x10) == 0x10);
+    REQUIRE(file.Read(buffer.data(), buffer.size(), size) == 0);
+}
+
+TEST_CASE("ReadAhead[Streams]", "[core]") {
+    const size_t size = 64 * ChunkSize;
+    const auto base = std::make_shared<RecordingStorage>(MakeData(size, 2));
+    const FileSys::ReadAheadVfsFile file{base, 2, ChunkSize};
+
+    // Interleaved sequential streams, as when a game loads several assets of its RomFS at once
+    for (size_t i = 0; i < 12 * ChunkSize; i += 0x2345) {
+        REQUIRE(ReadMatches(file, base->data, 0x2345, i));
+        REQUIRE(ReadMatches(file, base->data, 0x2345, 20 * ChunkSize + i));
+        REQUIRE(ReadMatches(file, base->data, 0x1000, 40 * ChunkSize + i / 2));
+    }
+
+    // Random reads drop the prefetched chunks but still return the base data
+    for (size_t i = 0; i < 64; ++i) {
+        const size_t offset = (i * 0x9E3779B1ULL) % size;
+        REQUIRE(ReadMatches(file, base->data, (i % 5 + 1) * 0x3333, offset));
+    }
+}
+
+TEST_CASE("ReadAhead[Concurrent]", "[core]") {
+    const size_t size = 64 * ChunkSize;
+    const auto base = std::make_shared<RecordingStorage>(MakeData(size, 3));
+    const auto file = std::make_shared<FileSys::ReadAheadVfsFile>(base, 4, ChunkSize);
+
+    std::array<bool, 4> matches{};
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < matches.size(); ++i) {
+        threads.emplace_back([&, i] {
+            bool match = true;
+            for (size_t offset = 0; offset < 16 * ChunkSize; offset += 0x1800) {
+                match &= ReadMatches(*file, base->data, 0x1800, i * 16 * ChunkSize + offset);
+            }
+            matches[i] = match;
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    REQUIRE(std::all_of(matches.begin(), matches.end(), [](bool match) { return match; }));
+}
+
+TEST_CASE("ReadAhead[Benchmark]", "[core][.benchmark]") {
+    // A 32 MiB encrypted RomFS image on a disk answering each request after 100 us, read by a
+    // guest either reading back-to-back or processing each 64 KiB read for 20 us
+    const std::array<u8, 16> key{};
+    const std::array<u8, 16> iv{};
+    const auto encrypted = std::make_shared<LatencyStorage>(
+        std::make_shared<FileSys::VectorVfsFile>(MakeData(32_MiB, 4)), 100us);
+    const auto decrypted = std::make_shared<FileSys::AesCtrStorage>(encrypted, key.data(),
+                                                                    key.size(), iv.data(),
+                                                                    iv.size());
+    std::vector<u8> buffer(64_KiB);
+
+    for (const size_t depth : {0ULL, 2ULL, 4ULL, 8ULL}) {
+        const std::string name = "depth " + std::to_string(depth);
+        for (const auto processing : {0us, 20us}) {
+            const std::string suffix = processing.count() == 0 ? ", reads only" : ", processing";
+            BENCHMARK("Stream 32 MiB, " + name + suffix) {
+                // Like the NCA driver, serialize reads of the decrypting storage through the cache
+                FileSys::VirtualFile image = std::make_shared<FileSys::BlockCacheStorage>(
+                    decrypted, FileSys::BlockCache::Instance());
+                if (depth > 0) {
+                    image = std::make_shared<FileSys::ReadAheadVfsFile>(std::move(image), depth);
+                }
+                StreamAssets(*image, 64_KiB, processing, buffer);
+                return buffer[0];
+            };
+        }
+    }
+}
@@ -0,0 +1,222 @@
+// SPDX-FileCopyrightText: Copyright 2026 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "core/file_sys/romfs.h"
+#include "core/file_sys/vfs/vfs_vector.h"
+#include "tests/test_data.h"
+
+using Tests::MakeData;
+
+namespace {
+
+FileSys::VirtualFile MakeFile(std::string name, size_t size, u32 seed) {
+    return std::make_shared<FileSys::VectorVfsFile>(MakeData(size, seed), std::move(name));
+}
+
+/// Builds a RomFS image and returns its root
+FileSys::VirtualDir MakeRomFS(std::vector<FileSys::VirtualFile> files,
+                              std::vector<FileSys::VirtualDir> dirs = {}) {
+    const auto root =
+        std::make_shared<FileSys::VectorVfsDirectory>(std::move(files), std::move(dirs));
+    const FileSys::VirtualFile image = FileSys::CreateRomFS(root);
+    REQUIRE(image != nullptr);
+    return FileSys::ExtractRomFS(image);
+}
+
+/// Builds a RomFS image in memory
+FileSys::VirtualFile MakeImage(std::vector<FileSys::VirtualFile> files,
+                               std::vector<FileSys::VirtualDir> dirs = {}) {
+    const auto root =
+        std::make_shared<FileSys::VectorVfsDirectory>(std::move(files), std::move(dirs));
+    const FileSys::VirtualFile image = FileSys::CreateRomFS(root);
+    REQUIRE(image != nullptr);
+    return std::make_shared<FileSys::VectorVfsFile>(image->ReadAllBytes());
+}
+
+FileSys::VirtualDir MakeDir(std::string name, std::vector<FileSys::VirtualFile> files,
+                            std::vector<FileSys::VirtualDir> dirs = {}) {
+    return std::make_shared<FileSys::VectorVfsDirectory>(std::move(files), std::move(dirs),
+                                                         std::move(name));
+}
+
+/// Writes a header field of a RomFS image
+void PatchHeader(std::vector<u8>& image, size_t offset, u64 value) {
+    std::memcpy(image.data() + offset, &value, sizeof(value));
+}
+
+/// Copies a directory into a tree of vector directories, like RomFS images used to be extracted
+FileSys::VirtualDir MaterializeTree(const FileSys::VirtualDir& dir) {
+    std::vector<FileSys::VirtualDir> dirs;
+    for (const auto& subdir : dir->GetSubdirectories()) {
+        dirs.push_back(MaterializeTree(subdir));
+    }
+    return MakeDir(dir->GetName(), dir->GetFiles(), std::move(dirs));
+}
+
+/// Bytes allocated on the heap, when the C library can tell
+size_t HeapInUse() {
+#if defined(__GLIBC__) && __GLIBC_PREREQ(2, 33)
+    return mallinfo2().uordblks;
+#else
+    return 0;
+#endif
+}
+
+} // Anonymous namespace
+
+TEST_CASE("RomFS[Roundtrip]", "[core]") {
+    const auto nested = std::make_shared<FileSys::VectorVfsDirectory>(
+        std::vector<FileSys::VirtualFile>{MakeFile("nested.bin", 0x12345, 3)},
+        std::vector<FileSys::VirtualDir>{}, "dir");
+    const FileSys::VirtualDir romfs = MakeRomFS({MakeFile("empty.bin", 0, 1),
+                                                 MakeFile("small.bin", 17, 2),
+                                                 MakeFile("large.bin", 1 << 20, 4)},
+                                                {nested});
+    REQUIRE(romfs != nullptr);
+
+    const auto check = [&romfs](std::string_view path, size_t size, u32 seed) {
+        const FileSys::VirtualFile file = romfs->GetFileRelative(path);
+        REQUIRE(file != nullptr);
+        REQUIRE(file->GetSize() == size);
+        REQUIRE(file->ReadAllBytes() == MakeData(size, seed));
+    };
+    check("empty.bin", 0, 1);
+    check("small.bin", 17, 2);
+    check("large.bin", 1 << 20, 4);
+    check("dir/nested.bin", 0x12345, 3);
+}
+
+TEST_CASE("RomFS[Lookup]", "[core]") {
+    const auto image = MakeImage(
+        {MakeFile("root.bin", 5, 6), MakeFile("caf\xc3\xa9.txt", 7, 7)},
+        {MakeDir("a", {MakeFile("a.bin", 9, 8), MakeFile("b.bin", 10, 9)},
+                 {MakeDir("deep", {MakeFile("a.bin", 11, 10)}), MakeDir("empty", {})}),
+         MakeDir("\xe3\x83\x87\xe3\x83\xbc\xe3\x82\xbf", {MakeFile("x", 12, 11)})});
+
+    // Without hash tables, lookups walk the children of the directory instead
+    std::vector<u8> unhashed = image->ReadAllBytes();
+    PatchHeader(unhashed, 0x10, 0);
+    PatchHeader(unhashed, 0x30, 0);
+
+    for (const FileSys::VirtualDir& romfs :
+         {FileSys::ExtractRomFS(image),
+          FileSys::ExtractRomFS(std::make_shared<FileSys::VectorVfsFile>(unhashed))}) {
+        REQUIRE(romfs != nullptr);
+        REQUIRE(romfs->IsRoot());
+        REQUIRE(!romfs->IsWritable());
+        REQUIRE(romfs->GetName().empty());
+
+        const auto check = [&romfs](std::string_view path, size_t size, u32 seed) {
+            const FileSys::VirtualFile file = romfs->GetFileRelative(path);
+            REQUIRE(file != nullptr);
+            REQUIRE(file->ReadAllBytes() == MakeData(size, seed));
+        };
+        check("root.bin", 5, 6);
+        check("caf\xc3\xa9.txt", 7, 7);
+        check("a/a.bin", 9, 8);
+        check("/a/b.bin", 10, 9);
+        check("a/deep/a.bin", 11, 10);
+        check("\xe3\x83\x87\xe3\x83\xbc\xe3\x82\xbf/x", 12, 11);
+
+        // Misses, and entries of the wrong kind
+        REQUIRE(romfs->GetFileRelative("a/c.bin") == nullptr);
+        REQUIRE(romfs->GetFileRelative("a/deep") == nullptr);
+        REQUIRE(romfs->GetFileRelative("b/a.bin") == nullptr);
+        REQUIRE(romfs->GetSubdirectory("root.bin") == nullptr);
+        REQUIRE(romfs->GetSubdirectory("") == nullptr);
+        REQUIRE(romfs->GetDirectoryRelative("a/deep/a.bin") == nullptr);
+
+        const FileSys::VirtualDir deep = romfs->GetDirectoryRelative("a/deep");
+        REQUIRE(deep != nullptr);
+        REQUIRE(deep->GetName() == "deep");
+        REQUIRE(!deep->IsRoot());
+        REQUIRE(deep->GetParentDirectory()->GetName() == "a");
+        REQUIRE(deep->GetParentDirectory()->GetParentDirectory()->IsRoot());
+        REQUIRE(deep->GetFileAbsolute("/root.bin") != nullptr);
+        REQUIRE(romfs->GetDirectoryRelative("a/empty")->GetFiles().empty());
+
+        // Listings follow the order of the image
+        const FileSys::VirtualDir a = romfs->GetSubdirectory("a");
+        REQUIRE(a->GetFiles().size() == 2);
+        REQUIRE(a->GetFiles()[0]->GetName() == "a.bin");
+        REQUIRE(a->GetSubdirectories().size() == 2);
+        const std::map<std::string, FileSys::VfsEntryType, std::less<>> entries{
+            {"a.bin", FileSys::VfsEntryType::File},
+            {"b.bin", FileSys::VfsEntryType::File},
+            {"deep", FileSys::VfsEntryType::Directory},
+            {"empty", FileSys::VfsEntryType::Directory},
+        };
+        REQUIRE(a->GetEntries() == entries);
+        REQUIRE(romfs->GetSize() == 5 + 7 + 9 + 10 + 11 + 12);
+    }
+
+    // Truncated images are rejected
+    REQUIRE(FileSys::ExtractRomFS(std::make_shared<FileSys::VectorVfsFile>(
+                std::vector<u8>(unhashed.begin(), unhashed.begin() + 0x20))) == nullptr);
+}
+
+TEST_CASE("RomFS[Large benchmark]", "[core][.benchmark]") {
+    // 100k files spread over 1000 directories, like the largest games
+    constexpr size_t num_dirs = 1000;
+    constexpr size_t files_per_dir = 100;
+    std::vector<FileSys::VirtualDir> dirs;
+    std::vector<std::string> paths;
+    for (size_t dir = 0; dir < num_dirs; ++dir) {
+        std::vector<FileSys::VirtualFile> files;
+        for (size_t file = 0; file < files_per_dir; ++file) {
+            const std::string name = "asset_" + std::to_string(file) + ".bin";
+            files.push_back(MakeFile(name, file % 64 + 1, static_cast<u32>(file)));
+            paths.push_back("data/" + std::to_string(dir) + "/" + name);
+        }
+        dirs.push_back(MakeDir(std::to_string(dir), std::move(files)));
+    }
+    const FileSys::VirtualFile image = MakeImage({}, {MakeDir("data", {}, std::move(dirs))});
+
+    // Every 97th path, out of order
+    std::vector<std::string> lookups;
+    for (size_t i = 0; i < paths.size(); i += 97) {
+        lookups.push_back(paths[(i * 7919) % paths.size()]);
+    }
+
+    const size_t heap_before = HeapInUse();
+    const FileSys::VirtualDir view = FileSys::ExtractRomFS(image);
+    const size_t heap_view = HeapInUse();
+    const FileSys::VirtualDir tree = MaterializeTree(view);
+    const size_t heap_tree = HeapInUse();
+    if (heap_before != 0) {
+        WARN("Heap used by the flat view: " << (heap_view - heap_before) / 1024
+                                            << " KiB, by the tree: "
+                                            << (heap_tree - heap_view) / 1024 << " KiB");
+    }
+
+    BENCHMARK("Open 100k files, tree") {
+        return MaterializeTree(FileSys::ExtractRomFS(image));
+    };
+    BENCHMARK("Open 100k files, flat view") {
+        return FileSys::ExtractRomFS(image);
+    };
+    for (const auto& [name, romfs] : {std::pair{"tree", tree}, std::pair{"flat view", view}}) {
+        BENCHMARK(std::string("Look up ") + std::to_string(lookups.size()) + " paths, " + name) {
+            size_t found = 0;
+            for (const std::string& path : lookups) {
+                found += romfs->GetFileRelative(path) != nullptr;
+            }
+            return found;
+        };
+    }
+}
@@ -0,0 +1,365 @@
+// SPDX-FileCopyrightText: Copyright 2026 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_funcs.h"
+#include "common/common_types.h"
+#include "core/core.h"
+#include "core/hle/ipc.h"
+#include "core/hle/kernel/k_process.h"
+#include "core/hle/kernel/k_shared_memory.h"
+#include "core/hle/kernel/k_thread.h"
+#include "core/hle/kernel/kernel.h"
+#include "core/hle/service/cmif_serialization.h"
+#include "core/hle/service/hle_ipc.h"
+#include "core/hle/service/server_manager.h"
+#include "core/hle/service/service.h"
+#include "core/memory.h"
+#include "tests/test_data.h"
+
+namespace {
+using Service::BufferAttr_HipcMapAlias;
+using Service::HLERequestContext;
+using Tests::MakeData;
+
+constexpr u64 PAGE_SIZE = Core::Memory::CITRON_PAGESIZE;
+constexpr u64 CODE_ADDRESS = 0x200000;
+constexpr u64 BASE_ADDRESS = 0x10000000;
+
+/// Service whose commands reverse their input buffer into their output buffer. Writing the output
+/// over its own input gives a different result, which makes aliasing visible.
+class ReverseService final : public Service::ServiceFramework<ReverseService> {
+public:
+    explicit ReverseService(Core::System& system_) : ServiceFramework{system_, "test:rev"} {}
+
+    void ReverseBytes(HLERequestContext& ctx) {
+        CmifReplyWrap<false, &ReverseService::ReverseBytesImpl>(ctx);
+    }
+
+    void ReverseWords(HLERequestContext& ctx) {
+        CmifReplyWrap<false, &ReverseService::ReverseWordsImpl>(ctx);
+    }
+
+    /// Output buffer handed to the last handler
+    const void* last_output{};
+
+private:
+    Result ReverseBytesImpl(Service::OutBuffer<BufferAttr_HipcMapAlias> out,
+                            Service::InBuffer<BufferAttr_HipcMapAlias> in) {
+        last_output = out.data();
+        const size_t size = std::min(out.size(), in.size());
+        for (size_t i = 0; i < size; ++i) {
+            out[i] = in[size - 1 - i];
+        }
+        R_SUCCEED();
+    }
+
+    Result ReverseWordsImpl(Service::OutArray<u32, BufferAttr_HipcMapAlias> out,
+                            Service::InArray<u32, BufferAttr_HipcMapAlias> in) {
+        last_output = out.data();
+        const size_t size = std::min(out.size(), in.size());
+        for (size_t i = 0; i < size; ++i) {
+            out[i] = in[size - 1 - i];
+        }
+        R_SUCCEED();
+    }
+};
+
+/// Kernel and a process owning the guest memory, enough to dispatch requests to a service
+class IpcEnvironment {
+public:
+    IpcEnvironment() {
+        system.Initialize();
+        auto& kernel = system.Kernel();
+        kernel.Initialize();
+
+        // A 32-bit process created the way the loader creates them, without capabilities
+        const Kernel::Svc::CreateProcessParameter params{
+            .name = {},
+            .version = {},
+            .program_id = {},
+            .code_address = CODE_ADDRESS,
+            .code_num_pages = 1,
+            .flags = Kernel::Svc::CreateProcessFlag::AddressSpace32Bit,
+            .reslimit = Kernel::Svc::InvalidHandle,
+            .system_resource_num_pages = 0,
+        };
+        process = Kernel::KProcess::Create(kernel);
+        REQUIRE(R_SUCCEEDED(process->Initialize(params, {}, kernel.GetSystemResourceLimit(),
+                                                Kernel::KMemoryManager::Pool::Application, 0)));
+        Kernel::KProcess::Register(kernel, process);
+    }
+
+    ~IpcEnvironment() {
+        for (const Mapping& mapping : mappings) {
+            mapping.shared_memory->Unmap(*process, mapping.address, mapping.size);
+            mapping.shared_memory->Close();
+        }
+        process->Close();
+        system.Kernel().Shutdown();
+    }
+
+    /// Maps num_pages guest pages starting at page to a new shared memory block, the pages of a
+    /// block are contiguous in host memory
+    u8* Map(u64 page, u64 num_pages) {
+        auto& kernel = system.Kernel();
+        constexpr auto permission = Kernel::Svc::MemoryPermission::ReadWrite;
+        auto* const shared_memory = Kernel::KSharedMemory::Create(kernel);
+        REQUIRE(R_SUCCEEDED(shared_memory->Initialize(system.DeviceMemory(), process, permission,
+                                                      permission, num_pages * PAGE_SIZE)));
+        Kernel::KSharedMemory::Register(kernel, shared_memory);
+        mappings.push_back({shared_memory, Address(page), num_pages * PAGE_SIZE});
+        REQUIRE(R_SUCCEEDED(
+            shared_memory->Map(*process, Address(page), num_pages * PAGE_SIZE, permission)));
+        return shared_memory->GetPointer();
+    }
+
+    static u64 Address(u64 page) {
+        return BASE_ADDRESS + page * PAGE_SIZE;
+    }
+
+    Core::Memory::Memory& Memory() {
+        return process->GetMemory();
+    }
+
+    void Write(u64 address, std::span<const u8> data) {
+        Memory().WriteBlock(address, data.data(), data.size());
+    }
+
+    std::vector<u8> Read(u64 address, size_t size) {
+        std::vector<u8> data(size);
+        Memory().ReadBlock(address, data.data(), size);
+        return data;
+    }
+
+    /// Runs func on a host thread owned by a process, with a session manager for its requests
+    void Run(std::function<void(Kernel::KThread&, std::shared_ptr<Service::SessionRequestManager>)>
+                 func) {
+        auto& kernel = system.Kernel();
+        auto server_manager = std::make_unique<Service::ServerManager>(system);
+        std::jthread loop = kernel.RunOnHostCoreProcess(
+            "IpcTestServer", [&server_manager] { server_manager->LoopProcess(); });
+        const auto manager =
+            std::make_shared<Service::SessionRequestManager>(kernel, *server_manager);
+        kernel
+            .RunOnHostCoreProcess("IpcTest",
+                                  [&] { func(*Kernel::GetCurrentThreadPointer(kernel), manager); })
+            .join();
+        // Stops the loop
+        server_manager.reset();
+    }
+
+    Core::System system;
+
+private:
+    struct Mapping {
+        Kernel::KSharedMemory* shared_memory;
+        u64 address;
+        u64 size;
+    };
+
+    Kernel::KProcess* process{};
+    std::vector<Mapping> mappings;
+};
+
+struct Descriptor {
+    u64 address;
+    u32 size;
+};
+
+/// Builds a CMIF request with one A (input) and one B (output) descriptor
+std::array<u32, IPC::COMMAND_BUFFER_LENGTH> MakeRequest(Descriptor in, Descriptor out) {
+    std::array<u32, IPC::COMMAND_BUFFER_LENGTH> cmdbuf{};
+    IPC::CommandHeader header{};
+    header.type.Assign(IPC::CommandType::Request);
+    header.num_buf_a_descriptors.Assign(1);
+    header.num_buf_b_descriptors.Assign(1);
+    header.data_size.Assign(16);
+
+    const auto make_descriptor = [](Descriptor descriptor) {
+        IPC::BufferDescriptorABW abw{};
+        abw.address_bits_0_31 = static_cast<u32>(descriptor.address);
+        abw.size_bits_0_31 = descriptor.size;
+        return abw;
+    };
+    const IPC::BufferDescriptorABW a = make_descriptor(in);
+    const IPC::BufferDescriptorABW b = make_descriptor(out);
+
+    size_t index = 0;
+    std::memcpy(&cmdbuf[index], &header, sizeof(header));
+    index += sizeof(header) / sizeof(u32);
+    std::memcpy(&cmdbuf[index], &a, sizeof(a));
+    index += sizeof(a) / sizeof(u32);
+    std::memcpy(&cmdbuf[index], &b, sizeof(b));
+    index += sizeof(b) / sizeof(u32);
+
+    // The payload is aligned to 16 bytes, then the command id follows its header
+    index = (index + 3) & ~size_t{3};
+    IPC::DataPayloadHeader payload{};
+    payload.magic = Common::MakeMagic('S', 'F', 'C', 'I');
+    std::memcpy(&cmdbuf[index], &payload, sizeof(payload));
+    index += sizeof(payload) / sizeof(u32);
+    cmdbuf[index] = 0;
+    return cmdbuf;
+}
+
+/// Sends a reverse request from thread, returns the output buffer the handler got
+const void* Send(IpcEnvironment& environment, ReverseService& service, Kernel::KThread& thread,
+                 const std::shared_ptr<Service::SessionRequestManager>& manager, bool words,
+                 Descriptor in, Descriptor out) {
+    auto cmdbuf = MakeRequest(in, out);
+    HLERequestContext ctx{environment.system.Kernel(), environment.Memory(), nullptr, &thread};
+    ctx.SetSessionRequestManager(manager);
+    REQUIRE(ctx.PopulateFromIncomingCommandBuffer(cmdbuf.data()).IsSuccess());
+    if (words) {
+        service.ReverseWords(ctx);
+    } else {
+        service.ReverseBytes(ctx);
+    }
+    return service.last_output;
+}
+
+/// Sends a reverse request from a new thread
+const void* Dispatch(IpcEnvironment& environment, ReverseService& service, bool words,
+                     Descriptor in, Descriptor out) {
+    environment.Run([&](Kernel::KThread& thread,
+                        std::shared_ptr<Service::SessionRequestManager> manager) {
+        Send(environment, service, thread, manager, words, in, out);
+    });
+    return service.last_output;
+}
+
+std::vector<u8> Reversed(std::vector<u8> data) {
+    std::ranges::reverse(data);
+    return data;
+}
+
+std::vector<u8> ReversedWords(const std::vector<u8>& data) {
+    std::vector<u8> result(data.size());
+    const size_t num_words = data.size() / sizeof(u32);
+    for (size_t i = 0; i < num_words; ++i) {
+        std::memcpy(result.data() + i * sizeof(u32),
+                    data.data() + (num_words - 1 - i) * sizeof(u32), sizeof(u32));
+    }
+    return result;
+}
+
+} // Anonymous namespace
+
+TEST_CASE("HLERequestContext[Output buffers are written in place when contiguous]", "[core]") {
+    IpcEnvironment environment;
+    ReverseService service{environment.system};
+    environment.Map(0, 1);
+    u8* const output = environment.Map(2, 2);
+
+    const std::vector<u8> input = MakeData(PAGE_SIZE, 1);
+    environment.Write(IpcEnvironment::Address(0), input);
+    const u32 size = static_cast<u32>(PAGE_SIZE);
+    const Descriptor in{IpcEnvironment::Address(0), size};
+    const Descriptor out{IpcEnvironment::Address(2) + 0x800, size};
+
+    REQUIRE(Dispatch(environment, service, false, in, out) == output + 0x800);
+    REQUIRE(environment.Read(out.address, size) == Reversed(input));
+}
+
+TEST_CASE("HLERequestContext[Non-contiguous output buffers fall back to scratch]", "[core]") {
+    IpcEnvironment environment;
+    ReverseService service{environment.system};
+    environment.Map(0, 1);
+    // Neighbouring guest pages in different host allocations
+    u8* const first = environment.Map(2, 1);
+    u8* const second = environment.Map(3, 1);
+
+    const std::vector<u8> input = MakeData(PAGE_SIZE, 2);
+    environment.Write(IpcEnvironment::Address(0), input);
+    const u32 size = static_cast<u32>(PAGE_SIZE);
+    const Descriptor in{IpcEnvironment::Address(0), size};
+    const Descriptor out{IpcEnvironment::Address(2) + 0x800, size};
+
+    const void* const used = Dispatch(environment, service, false, in, out);
+    REQUIRE(used != first + 0x800);
+    REQUIRE(used != second);
+    REQUIRE(environment.Read(out.address, size) == Reversed(input));
+}
+
+TEST_CASE("HLERequestContext[Misaligned output arrays fall back to scratch]", "[core]") {
+    IpcEnvironment environment;
+    ReverseService service{environment.system};
+    environment.Map(0, 1);
+    u8* const output = environment.Map(2, 1);
+
+    const std::vector<u8> input = MakeData(0x400, 3);
+    environment.Write(IpcEnvironment::Address(0), input);
+    const Descriptor in{IpcEnvironment::Address(0), 0x400};
+
+    // Aligned arrays are written in place
+    const Descriptor aligned{IpcEnvironment::Address(2), 0x400};
+    REQUIRE(Dispatch(environment, service, true, in, aligned) == output);
+    REQUIRE(environment.Read(aligned.address, 0x400) == ReversedWords(input));
+
+    // An array of words that is not word aligned in host memory goes through the scratch buffer
+    const Descriptor misaligned{IpcEnvironment::Address(2) + 0x802, 0x400};
+    REQUIRE(Dispatch(environment, service, true, in, misaligned) != output + 0x802);
+    REQUIRE(environment.Read(misaligned.address, 0x400) == ReversedWords(input));
+}
+
+TEST_CASE("HLERequestContext[Output buffers overlapping an input fall back to scratch]",
+          "[core]") {
+    IpcEnvironment environment;
+    ReverseService service{environment.system};
+    u8* const memory = environment.Map(0, 2);
+    const u32 size = static_cast<u32>(PAGE_SIZE);
+
+    // The output is the input itself
+    const std::vector<u8> input = MakeData(PAGE_SIZE, 4);
+    environment.Write(IpcEnvironment::Address(0), input);
+    const Descriptor same{IpcEnvironment::Address(0), size};
+    REQUIRE(Dispatch(environment, service, false, same, same) != memory);
+    REQUIRE(environment.Read(same.address, size) == Reversed(input));
+
+    // The output starts in the middle of the input
+    environment.Write(IpcEnvironment::Address(0), input);
+    const Descriptor out{IpcEnvironment::Address(0) + 0x100, size};
+    REQUIRE(Dispatch(environment, service, false, same, out) != memory + 0x100);
+    REQUIRE(environment.Read(out.address, size) == Reversed(input));
+}
+
+TEST_CASE("HLERequestContext[Benchmark]", "[core][.benchmark]") {
+    IpcEnvironment environment;
+    ReverseService service{environment.system};
+    constexpr u64 num_pages = 256;
+    constexpr u32 size = static_cast<u32>(num_pages * PAGE_SIZE);
+    environment.Map(0, num_pages);
+    environment.Map(num_pages, num_pages);
+    // Blocks of 64 KiB, the output can never be written in place
+    constexpr u64 block_pages = 16;
+    for (u64 page = 2 * num_pages; page < 3 * num_pages; page += block_pages) {
+        environment.Map(page, block_pages);
+    }
+    environment.Write(IpcEnvironment::Address(0), MakeData(size, 5));
+    const Descriptor in{IpcEnvironment::Address(0), size};
+
+    // Every run creates its own processes, the requests are all sent from one thread
+    environment.Run([&](Kernel::KThread& thread,
+                        std::shared_ptr<Service::SessionRequestManager> manager) {
+        BENCHMARK("Reverse 1 MiB through a scratch buffer") {
+            return Send(environment, service, thread, manager, true, in,
+                        {IpcEnvironment::Address(2 * num_pages), size});
+        };
+        BENCHMARK("Reverse 1 MiB in place") {
+            return Send(environment, service, thread, manager, true, in,
+                        {IpcEnvironment::Address(num_pages), size});
+        };
+    });
+}
@@ -0,0 +1,172 @@
+// SPDX-FileCopyrightText: Copyright 2026 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <thread>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/thread.h"
+#include "core/core.h"
+#include "core/hle/kernel/kernel.h"
+#include "core/hle/service/command_profiler.h"
+#include "core/hle/service/session_executor.h"
+
+namespace {
+
+std::jthread LaunchThread(std::string&&, std::function<void()>&& func) {
+    return std::jthread(std::move(func));
+}
+
+} // Anonymous namespace
+
+TEST_CASE("SessionExecutor[Run]", "[core]") {
+    constexpr size_t num_tasks = 10000;
+    std::atomic<size_t> counter{};
+    {
+        Service::SessionExecutor executor{4, LaunchThread};
+        REQUIRE(executor.NumWorkers() == 4);
+        for (size_t i = 0; i < num_tasks; ++i) {
+            // Half of the tasks are queued from the workers themselves
+            executor.Submit([&executor, &counter, i] {
+                if (i % 2 == 0) {
+                    executor.Submit([&counter] { ++counter; });
+                }
+                ++counter;
+            });
+        }
+    }
+    // The executor runs every queued task before stopping
+    REQUIRE(counter == num_tasks + num_tasks / 2);
+}
+
+TEST_CASE("SessionExecutor[Group concurrency]", "[core]") {
+    Service::SessionExecutor executor{8, LaunchThread};
+    Service::SessionExecutor::Group group{executor, 2};
+
+    std::atomic<size_t> running{};
+    std::atomic<size_t> max_running{};
+    std::atomic<size_t> done{};
+    const auto task = [&] {
+        const size_t now = ++running;
+        size_t expected = max_running.load();
+        while (now > expected && !max_running.compare_exchange_weak(expected, now)) {
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+        --running;
+        ++done;
+    };
+
+    for (size_t i = 0; i < 200; ++i) {
+        group.Submit(task);
+    }
+    group.Wait();
+    REQUIRE(done == 200);
+    REQUIRE(max_running <= 2);
+
+    group.SetMaxConcurrency(4);
+    REQUIRE(group.GetMaxConcurrency() == 4);
+    for (size_t i = 0; i < 200; ++i) {
+        group.Submit(task);
+    }
+    group.Wait();
+    REQUIRE(done == 400);
+    REQUIRE(max_running <= 4);
+}
+
+TEST_CASE("SessionExecutor[Blocked group]", "[core]") {
+    // A request blocked in one server must not delay the requests of the others
+    Service::SessionExecutor executor{2, LaunchThread};
+    Service::SessionExecutor::Group slow_group{executor};
+    Service::SessionExecutor::Group fast_group{executor};
+
+    Common::Event release;
+    std::atomic<bool> slow_done{};
+    std::atomic<size_t> slow_queued{};
+    slow_group.Submit([&] {
+        release.Wait();
+        slow_done = true;
+    });
+    // Queued behind the blocked request, as its server only handles one request at once
+    slow_group.Submit([&] { ++slow_queued; });
+
+    std::atomic<size_t> fast_done{};
+    for (size_t i = 0; i < 100; ++i) {
+        fast_group.Submit([&] { ++fast_done; });
+    }
+    fast_group.Wait();
+    REQUIRE(fast_done == 100);
+    REQUIRE(!slow_done);
+    REQUIRE(slow_queued == 0);
+
+    release.Set();
+    slow_group.Wait();
+    REQUIRE(slow_done);
+    REQUIRE(slow_queued == 1);
+}
+
+TEST_CASE("SessionExecutor[Kernel shutdown]", "[core]") {
+    Core::System system;
+    system.Initialize();
+    auto& kernel = system.Kernel();
+    kernel.Initialize();
+
+    Service::SessionExecutor* const executor = kernel.GetSessionExecutor();
+    REQUIRE(executor != nullptr);
+    REQUIRE(kernel.GetSessionExecutor() == executor);
+
+    // A task still running when the kernel shuts down asks for the executor, as a server created
+    // by a request would. The shutdown waits for the task, so it must get an answer meanwhile.
+    Service::SessionExecutor* executor_during_shutdown = executor;
+    std::atomic<bool> done{};
+    executor->Submit([&] {
+        while (!kernel.IsShuttingDown()) {
+            std::this_thread::yield();
+        }
+        executor_during_shutdown = kernel.GetSessionExecutor();
+        done = true;
+    });
+    kernel.Shutdown();
+
+    REQUIRE(done);
+    REQUIRE(executor_during_shutdown == nullptr);
+    // Closed services do not start another executor
+    REQUIRE(kernel.GetSessionExecutor() == nullptr);
+}
+
+TEST_CASE("CommandProfiler[Histogram]", "[core]") {
+    using Service::CommandProfiler;
+    REQUIRE(CommandProfiler::BucketOf(0) == 0);
+    REQUIRE(CommandProfiler::BucketOf(1) == 0);
+    REQUIRE(CommandProfiler::BucketOf(2) == 1);
+    REQUIRE(CommandProfiler::BucketOf(1023) == 9);
+    REQUIRE(CommandProfiler::BucketOf(1024) == 10);
+    REQUIRE(CommandProfiler::BucketOf(~u64{0}) == CommandProfiler::NUM_BUCKETS - 1);
+
+    CommandProfiler profiler;
+    for (u64 i = 0; i < 99; ++i) {
+        profiler.Record("fsp-srv", 18, "OpenSdCardFileSystem", 1000);
+    }
+    profiler.Record("fsp-srv", 18, "OpenSdCardFileSystem", 1'000'000);
+    profiler.Record("hid", 1, "CreateAppletResource", 10);
+
+    const auto report = profiler.Report();
+    REQUIRE(report.size() == 2);
+    const CommandProfiler::Entry& entry = report[0];
+    REQUIRE(entry.service == "fsp-srv");
+    REQUIRE(entry.command == 18);
+    REQUIRE(entry.function == "OpenSdCardFileSystem");
+    REQUIRE(entry.calls == 100);
+    REQUIRE(entry.total_ns == 99 * 1000 + 1'000'000);
+    REQUIRE(entry.max_ns == 1'000'000);
+    REQUIRE(entry.buckets[CommandProfiler::BucketOf(1000)] == 99);
+    REQUIRE(CommandProfiler::Percentile(entry, 50) == 1024);
+    REQUIRE(CommandProfiler::Percentile(entry, 99) == 1024);
+    REQUIRE(CommandProfiler::Percentile(entry, 100) == 1'000'000);
+    REQUIRE(report[1].service == "hid");
+    REQUIRE(CommandProfiler::Percentile(report[1], 99) == 10);
+}
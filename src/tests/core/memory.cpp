@@ -0,0 +1,148 @@
+// SPDX-FileCopyrightText: Copyright 2026 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "common/page_table.h"
+
+namespace {
+
+constexpr size_t ADDRESS_SPACE_BITS = 32;
+constexpr size_t PAGE_BITS = 12;
+constexpr size_t PAGE_SIZE = size_t{1} << PAGE_BITS;
+constexpr u64 BASE_ADDRESS = 0x10000000;
+
+/// Guest address space backed by a host allocation, mapped the same way as Core::Memory
+struct GuestMemory {
+    explicit GuestMemory(size_t num_pages) : host(num_pages * PAGE_SIZE) {
+        table.Resize(ADDRESS_SPACE_BITS, PAGE_BITS);
+        for (size_t i = 0; i < host.size(); ++i) {
+            host[i] = static_cast<u8>(i * 7 + (i >> 12));
+        }
+    }
+
+    void Map(size_t page, size_t host_page) {
+        const u64 vaddr = BASE_ADDRESS + page * PAGE_SIZE;
+        const auto pointer = reinterpret_cast<uintptr_t>(host.data() + host_page * PAGE_SIZE);
+        table.pointers[vaddr >> PAGE_BITS].Store(pointer - vaddr, Common::PageType::Memory);
+    }
+
+    void SetType(size_t page, Common::PageType type) {
+        table.pointers[(BASE_ADDRESS >> PAGE_BITS) + page].Store(0, type);
+    }
+
+    Common::PageTable table;
+    std::vector<u8> host;
+};
+
+void CopyOut(u8* dest, uintptr_t pointer, Common::PageType type, u64 vaddr, size_t size) {
+    if (type == Common::PageType::Memory) {
+        std::memcpy(dest, reinterpret_cast<const u8*>(pointer + vaddr), size);
+    } else {
+        std::memset(dest, 0, size);
+    }
+}
+
+/// Reads guest memory one page at a time, the way Core::Memory used to walk blocks
+void ReadPageByPage(const Common::PageTable& table, u64 vaddr, u8* dest, size_t size) {
+    while (size > 0) {
+        const size_t copy_amount = std::min(PAGE_SIZE - (vaddr & (PAGE_SIZE - 1)), size);
+        const auto [pointer, type] = table.pointers[vaddr >> PAGE_BITS].PointerType();
+        CopyOut(dest, pointer, type, vaddr, copy_amount);
+        vaddr += copy_amount;
+        dest += copy_amount;
+        size -= copy_amount;
+    }
+}
+
+/// Reads guest memory one run of contiguous pages at a time
+void ReadByRuns(const Common::PageTable& table, u64 vaddr, u8* dest, size_t size) {
+    while (size > 0) {
+        const auto [pointer, type, copy_amount] = table.ResolveRun(vaddr, size);
+        CopyOut(dest, pointer, type, vaddr, copy_amount);
+        vaddr += copy_amount;
+        dest += copy_amount;
+        size -= copy_amount;
+    }
+}
+
+} // Anonymous namespace
+
+TEST_CASE("Memory[ResolveRun]", "[core]") {
+    GuestMemory memory{64};
+    // Pages 0-15 are contiguous, pages 16-23 are mapped in reverse order
+    for (size_t page = 0; page < 16; ++page) {
+        memory.Map(page, page);
+    }
+    for (size_t page = 16; page < 24; ++page) {
+        memory.Map(page, 39 - page);
+    }
+    // Pages 24-27 are unmapped, page 28 is cached by the rasterizer, pages 29-31 are contiguous
+    memory.SetType(28, Common::PageType::RasterizerCachedMemory);
+    for (size_t page = 29; page < 32; ++page) {
+        memory.Map(page, page);
+    }
+
+    const auto run = [&memory](size_t offset, size_t max_size) {
+        return memory.table.ResolveRun(BASE_ADDRESS + offset, max_size);
+    };
+    REQUIRE(run(0, 64 * PAGE_SIZE).size == 16 * PAGE_SIZE);
+    REQUIRE(run(0, 64 * PAGE_SIZE).type == Common::PageType::Memory);
+    REQUIRE(run(0x10, 64 * PAGE_SIZE).size == 16 * PAGE_SIZE - 0x10);
+    REQUIRE(run(0x10, 0x100).size == 0x100);
+    REQUIRE(run(3 * PAGE_SIZE + 1, 2 * PAGE_SIZE).size == 2 * PAGE_SIZE);
+    REQUIRE(run(16 * PAGE_SIZE, 64 * PAGE_SIZE).size == PAGE_SIZE);
+    REQUIRE(run(24 * PAGE_SIZE, 64 * PAGE_SIZE).size == 4 * PAGE_SIZE);
+    REQUIRE(run(24 * PAGE_SIZE, 64 * PAGE_SIZE).type == Common::PageType::Unmapped);
+    REQUIRE(run(28 * PAGE_SIZE, 64 * PAGE_SIZE).size == PAGE_SIZE);
+    REQUIRE(run(28 * PAGE_SIZE, 64 * PAGE_SIZE).type ==
+            Common::PageType::RasterizerCachedMemory);
+    REQUIRE(run(29 * PAGE_SIZE, 3 * PAGE_SIZE).size == 3 * PAGE_SIZE);
+
+    // Reading by runs returns the same bytes as reading page by page
+    std::vector<u8> expected(32 * PAGE_SIZE);
+    std::vector<u8> actual(32 * PAGE_SIZE);
+    for (size_t offset = 0; offset < 32 * PAGE_SIZE; offset += 0x7f1) {
+        const size_t size = std::min<size_t>(32 * PAGE_SIZE - offset, offset / 3 + 1);
+        ReadPageByPage(memory.table, BASE_ADDRESS + offset, expected.data(), size);
+        ReadByRuns(memory.table, BASE_ADDRESS + offset, actual.data(), size);
+        REQUIRE(std::equal(expected.begin(), expected.begin() + size, actual.begin()));
+    }
+}
+
+TEST_CASE("Memory[Benchmark]", "[core][.benchmark]") {
+    constexpr size_t max_size = 64ULL << 20;
+    GuestMemory memory{max_size / PAGE_SIZE};
+    for (size_t page = 0; page < max_size / PAGE_SIZE; ++page) {
+        memory.Map(page, page);
+    }
+    std::vector<u8> buffer(max_size);
+
+    for (const size_t size : {4ULL << 10, 64ULL << 10, 1ULL << 20, 16ULL << 20, 64ULL << 20}) {
+        // Repeat small transfers so every measurement copies 64 MiB
+        const size_t repeats = max_size / size;
+        const std::string suffix = size < (1ULL << 20)
+                                       ? std::to_string(size >> 10) + " KiB transfers"
+                                       : std::to_string(size >> 20) + " MiB transfers";
+        BENCHMARK("Page by page, " + suffix) {
+            for (size_t i = 0; i < repeats; ++i) {
+                ReadPageByPage(memory.table, BASE_ADDRESS + i * size, buffer.data() + i * size,
+                               size);
+            }
+            return buffer[max_size - 1];
+        };
+        BENCHMARK("Contiguous runs, " + suffix) {
+            for (size_t i = 0; i < repeats; ++i) {
+                ReadByRuns(memory.table, BASE_ADDRESS + i * size, buffer.data() + i * size, size);
+            }
+            return buffer[max_size - 1];
+        };
+    }
+}
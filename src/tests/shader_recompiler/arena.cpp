@@ -0,0 +1,97 @@
+// SPDX-FileCopyrightText: Copyright 2026 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstdint>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "shader_recompiler/arena.h"
+#include "shader_recompiler/object_pool.h"
+
+namespace {
+using Shader::Arena;
+using Shader::ArenaVector;
+using Shader::ScopedArena;
+
+bool IsAligned(const void* pointer, size_t alignment) {
+    return reinterpret_cast<uintptr_t>(pointer) % alignment == 0;
+}
+} // Anonymous namespace
+
+TEST_CASE("Arena[Allocations are aligned and reused after reset]", "[shader_recompiler]") {
+    Arena arena{256};
+    void* const first{arena.Allocate(3, 1)};
+    void* const second{arena.Allocate(8, 8)};
+    void* const third{arena.Allocate(32, 32)};
+    REQUIRE(IsAligned(second, 8));
+    REQUIRE(IsAligned(third, 32));
+    REQUIRE(static_cast<u8*>(second) >= static_cast<u8*>(first) + 3);
+    REQUIRE(static_cast<u8*>(third) >= static_cast<u8*>(second) + 8);
+    REQUIRE(arena.GetStatistics().allocations == 3);
+    REQUIRE(arena.GetStatistics().system_allocations == 1);
+
+    arena.Reset();
+    REQUIRE(arena.Allocate(3, 1) == first);
+    REQUIRE(arena.GetStatistics().system_allocations == 1);
+}
+
+TEST_CASE("Arena[Blocks are squashed after a large program]", "[shader_recompiler]") {
+    Arena arena{256};
+    const auto run_program{[&arena] {
+        for (int i = 0; i < 64; ++i) {
+            REQUIRE(IsAligned(arena.Allocate(24, 8), 8));
+        }
+        // Larger than a block
+        REQUIRE(IsAligned(arena.Allocate(1024, 16), 16));
+    }};
+    run_program();
+    const u64 grown_allocations{arena.GetStatistics().system_allocations};
+    REQUIRE(grown_allocations > 1);
+
+    // The blocks are merged into one on reset, the next programs fit in it
+    arena.Reset();
+    REQUIRE(arena.GetStatistics().system_allocations == grown_allocations + 1);
+    for (int i = 0; i < 4; ++i) {
+        run_program();
+        arena.Reset();
+    }
+    REQUIRE(arena.GetStatistics().system_allocations == grown_allocations + 1);
+}
+
+TEST_CASE("Arena[Containers allocate from the installed arena]", "[shader_recompiler]") {
+    Arena arena;
+    ArenaVector<u32> heap_values;
+    {
+        const ScopedArena scoped_arena{arena};
+        REQUIRE(Arena::Current() == &arena);
+        {
+            Arena inner_arena;
+            const ScopedArena scoped_inner_arena{inner_arena};
+            REQUIRE(Arena::Current() == &inner_arena);
+        }
+        REQUIRE(Arena::Current() == &arena);
+
+        ArenaVector<u32> values;
+        for (u32 i = 0; i < 1000; ++i) {
+            values.push_back(i);
+        }
+        REQUIRE(arena.GetStatistics().allocations > 0);
+        REQUIRE(values[999] == 999);
+
+        // Containers created before the arena was installed keep using the heap
+        const u64 allocations{arena.GetStatistics().allocations};
+        heap_values.assign(values.begin(), values.end());
+        REQUIRE(arena.GetStatistics().allocations == allocations);
+
+        // Pools created while an arena is installed allocate their chunks from it
+        Shader::ObjectPool<u64> pool{4};
+        for (u64 i = 0; i < 16; ++i) {
+            REQUIRE(*pool.Create(i) == i);
+        }
+        REQUIRE(arena.GetStatistics().allocations > allocations);
+    }
+    REQUIRE(Arena::Current() == nullptr);
+    REQUIRE(heap_values.size() == 1000);
+    arena.Reset();
+}
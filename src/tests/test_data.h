@@ -0,0 +1,24 @@
+// SPDX-FileCopyrightText: Copyright 2026 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "common/common_types.h"
+
+namespace Tests {
+
+/// Returns size pseudo-random bytes, the same ones for every run with the same seed
+inline std::vector<u8> MakeData(std::size_t size, u32 seed) {
+    std::vector<u8> data(size);
+    u32 state = seed;
+    for (u8& value : data) {
+        state = state * 1664525U + 1013904223U;
+        value = static_cast<u8>(state >> 24);
+    }
+    return data;
+}
+
+} // namespace Tests
@@ -0,0 +1,239 @@
+// SPDX-FileCopyrightText: Copyright 2026 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/cityhash.h"
+#include "common/common_types.h"
+#include "common/div_ceil.h"
+#include "video_core/textures/astc.h"
+
+namespace {
+using Footprint = std::array<u32, 2>;
+
+constexpr std::array<Footprint, 8> FOOTPRINTS{{
+    {4, 4},
+    {5, 4},
+    {5, 5},
+    {6, 5},
+    {6, 6},
+    {8, 5},
+    {8, 6},
+    {8, 8},
+}};
+
+/// Builds an LDR void extent block, every texel of it decodes to 'rgba'.
+std::array<u8, 16> MakeVoidExtentBlock(u32 rgba) {
+    std::array<u8, 16> block{};
+    // Void extent block mode with the two reserved bits set, extent coordinates left as zero
+    const u16 header = 0x1FC | 0x400 | 0x800;
+    std::memcpy(block.data(), &header, sizeof(header));
+    for (u32 channel = 0; channel < 4; ++channel) {
+        const u16 value = static_cast<u16>(((rgba >> (channel * 8)) & 0xFF) << 8);
+        std::memcpy(block.data() + 8 + channel * 2, &value, sizeof(value));
+    }
+    return block;
+}
+
+/// Builds a block with a 4x4 weight grid of 1-bit weights, a single partition in the RGBA direct
+/// endpoint mode and random endpoint and weight bits.
+std::array<u8, 16> MakeRandomBlock(std::mt19937& rng) {
+    std::array<u8, 16> block;
+    for (u8& value : block) {
+        value = static_cast<u8>(rng());
+    }
+    // Block mode layout 0 with R=2, A=2, B=0, a single partition and color endpoint mode 12
+    const u32 header = 0x41 | (12U << 13);
+    block[0] = static_cast<u8>(header);
+    block[1] = static_cast<u8>(header >> 8);
+    block[2] = static_cast<u8>((block[2] & 0xFE) | ((header >> 16) & 1));
+    return block;
+}
+
+/// Parameters of a non void extent block, see Section C.2.10 of the ASTC specification.
+struct BlockConfig {
+    u32 grid_width;
+    u32 grid_height;
+    u32 weight_range; ///< R in the specification, 2 to 7
+    bool high_precision;
+    bool dual_plane;
+    u32 num_partitions;
+    u32 color_endpoint_mode; ///< Shared by every partition, LDR modes only
+};
+
+constexpr std::array<BlockConfig, 10> BLOCK_CONFIGS{{
+    {4, 4, 4, false, false, 1, 12},
+    {3, 3, 5, false, true, 1, 8},
+    {4, 4, 3, false, false, 2, 4},
+    {5, 4, 2, false, false, 3, 8},
+    {6, 5, 4, false, false, 4, 0},
+    {2, 3, 2, true, true, 2, 12},
+    {4, 8, 2, false, true, 1, 4},
+    {8, 5, 2, false, false, 1, 12},
+    {6, 6, 2, false, false, 2, 8},
+    {9, 8, 2, false, false, 1, 0},
+}};
+
+/// Encodes the 11-bit block mode of a configuration, picking the layout of table C.2.8 that fits
+/// its weight grid.
+u32 EncodeBlockMode(const BlockConfig& config) {
+    const u32 w = config.grid_width;
+    const u32 h = config.grid_height;
+    const u32 r = config.weight_range;
+    if (w >= 6 && h >= 6) {
+        // Layout with a 6x6 to 9x9 grid, low precision and a single plane only
+        return ((r & 1) << 4) | ((r >> 1) << 2) | 0x100 | ((w - 6) << 5) | ((h - 6) << 9);
+    }
+    u32 mode = (r >> 1) | ((r & 1) << 4) | (u32{config.high_precision} << 9) |
+               (u32{config.dual_plane} << 10);
+    if (w <= 3 && h <= 5) {
+        mode |= 0xC | 0x100 | ((w - 2) << 7) | ((h - 2) << 5);
+    } else if (w <= 7 && h <= 5) {
+        mode |= ((w - 4) << 7) | ((h - 2) << 5);
+    } else if (h <= 5) {
+        mode |= 0x4 | ((w - 8) << 7) | ((h - 2) << 5);
+    } else {
+        mode |= 0x8 | ((w - 2) << 5) | ((h - 8) << 7);
+    }
+    return mode;
+}
+
+/// Builds a block of the given configuration, the partition index, endpoints, plane selector and
+/// weights are random.
+std::array<u8, 16> MakeBlock(const BlockConfig& config, std::mt19937& rng) {
+    std::array<u8, 16> block;
+    for (u8& value : block) {
+        value = static_cast<u8>(rng());
+    }
+    u32 header = EncodeBlockMode(config) | ((config.num_partitions - 1) << 11);
+    u32 header_bits = 17;
+    if (config.num_partitions == 1) {
+        header |= config.color_endpoint_mode << 13;
+    } else {
+        // Random partition index, every partition shares the same endpoint mode
+        header |= (static_cast<u32>(rng()) & 0x3FF) << 13;
+        header |= config.color_endpoint_mode << 25;
+        header_bits = 29;
+    }
+    u32 bits;
+    std::memcpy(&bits, block.data(), sizeof(bits));
+    const u32 mask = (1U << header_bits) - 1;
+    bits = (bits & ~mask) | header;
+    std::memcpy(block.data(), &bits, sizeof(bits));
+    return block;
+}
+
+/// Footprint and hash of its decoded blocks, recorded with the decoder as written in the
+/// specification: per texel weight infill and floating point rounding of the blended endpoints.
+struct ReferenceHash {
+    Footprint footprint;
+    u64 hash;
+};
+} // Anonymous namespace
+
+TEST_CASE("ASTC[Tiled decode covers every texel]", "[video_core]") {
+    static constexpr u32 width = 131;
+    static constexpr u32 height = 67;
+    static constexpr u32 depth = 3;
+    for (const auto& [block_width, block_height] : FOOTPRINTS) {
+        const u32 cols = Common::DivCeil(width, block_width);
+        const u32 rows = Common::DivCeil(height, block_height);
+        std::vector<u8> data(size_t{cols} * rows * depth * 16);
+        for (u32 block = 0; block < cols * rows * depth; ++block) {
+            const auto encoded = MakeVoidExtentBlock(block * 0x9E3779B1U);
+            std::memcpy(data.data() + block * 16, encoded.data(), encoded.size());
+        }
+        std::vector<u8> output(size_t{width} * height * depth * 4);
+        Tegra::Texture::ASTC::Decompress(data, width, height, depth, block_width, block_height,
+                                         output);
+
+        for (u32 z = 0; z < depth; ++z) {
+            for (u32 y = 0; y < height; ++y) {
+                for (u32 x = 0; x < width; ++x) {
+                    const u32 block =
+                        (z * rows + y / block_height) * cols + x / block_width;
+                    u32 texel;
+                    std::memcpy(&texel, &output[((z * height + y) * width + x) * 4], 4);
+                    REQUIRE(texel == block * 0x9E3779B1U);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("ASTC[Decoded blocks match the reference decoder]", "[video_core]") {
+    // Sizes that are not a multiple of any footprint, so edge blocks are cropped
+    static constexpr u32 width = 37;
+    static constexpr u32 height = 29;
+    static constexpr u32 depth = 2;
+    static constexpr std::array<ReferenceHash, 6> references{{
+        {{4, 4}, 0xB893061770876D8FULL},
+        {{5, 4}, 0xC2D93946B45E05FCULL},
+        {{6, 6}, 0x9CAD7D9036AE1685ULL},
+        {{8, 8}, 0x42D45747A24EB461ULL},
+        {{10, 8}, 0x0BFF9E74F7940FA5ULL},
+        {{12, 12}, 0x6A50314918986ABAULL},
+    }};
+    std::mt19937 rng{0xA57C};
+    for (const auto& [footprint, reference_hash] : references) {
+        const auto [block_width, block_height] = footprint;
+        u64 hash = 0;
+        for (const BlockConfig& config : BLOCK_CONFIGS) {
+            if (config.grid_width > block_width || config.grid_height > block_height) {
+                continue;
+            }
+            const u32 num_blocks = Common::DivCeil(width, block_width) *
+                                   Common::DivCeil(height, block_height) * depth;
+            std::vector<u8> data(size_t{num_blocks} * 16);
+            for (u32 block = 0; block < num_blocks; ++block) {
+                const auto encoded = MakeBlock(config, rng);
+                std::memcpy(data.data() + block * 16, encoded.data(), encoded.size());
+            }
+
+            std::vector<u8> output(size_t{width} * height * depth * 4);
+            Tegra::Texture::ASTC::Decompress(data, width, height, depth, block_width,
+                                             block_height, output);
+            INFO("Footprint " << block_width << "x" << block_height << ", grid "
+                              << config.grid_width << "x" << config.grid_height << ", "
+                              << config.num_partitions << " partitions, dual plane "
+                              << config.dual_plane);
+            // Invalid blocks decode to zeros, make sure the blocks were actually decoded
+            REQUIRE(std::ranges::count(output, u8{0}) < static_cast<s64>(output.size() / 2));
+            hash = Common::CityHash64WithSeed(reinterpret_cast<const char*>(output.data()),
+                                              output.size(), hash);
+        }
+        INFO("Footprint " << block_width << "x" << block_height);
+        REQUIRE(hash == reference_hash);
+    }
+}
+
+TEST_CASE("ASTC[Benchmark]", "[video_core][.benchmark]") {
+    static constexpr u32 width = 1024;
+    static constexpr u32 height = 1024;
+    std::mt19937 rng{0x4A57C};
+    for (const auto& [block_width, block_height] : FOOTPRINTS) {
+        const u32 num_blocks =
+            Common::DivCeil(width, block_width) * Common::DivCeil(height, block_height);
+        std::vector<u8> data(size_t{num_blocks} * 16);
+        for (u32 block = 0; block < num_blocks; ++block) {
+            const auto encoded = MakeRandomBlock(rng);
+            std::memcpy(data.data() + block * 16, encoded.data(), encoded.size());
+        }
+        std::vector<u8> output(size_t{width} * height * 4);
+        BENCHMARK("Decompress " + std::to_string(block_width) + "x" +
+                  std::to_string(block_height) + " (1 MTexel)") {
+            Tegra::Texture::ASTC::Decompress(data, width, height, 1, block_width, block_height,
+                                             output);
+            return output[0];
+        };
+    }
+}
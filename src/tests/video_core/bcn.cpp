@@ -0,0 +1,290 @@
+// SPDX-FileCopyrightText: Copyright 2026 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "common/div_ceil.h"
+#include "video_core/textures/bcn.h"
+
+namespace {
+using namespace Tegra::Texture::BCN;
+
+constexpr std::array<EncoderKernel, 2> KERNELS{
+    EncoderKernel::Stb,
+    EncoderKernel::SSE,
+};
+
+constexpr const char* KernelName(EncoderKernel kernel) {
+    switch (kernel) {
+    case EncoderKernel::Stb:
+        return "Stb";
+    case EncoderKernel::SSE:
+        return "SSE";
+    }
+    return "Unknown";
+}
+
+/// Encoders the host does not support fall back to Stb
+bool IsSupported(EncoderKernel kernel) {
+    return static_cast<u32>(kernel) <= static_cast<u32>(GetHostEncoderKernel());
+}
+
+std::array<u32, 3> Unpack565(u32 color) {
+    const u32 r = (color >> 11) & 0x1F;
+    const u32 g = (color >> 5) & 0x3F;
+    const u32 b = color & 0x1F;
+    return {(r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2)};
+}
+
+/// Decodes a BC1 color block into 16 RGBA texels
+void DecodeColorBlock(const u8* block, std::array<std::array<u8, 4>, 16>& texels) {
+    u16 color0;
+    u16 color1;
+    u32 indices;
+    std::memcpy(&color0, block, sizeof(color0));
+    std::memcpy(&color1, block + 2, sizeof(color1));
+    std::memcpy(&indices, block + 4, sizeof(indices));
+    const auto c0 = Unpack565(color0);
+    const auto c1 = Unpack565(color1);
+    std::array<std::array<u8, 4>, 4> palette{};
+    for (u32 channel = 0; channel < 3; ++channel) {
+        palette[0][channel] = static_cast<u8>(c0[channel]);
+        palette[1][channel] = static_cast<u8>(c1[channel]);
+        if (color0 > color1) {
+            palette[2][channel] = static_cast<u8>((2 * c0[channel] + c1[channel]) / 3);
+            palette[3][channel] = static_cast<u8>((c0[channel] + 2 * c1[channel]) / 3);
+        } else {
+            palette[2][channel] = static_cast<u8>((c0[channel] + c1[channel]) / 2);
+        }
+    }
+    palette[0][3] = palette[1][3] = palette[2][3] = 255;
+    palette[3][3] = color0 > color1 ? 255 : 0;
+    for (u32 i = 0; i < 16; ++i) {
+        texels[i] = palette[(indices >> (i * 2)) & 3];
+    }
+}
+
+/// Decodes a BC3 alpha block into the alpha channel of 16 texels
+void DecodeAlphaBlock(const u8* block, std::array<std::array<u8, 4>, 16>& texels) {
+    const u32 alpha0 = block[0];
+    const u32 alpha1 = block[1];
+    u64 indices = 0;
+    std::memcpy(&indices, block + 2, 6);
+    for (u32 i = 0; i < 16; ++i) {
+        const u32 index = static_cast<u32>(indices >> (i * 3)) & 7;
+        u32 alpha;
+        if (index < 2) {
+            alpha = index == 0 ? alpha0 : alpha1;
+        } else if (alpha0 > alpha1) {
+            alpha = ((8 - index) * alpha0 + (index - 1) * alpha1) / 7;
+        } else if (index < 6) {
+            alpha = ((6 - index) * alpha0 + (index - 1) * alpha1) / 5;
+        } else {
+            alpha = index == 6 ? 0 : 255;
+        }
+        texels[i][3] = static_cast<u8>(alpha);
+    }
+}
+
+std::vector<u8> Decode(std::span<const u8> blocks, u32 width, u32 height, bool bc3) {
+    const u32 block_size = bc3 ? 16 : 8;
+    const u32 blocks_per_row = Common::DivCeil(width, 4U);
+    std::vector<u8> result(size_t{width} * height * 4);
+    std::array<std::array<u8, 4>, 16> texels;
+    for (u32 y = 0; y < height; y += 4) {
+        for (u32 x = 0; x < width; x += 4) {
+            const u8* block = blocks.data() + ((y / 4) * blocks_per_row + x / 4) * block_size;
+            DecodeColorBlock(block + (bc3 ? 8 : 0), texels);
+            if (bc3) {
+                DecodeAlphaBlock(block, texels);
+            }
+            for (u32 j = 0; j < 4 && y + j < height; ++j) {
+                for (u32 i = 0; i < 4 && x + i < width; ++i) {
+                    std::memcpy(&result[((y + j) * width + x + i) * 4], texels[j * 4 + i].data(),
+                                4);
+                }
+            }
+        }
+    }
+    return result;
+}
+
+/// Peak signal to noise ratio of the color channels, and of alpha when requested
+double PSNR(std::span<const u8> reference, std::span<const u8> decoded, bool with_alpha) {
+    double squared_error = 0.0;
+    size_t samples = 0;
+    for (size_t i = 0; i < reference.size(); ++i) {
+        if (i % 4 == 3 && !with_alpha) {
+            continue;
+        }
+        const double difference =
+            static_cast<double>(reference[i]) - static_cast<double>(decoded[i]);
+        squared_error += difference * difference;
+        ++samples;
+    }
+    if (squared_error == 0.0) {
+        return 99.0;
+    }
+    return 10.0 * std::log10(255.0 * 255.0 * static_cast<double>(samples) / squared_error);
+}
+
+/// Smooth gradients with noise and hard edges, alpha ramps from transparent to opaque
+std::vector<u8> MakeImage(u32 width, u32 height) {
+    std::mt19937 rng{width * height};
+    std::uniform_int_distribution<int> noise{-6, 6};
+    std::vector<u8> image(size_t{width} * height * 4);
+    for (u32 y = 0; y < height; ++y) {
+        for (u32 x = 0; x < width; ++x) {
+            const double fx = static_cast<double>(x) / width;
+            const double fy = static_cast<double>(y) / height;
+            const bool edge = ((x / 37) + (y / 23)) % 5 == 0;
+            const std::array<double, 4> color{
+                edge ? 230.0 : 255.0 * fx,
+                128.0 + 100.0 * std::sin(fx * 12.0 + fy * 7.0),
+                edge ? 20.0 : 255.0 * (1.0 - fy),
+                255.0 * fx * fy * 2.0,
+            };
+            for (u32 channel = 0; channel < 4; ++channel) {
+                const double value = color[channel] + (channel < 3 ? noise(rng) : 0);
+                image[(size_t{y} * width + x) * 4 + channel] =
+                    static_cast<u8>(std::clamp(value, 0.0, 255.0));
+            }
+        }
+    }
+    return image;
+}
+} // Anonymous namespace
+
+TEST_CASE("BCN[Encoders keep the image recognizable]", "[video_core]") {
+    static constexpr u32 width = 93;
+    static constexpr u32 height = 61;
+    const std::vector<u8> image = MakeImage(width, height);
+    const size_t num_blocks = size_t{Common::DivCeil(width, 4U)} * Common::DivCeil(height, 4U);
+
+    // The squared color error of each block, measured on the texels BC1 keeps opaque
+    const auto block_errors = [&](std::span<const u8> decoded) {
+        std::vector<u64> errors(num_blocks);
+        for (u32 y = 0; y < height; ++y) {
+            for (u32 x = 0; x < width; ++x) {
+                const size_t texel = size_t{y} * width + x;
+                if (image[texel * 4 + 3] < 128) {
+                    continue;
+                }
+                u64& error = errors[(y / 4) * Common::DivCeil(width, 4U) + x / 4];
+                for (u32 channel = 0; channel < 3; ++channel) {
+                    const int difference =
+                        int{image[texel * 4 + channel]} - int{decoded[texel * 4 + channel]};
+                    error += static_cast<u64>(difference * difference);
+                }
+            }
+        }
+        return errors;
+    };
+
+    std::vector<u64> reference_errors;
+    for (const EncoderKernel kernel : KERNELS) {
+        if (!IsSupported(kernel)) {
+            continue;
+        }
+        INFO("Kernel " << KernelName(kernel));
+
+        std::vector<u8> bc3(num_blocks * 16);
+        CompressBC3(image, width, height, 1, bc3, kernel);
+        const std::vector<u8> decoded = Decode(bc3, width, height, true);
+        REQUIRE(PSNR(image, decoded, true) > 32.0);
+
+        // BC1 keeps texels with an alpha of at least 128 and makes the rest transparent black
+        std::vector<u8> bc1(num_blocks * 8);
+        CompressBC1(image, width, height, 1, bc1, kernel);
+        const std::vector<u8> decoded_bc1 = Decode(bc1, width, height, false);
+        for (size_t texel = 0; texel < size_t{width} * height; ++texel) {
+            const bool opaque = image[texel * 4 + 3] >= 128;
+            REQUIRE(decoded_bc1[texel * 4 + 3] == (opaque ? 255 : 0));
+            if (!opaque) {
+                REQUIRE(decoded_bc1[texel * 4 + 0] == 0);
+            }
+        }
+
+        // stb_dxt is the reference, the other encoders must not pick worse endpoints than it does
+        const std::vector<u64> errors = block_errors(decoded_bc1);
+        if (kernel == EncoderKernel::Stb) {
+            reference_errors = errors;
+            continue;
+        }
+        REQUIRE(reference_errors.size() == errors.size());
+        u64 total_error = 0;
+        u64 total_reference_error = 0;
+        for (size_t block = 0; block < errors.size(); ++block) {
+            // Allow some blocks to be a little worse, and a rounding step per texel and channel
+            REQUIRE(errors[block] <= reference_errors[block] * 3 / 2 + 48);
+            total_error += errors[block];
+            total_reference_error += reference_errors[block];
+        }
+        REQUIRE(total_error <= total_reference_error);
+    }
+}
+
+TEST_CASE("BCN[Solid blocks are encoded exactly]", "[video_core]") {
+    std::mt19937 rng{0xBC1};
+    for (u32 sample = 0; sample < 256; ++sample) {
+        const u32 color = static_cast<u32>(rng()) | 0xFF000000;
+        std::array<u32, 16> texels;
+        texels.fill(color);
+        std::array<u8, 8> block;
+        CompressBC1(std::span(reinterpret_cast<const u8*>(texels.data()), sizeof(texels)), 4, 4,
+                    1, block, EncoderKernel::SSE);
+        const std::vector<u8> decoded = Decode(block, 4, 4, false);
+        for (u32 channel = 0; channel < 3; ++channel) {
+            const int expected = static_cast<int>((color >> (channel * 8)) & 0xFF);
+            // Interpolating 5 bit endpoints reaches every value within 1
+            REQUIRE(std::abs(expected - int{decoded[channel]}) <= 1);
+        }
+    }
+}
+
+TEST_CASE("BCN[Empty images]", "[video_core]") {
+    // Nothing to encode, and nothing may be written to the empty outputs
+    for (const EncoderKernel kernel : KERNELS) {
+        CompressBC1({}, 0, 0, 1, {}, kernel);
+        CompressBC1({}, 16, 0, 1, {}, kernel);
+        CompressBC3({}, 16, 16, 0, {}, kernel);
+        CompressBC3({}, 0, 16, 1, {}, kernel);
+    }
+}
+
+TEST_CASE("BCN[Benchmark]", "[video_core][.benchmark]") {
+    static constexpr u32 width = 1024;
+    static constexpr u32 height = 1024;
+    const std::vector<u8> image = MakeImage(width, height);
+    const size_t num_blocks = size_t{width / 4} * (height / 4);
+    std::vector<u8> bc1(num_blocks * 8);
+    std::vector<u8> bc3(num_blocks * 16);
+    for (const EncoderKernel kernel : KERNELS) {
+        if (!IsSupported(kernel)) {
+            continue;
+        }
+        const std::string name = KernelName(kernel);
+        BENCHMARK("CompressBC1 " + name + " (1 MTexel)") {
+            CompressBC1(image, width, height, 1, bc1, kernel);
+            return bc1[0];
+        };
+        BENCHMARK("CompressBC3 " + name + " (1 MTexel)") {
+            CompressBC3(image, width, height, 1, bc3, kernel);
+            return bc3[0];
+        };
+        const std::vector<u8> decoded = Decode(bc3, width, height, true);
+        WARN("BC3 " << name << " color PSNR " << PSNR(image, decoded, false) << " dB, alpha PSNR "
+                    << PSNR(image, decoded, true) << " dB");
+    }
+}
@@ -0,0 +1,186 @@
+// SPDX-FileCopyrightText: Copyright 2026 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <bc_decoder.h>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/alignment.h"
+#include "common/common_types.h"
+#include "common/div_ceil.h"
+#include "video_core/texture_cache/decode_bc.h"
+
+namespace {
+using VideoCommon::BufferImageCopy;
+using VideoCommon::Extent3D;
+using VideoCore::Surface::PixelFormat;
+
+struct Format {
+    PixelFormat format;
+    const char* name;
+    u32 block_size;
+};
+
+constexpr std::array<Format, 7> FORMATS{{
+    {PixelFormat::BC1_RGBA_UNORM, "BC1", 8},
+    {PixelFormat::BC2_UNORM, "BC2", 16},
+    {PixelFormat::BC3_UNORM, "BC3", 16},
+    {PixelFormat::BC4_SNORM, "BC4", 8},
+    {PixelFormat::BC5_UNORM, "BC5", 16},
+    {PixelFormat::BC6H_SFLOAT, "BC6H", 16},
+    {PixelFormat::BC7_UNORM, "BC7", 16},
+}};
+
+/// Decodes a single block with bc_decoder
+void ReferenceDecodeBlock(PixelFormat format, const u8* src, u8* dst, u32 x, u32 y, u32 width,
+                          u32 height) {
+    switch (format) {
+    case PixelFormat::BC1_RGBA_UNORM:
+        return bcn::DecodeBc1(src, dst, x, y, width, height);
+    case PixelFormat::BC2_UNORM:
+        return bcn::DecodeBc2(src, dst, x, y, width, height);
+    case PixelFormat::BC3_UNORM:
+        return bcn::DecodeBc3(src, dst, x, y, width, height);
+    case PixelFormat::BC4_SNORM:
+        return bcn::DecodeBc4(src, dst, x, y, width, height, true);
+    case PixelFormat::BC5_UNORM:
+        return bcn::DecodeBc5(src, dst, x, y, width, height, false);
+    case PixelFormat::BC6H_SFLOAT:
+        return bcn::DecodeBc6(src, dst, x, y, width, height, true);
+    case PixelFormat::BC7_UNORM:
+        return bcn::DecodeBc7(src, dst, x, y, width, height);
+    default:
+        return;
+    }
+}
+
+/// Builds the copies of a mipmapped image laid out as the texture cache unswizzles it
+std::vector<BufferImageCopy> MakeCopies(const Format& format, Extent3D size, u32 num_layers,
+                                        u32 num_levels, size_t& input_size) {
+    std::vector<BufferImageCopy> copies;
+    input_size = 0;
+    for (u32 level = 0; level < num_levels; ++level) {
+        const Extent3D level_size{
+            .width = std::max(size.width >> level, 1U),
+            .height = std::max(size.height >> level, 1U),
+            .depth = std::max(size.depth >> level, 1U),
+        };
+        const size_t level_bytes = size_t{Common::DivCeil(level_size.width, 4U)} *
+                                   Common::DivCeil(level_size.height, 4U) * level_size.depth *
+                                   num_layers * format.block_size;
+        copies.push_back({
+            .buffer_offset = input_size,
+            .buffer_size = level_bytes,
+            .buffer_row_length = Common::AlignUp(level_size.width, 4U),
+            .buffer_image_height = Common::AlignUp(level_size.height, 4U),
+            .image_subresource =
+                {
+                    .base_level = static_cast<s32>(level),
+                    .base_layer = 0,
+                    .num_layers = static_cast<s32>(num_layers),
+                },
+            .image_offset = {0, 0, 0},
+            .image_extent = level_size,
+        });
+        input_size += level_bytes;
+    }
+    return copies;
+}
+
+std::vector<u8> RandomBytes(size_t size) {
+    std::mt19937 rng{static_cast<u32>(size)};
+    std::vector<u8> result(size);
+    for (u8& value : result) {
+        value = static_cast<u8>(rng());
+    }
+    return result;
+}
+
+struct Image {
+    Extent3D size;
+    u32 num_layers;
+    u32 num_levels;
+};
+
+constexpr std::array<Image, 6> IMAGES{{
+    {{1, 1, 1}, 1, 1},
+    {{2, 14, 1}, 1, 1},
+    {{37, 23, 1}, 3, 4},
+    {{256, 256, 1}, 1, 9},
+    {{128, 64, 1}, 6, 8},
+    {{64, 32, 8}, 1, 4},
+}};
+} // Anonymous namespace
+
+TEST_CASE("DecodeBC[Parallel decode matches per-block decode]", "[video_core]") {
+    for (const Format& format : FORMATS) {
+        const u32 out_bpp = VideoCommon::ConvertedBytesPerBlock(format.format);
+        for (const Image& image : IMAGES) {
+            size_t input_size;
+            std::vector<BufferImageCopy> copies =
+                MakeCopies(format, image.size, image.num_layers, image.num_levels, input_size);
+            const std::vector<u8> input = RandomBytes(input_size);
+
+            // Every level, layer and slice is decoded into tightly packed rows
+            std::vector<u8> expected;
+            for (const BufferImageCopy& copy : copies) {
+                const u32 width = copy.image_extent.width;
+                const u32 height = copy.image_extent.height;
+                const u32 num_slices = image.num_layers * copy.image_extent.depth;
+                const size_t slice_bytes = size_t{width} * height * out_bpp;
+                const size_t level_offset = expected.size();
+                expected.resize(level_offset + slice_bytes * num_slices);
+                const u8* src = input.data() + copy.buffer_offset;
+                for (u32 slice = 0; slice < num_slices; ++slice) {
+                    for (u32 y = 0; y < height; y += 4) {
+                        for (u32 x = 0; x < width; x += 4) {
+                            u8* const dst = expected.data() + level_offset + slice * slice_bytes +
+                                            (size_t{y} * width + x) * out_bpp;
+                            ReferenceDecodeBlock(format.format, src, dst, x, y, width, height);
+                            src += format.block_size;
+                        }
+                    }
+                }
+            }
+
+            std::vector<u8> output(expected.size());
+            const size_t decoded_size =
+                VideoCommon::DecompressBCn(input, output, copies, format.format);
+            REQUIRE(decoded_size == expected.size());
+            REQUIRE(output == expected);
+            for (size_t level = 1; level < copies.size(); ++level) {
+                const BufferImageCopy& previous = copies[level - 1];
+                REQUIRE(copies[level].buffer_offset ==
+                        previous.buffer_offset + size_t{previous.image_extent.width} *
+                                                     previous.image_extent.height *
+                                                     previous.image_extent.depth *
+                                                     image.num_layers * out_bpp);
+            }
+        }
+    }
+}
+
+TEST_CASE("DecodeBC[Benchmark]", "[video_core][.benchmark]") {
+    for (const u32 resolution : {256U, 1024U, 2048U}) {
+        for (const Format& format : FORMATS) {
+            size_t input_size;
+            const std::vector<BufferImageCopy> base_copies =
+                MakeCopies(format, {resolution, resolution, 1}, 1, 1, input_size);
+            const std::vector<u8> input = RandomBytes(input_size);
+            std::vector<u8> output(size_t{resolution} * resolution *
+                                   VideoCommon::ConvertedBytesPerBlock(format.format));
+            BENCHMARK(std::string{"Decode "} + format.name + " " + std::to_string(resolution) +
+                      "x" + std::to_string(resolution)) {
+                std::vector<BufferImageCopy> copies = base_copies;
+                return VideoCommon::DecompressBCn(input, output, copies, format.format);
+            };
+        }
+    }
+}
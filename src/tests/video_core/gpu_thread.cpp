@@ -0,0 +1,93 @@
+// SPDX-FileCopyrightText: Copyright 2026 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <variant>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "video_core/gpu.h"
+#include "video_core/gpu_thread.h"
+
+namespace {
+using VideoCommon::GPUThread::CommandDataContainer;
+using VideoCommon::GPUThread::CommandQueue;
+using VideoCommon::GPUThread::FlushRegionCommand;
+
+/// Pushes commands from several producers and checks they are consumed in fence order
+void RunProducersAndConsumer(u32 spin_iterations) {
+    static constexpr u64 NUM_PRODUCERS = 3;
+    static constexpr u64 COMMANDS_PER_PRODUCER = 3 * CommandQueue::CAPACITY;
+    static constexpr u64 NUM_COMMANDS = NUM_PRODUCERS * COMMANDS_PER_PRODUCER;
+
+    const auto queue = std::make_unique<CommandQueue>();
+    std::mutex write_lock;
+    u64 last_fence = 0;
+
+    std::vector<u64> fences;
+    fences.reserve(NUM_COMMANDS);
+    bool ordered_data = true;
+    std::jthread consumer([&](std::stop_token stop_token) {
+        CommandDataContainer command;
+        while (fences.size() < NUM_COMMANDS && queue->Wait(stop_token, spin_iterations)) {
+            while (queue->TryPop(command)) {
+                const auto* const flush = std::get_if<FlushRegionCommand>(&command.data);
+                ordered_data &= flush != nullptr && flush->addr == command.fence;
+                fences.push_back(command.fence);
+            }
+        }
+    });
+    {
+        std::vector<std::jthread> producers;
+        for (u64 producer = 0; producer < NUM_PRODUCERS; ++producer) {
+            producers.emplace_back([&](std::stop_token stop_token) {
+                for (u64 i = 0; i < COMMANDS_PER_PRODUCER; ++i) {
+                    std::scoped_lock lock{write_lock};
+                    const u64 fence = ++last_fence;
+                    queue->Push(CommandDataContainer(FlushRegionCommand(fence, 1), fence, false),
+                                stop_token);
+                }
+            });
+        }
+        // Destroying a running jthread requests a stop, which makes full pushes give up
+        for (std::jthread& producer : producers) {
+            producer.join();
+        }
+    }
+    consumer.join();
+
+    REQUIRE(ordered_data);
+    REQUIRE(fences.size() == NUM_COMMANDS);
+    for (u64 i = 0; i < NUM_COMMANDS; ++i) {
+        REQUIRE(fences[i] == i + 1);
+    }
+    REQUIRE(queue->Size() == 0);
+}
+} // Anonymous namespace
+
+TEST_CASE("GPUThread[Commands are consumed in order while parking]", "[video_core]") {
+    RunProducersAndConsumer(0);
+}
+
+TEST_CASE("GPUThread[Commands are consumed in order while spinning]", "[video_core]") {
+    RunProducersAndConsumer(1024);
+}
+
+TEST_CASE("GPUThread[Waiting consumer is stopped]", "[video_core]") {
+    const auto queue = std::make_unique<CommandQueue>();
+    bool woken = true;
+    std::jthread consumer([&](std::stop_token stop_token) { woken = queue->Wait(stop_token, 16); });
+    // The park is counted under the park mutex right before waiting, a stop requested from then on
+    // has to wake the consumer
+    while (queue->NumParks() == 0) {
+        std::this_thread::yield();
+    }
+    consumer.request_stop();
+    consumer.join();
+    REQUIRE(!woken);
+    REQUIRE(queue->NumParks() == 1);
+}
@@ -0,0 +1,412 @@
+// SPDX-FileCopyrightText: Copyright 2026 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "core/core.h"
+#include "video_core/engines/maxwell_3d.h"
+#include "video_core/host1x/host1x.h"
+#include "video_core/macro/macro.h"
+#include "video_core/macro/macro_interpreter.h"
+#include "video_core/macro/macro_profiler.h"
+#include "video_core/macro/macro_threaded_interpreter.h"
+#ifdef ARCHITECTURE_x86_64
+#include "video_core/macro/macro_jit_x64.h"
+#endif
+
+namespace {
+using Tegra::Engines::Maxwell3D;
+using Tegra::Macro::ALUOperation;
+using Tegra::Macro::BranchCondition;
+using Tegra::Macro::Opcode;
+using Tegra::Macro::Operation;
+using Tegra::Macro::ResultOperation;
+
+// Macros only send to the shadow scratch registers, writes to them have no side effects
+constexpr u32 SCRATCH_METHOD = static_cast<u32>(MAXWELL3D_REG_INDEX(shadow_scratch));
+constexpr u32 EPILOGUE_METHOD = SCRATCH_METHOD + 0xf0;
+constexpr u32 METHOD_INCREMENT = 1 << 12;
+
+// Registers the generated bodies never write to
+constexpr u32 LOOP_REGISTER = 6;
+constexpr u32 SHIFT_REGISTER = 7;
+
+constexpr std::array ALU_OPERATIONS{
+    ALUOperation::Add, ALUOperation::AddWithCarry, ALUOperation::Subtract,
+    ALUOperation::SubtractWithBorrow, ALUOperation::Xor, ALUOperation::Or,
+    ALUOperation::And, ALUOperation::AndNot, ALUOperation::Nand,
+};
+
+struct RandomMacro {
+    std::vector<u32> code;
+    std::vector<u32> parameters;
+};
+
+Opcode MakeOpcode(Operation operation, ResultOperation result, u32 dst, u32 src_a) {
+    Opcode opcode{};
+    opcode.operation.Assign(operation);
+    opcode.result_operation.Assign(result);
+    opcode.dst.Assign(dst);
+    opcode.src_a.Assign(src_a);
+    return opcode;
+}
+
+u32 Alu(ALUOperation alu, ResultOperation result, u32 dst, u32 src_a, u32 src_b) {
+    Opcode opcode = MakeOpcode(Operation::ALU, result, dst, src_a);
+    opcode.src_b.Assign(src_b);
+    opcode.alu_operation.Assign(alu);
+    return opcode.raw;
+}
+
+u32 Immediate(Operation operation, ResultOperation result, u32 dst, u32 src_a, s32 immediate) {
+    Opcode opcode = MakeOpcode(operation, result, dst, src_a);
+    opcode.immediate.Assign(immediate);
+    return opcode.raw;
+}
+
+u32 Bitfield(Operation operation, ResultOperation result, u32 dst, u32 src_a, u32 src_b,
+             u32 src_bit, u32 size, u32 dst_bit) {
+    Opcode opcode = MakeOpcode(operation, result, dst, src_a);
+    opcode.src_b.Assign(src_b);
+    opcode.bf_src_bit.Assign(src_bit);
+    opcode.bf_size.Assign(size);
+    opcode.bf_dst_bit.Assign(dst_bit);
+    return opcode.raw;
+}
+
+u32 Branch(BranchCondition condition, bool annul, u32 src_a, s32 offset) {
+    Opcode opcode{};
+    opcode.operation.Assign(Operation::Branch);
+    opcode.branch_condition.Assign(condition);
+    opcode.branch_annul.Assign(annul ? 1 : 0);
+    opcode.src_a.Assign(src_a);
+    opcode.immediate.Assign(offset);
+    return opcode.raw;
+}
+
+u32 WithExit(u32 raw) {
+    Opcode opcode{raw};
+    opcode.is_exit.Assign(1);
+    return opcode.raw;
+}
+
+/**
+ * Generates well formed macros covering every operation and result operation.
+ * Parameters are only fetched in a branch-free prologue so the number of parameters is exact,
+ * methods are only set to scratch registers, branches are forward except for a counted loop and
+ * delay slots never hold branches or exits.
+ */
+class MacroGenerator {
+public:
+    explicit MacroGenerator(u32 seed) : rng{seed} {}
+
+    RandomMacro Generate() {
+        RandomMacro macro;
+        code = &macro.code;
+        const u32 num_fetches = Random(1, 6);
+        const u32 body_size = Random(4, 32);
+
+        Push(Immediate(Operation::AddImmediate, ResultOperation::MoveAndSetMethod, 0, 0,
+                       ScratchMethod()));
+        Push(Immediate(Operation::AddImmediate, ResultOperation::Move, SHIFT_REGISTER, 0,
+                       static_cast<s32>(Random(0, 31))));
+        Push(Immediate(Operation::AddImmediate, ResultOperation::Move, LOOP_REGISTER, 0,
+                       static_cast<s32>(Random(1, 3))));
+        for (u32 i = 0; i < num_fetches; ++i) {
+            PushFetch();
+        }
+
+        const u32 body_start = Pc();
+        const u32 loop_pc = body_start + body_size;
+        bool in_delay_slot = false;
+        bool after_set_method = false;
+        for (u32 pc = body_start; pc < loop_pc; ++pc) {
+            // The JIT drops a method move when the next result operation reads as another one,
+            // which branch encodings can do. The loop counter is never decremented in a delay slot.
+            const u32 kind = Random(0, 99);
+            if (kind < 10 && !in_delay_slot && !after_set_method && pc + 1 < loop_pc) {
+                const bool annul = Random(0, 1) != 0;
+                const auto condition =
+                    Random(0, 1) != 0 ? BranchCondition::Zero : BranchCondition::NotZero;
+                const u32 target = Random(pc + 1, loop_pc);
+                Push(Branch(condition, annul, Random(0, 7), static_cast<s32>(target - pc)));
+                in_delay_slot = !annul;
+                after_set_method = false;
+            } else if (kind < 18 && !after_set_method) {
+                const auto result = Random(0, 1) != 0 ? ResultOperation::MoveAndSetMethodSend
+                                                      : ResultOperation::MoveAndSetMethod;
+                Push(Immediate(Operation::AddImmediate, result, Random(0, 5), 0, ScratchMethod()));
+                in_delay_slot = false;
+                after_set_method = true;
+            } else {
+                const bool exit = kind == 99 && !in_delay_slot;
+                Push(exit ? WithExit(PlainInstruction()) : PlainInstruction());
+                in_delay_slot = exit;
+                after_set_method = false;
+            }
+        }
+
+        Push(Immediate(Operation::AddImmediate, ResultOperation::Move, LOOP_REGISTER,
+                       LOOP_REGISTER, -1));
+        Push(Branch(BranchCondition::NotZero, Random(0, 1) != 0, LOOP_REGISTER,
+                    static_cast<s32>(body_start) - static_cast<s32>(Pc())));
+        Push(Immediate(Operation::AddImmediate, ResultOperation::Move, 0, 0, 0));
+
+        // Send every register so all engines can be compared through the Maxwell3D registers
+        Push(Immediate(Operation::AddImmediate, ResultOperation::MoveAndSetMethod, 0, 0,
+                       static_cast<s32>(EPILOGUE_METHOD | METHOD_INCREMENT)));
+        for (u32 reg = 1; reg < Tegra::Macro::NUM_MACRO_REGISTERS; ++reg) {
+            const u32 send = Alu(ALUOperation::Add, ResultOperation::MoveAndSend, 0, reg, 0);
+            Push(reg + 1 == Tegra::Macro::NUM_MACRO_REGISTERS ? WithExit(send) : send);
+        }
+        Push(Immediate(Operation::AddImmediate, ResultOperation::Move, 0, 0, 0));
+
+        macro.parameters.resize(num_fetches + 1);
+        std::ranges::generate(macro.parameters, [this] { return static_cast<u32>(rng()); });
+        return macro;
+    }
+
+private:
+    u32 Random(u32 min, u32 max) {
+        return std::uniform_int_distribution<u32>{min, max}(rng);
+    }
+
+    ALUOperation RandomAluOperation() {
+        return ALU_OPERATIONS[Random(0, static_cast<u32>(ALU_OPERATIONS.size()) - 1)];
+    }
+
+    s32 ScratchMethod() {
+        return static_cast<s32>((SCRATCH_METHOD + Random(0, 0x3f)) |
+                                (Random(0, 1) * METHOD_INCREMENT));
+    }
+
+    u32 Pc() const {
+        return static_cast<u32>(code->size());
+    }
+
+    void Push(u32 raw) {
+        code->push_back(raw);
+    }
+
+    void PushFetch() {
+        const u32 dst = Random(0, 5);
+        switch (Random(0, 5)) {
+        case 0:
+            return Push(Immediate(Operation::AddImmediate, ResultOperation::IgnoreAndFetch, dst,
+                                  Random(0, 7), static_cast<s32>(rng() & 0x1ffff)));
+        case 1:
+            return Push(Alu(RandomAluOperation(), ResultOperation::IgnoreAndFetch, dst,
+                            Random(0, 7), Random(0, 7)));
+        case 2:
+            return Push(Alu(RandomAluOperation(), ResultOperation::FetchAndSend, dst, Random(0, 7),
+                            Random(0, 7)));
+        case 3:
+            return Push(Immediate(Operation::AddImmediate, ResultOperation::FetchAndSetMethod, dst,
+                                  0, ScratchMethod()));
+        case 4:
+            return Push(Immediate(Operation::AddImmediate,
+                                  ResultOperation::MoveAndSetMethodFetchAndSend, dst, 0,
+                                  ScratchMethod()));
+        default:
+            return Push(Bitfield(Operation::ExtractInsert, ResultOperation::IgnoreAndFetch, dst,
+                                 Random(0, 7), Random(0, 7), Random(0, 31), Random(0, 31),
+                                 Random(0, 31)));
+        }
+    }
+
+    /// Returns an instruction that writes a general purpose register and may send it
+    u32 PlainInstruction() {
+        const u32 dst = Random(0, 5);
+        const ResultOperation result =
+            Random(0, 2) == 0 ? ResultOperation::MoveAndSend : ResultOperation::Move;
+        switch (Random(0, 6)) {
+        case 0:
+        case 1:
+            return Alu(RandomAluOperation(), result, dst, Random(0, 7), Random(0, 7));
+        case 2:
+            return Immediate(Operation::AddImmediate, result, dst, Random(0, 7),
+                             static_cast<s32>(Random(0, 7)) - 3);
+        case 3:
+            return Bitfield(Operation::ExtractInsert, result, dst, Random(0, 7), Random(0, 7),
+                            Random(0, 31), Random(0, 31), Random(0, 31));
+        case 4:
+            // Shift amounts come from a register that always holds a value below 32
+            return Bitfield(Operation::ExtractShiftLeftImmediate, result, dst,
+                            Random(0, 1) * SHIFT_REGISTER, Random(0, 7), 0, Random(0, 31),
+                            Random(0, 31));
+        case 5:
+            return Bitfield(Operation::ExtractShiftLeftRegister, result, dst,
+                            Random(0, 1) * SHIFT_REGISTER, Random(0, 7), Random(0, 31),
+                            Random(0, 31), 0);
+        default: {
+            const u32 num_regs = static_cast<u32>(Maxwell3D::Regs::NUM_REGS);
+            return Immediate(Operation::Read, result, dst, 0,
+                             static_cast<s32>(Random(0, num_regs - 1)));
+        }
+        }
+    }
+
+    std::mt19937 rng;
+    std::vector<u32>* code{};
+};
+
+enum class EngineType {
+    Interpreter,
+    ThreadedInterpreter,
+#ifdef ARCHITECTURE_x86_64
+    JIT,
+#endif
+};
+
+constexpr std::array ENGINE_TYPES{
+    EngineType::Interpreter,
+    EngineType::ThreadedInterpreter,
+#ifdef ARCHITECTURE_x86_64
+    EngineType::JIT,
+#endif
+};
+
+constexpr std::array<std::string_view, 3> ENGINE_NAMES{"interpreter", "threaded interpreter",
+                                                       "JIT"};
+
+std::unique_ptr<Tegra::MacroEngine> MakeEngine(EngineType type, Maxwell3D& maxwell3d) {
+    switch (type) {
+    case EngineType::Interpreter:
+        return std::make_unique<Tegra::MacroInterpreter>(maxwell3d);
+    case EngineType::ThreadedInterpreter:
+        return std::make_unique<Tegra::MacroThreadedInterpreter>(maxwell3d);
+#ifdef ARCHITECTURE_x86_64
+    case EngineType::JIT:
+        return std::make_unique<Tegra::MacroJITx64>(maxwell3d);
+#endif
+    }
+    return nullptr;
+}
+
+/// One Maxwell3D per macro engine, so the registers written by each engine can be compared
+class MacroEngines {
+public:
+    MacroEngines() {
+        system.Initialize();
+        host1x = std::make_unique<Tegra::Host1x::Host1x>(system);
+        for (size_t i = 0; i < ENGINE_TYPES.size(); ++i) {
+            maxwell3ds.push_back(std::make_unique<Maxwell3D>(system, host1x->GMMU()));
+        }
+    }
+
+    /// Uploads the macros to every engine as methods 0, 2, 4...
+    void Upload(const std::vector<RandomMacro>& macros) {
+        engines.clear();
+        for (size_t i = 0; i < ENGINE_TYPES.size(); ++i) {
+            engines.push_back(MakeEngine(ENGINE_TYPES[i], *maxwell3ds[i]));
+            for (u32 index = 0; index < macros.size(); ++index) {
+                for (const u32 word : macros[index].code) {
+                    engines[i]->AddCode(index * 2, word);
+                }
+            }
+        }
+    }
+
+    void Execute(size_t engine, u32 index, const std::vector<u32>& parameters) {
+        engines[engine]->Execute(index * 2, parameters);
+    }
+
+    const Maxwell3D::Regs& Registers(size_t engine) const {
+        return maxwell3ds[engine]->regs;
+    }
+
+private:
+    Core::System system;
+    std::unique_ptr<Tegra::Host1x::Host1x> host1x;
+    std::vector<std::unique_ptr<Maxwell3D>> maxwell3ds;
+    std::vector<std::unique_ptr<Tegra::MacroEngine>> engines;
+};
+
+std::vector<RandomMacro> GenerateMacros(u32 count) {
+    std::vector<RandomMacro> macros;
+    for (u32 seed = 0; seed < count; ++seed) {
+        macros.push_back(MacroGenerator{seed}.Generate());
+    }
+    return macros;
+}
+} // Anonymous namespace
+
+TEST_CASE("MacroEngine[Random macros match the interpreter]", "[video_core]") {
+    const std::vector<RandomMacro> macros = GenerateMacros(512);
+    MacroEngines engines;
+    engines.Upload(macros);
+    for (u32 index = 0; index < macros.size(); ++index) {
+        INFO("Macro " << index);
+        for (size_t engine = 0; engine < ENGINE_TYPES.size(); ++engine) {
+            engines.Execute(engine, index, macros[index].parameters);
+        }
+        const auto& expected = engines.Registers(0).reg_array;
+        for (size_t engine = 1; engine < ENGINE_TYPES.size(); ++engine) {
+            INFO("Engine " << ENGINE_NAMES[engine]);
+            REQUIRE(std::ranges::equal(engines.Registers(engine).reg_array, expected));
+        }
+    }
+}
+
+TEST_CASE("MacroProfiler[Report is sorted by host time and flags hot LLE macros]",
+          "[video_core]") {
+    using Tegra::MacroBackend;
+    Tegra::MacroProfiler profiler;
+    profiler.RecordCompile(1, 12, 300);
+    profiler.RecordExecution(1, MacroBackend::JIT, 4, 400);
+    profiler.RecordExecution(1, MacroBackend::JIT, 6, 500);
+    profiler.RecordCompile(2, 30, 100);
+    profiler.RecordExecution(2, MacroBackend::HLE, 8, 5000);
+    // Below the hot share of the macro time
+    profiler.RecordCompile(3, 5, 100);
+    profiler.RecordExecution(3, MacroBackend::Interpreter, 1, 10);
+    // Compiled and never executed
+    profiler.RecordCompile(4, 5, 100);
+
+    const std::vector<Tegra::MacroProfiler::Entry> report = profiler.Report();
+    REQUIRE(report.size() == 4);
+    REQUIRE(report[0].hash == 2);
+    REQUIRE(!report[0].hle_candidate);
+    REQUIRE(report[1].hash == 1);
+    REQUIRE(report[1].hle_candidate);
+    REQUIRE(report[1].backend == MacroBackend::JIT);
+    REQUIRE(report[1].calls == 2);
+    REQUIRE(report[1].arguments == 10);
+    REQUIRE(report[1].host_ns == 900);
+    REQUIRE(report[1].compile_ns == 300);
+    REQUIRE(report[1].code_size == 12);
+    REQUIRE(report[2].hash == 3);
+    REQUIRE(!report[2].hle_candidate);
+    REQUIRE(report[3].hash == 4);
+    REQUIRE(report[3].calls == 0);
+    REQUIRE(!report[3].hle_candidate);
+}
+
+TEST_CASE("MacroEngine[Benchmark]", "[video_core][.benchmark]") {
+    const std::vector<RandomMacro> macros = GenerateMacros(128);
+    MacroEngines engines;
+    engines.Upload(macros);
+    const auto execute_all = [&](size_t engine) {
+        for (u32 index = 0; index < macros.size(); ++index) {
+            engines.Execute(engine, index, macros[index].parameters);
+        }
+        return engines.Registers(engine).reg_array[EPILOGUE_METHOD];
+    };
+    for (size_t engine = 0; engine < ENGINE_TYPES.size(); ++engine) {
+        // Macros are compiled on their first execution
+        execute_all(engine);
+        BENCHMARK("Execute random macros (" + std::string{ENGINE_NAMES[engine]} + ")") {
+            return execute_all(engine);
+        };
+    }
+}
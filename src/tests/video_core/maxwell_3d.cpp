@@ -0,0 +1,208 @@
+// SPDX-FileCopyrightText: Copyright 2026 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "core/core.h"
+#include "video_core/engines/maxwell_3d.h"
+#include "video_core/host1x/host1x.h"
+
+namespace {
+using Tegra::Engines::Maxwell3D;
+
+// Writing it only switches the shadow RAM mode, so it can be executed without a rasterizer
+constexpr u32 SHADOW_RAM_CONTROL = static_cast<u32>(MAXWELL3D_REG_INDEX(shadow_ram_control));
+constexpr u32 MACRO_REGISTERS_START = 0xE00;
+constexpr u32 NUM_SHADOW_RAM_MODES = 4;
+
+/// A methods command of a pushbuffer, as seen by the engine bound to its subchannel
+struct Command {
+    u32 method;
+    bool incrementing;
+    std::vector<u32> values;
+};
+
+/// Feeds commands the way DmaPusher does, per register or with passive runs as blocks
+enum class Dispatch {
+    PerRegister,
+    Block,
+};
+
+void Execute(Maxwell3D& maxwell3d, Dispatch dispatch, const Command& command) {
+    const u32* const values = command.values.data();
+    const u32 amount = static_cast<u32>(command.values.size());
+    if (!command.incrementing && dispatch == Dispatch::Block) {
+        maxwell3d.ConsumeSink();
+        maxwell3d.CallMultiMethod(command.method, values, amount, amount);
+        return;
+    }
+    for (u32 i = 0; i < amount;) {
+        const u32 method = command.incrementing ? command.method + i : command.method;
+        if (dispatch == Dispatch::Block && command.incrementing) {
+            const u32 num_written = maxwell3d.WritePassiveRegisters(method, values + i, amount - i);
+            if (num_written != 0) {
+                i += num_written;
+                continue;
+            }
+        }
+        if (dispatch == Dispatch::PerRegister && !maxwell3d.execution_mask[method]) {
+            maxwell3d.method_sink.emplace_back(method, values[i]);
+        } else {
+            maxwell3d.ConsumeSink();
+            maxwell3d.CallMethod(method, values[i], i + 1 == amount);
+        }
+        ++i;
+    }
+}
+
+/// Generates state updates, mostly rewriting registers with the values they already hold
+class CommandGenerator {
+public:
+    explicit CommandGenerator(u32 seed, const Maxwell3D& maxwell3d_)
+        : random{seed}, maxwell3d{maxwell3d_} {}
+
+    Command Generate() {
+        Command command{};
+        const u32 amount = std::uniform_int_distribution<u32>{1, 48}(random);
+        command.incrementing = random() % 4 != 0;
+        do {
+            if (random() % 3 == 0) {
+                // Runs around the shadow RAM control, switching modes in the middle of them
+                command.method = SHADOW_RAM_CONTROL - std::min(SHADOW_RAM_CONTROL, amount / 2);
+            } else {
+                command.method = static_cast<u32>(random() % MACRO_REGISTERS_START);
+            }
+        } while (!IsSafe(command.method, command.incrementing ? amount : 1));
+        for (u32 i = 0; i < amount; ++i) {
+            const u32 method = command.incrementing ? command.method + i : command.method;
+            command.values.push_back(GenerateValue(method));
+        }
+        return command;
+    }
+
+private:
+    bool IsSafe(u32 method, u32 amount) const {
+        if (method + amount > MACRO_REGISTERS_START) {
+            return false;
+        }
+        for (u32 i = method; i < method + amount; ++i) {
+            if (maxwell3d.execution_mask[i] && i != SHADOW_RAM_CONTROL) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    u32 GenerateValue(u32 method) {
+        if (method == SHADOW_RAM_CONTROL) {
+            return static_cast<u32>(random() % NUM_SHADOW_RAM_MODES);
+        }
+        switch (random() % 4) {
+        case 0:
+            return static_cast<u32>(random());
+        case 1:
+            return static_cast<u32>(random() % 4);
+        default:
+            return maxwell3d.regs.reg_array[method];
+        }
+    }
+
+    std::mt19937 random;
+    const Maxwell3D& maxwell3d;
+};
+
+/// One Maxwell3D per dispatch, with dirty tables spreading the registers over many flags
+class Engines {
+public:
+    Engines() {
+        system.Initialize();
+        host1x = std::make_unique<Tegra::Host1x::Host1x>(system);
+        for (Maxwell3D*& maxwell3d : maxwell3ds) {
+            owned.push_back(std::make_unique<Maxwell3D>(system, host1x->GMMU()));
+            maxwell3d = owned.back().get();
+            for (u32 method = 0; method < Maxwell3D::Regs::NUM_REGS; ++method) {
+                maxwell3d->dirty.tables[0][method] = static_cast<u8>(method % 251);
+                maxwell3d->dirty.tables[1][method] = static_cast<u8>(method / 13 % 251);
+            }
+            maxwell3d->dirty.flags.reset();
+        }
+    }
+
+    Maxwell3D& operator[](Dispatch dispatch) {
+        return *maxwell3ds[static_cast<size_t>(dispatch)];
+    }
+
+private:
+    Core::System system;
+    std::unique_ptr<Tegra::Host1x::Host1x> host1x;
+    std::vector<std::unique_ptr<Maxwell3D>> owned;
+    std::array<Maxwell3D*, 2> maxwell3ds{};
+};
+
+std::vector<Command> GenerateCommands(const Maxwell3D& maxwell3d, u32 count) {
+    CommandGenerator generator{1234, maxwell3d};
+    std::vector<Command> commands;
+    for (u32 i = 0; i < count; ++i) {
+        commands.push_back(generator.Generate());
+    }
+    return commands;
+}
+} // Anonymous namespace
+
+TEST_CASE("Maxwell3D[Passive register blocks match per register writes]", "[video_core]") {
+    Engines engines;
+    Maxwell3D& reference = engines[Dispatch::PerRegister];
+    Maxwell3D& block = engines[Dispatch::Block];
+    CommandGenerator generator{42, reference};
+    for (u32 index = 0; index < 4096; ++index) {
+        const Command command = generator.Generate();
+        INFO("Command " << index << " method " << command.method << " amount "
+                        << command.values.size() << " incrementing " << command.incrementing);
+        Execute(reference, Dispatch::PerRegister, command);
+        Execute(block, Dispatch::Block, command);
+        reference.ConsumeSink();
+        block.ConsumeSink();
+
+        REQUIRE(std::ranges::equal(block.regs.reg_array, reference.regs.reg_array));
+        REQUIRE(std::ranges::equal(block.shadow_state.reg_array, reference.shadow_state.reg_array));
+        REQUIRE(block.dirty.flags == reference.dirty.flags);
+        if (index % 16 == 0) {
+            // Renderers clear the flags they consumed between draws
+            reference.dirty.flags.reset();
+            block.dirty.flags.reset();
+        }
+    }
+}
+
+TEST_CASE("Maxwell3D[Benchmark]", "[video_core][.benchmark]") {
+    Engines engines;
+    const std::vector<Command> commands = GenerateCommands(engines[Dispatch::PerRegister], 4096);
+    u64 num_methods = 0;
+    for (const Command& command : commands) {
+        num_methods += command.values.size();
+    }
+    const auto replay = [&](Dispatch dispatch) {
+        Maxwell3D& maxwell3d = engines[dispatch];
+        for (const Command& command : commands) {
+            Execute(maxwell3d, dispatch, command);
+        }
+        maxwell3d.ConsumeSink();
+        maxwell3d.dirty.flags.reset();
+        return maxwell3d.regs.reg_array[commands.back().method];
+    };
+    BENCHMARK("Replay " + std::to_string(num_methods) + " methods (per register)") {
+        return replay(Dispatch::PerRegister);
+    };
+    BENCHMARK("Replay " + std::to_string(num_methods) + " methods (block)") {
+        return replay(Dispatch::Block);
+    };
+}
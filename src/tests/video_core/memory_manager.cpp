@@ -0,0 +1,181 @@
+// SPDX-FileCopyrightText: Copyright 2026 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <random>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "common/literals.h"
+#include "core/core.h"
+#include "core/device_memory.h"
+#include "video_core/host1x/gpu_device_memory_manager.h"
+#include "video_core/memory_manager.h"
+#include "video_core/rasterizer_interface.h"
+
+using namespace Common::Literals;
+
+namespace {
+
+constexpr u64 ADDRESS_SPACE_BITS = 32;
+constexpr u64 BIG_PAGE_BITS = 16;
+constexpr u64 PAGE_BITS = 12;
+constexpr u64 BIG_PAGE_SIZE = 1ULL << BIG_PAGE_BITS;
+constexpr u64 PAGE_SIZE = 1ULL << PAGE_BITS;
+
+/// Rasterizer without caches, mapping changes only reach the page tables
+class NullRasterizer final : public VideoCore::RasterizerInterface {
+public:
+    void Draw(bool is_indexed, u32 instance_count) override {}
+    void DrawTexture() override {}
+    void Clear(u32 layer_count) override {}
+    void DispatchCompute() override {}
+    void ResetCounter(VideoCommon::QueryType type) override {}
+    void Query(GPUVAddr gpu_addr, VideoCommon::QueryType type,
+               VideoCommon::QueryPropertiesFlags flags, u32 payload, u32 subreport) override {}
+    void BindGraphicsUniformBuffer(size_t stage, u32 index, GPUVAddr gpu_addr,
+                                   u32 size) override {}
+    void DisableGraphicsUniformBuffer(size_t stage, u32 index) override {}
+    void SignalFence(std::function<void()>&& func) override {
+        func();
+    }
+    void SyncOperation(std::function<void()>&& func) override {
+        func();
+    }
+    void SignalSyncPoint(u32 value) override {}
+    void SignalReference() override {}
+    void ReleaseFences(bool force) override {}
+    void FlushAll() override {}
+    void FlushRegion(DAddr addr, u64 size, VideoCommon::CacheType which) override {}
+    bool MustFlushRegion(DAddr addr, u64 size, VideoCommon::CacheType which) override {
+        return false;
+    }
+    VideoCore::RasterizerDownloadArea GetFlushArea(DAddr addr, u64 size) override {
+        return {
+            .start_address = addr,
+            .end_address = addr + size,
+            .preemtive = true,
+        };
+    }
+    void InvalidateRegion(DAddr addr, u64 size, VideoCommon::CacheType which) override {}
+    void OnCacheInvalidation(PAddr addr, u64 size) override {}
+    bool OnCPUWrite(PAddr addr, u64 size) override {
+        return false;
+    }
+    void InvalidateGPUCache() override {}
+    void UnmapMemory(DAddr addr, u64 size) override {}
+    void ModifyGPUMemory(size_t as_id, GPUVAddr addr, u64 size) override {}
+    void FlushAndInvalidateRegion(DAddr addr, u64 size, VideoCommon::CacheType which) override {}
+    void WaitForIdle() override {}
+    void FragmentBarrier() override {}
+    void TiledCacheBarrier() override {}
+    void FlushCommands() override {}
+    void TickFrame() override {}
+    Tegra::Engines::AccelerateDMAInterface& AccessAccelerateDMA() override {
+        std::abort();
+    }
+    void AccelerateInlineToMemory(GPUVAddr address, size_t copy_size,
+                                  std::span<const u8> memory) override {}
+};
+
+/// GPU address spaces over a device memory without backing pages, enough to translate addresses
+class AddressSpaces {
+public:
+    AddressSpaces() : device_memory_manager{device_memory} {}
+
+    std::unique_ptr<Tegra::MemoryManager> Create() {
+        auto gmmu = std::make_unique<Tegra::MemoryManager>(system, device_memory_manager,
+                                                           ADDRESS_SPACE_BITS, 1ULL << 30,
+                                                           BIG_PAGE_BITS, PAGE_BITS);
+        gmmu->BindRasterizer(&rasterizer);
+        return gmmu;
+    }
+
+private:
+    Core::System system;
+    Core::DeviceMemory device_memory;
+    Tegra::MaxwellDeviceMemoryManager device_memory_manager;
+    NullRasterizer rasterizer;
+};
+
+} // Anonymous namespace
+
+TEST_CASE("MemoryManager[Translations follow mapping changes]", "[video_core]") {
+    AddressSpaces address_spaces;
+    const auto gmmu_owner = address_spaces.Create();
+    const auto other = address_spaces.Create();
+    Tegra::MemoryManager& gmmu = *gmmu_owner;
+
+    const GPUVAddr big = 0x1000000;
+    gmmu.Map(big, 0x40000000, 4 * BIG_PAGE_SIZE);
+    REQUIRE(gmmu.GpuToCpuAddress(big + 0x1234) == 0x40001234);
+    REQUIRE(gmmu.GpuToCpuAddress(big + BIG_PAGE_SIZE + 0x10) == 0x40000000 + BIG_PAGE_SIZE + 0x10);
+    REQUIRE(other->GpuToCpuAddress(big + 0x1234) == std::nullopt);
+
+    // Ranges within a device page take a single lookup, longer ones walk the pages
+    using Ranges = std::vector<std::pair<GPUVAddr, std::size_t>>;
+    const auto submapped = [&gmmu](GPUVAddr gpu_addr, std::size_t size) {
+        const auto ranges = gmmu.GetSubmappedRange(gpu_addr, size);
+        return Ranges(ranges.begin(), ranges.end());
+    };
+    REQUIRE(submapped(big + 0x1010, 0x20) == Ranges{{big + 0x1010, 0x20}});
+    REQUIRE(submapped(big + 0x1010, 4 * BIG_PAGE_SIZE) ==
+            Ranges{{big + 0x1010, 4 * BIG_PAGE_SIZE - 0x1010}});
+
+    gmmu.Map(big, 0x80000000, BIG_PAGE_SIZE);
+    REQUIRE(gmmu.GpuToCpuAddress(big + 0x1234) == 0x80001234);
+    REQUIRE(gmmu.GpuToCpuAddress(big + BIG_PAGE_SIZE + 0x10) == 0x40000000 + BIG_PAGE_SIZE + 0x10);
+    gmmu.Unmap(big, BIG_PAGE_SIZE);
+    REQUIRE(gmmu.GpuToCpuAddress(big + 0x1234) == std::nullopt);
+    REQUIRE(gmmu.GpuToCpuAddress(big + BIG_PAGE_SIZE) == 0x40000000 + BIG_PAGE_SIZE);
+
+    // Small pages, also below a reserved big page, which only GpuToCpuAddress translates
+    const GPUVAddr small = 0x2000000;
+    gmmu.Map(small, 0x50000000, 2 * PAGE_SIZE, Tegra::PTEKind::INVALID, false);
+    REQUIRE(gmmu.GpuToCpuAddress(small + PAGE_SIZE + 4) == 0x50000000 + PAGE_SIZE + 4);
+    gmmu.MapSparse(small, BIG_PAGE_SIZE);
+    REQUIRE(gmmu.GpuToCpuAddress(small + PAGE_SIZE + 4) == 0x50000000 + PAGE_SIZE + 4);
+    REQUIRE(gmmu.GetSubmappedRange(small + PAGE_SIZE + 4, 4).empty());
+    gmmu.Unmap(small, BIG_PAGE_SIZE);
+    REQUIRE(gmmu.GpuToCpuAddress(small + PAGE_SIZE + 4) == std::nullopt);
+}
+
+TEST_CASE("MemoryManager[Benchmark]", "[video_core][.benchmark]") {
+    AddressSpaces address_spaces;
+    const auto gmmu_owner = address_spaces.Create();
+    Tegra::MemoryManager& gmmu = *gmmu_owner;
+    // Buffers and textures of a frame, a mix of big and small page mappings
+    constexpr GPUVAddr big_base = 0x10000000;
+    constexpr GPUVAddr small_base = 0x20000000;
+    constexpr u64 mapping_size = 64_MiB;
+    gmmu.Map(big_base, 0x100000000, mapping_size);
+    gmmu.Map(small_base, 0x200000000, mapping_size, Tegra::PTEKind::INVALID, false);
+
+    // Engines access runs of a few KiB, jumping between the buffers of the frame
+    std::mt19937 random{1234};
+    std::vector<GPUVAddr> addresses(1 << 16);
+    GPUVAddr address{};
+    for (size_t i = 0; i < addresses.size(); ++i) {
+        if (i % 16 == 0) {
+            const GPUVAddr base = random() % 2 == 0 ? big_base : small_base;
+            address = base + random() % (mapping_size / 4_KiB) * 4_KiB;
+        }
+        addresses[i] = address + (i % 16) * 256;
+    }
+
+    BENCHMARK("Translate 64K addresses") {
+        DAddr sum = 0;
+        for (const GPUVAddr value : addresses) {
+            sum += *gmmu.GpuToCpuAddress(value);
+        }
+        return sum;
+    };
+}
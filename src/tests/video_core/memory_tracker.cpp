@@ -5,6 +5,7 @@
 #include <stdexcept>
 #include <unordered_map>
 
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
 
 #include "common/alignment.h"
@@ -54,6 +55,18 @@ public:
 private:
     std::unordered_map<u64, int> page_table;
 };
+
+/// Tracker counting notifications without tracking pages, to benchmark the tracker itself
+class CountingTracker {
+public:
+    void UpdatePagesCachedCount(VAddr addr, u64 size, int delta) {
+        ++num_calls;
+        num_pages += static_cast<s64>(size / PAGE) * delta;
+    }
+
+    u64 num_calls = 0;
+    s64 num_pages = 0;
+};
 } // Anonymous namespace
 
 using MemoryTracker = VideoCommon::MemoryTrackerBase<RasterizerInterface>;
@@ -546,3 +559,71 @@ TEST_CASE("MemoryTracker: Cached write downloads") {
     memory_track->MarkRegionAsCpuModified(c, WORD);
     REQUIRE(rasterizer.Count() == 0);
 }
+
+TEST_CASE("MemoryTracker: Ranges across regions are coalesced") {
+    CountingTracker tracker;
+    auto memory_track = std::make_unique<VideoCommon::MemoryTrackerBase<CountingTracker>>(tracker);
+    memory_track->UnmarkRegionAsCpuModified(c, HIGH_PAGE_SIZE * 2);
+    REQUIRE(tracker.num_calls == 2);
+    REQUIRE(tracker.num_pages == static_cast<s64>(HIGH_PAGE_SIZE * 2 / PAGE));
+
+    tracker.num_calls = 0;
+    memory_track->MarkRegionAsCpuModified(c + HIGH_PAGE_SIZE - WORD * 2, WORD * 4);
+    REQUIRE(tracker.num_calls == 2);
+    int num = 0;
+    memory_track->ForEachUploadRange(c, HIGH_PAGE_SIZE * 2, [&](u64 offset, u64 size) {
+        REQUIRE(offset == c + HIGH_PAGE_SIZE - WORD * 2);
+        REQUIRE(size == WORD * 4);
+        ++num;
+    });
+    REQUIRE(num == 1);
+    REQUIRE(tracker.num_calls == 4);
+    REQUIRE(tracker.num_pages == static_cast<s64>(HIGH_PAGE_SIZE * 2 / PAGE));
+}
+
+TEST_CASE("MemoryTracker: Benchmark", "[.benchmark]") {
+    static constexpr u64 size = 64ULL << 20;
+    CountingTracker tracker;
+    auto memory_track = std::make_unique<VideoCommon::MemoryTrackerBase<CountingTracker>>(tracker);
+    memory_track->UnmarkRegionAsCpuModified(c, size);
+
+    BENCHMARK("Mark and upload 64 MiB") {
+        memory_track->MarkRegionAsCpuModified(c, size);
+        u64 uploaded = 0;
+        memory_track->ForEachUploadRange(c, size, [&](u64, u64 range_size) {
+            uploaded += range_size;
+        });
+        return uploaded;
+    };
+    BENCHMARK("Mark and upload every other page of 64 MiB") {
+        for (u64 offset = 0; offset < size; offset += PAGE * 2) {
+            memory_track->MarkRegionAsCpuModified(c + offset, PAGE);
+        }
+        u64 uploaded = 0;
+        memory_track->ForEachUploadRange(c, size, [&](u64, u64 range_size) {
+            uploaded += range_size;
+        });
+        return uploaded;
+    };
+    BENCHMARK("Query clean 64 MiB") {
+        return memory_track->IsRegionCpuModified(c, size);
+    };
+    BENCHMARK("Cached write and flush 64 MiB") {
+        memory_track->CachedCpuWrite(c, size);
+        memory_track->FlushCachedWrites();
+        memory_track->UnmarkRegionAsCpuModified(c, size);
+        return tracker.num_pages;
+    };
+    BENCHMARK("Mark and download 64 MiB") {
+        memory_track->MarkRegionAsGpuModified(c, size);
+        u64 downloaded = 0;
+        memory_track->ForEachDownloadRangeAndClear(c, size, [&](u64, u64 range_size) {
+            downloaded += range_size;
+        });
+        return downloaded;
+    };
+    tracker.num_calls = 0;
+    memory_track->MarkRegionAsCpuModified(c, size);
+    memory_track->UnmarkRegionAsCpuModified(c, size);
+    WARN("Tracker notifications to mark and unmark 64 MiB: " << tracker.num_calls);
+}
@@ -0,0 +1,201 @@
+// SPDX-FileCopyrightText: Copyright 2026 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "common/hash.h"
+#include "video_core/texture_cache/page_index.h"
+
+namespace {
+using VideoCommon::PageIndex;
+
+// Matches the texture cache page size
+constexpr u64 PAGE_BITS = 20;
+
+using HashedPageTable = std::unordered_map<u64, std::vector<u32>, Common::IdentityHash<u64>>;
+
+struct TraceImage {
+    u64 first_page;
+    u64 last_page;
+};
+
+/// Builds images scattered over a 40-bit address space, clustered like guest allocations are
+std::vector<TraceImage> MakeTrace(size_t num_images) {
+    std::mt19937_64 rng{0x7e47};
+    std::uniform_int_distribution<u64> cluster_dist{0, 31};
+    std::uniform_int_distribution<u64> offset_dist{0, (512ULL << PAGE_BITS) - 1};
+    std::uniform_int_distribution<u64> size_dist{4 << 10, 24 << 20};
+    std::vector<TraceImage> images(num_images);
+    for (TraceImage& image : images) {
+        const u64 addr = (cluster_dist(rng) << 35) + (offset_dist(rng) & ~0xffffULL);
+        const u64 size = size_dist(rng);
+        image.first_page = addr >> PAGE_BITS;
+        image.last_page = (addr + size - 1) >> PAGE_BITS;
+    }
+    return images;
+}
+
+/// Returns the pages probed by lookups, most of them land inside registered images
+std::vector<u64> MakeLookups(const std::vector<TraceImage>& images, size_t num_lookups) {
+    std::mt19937_64 rng{0x100c};
+    std::uniform_int_distribution<size_t> image_dist{0, images.size() - 1};
+    std::vector<u64> pages(num_lookups);
+    for (u64& page : pages) {
+        const TraceImage& image = images[image_dist(rng)];
+        page = image.first_page + rng() % (image.last_page - image.first_page + 3);
+    }
+    return pages;
+}
+
+void Insert(HashedPageTable& table, const TraceImage& image, u32 id) {
+    for (u64 page = image.first_page; page <= image.last_page; ++page) {
+        table[page].push_back(id);
+    }
+}
+
+void Erase(HashedPageTable& table, const TraceImage& image, u32 id) {
+    for (u64 page = image.first_page; page <= image.last_page; ++page) {
+        std::vector<u32>& ids = table.at(page);
+        ids.erase(std::ranges::find(ids, id));
+    }
+}
+
+template <typename Bucket>
+std::vector<u32> Sorted(const Bucket* bucket) {
+    std::vector<u32> ids;
+    if (bucket) {
+        ids.assign(bucket->begin(), bucket->end());
+    }
+    std::ranges::sort(ids);
+    return ids;
+}
+} // Anonymous namespace
+
+TEST_CASE("PageIndex[Pages in unallocated blocks are not found]", "[video_core]") {
+    PageIndex<u32> index;
+    REQUIRE(index.Find(0) == nullptr);
+    REQUIRE(index.Find(u64{1} << 30) == nullptr);
+
+    index.Insert(5000, 5002, 7);
+    REQUIRE(index.Find(0) == nullptr);
+    REQUIRE(index.Find(u64{1} << 30) == nullptr);
+    REQUIRE(index.Find(4999) != nullptr);
+    REQUIRE(index.Find(4999)->empty());
+    REQUIRE(index.Find(5001)->size() == 1);
+}
+
+TEST_CASE("PageIndex[Buckets are stable while other pages are inserted]", "[video_core]") {
+    PageIndex<u32> index;
+    index.Insert(3, 3, 1);
+    const auto* const bucket = index.Find(3);
+    index.Insert(1ULL << 24, (1ULL << 24) + 4096, 2);
+    REQUIRE(index.Find(3) == bucket);
+    REQUIRE(bucket->size() == 1);
+    REQUIRE((*bucket)[0] == 1);
+}
+
+TEST_CASE("PageIndex[Erase reports pages without the id]", "[video_core]") {
+    PageIndex<u32> index;
+    index.Insert(10, 20, 1);
+    index.Insert(15, 30, 2);
+
+    REQUIRE(!index.Erase(10, 20, 1));
+    REQUIRE(index.Find(15)->size() == 1);
+    REQUIRE(index.Find(10)->empty());
+
+    // Pages 10 to 14 never held id 2, the rest of the range is still erased
+    REQUIRE(index.Erase(10, 30, 2) == 10);
+    REQUIRE(index.Find(20)->empty());
+    REQUIRE(index.Erase(1ULL << 32, 1ULL << 32, 2) == 1ULL << 32);
+}
+
+TEST_CASE("PageIndex[Register and unregister trace matches a hash table]", "[video_core]") {
+    const std::vector<TraceImage> images = MakeTrace(512);
+    const std::vector<u64> lookups = MakeLookups(images, 4096);
+    PageIndex<u32> index;
+    HashedPageTable reference;
+    const auto check = [&] {
+        for (const u64 page : lookups) {
+            const auto it = reference.find(page);
+            const std::vector<u32>* const expected = it != reference.end() ? &it->second : nullptr;
+            const std::vector<u32> ids = Sorted(index.Find(page));
+            REQUIRE(ids == Sorted(expected));
+        }
+    };
+    for (u32 id = 0; id < images.size(); ++id) {
+        index.Insert(images[id].first_page, images[id].last_page, id);
+        Insert(reference, images[id], id);
+    }
+    check();
+    for (u32 id = 0; id < images.size(); id += 2) {
+        REQUIRE(!index.Erase(images[id].first_page, images[id].last_page, id));
+        Erase(reference, images[id], id);
+    }
+    check();
+}
+
+TEST_CASE("PageIndex[Benchmark]", "[video_core][.benchmark]") {
+    const std::vector<TraceImage> images = MakeTrace(2048);
+    const std::vector<u64> lookups = MakeLookups(images, 1 << 16);
+
+    BENCHMARK("Register, lookup and unregister (hash table)") {
+        HashedPageTable table;
+        size_t found = 0;
+        for (u32 id = 0; id < images.size(); ++id) {
+            Insert(table, images[id], id);
+        }
+        for (const u64 page : lookups) {
+            const auto it = table.find(page);
+            found += it != table.end() ? it->second.size() : 0;
+        }
+        for (u32 id = 0; id < images.size(); ++id) {
+            Erase(table, images[id], id);
+        }
+        return found;
+    };
+    BENCHMARK("Register, lookup and unregister (page index)") {
+        PageIndex<u32> index;
+        size_t found = 0;
+        for (u32 id = 0; id < images.size(); ++id) {
+            index.Insert(images[id].first_page, images[id].last_page, id);
+        }
+        for (const u64 page : lookups) {
+            const auto* const ids = index.Find(page);
+            found += ids ? ids->size() : 0;
+        }
+        for (u32 id = 0; id < images.size(); ++id) {
+            index.Erase(images[id].first_page, images[id].last_page, id);
+        }
+        return found;
+    };
+
+    HashedPageTable table;
+    PageIndex<u32> index;
+    for (u32 id = 0; id < images.size(); ++id) {
+        Insert(table, images[id], id);
+        index.Insert(images[id].first_page, images[id].last_page, id);
+    }
+    BENCHMARK("Lookup (hash table)") {
+        size_t found = 0;
+        for (const u64 page : lookups) {
+            const auto it = table.find(page);
+            found += it != table.end() ? it->second.size() : 0;
+        }
+        return found;
+    };
+    BENCHMARK("Lookup (page index)") {
+        size_t found = 0;
+        for (const u64 page : lookups) {
+            const auto* const ids = index.Find(page);
+            found += ids ? ids->size() : 0;
+        }
+        return found;
+    };
+}
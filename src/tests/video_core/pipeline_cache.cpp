@@ -0,0 +1,292 @@
+// SPDX-FileCopyrightText: Copyright 2026 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <fmt/format.h>
+
+#include "common/common_types.h"
+#include "common/thread_worker.h"
+#include "video_core/shader_environment.h"
+
+namespace {
+using VideoCommon::FileEnvironment;
+using VideoCommon::GenericEnvironment;
+using VideoCommon::SerializedPipeline;
+
+constexpr u32 CACHE_VERSION = 7;
+constexpr size_t CODE_WORDS = 256;
+
+struct ComputeKey {
+    u64 hash;
+    u32 id;
+    u32 padding;
+};
+
+struct GraphicsKey {
+    std::array<u64, 3> hashes;
+    u32 id;
+    u32 padding;
+};
+
+/// Environment with generated code, serialized like the environments of a running guest
+class TestEnvironment final : public GenericEnvironment {
+public:
+    explicit TestEnvironment(Shader::Stage stage_, u32 seed) {
+        stage = stage_;
+        code = MakeCode(seed);
+        cached_lowest = 0;
+        cached_highest = static_cast<u32>((code.size() - 1) * sizeof(u64));
+        texture_bound = seed;
+        cbuf_values.emplace(seed, seed * 3);
+    }
+
+    static std::vector<u64> MakeCode(u32 seed) {
+        std::mt19937_64 rng{seed};
+        std::vector<u64> result(CODE_WORDS);
+        for (u64& word : result) {
+            // Keep some redundancy, like real shader code
+            word = rng() & 0xFFFF00000000FFFFULL;
+        }
+        return result;
+    }
+
+    u32 ReadCbufValue(u32, u32) override {
+        return 0;
+    }
+
+    Shader::TextureType ReadTextureType(u32) override {
+        return Shader::TextureType::Color2D;
+    }
+
+    Shader::TexturePixelFormat ReadTexturePixelFormat(u32) override {
+        return {};
+    }
+
+    bool IsTexturePixelFormatInteger(u32) override {
+        return false;
+    }
+
+    u32 ReadViewportTransformState() override {
+        return 1;
+    }
+
+    std::optional<Shader::ReplaceConstant> GetReplaceConstBuffer(u32, u32) override {
+        return std::nullopt;
+    }
+};
+
+bool IsCompute(u32 id) {
+    return id % 4 == 0;
+}
+
+std::filesystem::path CachePath(const char* name) {
+    const auto path =
+        std::filesystem::temp_directory_path() / fmt::format("citron_pipeline_cache_{}.bin", name);
+    std::filesystem::remove(path);
+    return path;
+}
+
+void WritePipeline(const std::filesystem::path& path, u32 id) {
+    if (IsCompute(id)) {
+        const TestEnvironment env(Shader::Stage::Compute, id);
+        const std::array<const GenericEnvironment*, 1> envs{&env};
+        VideoCommon::SerializePipeline(ComputeKey{.hash = id * 31ULL, .id = id, .padding = 0},
+                                       envs, path, CACHE_VERSION);
+        return;
+    }
+    const TestEnvironment vertex(Shader::Stage::VertexB, id);
+    const TestEnvironment fragment(Shader::Stage::Fragment, id + 1);
+    const std::array<const GenericEnvironment*, 2> envs{&vertex, &fragment};
+    const GraphicsKey key{.hashes = {id, id * 7ULL, 0}, .id = id, .padding = 0};
+    VideoCommon::SerializePipeline(key, envs, path, CACHE_VERSION);
+}
+
+void WritePipelines(const std::filesystem::path& path, u32 first, u32 count) {
+    for (u32 id = first; id < first + count; ++id) {
+        WritePipeline(path, id);
+    }
+}
+
+/// Writes the cache format used before pipelines were stored in indexed records
+void WriteLegacyCache(const std::filesystem::path& path, u32 count) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write("yuzucach", 8).write(reinterpret_cast<const char*>(&CACHE_VERSION), sizeof(u32));
+    for (u32 id = 0; id < count; ++id) {
+        const bool is_compute = IsCompute(id);
+        const u32 num_envs = is_compute ? 1 : 2;
+        file.write(reinterpret_cast<const char*>(&num_envs), sizeof(num_envs));
+        if (is_compute) {
+            TestEnvironment(Shader::Stage::Compute, id).Serialize(file);
+            const ComputeKey key{.hash = id * 31ULL, .id = id, .padding = 0};
+            file.write(reinterpret_cast<const char*>(&key), sizeof(key));
+        } else {
+            TestEnvironment(Shader::Stage::VertexB, id).Serialize(file);
+            TestEnvironment(Shader::Stage::Fragment, id + 1).Serialize(file);
+            const GraphicsKey key{.hashes = {id, id * 7ULL, 0}, .id = id, .padding = 0};
+            file.write(reinterpret_cast<const char*>(&key), sizeof(key));
+        }
+    }
+}
+
+void CheckEnvironment(FileEnvironment& env, Shader::Stage stage, u32 seed) {
+    REQUIRE(env.ShaderStage() == stage);
+    REQUIRE(env.TextureBoundBuffer() == seed);
+    const std::vector<u64> code = TestEnvironment::MakeCode(seed);
+    for (u32 word = 0; word < code.size(); ++word) {
+        REQUIRE(env.ReadInstruction(word * static_cast<u32>(sizeof(u64))) == code[word]);
+    }
+}
+
+/// Loads the cache and returns the sorted ids of the pipelines in it
+std::vector<u32> LoadIds(const std::filesystem::path& path, u32 cache_version = CACHE_VERSION) {
+    std::vector<u32> ids;
+    VideoCommon::LoadPipelines<ComputeKey, GraphicsKey>(
+        {}, path, cache_version,
+        [&](SerializedPipeline pipeline) {
+            const auto key = pipeline.ReadKey<ComputeKey>();
+            REQUIRE(key.hash == key.id * 31ULL);
+            std::vector<FileEnvironment> envs = pipeline.Deserialize();
+            REQUIRE(envs.size() == 1);
+            CheckEnvironment(envs[0], Shader::Stage::Compute, key.id);
+            ids.push_back(key.id);
+        },
+        [&](SerializedPipeline pipeline) {
+            const auto key = pipeline.ReadKey<GraphicsKey>();
+            REQUIRE(key.hashes[1] == key.id * 7ULL);
+            std::vector<FileEnvironment> envs = pipeline.Deserialize();
+            REQUIRE(envs.size() == 2);
+            CheckEnvironment(envs[0], Shader::Stage::VertexB, key.id);
+            CheckEnvironment(envs[1], Shader::Stage::Fragment, key.id + 1);
+            ids.push_back(key.id);
+        });
+    std::ranges::sort(ids);
+    return ids;
+}
+
+std::vector<u32> Ids(u32 count) {
+    std::vector<u32> result(count);
+    std::iota(result.begin(), result.end(), 0U);
+    return result;
+}
+
+std::vector<char> ReadFile(const std::filesystem::path& path) {
+    std::ifstream file(path, std::ios::binary);
+    return std::vector<char>(std::istreambuf_iterator<char>(file), {});
+}
+
+void WriteFile(const std::filesystem::path& path, const std::vector<char>& data) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(data.data(), static_cast<std::streamsize>(data.size()));
+}
+} // Anonymous namespace
+
+TEST_CASE("PipelineCache[Pipelines round trip]", "[video_core]") {
+    const auto path = CachePath("round_trip");
+    WritePipelines(path, 0, 40);
+    REQUIRE(LoadIds(path) == Ids(40));
+    // The first load indexes the file, the second one reads the index
+    REQUIRE(LoadIds(path) == Ids(40));
+
+    WritePipelines(path, 40, 8);
+    REQUIRE(LoadIds(path) == Ids(48));
+    REQUIRE(LoadIds(path) == Ids(48));
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("PipelineCache[Pipeline hashes are stable]", "[video_core]") {
+    const auto path = CachePath("hashes");
+    const TestEnvironment env(Shader::Stage::Compute, 4);
+    const std::array<const GenericEnvironment*, 1> envs{&env};
+    const ComputeKey key{.hash = 4 * 31ULL, .id = 4, .padding = 0};
+    const auto hash = VideoCommon::SerializePipeline(key, envs, path, CACHE_VERSION);
+    REQUIRE(hash);
+    for (int load = 0; load < 2; ++load) {
+        std::vector<u64> hashes;
+        VideoCommon::LoadPipelines<ComputeKey, GraphicsKey>(
+            {}, path, CACHE_VERSION,
+            [&](SerializedPipeline pipeline) { hashes.push_back(pipeline.Hash()); },
+            [&](SerializedPipeline pipeline) { hashes.push_back(pipeline.Hash()); });
+        REQUIRE(hashes == std::vector<u64>{*hash});
+    }
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("PipelineCache[Damaged records are skipped]", "[video_core]") {
+    const auto path = CachePath("damaged");
+    WritePipelines(path, 0, 10);
+    REQUIRE(LoadIds(path) == Ids(10));
+
+    // The middle of the file is in one of the records, only that record is lost
+    std::vector<char> data = ReadFile(path);
+    data[data.size() / 2] ^= 0x5A;
+    WriteFile(path, data);
+    const std::vector<u32> ids = LoadIds(path);
+    REQUIRE(ids.size() == 9);
+    REQUIRE(LoadIds(path) == ids);
+
+    // A partially written record at the end of the file is dropped
+    WritePipelines(path, 10, 3);
+    data = ReadFile(path);
+    data.resize(data.size() - 10);
+    WriteFile(path, data);
+    const std::vector<u32> truncated_ids = LoadIds(path);
+    REQUIRE(truncated_ids.size() == 11);
+    REQUIRE(truncated_ids.back() == 11);
+    WritePipelines(path, 12, 1);
+    REQUIRE(LoadIds(path).size() == 12);
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("PipelineCache[Old caches are converted]", "[video_core]") {
+    const auto path = CachePath("legacy");
+    WriteLegacyCache(path, 20);
+    REQUIRE(LoadIds(path) == Ids(20));
+    REQUIRE(ReadFile(path)[0] == 'c');
+    REQUIRE(LoadIds(path) == Ids(20));
+
+    // Caches of other versions are deleted
+    REQUIRE(LoadIds(path, CACHE_VERSION + 1).empty());
+    REQUIRE(!std::filesystem::exists(path));
+}
+
+TEST_CASE("PipelineCache[Benchmark]", "[video_core][.benchmark]") {
+    static constexpr u32 num_pipelines = 2000;
+    const auto path = CachePath("benchmark");
+    WritePipelines(path, 0, num_pipelines);
+    REQUIRE(LoadIds(path).size() == num_pipelines);
+
+    BENCHMARK("Index and validate 2000 pipelines") {
+        size_t count = 0;
+        VideoCommon::LoadPipelines<ComputeKey, GraphicsKey>(
+            {}, path, CACHE_VERSION, [&](SerializedPipeline) { ++count; },
+            [&](SerializedPipeline) { ++count; });
+        return count;
+    };
+
+    const size_t num_workers = std::max(std::thread::hardware_concurrency(), 2U) - 1;
+    Common::ThreadWorker workers(num_workers, "PipelineCacheBenchmark");
+    BENCHMARK("Load 2000 pipelines on " + std::to_string(num_workers) + " workers") {
+        std::atomic<size_t> num_envs = 0;
+        const auto load = [&](SerializedPipeline pipeline) {
+            workers.QueueWork([&num_envs, pipeline_ = std::move(pipeline)] {
+                num_envs += pipeline_.Deserialize().size();
+            });
+        };
+        VideoCommon::LoadPipelines<ComputeKey, GraphicsKey>({}, path, CACHE_VERSION, load, load);
+        workers.WaitForRequests();
+        return num_envs.load();
+    };
+    std::filesystem::remove(path);
+}
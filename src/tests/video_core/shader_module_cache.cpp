@@ -0,0 +1,164 @@
+// SPDX-FileCopyrightText: Copyright 2026 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "shader_recompiler/host_translate_info.h"
+#include "shader_recompiler/profile.h"
+#include "video_core/shader_module_cache.h"
+
+namespace {
+using VideoCommon::CachedShader;
+using VideoCommon::ShaderModuleCache;
+
+constexpr u64 BUILD_HASH = 0x1234'5678'9ABC'DEF0ULL;
+
+std::filesystem::path CachePath(const char* name) {
+    const auto path = std::filesystem::temp_directory_path() /
+                      (std::string("citron_shader_module_cache_") + name + ".bin");
+    std::filesystem::remove(path);
+    return path;
+}
+
+std::vector<CachedShader> MakeShaders(u32 seed) {
+    std::vector<CachedShader> shaders(2);
+    for (u32 index = 0; index < shaders.size(); ++index) {
+        CachedShader& shader = shaders[index];
+        shader.stage_index = index * 4;
+        shader.code.assign(64 + seed, seed * 7 + index);
+        shader.info.uses_fp16 = true;
+        shader.info.stores_frag_color[3] = true;
+        shader.info.constant_buffer_mask = seed | 1;
+        shader.info.stores.Set(Shader::IR::Attribute::PositionX);
+        shader.info.legacy_stores_mapping.emplace(Shader::IR::Attribute::ColorFrontDiffuseR,
+                                                  Shader::IR::Attribute::Generic0X);
+        shader.info.constant_buffer_descriptors.push_back({.index = seed, .count = 1});
+        shader.info.texture_descriptors.push_back({
+            .type = Shader::TextureType::ColorArray2D,
+            .is_depth = true,
+            .is_multisample = false,
+            .has_secondary = false,
+            .cbuf_index = 2,
+            .cbuf_offset = seed * 8,
+            .shift_left = 0,
+            .secondary_cbuf_index = 0,
+            .secondary_cbuf_offset = 0,
+            .secondary_shift_left = 0,
+            .count = 1,
+            .size_shift = 0,
+        });
+    }
+    return shaders;
+}
+
+void CheckShaders(const std::vector<CachedShader>& shaders, u32 seed) {
+    const std::vector<CachedShader> expected = MakeShaders(seed);
+    REQUIRE(shaders.size() == expected.size());
+    for (size_t index = 0; index < shaders.size(); ++index) {
+        const Shader::Info& info = shaders[index].info;
+        const Shader::Info& expected_info = expected[index].info;
+        REQUIRE(shaders[index].stage_index == expected[index].stage_index);
+        REQUIRE(shaders[index].code == expected[index].code);
+        REQUIRE(info.uses_fp16);
+        REQUIRE(!info.uses_fp64);
+        REQUIRE(info.stores_frag_color == expected_info.stores_frag_color);
+        REQUIRE(info.constant_buffer_mask == expected_info.constant_buffer_mask);
+        REQUIRE(info.stores.mask == expected_info.stores.mask);
+        REQUIRE(info.legacy_stores_mapping == expected_info.legacy_stores_mapping);
+        REQUIRE(std::ranges::equal(info.constant_buffer_descriptors,
+                                   expected_info.constant_buffer_descriptors));
+        REQUIRE(std::ranges::equal(info.texture_descriptors, expected_info.texture_descriptors));
+    }
+}
+} // Anonymous namespace
+
+TEST_CASE("ShaderModuleCache[Shaders round trip]", "[video_core]") {
+    const auto path = CachePath("round_trip");
+    {
+        ShaderModuleCache cache;
+        cache.Open(path, BUILD_HASH);
+        REQUIRE(cache.IsOpen());
+        REQUIRE(!cache.Find(1));
+        for (u32 seed = 1; seed <= 8; ++seed) {
+            cache.Insert(seed, MakeShaders(seed));
+        }
+        // Inserted shaders are found once the cache is opened again
+        REQUIRE(!cache.Find(1));
+    }
+    ShaderModuleCache cache;
+    cache.Open(path, BUILD_HASH);
+    for (u32 seed = 1; seed <= 8; ++seed) {
+        const auto shaders = cache.Find(seed);
+        REQUIRE(shaders);
+        CheckShaders(*shaders, seed);
+    }
+    REQUIRE(!cache.Find(9));
+    cache.Close();
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("ShaderModuleCache[Caches of other builds are discarded]", "[video_core]") {
+    const auto path = CachePath("other_build");
+    ShaderModuleCache cache;
+    cache.Open(path, BUILD_HASH);
+    cache.Insert(1, MakeShaders(1));
+    cache.Open(path, BUILD_HASH + 1);
+    REQUIRE(!cache.Find(1));
+    cache.Open(path, BUILD_HASH);
+    REQUIRE(!cache.Find(1));
+
+    Shader::Profile profile{};
+    Shader::HostTranslateInfo host_info{};
+    const u64 hash = ShaderModuleCache::BuildHash(profile, host_info);
+    REQUIRE(hash == ShaderModuleCache::BuildHash(profile, host_info));
+    profile.support_int64 = true;
+    REQUIRE(hash != ShaderModuleCache::BuildHash(profile, host_info));
+    cache.Close();
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("ShaderModuleCache[Damaged records are skipped]", "[video_core]") {
+    const auto path = CachePath("damaged");
+    {
+        ShaderModuleCache cache;
+        cache.Open(path, BUILD_HASH);
+        cache.Insert(1, MakeShaders(1));
+        cache.Insert(2, MakeShaders(2));
+    }
+    // Damage the end of the last record, then append a partially written record
+    std::vector<char> data;
+    {
+        std::ifstream file(path, std::ios::binary);
+        data.assign(std::istreambuf_iterator<char>(file), {});
+    }
+    data[data.size() - 2] ^= 0x5A;
+    data.insert(data.end(), 20, '\0');
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(data.data(), static_cast<std::streamsize>(data.size()));
+    }
+    {
+        ShaderModuleCache cache;
+        cache.Open(path, BUILD_HASH);
+        const auto shaders = cache.Find(1);
+        REQUIRE(shaders);
+        CheckShaders(*shaders, 1);
+        REQUIRE(!cache.Find(2));
+        cache.Insert(2, MakeShaders(2));
+    }
+    // The record appended after the truncated one replaces the damaged one
+    ShaderModuleCache cache;
+    cache.Open(path, BUILD_HASH);
+    const auto shaders = cache.Find(2);
+    REQUIRE(shaders);
+    CheckShaders(*shaders, 2);
+    cache.Close();
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,202 @@
+// SPDX-FileCopyrightText: Copyright 2026 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <cstring>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/alignment.h"
+#include "common/common_types.h"
+#include "common/div_ceil.h"
+#include "video_core/textures/decoders.h"
+
+namespace {
+using namespace Tegra::Texture;
+
+constexpr std::array<GobCopyKernel, 3> KERNELS{
+    GobCopyKernel::Scalar,
+    GobCopyKernel::SSE,
+    GobCopyKernel::AVX2,
+};
+
+constexpr const char* KernelName(GobCopyKernel kernel) {
+    switch (kernel) {
+    case GobCopyKernel::Scalar:
+        return "Scalar";
+    case GobCopyKernel::SSE:
+        return "SSE";
+    case GobCopyKernel::AVX2:
+        return "AVX2";
+    }
+    return "Unknown";
+}
+
+constexpr std::array<u32, 8> BYTES_PER_PIXEL{1, 2, 3, 4, 6, 8, 12, 16};
+
+/// Per-texel swizzle using the swizzle table, the reference all kernels have to match.
+template <bool TO_LINEAR>
+void ReferenceSwizzle(std::span<u8> output, std::span<const u8> input, u32 bytes_per_pixel,
+                      u32 width, u32 height, u32 depth, u32 origin_x, u32 origin_y, u32 extent_x,
+                      u32 extent_y, u32 block_height, u32 block_depth, u32 pitch, u32 stride) {
+    static constexpr SwizzleTable table = MakeSwizzleTable();
+    const u32 gobs_in_x = Common::DivCeilLog2(stride, GOB_SIZE_X_SHIFT);
+    const u32 block_size = gobs_in_x << (GOB_SIZE_SHIFT + block_height + block_depth);
+    const u32 slice_size =
+        Common::DivCeilLog2(height, block_height + GOB_SIZE_Y_SHIFT) * block_size;
+    for (u32 z = 0; z < depth; ++z) {
+        const u32 offset_z = (z >> block_depth) * slice_size +
+                             ((z & ((1U << block_depth) - 1)) << (GOB_SIZE_SHIFT + block_height));
+        for (u32 line = 0; line < extent_y; ++line) {
+            const u32 y = line + origin_y;
+            const u32 block_y = y >> GOB_SIZE_Y_SHIFT;
+            const u32 offset_y = (block_y >> block_height) * block_size +
+                                 ((block_y & ((1U << block_height) - 1)) << GOB_SIZE_SHIFT);
+            for (u32 column = 0; column < extent_x; ++column) {
+                const u32 x = (column + origin_x) * bytes_per_pixel;
+                const u32 offset_x = (x >> GOB_SIZE_X_SHIFT)
+                                     << (GOB_SIZE_SHIFT + block_height + block_depth);
+                const u32 swizzled = offset_z + offset_y + offset_x +
+                                     table[y % GOB_SIZE_Y][x % GOB_SIZE_X];
+                const u32 linear = z * pitch * height + line * pitch + column * bytes_per_pixel;
+                if constexpr (TO_LINEAR) {
+                    std::memcpy(&output[swizzled], &input[linear], bytes_per_pixel);
+                } else {
+                    std::memcpy(&output[linear], &input[swizzled], bytes_per_pixel);
+                }
+            }
+        }
+    }
+}
+
+std::vector<u8> RandomBytes(size_t size) {
+    std::mt19937 rng{static_cast<u32>(size)};
+    std::vector<u8> result(size);
+    for (u8& value : result) {
+        value = static_cast<u8>(rng());
+    }
+    return result;
+}
+
+struct Dimensions {
+    u32 width;
+    u32 height;
+    u32 depth;
+};
+
+constexpr std::array<Dimensions, 5> SIZES{{
+    {1, 1, 1},
+    {64, 64, 1},
+    {67, 45, 1},
+    {256, 130, 2},
+    {19, 300, 3},
+}};
+} // Anonymous namespace
+
+TEST_CASE("Swizzle[GOB kernels match per-texel reference]", "[video_core]") {
+    for (const GobCopyKernel kernel : KERNELS) {
+        for (const u32 bpp : {1U, 2U, 4U, 8U, 16U}) {
+            for (u32 block_height = 0; block_height <= 5; ++block_height) {
+                for (const Dimensions& size : SIZES) {
+                    const u32 block_depth = size.depth > 1 ? 1 : 0;
+                    const size_t tiled_size = CalculateSize(true, bpp, size.width, size.height,
+                                                            size.depth, block_height, block_depth);
+                    const size_t linear_size = size_t{size.width} * size.height * size.depth * bpp;
+                    const u32 stride = size.width * bpp;
+
+                    const std::vector<u8> tiled = RandomBytes(tiled_size);
+                    std::vector<u8> expected(linear_size);
+                    std::vector<u8> result(linear_size);
+                    ReferenceSwizzle<false>(expected, tiled, bpp, size.width, size.height,
+                                            size.depth, 0, 0, size.width, size.height,
+                                            block_height, block_depth, stride, stride);
+                    UnswizzleTexture(result, tiled, bpp, size.width, size.height, size.depth,
+                                     block_height, block_depth, 1, kernel);
+                    REQUIRE(result == expected);
+
+                    const std::vector<u8> linear = RandomBytes(linear_size);
+                    std::vector<u8> expected_tiled(tiled_size);
+                    std::vector<u8> result_tiled(tiled_size);
+                    ReferenceSwizzle<true>(expected_tiled, linear, bpp, size.width, size.height,
+                                           size.depth, 0, 0, size.width, size.height,
+                                           block_height, block_depth, stride, stride);
+                    SwizzleTexture(result_tiled, linear, bpp, size.width, size.height, size.depth,
+                                   block_height, block_depth, 1, kernel);
+                    REQUIRE(result_tiled == expected_tiled);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("Swizzle[Subrect GOB kernels match per-texel reference]", "[video_core]") {
+    static constexpr u32 width = 200;
+    static constexpr u32 height = 77;
+    for (const GobCopyKernel kernel : KERNELS) {
+        for (const u32 bpp : BYTES_PER_PIXEL) {
+            for (u32 block_height = 0; block_height <= 5; ++block_height) {
+                const u32 origin_x = 128 / bpp - 3;
+                const u32 origin_y = 5;
+                const u32 extent_x = width - origin_x - 2;
+                const u32 extent_y = height - origin_y;
+                const u32 pitch = extent_x * bpp + 32;
+                const u32 stride = Common::AlignUpLog2(width * bpp, GOB_SIZE_X_SHIFT);
+                const size_t tiled_size =
+                    CalculateSize(true, bpp, width, height, 1, block_height, 0);
+                const size_t linear_size = size_t{pitch} * height;
+
+                const std::vector<u8> linear = RandomBytes(linear_size);
+                std::vector<u8> expected_tiled = RandomBytes(tiled_size);
+                std::vector<u8> result_tiled = expected_tiled;
+                ReferenceSwizzle<true>(expected_tiled, linear, bpp, width, height, 1, origin_x,
+                                       origin_y, extent_x, extent_y, block_height, 0, pitch,
+                                       stride);
+                SwizzleSubrect(result_tiled, linear, bpp, width, height, 1, origin_x, origin_y,
+                               extent_x, extent_y, block_height, 0, pitch, kernel);
+                REQUIRE(result_tiled == expected_tiled);
+
+                std::vector<u8> expected(linear_size);
+                std::vector<u8> result(linear_size);
+                ReferenceSwizzle<false>(expected, expected_tiled, bpp, width, height, 1, origin_x,
+                                        origin_y, extent_x, extent_y, block_height, 0, pitch,
+                                        stride);
+                UnswizzleSubrect(result, expected_tiled, bpp, width, height, 1, origin_x, origin_y,
+                                 extent_x, extent_y, block_height, 0, pitch, kernel);
+                REQUIRE(result == expected);
+            }
+        }
+    }
+}
+
+TEST_CASE("Swizzle[Benchmark]", "[video_core][.benchmark]") {
+    static constexpr u32 width = 2048;
+    static constexpr u32 height = 2048;
+    static constexpr u32 block_height = 4;
+    for (const u32 bpp : {1U, 4U, 16U}) {
+        const size_t tiled_size = CalculateSize(true, bpp, width, height, 1, block_height, 0);
+        const size_t linear_size = size_t{width} * height * bpp;
+        const std::vector<u8> tiled = RandomBytes(tiled_size);
+        std::vector<u8> linear(linear_size);
+
+        BENCHMARK("Unswizzle reference bpp=" + std::to_string(bpp)) {
+            ReferenceSwizzle<false>(linear, tiled, bpp, width, height, 1, 0, 0, width, height,
+                                    block_height, 0, width * bpp, width * bpp);
+            return linear[0];
+        };
+        for (const GobCopyKernel kernel : KERNELS) {
+            if (static_cast<u32>(kernel) > static_cast<u32>(GetHostGobCopyKernel())) {
+                continue;
+            }
+            BENCHMARK(std::string{"Unswizzle "} + KernelName(kernel) +
+                      " bpp=" + std::to_string(bpp)) {
+                UnswizzleTexture(linear, tiled, bpp, width, height, 1, block_height, 0, 1, kernel);
+                return linear[0];
+            };
+        }
+    }
+}
@@ -0,0 +1,208 @@
+// SPDX-FileCopyrightText: Copyright 2026 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <filesystem>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "tests/test_data.h"
+#include "video_core/texture_cache/transcode_cache.h"
+
+namespace {
+using VideoCommon::BufferImageCopy;
+using VideoCommon::TranscodeCache;
+using Copies = boost::container::small_vector<BufferImageCopy, 16>;
+using Tests::MakeData;
+
+constexpr u64 KEY_A = 0xA;
+constexpr u64 KEY_B = 0xB;
+
+std::filesystem::path CachePath(const char* name) {
+    const auto path = std::filesystem::temp_directory_path() /
+                      (std::string("citron_transcode_cache_") + name + ".bin");
+    std::filesystem::remove(path);
+    return path;
+}
+
+Copies MakeCopies(u32 count, size_t level_size) {
+    Copies copies(count);
+    for (u32 level = 0; level < count; ++level) {
+        copies[level].buffer_offset = level * level_size;
+        copies[level].buffer_size = level_size;
+        copies[level].image_subresource.base_level = static_cast<s32>(level);
+        copies[level].image_extent = {.width = 16U >> level, .height = 8, .depth = 1};
+    }
+    return copies;
+}
+
+std::span<const BufferImageCopy> AsSpan(const Copies& copies) {
+    return {copies.data(), copies.size()};
+}
+
+bool SameCopies(const Copies& lhs, const Copies& rhs) {
+    if (lhs.size() != rhs.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < lhs.size(); ++i) {
+        if (lhs[i].buffer_offset != rhs[i].buffer_offset ||
+            lhs[i].buffer_size != rhs[i].buffer_size ||
+            lhs[i].image_subresource.base_level != rhs[i].image_subresource.base_level ||
+            lhs[i].image_extent.width != rhs[i].image_extent.width) {
+            return false;
+        }
+    }
+    return true;
+}
+} // Anonymous namespace
+
+TEST_CASE("TranscodeCache[Hit and miss]", "[video_core]") {
+    const auto path = CachePath("hit");
+    const std::vector<u8> data = MakeData(0x300, 1);
+    const Copies copies = MakeCopies(3, 0x100);
+    {
+        TranscodeCache cache;
+        cache.Open(path);
+        REQUIRE(cache.IsOpen());
+        cache.Store(KEY_A, data, AsSpan(copies));
+
+        std::vector<u8> output(0x400);
+        Copies loaded;
+        REQUIRE(cache.Load(KEY_A, output, loaded));
+        REQUIRE(SameCopies(loaded, copies));
+        REQUIRE(std::vector<u8>(output.begin(), output.begin() + data.size()) == data);
+
+        // Unknown keys and outputs too small for the record miss and leave the copies alone
+        Copies untouched = MakeCopies(1, 0x40);
+        REQUIRE(!cache.Load(KEY_B, output, untouched));
+        std::vector<u8> small_output(data.size() - 1);
+        REQUIRE(!cache.Load(KEY_A, small_output, untouched));
+        REQUIRE(SameCopies(untouched, MakeCopies(1, 0x40)));
+
+        const TranscodeCache::Statistics statistics = cache.GetStatistics();
+        REQUIRE(statistics.hits == 1);
+        REQUIRE(statistics.misses == 2);
+        REQUIRE(statistics.bytes_saved == data.size());
+    }
+
+    // Entries survive closing the cache
+    TranscodeCache cache;
+    cache.Open(path);
+    std::vector<u8> output(data.size());
+    Copies loaded;
+    REQUIRE(cache.Load(KEY_A, output, loaded));
+    REQUIRE(output == data);
+    REQUIRE(SameCopies(loaded, copies));
+    cache.Close();
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("TranscodeCache[Truncated pack file]", "[video_core]") {
+    const auto path = CachePath("truncated");
+    const std::vector<u8> data_a = MakeData(0x200, 2);
+    const std::vector<u8> data_b = MakeData(0x180, 3);
+    const Copies copies_a = MakeCopies(2, 0x100);
+    const Copies copies_b = MakeCopies(1, 0x180);
+    {
+        TranscodeCache cache;
+        cache.Open(path);
+        cache.Store(KEY_A, data_a, AsSpan(copies_a));
+    }
+    const u64 size_a = std::filesystem::file_size(path);
+    {
+        TranscodeCache cache;
+        cache.Open(path);
+        cache.Store(KEY_B, data_b, AsSpan(copies_b));
+    }
+
+    // Cut the last record in the middle of its data, as a crash while writing it would
+    const u64 full_size = std::filesystem::file_size(path);
+    std::filesystem::resize_file(path, full_size - 0x10);
+
+    TranscodeCache cache;
+    cache.Open(path);
+    std::vector<u8> output(0x200);
+    Copies loaded;
+    REQUIRE(!cache.Load(KEY_B, output, loaded));
+    REQUIRE(loaded.empty());
+    REQUIRE(cache.Load(KEY_A, output, loaded));
+    REQUIRE(output == data_a);
+    REQUIRE(SameCopies(loaded, copies_a));
+
+    // The partial record is dropped from the file
+    REQUIRE(std::filesystem::file_size(path) == size_a);
+    cache.Close();
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("TranscodeCache[Short read]", "[video_core]") {
+    const auto path = CachePath("short_read");
+    // Larger than the stdio buffer of the pack file, so the record is read from the file again
+    const std::vector<u8> data = MakeData(0x10000, 4);
+    TranscodeCache cache;
+    cache.Open(path);
+    cache.Store(KEY_A, data, AsSpan(MakeCopies(2, 0x100)));
+    std::vector<u8> output(data.size());
+    Copies loaded;
+    REQUIRE(cache.Load(KEY_A, output, loaded));
+    REQUIRE(output == data);
+
+    // The pack file shrinks behind the cache's back, the record can no longer be read whole
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 0x20);
+
+    const Copies caller_copies = MakeCopies(3, 0x40);
+    Copies copies = caller_copies;
+    REQUIRE(!cache.Load(KEY_A, output, copies));
+    REQUIRE(SameCopies(copies, caller_copies));
+
+    // The unreadable entry is forgotten
+    REQUIRE(!cache.Load(KEY_A, output, copies));
+    REQUIRE(cache.GetStatistics().hits == 1);
+    REQUIRE(cache.GetStatistics().misses == 2);
+    cache.Close();
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("TranscodeCache[Eviction]", "[video_core]") {
+    const auto path = CachePath("eviction");
+    constexpr size_t data_size = 0x100;
+    // Pack and record headers, records without copies
+    constexpr u64 header_size = 8;
+    constexpr u64 record_size = 0x18 + data_size;
+    const std::vector<u64> keys{1, 2, 3, 4, 5, 6};
+    {
+        // Two records fit the budget, storing a third evicts the least recently used one
+        TranscodeCache cache(2 * record_size);
+        cache.Open(path);
+        for (const u64 key : keys) {
+            cache.Store(key, MakeData(data_size, static_cast<u32>(key)), {});
+        }
+        std::vector<u8> output(data_size);
+        Copies loaded;
+        REQUIRE(!cache.Load(keys[2], output, loaded));
+        REQUIRE(cache.Load(keys[3], output, loaded));
+        REQUIRE(cache.Load(keys[4], output, loaded));
+        REQUIRE(output == MakeData(data_size, static_cast<u32>(keys[4])));
+
+        // Three evicted records are more than the budget, the last store waits for compaction
+        REQUIRE(!cache.Load(keys[5], output, loaded));
+        REQUIRE(cache.IsOpen());
+    }
+
+    // Closing the cache compacts the pack file down to the live records
+    REQUIRE(std::filesystem::file_size(path) == header_size + 2 * record_size);
+    TranscodeCache cache(2 * record_size);
+    cache.Open(path);
+    std::vector<u8> output(data_size);
+    Copies loaded;
+    REQUIRE(!cache.Load(keys[0], output, loaded));
+    REQUIRE(cache.Load(keys[3], output, loaded));
+    REQUIRE(output == MakeData(data_size, static_cast<u32>(keys[3])));
+    REQUIRE(cache.Load(keys[4], output, loaded));
+    REQUIRE(output == MakeData(data_size, static_cast<u32>(keys[4])));
+    cache.Close();
+    std::filesystem::remove(path);
+}
@@ -156,35 +156,41 @@ public:
     /// Call 'func' for each CPU modified range and unmark those pages as CPU modified
     template <typename Func>
     void ForEachUploadRange(VAddr query_cpu_range, u64 query_size, Func&& func) {
+        RangeCoalescer<Func&> ranges{func};
         IteratePages<true>(query_cpu_range, query_size,
-                           [&func](Manager* manager, u64 offset, size_t size) {
+                           [&ranges](Manager* manager, u64 offset, size_t size) {
                                manager->template ForEachModifiedRange<Type::CPU, true>(
-                                   manager->GetCpuAddr() + offset, size, func);
+                                   manager->GetCpuAddr() + offset, size, ranges);
                            });
+        ranges.Flush();
     }
 
     /// Call 'func' for each GPU modified range and unmark those pages as GPU modified
     template <typename Func>
     void ForEachDownloadRange(VAddr query_cpu_range, u64 query_size, bool clear, Func&& func) {
+        RangeCoalescer<Func&> ranges{func};
         IteratePages<false>(query_cpu_range, query_size,
-                            [&func, clear](Manager* manager, u64 offset, size_t size) {
+                            [&ranges, clear](Manager* manager, u64 offset, size_t size) {
                                 if (clear) {
                                     manager->template ForEachModifiedRange<Type::GPU, true>(
-                                        manager->GetCpuAddr() + offset, size, func);
+                                        manager->GetCpuAddr() + offset, size, ranges);
                                 } else {
                                     manager->template ForEachModifiedRange<Type::GPU, false>(
-                                        manager->GetCpuAddr() + offset, size, func);
+                                        manager->GetCpuAddr() + offset, size, ranges);
                                 }
                             });
+        ranges.Flush();
     }
 
     template <typename Func>
     void ForEachDownloadRangeAndClear(VAddr query_cpu_range, u64 query_size, Func&& func) {
+        RangeCoalescer<Func&> ranges{func};
         IteratePages<false>(query_cpu_range, query_size,
-                            [&func](Manager* manager, u64 offset, size_t size) {
+                            [&ranges](Manager* manager, u64 offset, size_t size) {
                                 manager->template ForEachModifiedRange<Type::GPU, true>(
-                                    manager->GetCpuAddr() + offset, size, func);
+                                    manager->GetCpuAddr() + offset, size, ranges);
                             });
+        ranges.Flush();
     }
 
 private:
@@ -29,6 +29,38 @@ enum class Type {
     Preflushable,
 };
 
+/// Coalesces ranges given in ascending order, contiguous ranges are forwarded as a single range
+template <typename Func>
+class RangeCoalescer {
+public:
+    explicit RangeCoalescer(Func func_) : func{std::forward<Func>(func_)} {}
+
+    void operator()(u64 address, u64 size) {
+        if (pending && pending_end == address) {
+            pending_end += size;
+            return;
+        }
+        Flush();
+        pending = true;
+        pending_begin = address;
+        pending_end = address + size;
+    }
+
+    /// Forwards the pending range, must be called once all ranges have been given
+    void Flush() {
+        if (pending) {
+            func(pending_begin, pending_end - pending_begin);
+            pending = false;
+        }
+    }
+
+private:
+    Func func;
+    bool pending = false;
+    u64 pending_begin = 0;
+    u64 pending_end = 0;
+};
+
 /// Vector tracking modified pages tightly packed with small vector optimization
 template <size_t stack_words = 1>
 struct WordsArray {
@@ -253,9 +285,10 @@ public:
         std::span<u64> state_words = words.template Span<type>();
         [[maybe_unused]] std::span<u64> untracked_words = words.template Span<Type::Untracked>();
         [[maybe_unused]] std::span<u64> cached_words = words.template Span<Type::CachedCPU>();
+        auto notifier = MakeNotifier<!enable>();
         IterateWords(dirty_addr - cpu_addr, size, [&](size_t index, u64 mask) {
             if constexpr (type == Type::CPU || type == Type::CachedCPU) {
-                NotifyRasterizer<!enable>(index, untracked_words[index], mask);
+                NotifyRasterizer<!enable>(index, untracked_words[index], mask, notifier);
             }
             if constexpr (enable) {
                 state_words[index] |= mask;
@@ -276,11 +309,13 @@ public:
                 }
             }
         });
+        notifier.Flush();
     }
 
     /**
      * Loop over each page in the given range, turn off those bits and notify the tracker if
      * needed. Call the given function on each turned off range.
+     * Ranges spanning multiple words are given as a single range.
      *
      * @param query_cpu_range Base CPU address to loop over
      * @param size            Size in bytes of the CPU range to loop over
@@ -294,13 +329,8 @@ public:
         [[maybe_unused]] std::span<u64> untracked_words = words.template Span<Type::Untracked>();
         [[maybe_unused]] std::span<u64> cached_words = words.template Span<Type::CachedCPU>();
         const size_t offset = query_cpu_range - cpu_addr;
-        bool pending = false;
-        size_t pending_offset{};
-        size_t pending_pointer{};
-        const auto release = [&]() {
-            func(cpu_addr + pending_offset * BYTES_PER_PAGE,
-                 (pending_pointer - pending_offset) * BYTES_PER_PAGE);
-        };
+        auto notifier = MakeNotifier<true>();
+        RangeCoalescer<Func&> ranges{func};
         IterateWords(offset, size, [&](size_t index, u64 mask) {
             if constexpr (type == Type::GPU) {
                 mask &= ~untracked_words[index];
@@ -308,7 +338,7 @@ public:
             const u64 word = state_words[index] & mask;
             if constexpr (clear) {
                 if constexpr (type == Type::CPU || type == Type::CachedCPU) {
-                    NotifyRasterizer<true>(index, untracked_words[index], mask);
+                    NotifyRasterizer<true>(index, untracked_words[index], mask, notifier);
                 }
                 state_words[index] &= ~mask;
                 if constexpr (type == Type::CPU || type == Type::CachedCPU) {
@@ -318,28 +348,13 @@ public:
                     cached_words[index] &= ~word;
                 }
             }
-            const size_t base_offset = index * PAGES_PER_WORD;
+            const VAddr base_addr = cpu_addr + index * BYTES_PER_WORD;
             IteratePages(word, [&](size_t pages_offset, size_t pages_size) {
-                const auto reset = [&]() {
-                    pending_offset = base_offset + pages_offset;
-                    pending_pointer = base_offset + pages_offset + pages_size;
-                };
-                if (!pending) {
-                    reset();
-                    pending = true;
-                    return;
-                }
-                if (pending_pointer == base_offset + pages_offset) {
-                    pending_pointer += pages_size;
-                    return;
-                }
-                release();
-                reset();
+                ranges(base_addr + pages_offset * BYTES_PER_PAGE, pages_size * BYTES_PER_PAGE);
             });
         });
-        if (pending) {
-            release();
-        }
+        notifier.Flush();
+        ranges.Flush();
     }
 
     /**
@@ -422,13 +437,18 @@ public:
         u64* const cached_words = Array<Type::CachedCPU>();
         u64* const untracked_words = Array<Type::Untracked>();
         u64* const cpu_words = Array<Type::CPU>();
+        auto notifier = MakeNotifier<false>();
         for (u64 word_index = 0; word_index < num_words; ++word_index) {
             const u64 cached_bits = cached_words[word_index];
-            NotifyRasterizer<false>(word_index, untracked_words[word_index], cached_bits);
+            if (cached_bits == 0) {
+                continue;
+            }
+            NotifyRasterizer<false>(word_index, untracked_words[word_index], cached_bits, notifier);
             untracked_words[word_index] |= cached_bits;
             cpu_words[word_index] |= cached_bits;
             cached_words[word_index] = 0;
         }
+        notifier.Flush();
     }
 
 private:
@@ -458,22 +478,36 @@ private:
         }
     }
 
+    /**
+     * Returns a coalescer notifying the tracker about changes in the CPU tracking state of pages,
+     * changes to contiguous pages are notified in a single call
+     *
+     * @tparam add_to_tracker True when the tracker should start tracking the pages
+     */
+    template <bool add_to_tracker>
+    [[nodiscard]] auto MakeNotifier() const {
+        return RangeCoalescer{[tracker = tracker](VAddr addr, u64 size) {
+            tracker->UpdatePagesCachedCount(addr, size, add_to_tracker ? 1 : -1);
+        }};
+    }
+
     /**
      * Notify tracker about changes in the CPU tracking state of a word in the buffer
      *
      * @param word_index   Index to the word to notify to the tracker
      * @param current_bits Current state of the word
      * @param new_bits     New state of the word
+     * @param notifier     Notifier returned by MakeNotifier with the same add_to_tracker
      *
      * @tparam add_to_tracker True when the tracker should start tracking the new pages
      */
-    template <bool add_to_tracker>
-    void NotifyRasterizer(u64 word_index, u64 current_bits, u64 new_bits) const {
+    template <bool add_to_tracker, typename Notifier>
+    void NotifyRasterizer(u64 word_index, u64 current_bits, u64 new_bits,
+                          Notifier& notifier) const {
         u64 changed_bits = (add_to_tracker ? current_bits : ~current_bits) & new_bits;
         VAddr addr = cpu_addr + word_index * BYTES_PER_WORD;
         IteratePages(changed_bits, [&](size_t offset, size_t size) {
-            tracker->UpdatePagesCachedCount(addr + offset * BYTES_PER_PAGE, size * BYTES_PER_PAGE,
-                                            add_to_tracker ? 1 : -1);
+            notifier(addr + offset * BYTES_PER_PAGE, size * BYTES_PER_PAGE);
         });
     }
 
@@ -134,10 +134,20 @@ void DmaPusher::ProcessCommands(std::span<const CommandHeader> commands) {
                 dma_state.is_last_call = true;
                 index += max_write;
                 continue;
-            } else {
-                dma_state.is_last_call = dma_state.method_count <= 1;
-                CallMethod(command_header.argument);
             }
+            if (!dma_increment_once) {
+                const u32 max_write = static_cast<u32>(
+                    std::min<std::size_t>(index + dma_state.method_count, commands.size()) - index);
+                const u32 num_written = WriteRegisters(&command_header.argument, max_write);
+                if (num_written != 0) {
+                    dma_state.method += num_written;
+                    dma_state.method_count -= num_written;
+                    index += num_written;
+                    continue;
+                }
+            }
+            dma_state.is_last_call = dma_state.method_count <= 1;
+            CallMethod(command_header.argument);
 
             if (!dma_state.non_incrementing) {
                 dma_state.method++;
@@ -222,6 +232,15 @@ void DmaPusher::CallMultiMethod(const u32* base_start, u32 num_methods) const {
     }
 }
 
+u32 DmaPusher::WriteRegisters(const u32* arguments, u32 num_methods) const {
+    if (dma_state.method < non_puller_methods) {
+        return 0;
+    }
+    // Registers without side effects are written as a block, up to the next executable method
+    return subchannels[dma_state.subchannel]->WritePassiveRegisters(dma_state.method, arguments,
+                                                                    num_methods);
+}
+
 void DmaPusher::BindRasterizer(VideoCore::RasterizerInterface* rasterizer) {
     puller.BindRasterizer(rasterizer);
 }
@@ -149,6 +149,10 @@ private:
     void CallMethod(u32 argument) const;
     void CallMultiMethod(const u32* base_start, u32 num_methods) const;
 
+    /// Writes the registers of an incrementing method run until the first executable method.
+    /// Returns the number of arguments consumed, zero when the current method has to be called.
+    u32 WriteRegisters(const u32* arguments, u32 num_methods) const;
+
     Common::ScratchBuffer<CommandHeader>
         command_headers; ///< Buffer for list of commands fetched at once
 
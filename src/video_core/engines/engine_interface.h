@@ -30,6 +30,26 @@ public:
     virtual void CallMultiMethod(u32 method, const u32* base_start, u32 amount,
                                  u32 methods_pending) = 0;
 
+    /// Write consecutive registers starting at method, none of them can be in execution_mask.
+    virtual void WriteRegisters(u32 method, const u32* values, u32 amount) {
+        for (u32 i = 0; i < amount; ++i) {
+            method_sink.emplace_back(method + i, values[i]);
+        }
+    }
+
+    /// Write the leading registers of a run that are not in execution_mask as a block.
+    /// Returns the number of registers written, zero when the first method has to be called.
+    u32 WritePassiveRegisters(u32 method, const u32* values, u32 amount) {
+        u32 num_registers = 0;
+        while (num_registers < amount && !execution_mask[method + num_registers]) {
+            ++num_registers;
+        }
+        if (num_registers != 0) {
+            WriteRegisters(method, values, num_registers);
+        }
+        return num_registers;
+    }
+
     void ConsumeSink() {
         if (method_sink.empty()) {
             return;
@@ -1,8 +1,14 @@
 // SPDX-FileCopyrightText: Copyright 2018 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
 #include <cstring>
 #include <optional>
+
+#ifdef ARCHITECTURE_x86_64
+#include <emmintrin.h>
+#endif
+
 #include "common/assert.h"
 #include "common/bit_util.h"
 #include "common/scope_exit.h"
@@ -320,12 +326,80 @@ void Maxwell3D::ProcessDirtyRegisters(u32 method, u32 argument) {
         return;
     }
     regs.reg_array[method] = argument;
+    MarkRegisterDirty(method);
+}
 
-    for (const auto& table : dirty.tables) {
-        dirty.flags[table[method]] = true;
+void Maxwell3D::ProcessDirtyRegisterRange(u32 method, const u32* values, u32 amount) {
+    u32* const registers = &regs.reg_array[method];
+    u32 i = 0;
+#ifdef ARCHITECTURE_x86_64
+    // Games rewrite most of their state with the values it already has. Compare four registers at
+    // a time and only look at single registers in groups where something changed. The flags are
+    // looked up through the dirty tables, so they are still set one register at a time.
+    for (; i + 4 <= amount; i += 4) {
+        const __m128i current = _mm_loadu_si128(reinterpret_cast<const __m128i*>(registers + i));
+        const __m128i written = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i));
+        const int equal_mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(current, written)));
+        if (equal_mask == 0xF) {
+            continue;
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(registers + i), written);
+        for (u32 lane = 0; lane < 4; ++lane) {
+            if ((equal_mask & (1 << lane)) == 0) {
+                MarkRegisterDirty(method + i + lane);
+            }
+        }
+    }
+#else
+    if (std::memcmp(registers, values, amount * sizeof(u32)) == 0) {
+        return;
+    }
+#endif
+    for (; i < amount; ++i) {
+        if (registers[i] != values[i]) {
+            registers[i] = values[i];
+            MarkRegisterDirty(method + i);
+        }
     }
 }
 
+void Maxwell3D::ProcessRepeatedRegister(u32 method, const u32* values, u32 amount) {
+    const auto control = shadow_state.shadow_ram_control;
+    if (control == Regs::ShadowRamControl::Replay) {
+        ProcessDirtyRegisters(method, shadow_state.reg_array[method]);
+        return;
+    }
+    const u32 last_value = values[amount - 1];
+    if (control == Regs::ShadowRamControl::Track ||
+        control == Regs::ShadowRamControl::TrackWithFilter) {
+        shadow_state.reg_array[method] = last_value;
+    }
+    // Only the last value is kept, but the register changed if any of the values differ from it
+    const u32 current_value = regs.reg_array[method];
+    if (std::all_of(values, values + amount,
+                    [current_value](u32 value) { return value == current_value; })) {
+        return;
+    }
+    regs.reg_array[method] = last_value;
+    MarkRegisterDirty(method);
+}
+
+void Maxwell3D::WriteRegisters(u32 method, const u32* values, u32 amount) {
+    ASSERT_MSG(method + amount <= Regs::NUM_REGS,
+               "Invalid Maxwell3D register, increase the size of the Regs structure");
+
+    // Earlier writes waiting in the sink have to land first
+    ConsumeSink();
+    const auto control = shadow_state.shadow_ram_control;
+    if (control == Regs::ShadowRamControl::Track ||
+        control == Regs::ShadowRamControl::TrackWithFilter) {
+        std::memcpy(&shadow_state.reg_array[method], values, amount * sizeof(u32));
+    } else if (control == Regs::ShadowRamControl::Replay) {
+        values = &shadow_state.reg_array[method];
+    }
+    ProcessDirtyRegisterRange(method, values, amount);
+}
+
 void Maxwell3D::ProcessMethodCall(u32 method, u32 argument, u32 nonshadow_argument,
                                   bool is_last_call) {
     switch (method) {
@@ -465,6 +539,12 @@ void Maxwell3D::CallMultiMethod(u32 method, const u32* base_start, u32 amount,
         return;
     }
     default:
+        if (!execution_mask[method] && amount != 0) {
+            ASSERT_MSG(method < Regs::NUM_REGS,
+                       "Invalid Maxwell3D register, increase the size of the Regs structure");
+            ProcessRepeatedRegister(method, base_start, amount);
+            break;
+        }
         for (u32 i = 0; i < amount; i++) {
             CallMethod(method, base_start[i], methods_pending - i <= 1);
         }
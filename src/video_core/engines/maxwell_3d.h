@@ -3078,6 +3078,9 @@ public:
     void CallMultiMethod(u32 method, const u32* base_start, u32 amount,
                          u32 methods_pending) override;
 
+    /// Write consecutive registers that do not execute anything.
+    void WriteRegisters(u32 method, const u32* values, u32 amount) override;
+
     bool ShouldExecute() const {
         return execute_on;
     }
@@ -3140,6 +3143,18 @@ private:
 
     void ProcessDirtyRegisters(u32 method, u32 argument);
 
+    /// Writes a run of registers, flagging only the ones that changed.
+    void ProcessDirtyRegisterRange(u32 method, const u32* values, u32 amount);
+
+    /// Writes values to a register that does not execute anything, in order.
+    void ProcessRepeatedRegister(u32 method, const u32* values, u32 amount);
+
+    void MarkRegisterDirty(u32 method) {
+        for (const auto& table : dirty.tables) {
+            dirty.flags[table[method]] = true;
+        }
+    }
+
     void ConsumeSinkImpl() override;
 
     void ProcessMethodCall(u32 method, u32 argument, u32 nonshadow_argument, bool is_last_call);
@@ -1,7 +1,14 @@
 // SPDX-FileCopyrightText: Copyright 2019 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <chrono>
+
+#ifdef ARCHITECTURE_x86_64
+#include <xmmintrin.h>
+#endif
+
 #include "common/assert.h"
+#include "common/logging/log.h"
 #include "common/microprofile.h"
 #include "common/scope_exit.h"
 #include "common/settings.h"
@@ -16,6 +23,103 @@
 
 namespace VideoCommon::GPUThread {
 
+namespace {
+
+/// Iterations the GPU thread spins on an empty queue before parking, a few microseconds
+constexpr u32 SPIN_ITERATIONS = 1024;
+
+void ThreadPause() {
+#ifdef ARCHITECTURE_x86_64
+    _mm_pause();
+#endif
+}
+
+u64 ElapsedNs(std::chrono::steady_clock::time_point start) {
+    return static_cast<u64>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                std::chrono::steady_clock::now() - start)
+                                .count());
+}
+
+} // Anonymous namespace
+
+u64 CommandQueue::Push(CommandDataContainer&& command, std::stop_token stop_token) {
+    const size_t index = write_index.load(std::memory_order_relaxed);
+    u64 stall_ns = 0;
+    if (index - read_index.load(std::memory_order_acquire) == CAPACITY) {
+        const auto stall_start = std::chrono::steady_clock::now();
+        {
+            std::unique_lock lock{park_mutex};
+            producer_parked.store(true);
+            Common::CondvarWait(producer_cv, lock, stop_token,
+                                [this, index] { return index - read_index.load() < CAPACITY; });
+            producer_parked.store(false, std::memory_order_relaxed);
+        }
+        stall_ns = ElapsedNs(stall_start);
+        if (stop_token.stop_requested()) {
+            return stall_ns;
+        }
+    }
+    slots[index % CAPACITY] = std::move(command);
+
+    // Sequentially consistent so either the consumer sees the command or we see it parked
+    write_index.store(index + 1);
+    if (consumer_parked.load()) {
+        std::scoped_lock lock{park_mutex};
+        consumer_cv.notify_one();
+    }
+    return stall_ns;
+}
+
+bool CommandQueue::TryPop(CommandDataContainer& command) {
+    const size_t index = read_index.load(std::memory_order_relaxed);
+    if (index == write_index.load(std::memory_order_acquire)) {
+        return false;
+    }
+    command = std::move(slots[index % CAPACITY]);
+
+    read_index.store(index + 1);
+    if (producer_parked.load()) {
+        std::scoped_lock lock{park_mutex};
+        producer_cv.notify_one();
+    }
+    return true;
+}
+
+bool CommandQueue::Wait(std::stop_token stop_token, u32 spin_iterations) {
+    const size_t index = read_index.load(std::memory_order_relaxed);
+    for (u32 spin = 0; spin < spin_iterations; ++spin) {
+        if (index != write_index.load(std::memory_order_acquire)) {
+            return true;
+        }
+        ThreadPause();
+    }
+    std::unique_lock lock{park_mutex};
+    consumer_parked.store(true);
+    if (index == write_index.load()) {
+        num_parks.fetch_add(1, std::memory_order_relaxed);
+        Common::CondvarWait(consumer_cv, lock, stop_token,
+                            [this, index] { return index != write_index.load(); });
+    }
+    consumer_parked.store(false, std::memory_order_relaxed);
+    return !stop_token.stop_requested();
+}
+
+/// Executes a command on the GPU thread
+static void ExecuteCommand(Core::System& system, Tegra::Control::Scheduler& scheduler,
+                           VideoCore::RasterizerInterface& rasterizer, CommandData& data) {
+    if (auto* submit_list = std::get_if<SubmitListCommand>(&data)) {
+        scheduler.Push(submit_list->channel, std::move(submit_list->entries));
+    } else if (std::holds_alternative<GPUTickCommand>(data)) {
+        system.GPU().TickWork();
+    } else if (const auto* flush = std::get_if<FlushRegionCommand>(&data)) {
+        rasterizer.FlushRegion(flush->addr, flush->size);
+    } else if (const auto* invalidate = std::get_if<InvalidateRegionCommand>(&data)) {
+        rasterizer.OnCacheInvalidation(invalidate->addr, invalidate->size);
+    } else {
+        ASSERT(false);
+    }
+}
+
 /// Runs the GPU thread
 static void RunThread(std::stop_token stop_token, Core::System& system,
                       VideoCore::RendererBase& renderer, Core::Frontend::GraphicsContext& context,
@@ -33,30 +137,27 @@ static void RunThread(std::stop_token stop_token, Core::System& system,
     auto current_context = context.Acquire();
     VideoCore::RasterizerInterface* const rasterizer = renderer.ReadRasterizer();
 
+    const u32 spin_iterations =
+        Settings::values.gpu_thread_spin_wait.GetValue() ? SPIN_ITERATIONS : 0;
     CommandDataContainer next;
 
-    while (!stop_token.stop_requested()) {
-        state.queue.PopWait(next, stop_token);
-        if (stop_token.stop_requested()) {
-            break;
-        }
-        if (auto* submit_list = std::get_if<SubmitListCommand>(&next.data)) {
-            scheduler.Push(submit_list->channel, std::move(submit_list->entries));
-        } else if (std::holds_alternative<GPUTickCommand>(next.data)) {
-            system.GPU().TickWork();
-        } else if (const auto* flush = std::get_if<FlushRegionCommand>(&next.data)) {
-            rasterizer->FlushRegion(flush->addr, flush->size);
-        } else if (const auto* invalidate = std::get_if<InvalidateRegionCommand>(&next.data)) {
-            rasterizer->OnCacheInvalidation(invalidate->addr, invalidate->size);
-        } else {
-            ASSERT(false);
+    while (state.queue.Wait(stop_token, spin_iterations)) {
+        state.num_batches.fetch_add(1, std::memory_order_relaxed);
+        // Fences nobody waits on are signaled once for the whole batch
+        u64 batch_fence = 0;
+        while (state.queue.TryPop(next)) {
+            ExecuteCommand(system, scheduler, *rasterizer, next.data);
+            batch_fence = next.fence;
+            if (next.block) {
+                state.signaled_fence.store(next.fence);
+                // We have to lock the write_lock to ensure that the condition_variable wait not
+                // get a race between the check and the lock itself.
+                std::scoped_lock lk{state.write_lock};
+                state.cv.notify_all();
+            }
         }
-        state.signaled_fence.store(next.fence);
-        if (next.block) {
-            // We have to lock the write_lock to ensure that the condition_variable wait not get a
-            // race between the check and the lock itself.
-            std::scoped_lock lk{state.write_lock};
-            state.cv.notify_all();
+        if (batch_fence != 0) {
+            state.signaled_fence.store(batch_fence);
         }
     }
 }
@@ -64,7 +165,17 @@ static void RunThread(std::stop_token stop_token, Core::System& system,
 ThreadManager::ThreadManager(Core::System& system_, bool is_async_)
     : system{system_}, is_async{is_async_} {}
 
-ThreadManager::~ThreadManager() = default;
+ThreadManager::~ThreadManager() {
+    if (!thread.joinable()) {
+        return;
+    }
+    const Statistics statistics = GetStatistics();
+    LOG_INFO(HW_GPU,
+             "GPU thread: {} commands in {} batches, {} parks, max queue depth {}, {} ms waiting "
+             "for queue slots, {} ms waiting for blocking commands",
+             statistics.commands, statistics.batches, statistics.parks, statistics.max_queue_depth,
+             statistics.full_stall_ns / 1'000'000, statistics.blocking_wait_ns / 1'000'000);
+}
 
 void ThreadManager::StartThread(VideoCore::RendererBase& renderer,
                                 Core::Frontend::GraphicsContext& context,
@@ -114,15 +225,37 @@ u64 ThreadManager::PushCommand(CommandData&& command_data, bool block) {
 
     std::unique_lock lk(state.write_lock);
     const u64 fence{++state.last_fence};
-    state.queue.EmplaceWait(std::move(command_data), fence, block);
+    const u64 full_stall_ns = state.queue.Push(
+        CommandDataContainer(std::move(command_data), fence, block), thread.get_stop_token());
+
+    // Producers are serialized by write_lock, the counters only need to be readable elsewhere
+    state.num_commands.fetch_add(1, std::memory_order_relaxed);
+    state.full_stall_ns.fetch_add(full_stall_ns, std::memory_order_relaxed);
+    const u64 queue_depth = state.queue.Size();
+    if (queue_depth > state.max_queue_depth.load(std::memory_order_relaxed)) {
+        state.max_queue_depth.store(queue_depth, std::memory_order_relaxed);
+    }
 
     if (block) {
+        const auto wait_start = std::chrono::steady_clock::now();
         Common::CondvarWait(state.cv, lk, thread.get_stop_token(), [this, fence] {
             return fence <= state.signaled_fence.load(std::memory_order_relaxed);
         });
+        state.blocking_wait_ns.fetch_add(ElapsedNs(wait_start), std::memory_order_relaxed);
     }
 
     return fence;
 }
 
+Statistics ThreadManager::GetStatistics() const {
+    return Statistics{
+        .commands = state.num_commands.load(std::memory_order_relaxed),
+        .batches = state.num_batches.load(std::memory_order_relaxed),
+        .parks = state.queue.NumParks(),
+        .max_queue_depth = state.max_queue_depth.load(std::memory_order_relaxed),
+        .full_stall_ns = state.full_stall_ns.load(std::memory_order_relaxed),
+        .blocking_wait_ns = state.blocking_wait_ns.load(std::memory_order_relaxed),
+    };
+}
+
 } // namespace VideoCommon::GPUThread
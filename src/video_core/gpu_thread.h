@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <condition_variable>
 #include <mutex>
@@ -10,8 +11,9 @@
 #include <thread>
 #include <variant>
 
-#include "common/bounded_threadsafe_queue.h"
+#include "common/common_types.h"
 #include "common/polyfill_thread.h"
+#include "video_core/dma_pusher.h"
 #include "video_core/framebuffer_config.h"
 
 namespace Tegra {
@@ -87,14 +89,81 @@ struct CommandDataContainer {
     bool block{};
 };
 
+/**
+ * Ring buffer carrying commands to the GPU thread.
+ * Pushes are serialized by SynchState::write_lock, so the ring has a single producer and a single
+ * consumer at any time and publishing a command is one atomic store. Locks are only taken to wake
+ * a side that parked: the consumer when it runs out of commands, producers when the ring is full.
+ */
+class CommandQueue final {
+public:
+    static constexpr size_t CAPACITY = 0x1000;
+
+    /**
+     * Publishes a command, waiting for a free slot when the ring is full
+     *
+     * @returns Nanoseconds spent waiting for a free slot
+     */
+    u64 Push(CommandDataContainer&& command, std::stop_token stop_token);
+
+    /// Moves the oldest published command out of the ring, returns false when it is empty
+    bool TryPop(CommandDataContainer& command);
+
+    /**
+     * Waits until a command is published, spinning for spin_iterations before parking the thread
+     *
+     * @returns False when a stop was requested
+     */
+    bool Wait(std::stop_token stop_token, u32 spin_iterations);
+
+    /// Returns the number of published commands not popped yet
+    [[nodiscard]] size_t Size() const noexcept {
+        return write_index.load(std::memory_order_acquire) -
+               read_index.load(std::memory_order_acquire);
+    }
+
+    /// Returns the number of times the consumer parked on an empty ring
+    [[nodiscard]] u64 NumParks() const noexcept {
+        return num_parks.load(std::memory_order_relaxed);
+    }
+
+private:
+    alignas(128) std::atomic_size_t read_index{0};
+    alignas(128) std::atomic_size_t write_index{0};
+    alignas(128) std::atomic_bool consumer_parked{false};
+    std::atomic_bool producer_parked{false};
+    std::atomic<u64> num_parks{0};
+
+    std::array<CommandDataContainer, CAPACITY> slots;
+
+    std::mutex park_mutex;
+    std::condition_variable_any consumer_cv;
+    std::condition_variable_any producer_cv;
+};
+
+/// Counters describing the balance between the emulated CPU threads and the GPU thread
+struct Statistics {
+    u64 commands;         ///< Commands pushed to the GPU thread
+    u64 batches;          ///< Groups of commands executed between two waits of the GPU thread
+    u64 parks;            ///< Times the GPU thread went to sleep on an empty queue
+    u64 max_queue_depth;  ///< Largest number of commands waiting for the GPU thread
+    u64 full_stall_ns;    ///< Time producers waited for a free slot in the queue
+    u64 blocking_wait_ns; ///< Time producers waited for blocking commands to execute
+};
+
 /// Struct used to synchronize the GPU thread
 struct SynchState final {
-    using CommandQueue = Common::MPSCQueue<CommandDataContainer>;
     std::mutex write_lock;
     CommandQueue queue;
     u64 last_fence{};
     std::atomic<u64> signaled_fence{};
     std::condition_variable_any cv;
+
+    std::atomic<u64> num_commands{};
+    std::atomic<u64> num_batches{};
+    std::atomic<u64> max_queue_depth{};
+    std::atomic<u64> full_stall_ns{};
+    std::atomic<u64> blocking_wait_ns{};
 };
 
 /// Class used to manage the GPU thread
@@ -121,6 +190,8 @@ public:
 
     void TickGPU();
 
+    [[nodiscard]] Statistics GetStatistics() const;
+
 private:
     /// Pushes a command to be executed by the GPU thread
     u64 PushCommand(CommandData&& command_data, bool block = false);
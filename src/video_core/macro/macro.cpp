@@ -1,6 +1,7 @@
 // SPDX-FileCopyrightText: Copyright 2020 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <chrono>
 #include <cstring>
 #include <fstream>
 #include <optional>
@@ -18,6 +19,8 @@
 #include "video_core/macro/macro.h"
 #include "video_core/macro/macro_hle.h"
 #include "video_core/macro/macro_interpreter.h"
+#include "video_core/macro/macro_profiler.h"
+#include "video_core/macro/macro_threaded_interpreter.h"
 
 #ifdef ARCHITECTURE_x86_64
 #include "video_core/macro/macro_jit_x64.h"
@@ -26,6 +29,17 @@
 MICROPROFILE_DEFINE(MacroHLE, "GPU", "Execute macro HLE", MP_RGB(128, 192, 192));
 
 namespace Tegra {
+namespace {
+using Clock = std::chrono::steady_clock;
+
+/// Number of macros listed in the profile report logged at shutdown
+constexpr size_t MAX_PROFILE_REPORT_ENTRIES = 32;
+
+u64 ElapsedNs(Clock::time_point start) {
+    return static_cast<u64>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+}
+} // Anonymous namespace
 
 static void Dump(u64 hash, std::span<const u32> code, bool decompiled = false) {
     const auto base_dir{Common::FS::GetCitronPath(Common::FS::CitronPath::DumpDir)};
@@ -55,9 +69,17 @@ static void Dump(u64 hash, std::span<const u32> code, bool decompiled = false) {
 }
 
 MacroEngine::MacroEngine(Engines::Maxwell3D& maxwell3d_)
-    : hle_macros{std::make_unique<Tegra::HLEMacro>(maxwell3d_)}, maxwell3d{maxwell3d_} {}
+    : hle_macros{std::make_unique<Tegra::HLEMacro>(maxwell3d_)}, maxwell3d{maxwell3d_} {
+    if (Settings::values.profile_macros) {
+        profiler = std::make_unique<MacroProfiler>();
+    }
+}
 
-MacroEngine::~MacroEngine() = default;
+MacroEngine::~MacroEngine() {
+    if (profiler) {
+        profiler->LogReport(MAX_PROFILE_REPORT_ENTRIES);
+    }
+}
 
 void MacroEngine::AddCode(u32 method, u32 data) {
     uploaded_macro_code[method].push_back(data);
@@ -71,15 +93,9 @@ void MacroEngine::ClearCode(u32 method) {
 void MacroEngine::Execute(u32 method, const std::vector<u32>& parameters) {
     auto compiled_macro = macro_cache.find(method);
     if (compiled_macro != macro_cache.end()) {
-        const auto& cache_info = compiled_macro->second;
-        if (cache_info.has_hle_program) {
-            MICROPROFILE_SCOPE(MacroHLE);
-            cache_info.hle_program->Execute(parameters, method);
-        } else {
-            maxwell3d.RefreshParameters();
-            cache_info.lle_program->Execute(parameters, method);
-        }
+        ExecuteProgram(compiled_macro->second, method, parameters);
     } else {
+        const auto compile_start = profiler ? Clock::now() : Clock::time_point{};
         // Macro not compiled, check if it's uploaded and if so, compile it
         std::optional<u32> mid_method;
         const auto macro_code = uploaded_macro_code.find(method);
@@ -112,15 +128,15 @@ void MacroEngine::Execute(u32 method, const std::vector<u32>& parameters) {
         }
 
         auto hle_program = hle_macros->GetHLEProgram(cache_info.hash);
-        if (!hle_program || Settings::values.disable_macro_hle) {
-            maxwell3d.RefreshParameters();
-            cache_info.lle_program->Execute(parameters, method);
-        } else {
+        if (hle_program && !Settings::values.disable_macro_hle) {
             cache_info.has_hle_program = true;
             cache_info.hle_program = std::move(hle_program);
-            MICROPROFILE_SCOPE(MacroHLE);
-            cache_info.hle_program->Execute(parameters, method);
         }
+        if (profiler) {
+            profiler->RecordCompile(cache_info.hash, uploaded_macro_code[method].size(),
+                                    ElapsedNs(compile_start));
+        }
+        ExecuteProgram(cache_info, method, parameters);
 
         if (Settings::values.dump_macros) {
             Dump(cache_info.hash, macro_code->second, cache_info.has_hle_program);
@@ -128,15 +144,33 @@ void MacroEngine::Execute(u32 method, const std::vector<u32>& parameters) {
     }
 }
 
-std::unique_ptr<MacroEngine> GetMacroEngine(Engines::Maxwell3D& maxwell3d) {
-    if (Settings::values.disable_macro_jit) {
-        return std::make_unique<MacroInterpreter>(maxwell3d);
+void MacroEngine::ExecuteProgram(const CacheInfo& cache_info, u32 method,
+                                 const std::vector<u32>& parameters) {
+    const auto start = profiler ? Clock::now() : Clock::time_point{};
+    if (cache_info.has_hle_program) {
+        MICROPROFILE_SCOPE(MacroHLE);
+        cache_info.hle_program->Execute(parameters, method);
+    } else {
+        maxwell3d.RefreshParameters();
+        cache_info.lle_program->Execute(parameters, method);
     }
+    if (profiler) {
+        const MacroBackend backend =
+            cache_info.has_hle_program ? MacroBackend::HLE : GetBackend();
+        profiler->RecordExecution(cache_info.hash, backend, parameters.size(), ElapsedNs(start));
+    }
+}
+
+std::unique_ptr<MacroEngine> GetMacroEngine(Engines::Maxwell3D& maxwell3d) {
 #ifdef ARCHITECTURE_x86_64
-    return std::make_unique<MacroJITx64>(maxwell3d);
-#else
-    return std::make_unique<MacroInterpreter>(maxwell3d);
+    if (!Settings::values.disable_macro_jit) {
+        return std::make_unique<MacroJITx64>(maxwell3d);
+    }
 #endif
+    if (Settings::values.disable_macro_threaded_interpreter) {
+        return std::make_unique<MacroInterpreter>(maxwell3d);
+    }
+    return std::make_unique<MacroThreadedInterpreter>(maxwell3d);
 }
 
 } // namespace Tegra
@@ -8,6 +8,7 @@
 #include <vector>
 #include "common/bit_field.h"
 #include "common/common_types.h"
+#include "video_core/macro/macro_profiler.h"
 
 namespace Tegra {
 
@@ -79,7 +80,7 @@ union Opcode {
     BitField<27, 5, u32> bf_dst_bit;
 
     u32 GetBitfieldMask() const {
-        return (1 << bf_size) - 1;
+        return (1U << bf_size) - 1;
     }
 
     s32 GetBranchTarget() const {
@@ -126,6 +127,9 @@ public:
 protected:
     virtual std::unique_ptr<CachedMacro> Compile(const std::vector<u32>& code) = 0;
 
+    /// Returns the backend executing the programs returned by Compile
+    virtual MacroBackend GetBackend() const = 0;
+
 private:
     struct CacheInfo {
         std::unique_ptr<CachedMacro> lle_program{};
@@ -134,9 +138,13 @@ private:
         bool has_hle_program{};
     };
 
+    void ExecuteProgram(const CacheInfo& cache_info, u32 method,
+                        const std::vector<u32>& parameters);
+
     std::unordered_map<u32, CacheInfo> macro_cache;
     std::unordered_map<u32, std::vector<u32>> uploaded_macro_code;
     std::unique_ptr<HLEMacro> hle_macros;
+    std::unique_ptr<MacroProfiler> profiler;
     Engines::Maxwell3D& maxwell3d;
 };
 
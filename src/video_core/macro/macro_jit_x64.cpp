@@ -264,7 +264,7 @@ void MacroJITx64Impl::Compile_AddImmediate(Macro::Opcode opcode) {
         }
     } else {
         auto result = Compile_GetRegister(opcode.src_a, RESULT);
-        if (opcode.immediate > 2) {
+        if (opcode.immediate >= 2) {
             add(result, opcode.immediate);
         } else if (opcode.immediate == 1) {
             inc(result);
@@ -320,7 +320,7 @@ void MacroJITx64Impl::Compile_Read(Macro::Opcode opcode) {
         }
     } else {
         auto result = Compile_GetRegister(opcode.src_a, RESULT);
-        if (opcode.immediate > 2) {
+        if (opcode.immediate >= 2) {
             add(result, opcode.immediate);
         } else if (opcode.immediate == 1) {
             inc(result);
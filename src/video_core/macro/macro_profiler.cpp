@@ -0,0 +1,89 @@
+// SPDX-FileCopyrightText: Copyright 2026 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+
+#include "common/logging/log.h"
+#include "video_core/macro/macro_profiler.h"
+
+namespace Tegra {
+
+std::string_view NameOf(MacroBackend backend) {
+    switch (backend) {
+    case MacroBackend::Interpreter:
+        return "interpreter";
+    case MacroBackend::ThreadedInterpreter:
+        return "threaded interpreter";
+    case MacroBackend::JIT:
+        return "JIT";
+    case MacroBackend::HLE:
+        return "HLE";
+    }
+    return "unknown";
+}
+
+void MacroProfiler::RecordCompile(u64 hash, size_t code_size, u64 ns) {
+    Entry& entry = entries[hash];
+    entry.hash = hash;
+    entry.code_size = code_size;
+    entry.compile_ns += ns;
+}
+
+void MacroProfiler::RecordExecution(u64 hash, MacroBackend backend, size_t num_arguments,
+                                    u64 ns) {
+    Entry& entry = entries[hash];
+    entry.hash = hash;
+    entry.backend = backend;
+    ++entry.calls;
+    entry.arguments += num_arguments;
+    entry.host_ns += ns;
+}
+
+std::vector<MacroProfiler::Entry> MacroProfiler::Report() const {
+    std::vector<Entry> report;
+    report.reserve(entries.size());
+    u64 total_ns = 0;
+    for (const auto& [hash, entry] : entries) {
+        report.push_back(entry);
+        total_ns += entry.host_ns;
+    }
+    for (Entry& entry : report) {
+        entry.hle_candidate = entry.backend != MacroBackend::HLE && entry.calls > 0 &&
+                              entry.host_ns * 100 >= total_ns * HOT_MACRO_PERCENT;
+    }
+    std::ranges::sort(report, [](const Entry& lhs, const Entry& rhs) {
+        return lhs.host_ns != rhs.host_ns ? lhs.host_ns > rhs.host_ns : lhs.hash < rhs.hash;
+    });
+    return report;
+}
+
+void MacroProfiler::LogReport(size_t max_entries) const {
+    const std::vector<Entry> report = Report();
+    u64 total_ns = 0;
+    u64 total_calls = 0;
+    for (const Entry& entry : report) {
+        total_ns += entry.host_ns;
+        total_calls += entry.calls;
+    }
+    LOG_INFO(HW_GPU, "Macro profile: {} macros, {} calls, {:.3f} ms", report.size(), total_calls,
+             static_cast<double>(total_ns) / 1e6);
+    for (size_t i = 0; i < std::min(max_entries, report.size()); ++i) {
+        const Entry& entry = report[i];
+        const double calls = static_cast<double>(std::max<u64>(entry.calls, 1));
+        const double arguments = static_cast<double>(std::max<u64>(entry.arguments, 1));
+        LOG_INFO(HW_GPU,
+                 "  {:016X} {:>20}: {} calls, {} arguments, {:.3f} ms ({:.1f}%), {:.0f} ns/call, "
+                 "{:.1f} ns/argument, {} instructions, {:.3f} ms compiling{}",
+                 entry.hash, NameOf(entry.backend), entry.calls, entry.arguments,
+                 static_cast<double>(entry.host_ns) / 1e6,
+                 total_ns != 0 ? static_cast<double>(entry.host_ns) * 100.0 /
+                                     static_cast<double>(total_ns)
+                               : 0.0,
+                 static_cast<double>(entry.host_ns) / calls,
+                 static_cast<double>(entry.host_ns) / arguments, entry.code_size,
+                 static_cast<double>(entry.compile_ns) / 1e6,
+                 entry.hle_candidate ? ", HLE candidate" : "");
+    }
+}
+
+} // namespace Tegra
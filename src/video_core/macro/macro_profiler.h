@@ -0,0 +1,61 @@
+// SPDX-FileCopyrightText: Copyright 2026 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "common/common_types.h"
+
+namespace Tegra {
+
+/// Backend executing a macro
+enum class MacroBackend : u32 {
+    Interpreter,
+    ThreadedInterpreter,
+    JIT,
+    HLE,
+};
+
+[[nodiscard]] std::string_view NameOf(MacroBackend backend);
+
+/**
+ * Records how much host time is spent in each macro, identified by the hash of its code.
+ * The report flags the macros running on a low level backend that take a large share of the
+ * macro time, those are the candidates for new HLE implementations.
+ */
+class MacroProfiler {
+public:
+    /// Share of the total macro time, in percent, from which a low level macro is flagged
+    static constexpr u64 HOT_MACRO_PERCENT = 2;
+
+    struct Entry {
+        u64 hash{};
+        MacroBackend backend{};
+        u64 code_size{};
+        u64 calls{};
+        u64 arguments{};
+        u64 host_ns{};
+        u64 compile_ns{};
+        bool hle_candidate{};
+    };
+
+    /// Records the translation of a macro, and the lookup of its HLE implementation
+    void RecordCompile(u64 hash, size_t code_size, u64 ns);
+
+    /// Records an execution of a macro with its number of method arguments
+    void RecordExecution(u64 hash, MacroBackend backend, size_t num_arguments, u64 ns);
+
+    /// Returns the recorded macros sorted by decreasing host time
+    [[nodiscard]] std::vector<Entry> Report() const;
+
+    /// Logs the report, up to max_entries macros
+    void LogReport(size_t max_entries) const;
+
+private:
+    std::unordered_map<u64, Entry> entries;
+};
+
+} // namespace Tegra
@@ -0,0 +1,430 @@
+// SPDX-FileCopyrightText: Copyright 2026 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <span>
+
+#include "common/assert.h"
+#include "common/logging/log.h"
+#include "common/microprofile.h"
+#include "video_core/engines/maxwell_3d.h"
+#include "video_core/macro/macro_threaded_interpreter.h"
+
+MICROPROFILE_DEFINE(MacroThreaded, "GPU", "Execute macro threaded interpreter",
+                    MP_RGB(128, 160, 192));
+
+#if defined(__GNUC__) || defined(__clang__)
+#define MACRO_COMPUTED_GOTO
+#endif
+
+namespace Tegra {
+namespace {
+
+// Handlers of pre-decoded instructions, the order defines the dispatch table
+#define THREADED_MACRO_OPS(X)                                                                      \
+    X(Add)                                                                                         \
+    X(AddWithCarry)                                                                                \
+    X(Subtract)                                                                                    \
+    X(SubtractWithBorrow)                                                                          \
+    X(Xor)                                                                                         \
+    X(Or)                                                                                          \
+    X(And)                                                                                         \
+    X(AndNot)                                                                                      \
+    X(Nand)                                                                                        \
+    X(AddImmediate)                                                                                \
+    X(ExtractInsert)                                                                               \
+    X(ExtractShiftLeftImmediate)                                                                   \
+    X(ExtractShiftLeftRegister)                                                                    \
+    X(Read)                                                                                        \
+    X(BranchZero)                                                                                  \
+    X(BranchNotZero)                                                                               \
+    X(Fetch)                                                                                       \
+    X(AddImmediateMove)                                                                            \
+    X(Nop)                                                                                         \
+    X(DelaySlotBranch)                                                                             \
+    X(OutOfBounds)                                                                                 \
+    X(Exit)
+
+// Result operations in the order of Macro::ResultOperation
+#define THREADED_MACRO_RESULTS(X)                                                                  \
+    X(IgnoreAndFetch)                                                                              \
+    X(Move)                                                                                        \
+    X(MoveAndSetMethod)                                                                            \
+    X(FetchAndSend)                                                                                \
+    X(MoveAndSend)                                                                                 \
+    X(FetchAndSetMethod)                                                                           \
+    X(MoveAndSetMethodFetchAndSend)                                                                \
+    X(MoveAndSetMethodSend)
+
+enum class Op : u8 {
+#define DECLARE_OP(name) name,
+    THREADED_MACRO_OPS(DECLARE_OP)
+#undef DECLARE_OP
+};
+
+/// Writes to register 0 are redirected to this register, so reads of register 0 stay zero
+constexpr u8 SINK_REGISTER = Macro::NUM_MACRO_REGISTERS;
+
+struct Instruction {
+    Op op{};
+    Macro::ResultOperation result{};
+    u8 dst{};
+    u8 src_a{};
+    u8 src_b{};
+    u8 bf_src_bit{};
+    u8 bf_dst_bit{};
+    u32 immediate{};
+    u32 bf_mask{};
+    u32 next{};   ///< Instruction executed after this one, or when a branch is not taken
+    u32 target{}; ///< Instruction executed when a branch is taken
+};
+
+class ThreadedMacro final : public CachedMacro {
+public:
+    explicit ThreadedMacro(Engines::Maxwell3D& maxwell3d_, std::span<const u32> code);
+
+    void Execute(const std::vector<u32>& parameters, u32 method) override;
+
+private:
+    /// Decodes the operation and operands of an opcode, control flow is resolved by the caller
+    static Instruction Decode(Macro::Opcode opcode);
+
+    /**
+     * Appends a copy of the instruction at pc executed in a delay slot
+     *
+     * @param next Instruction executed after the delay slot
+     * @returns Index of the copy
+     */
+    u32 AddDelaySlot(std::span<const u32> code, u32 pc, u32 next);
+
+    Engines::Maxwell3D& maxwell3d;
+    std::vector<Instruction> instructions;
+};
+
+ThreadedMacro::ThreadedMacro(Engines::Maxwell3D& maxwell3d_, std::span<const u32> code)
+    : maxwell3d{maxwell3d_} {
+    // One instruction per opcode, followed by the sentinels and the delay slot copies
+    const u32 size = static_cast<u32>(code.size());
+    const u32 out_of_bounds = size;
+    const u32 exit = size + 1;
+    instructions.reserve(code.size() + 4);
+    for (u32 pc = 0; pc < size; ++pc) {
+        instructions.push_back(Decode(Macro::Opcode{code[pc]}));
+    }
+    instructions.push_back(Instruction{.op = Op::OutOfBounds});
+    instructions.push_back(Instruction{.op = Op::Exit});
+
+    for (u32 pc = 0; pc < size; ++pc) {
+        const Macro::Opcode opcode{code[pc]};
+        // An exit has a delay slot, and is ignored on branches that are taken
+        const u32 next = opcode.is_exit ? AddDelaySlot(code, pc + 1, exit) : pc + 1;
+        instructions[pc].next = next;
+        if (opcode.operation != Macro::Operation::Branch) {
+            continue;
+        }
+        const s64 branch_pc = static_cast<s64>(pc) + opcode.immediate;
+        const u32 target =
+            branch_pc >= 0 && branch_pc < size ? static_cast<u32>(branch_pc) : out_of_bounds;
+        // Branches with the annul bit skip their delay slot
+        instructions[pc].target = opcode.branch_annul ? target : AddDelaySlot(code, pc + 1, target);
+    }
+}
+
+Instruction ThreadedMacro::Decode(Macro::Opcode opcode) {
+    Instruction inst{
+        .op = Op::Nop,
+        .result = opcode.result_operation,
+        .dst = opcode.dst == 0 ? SINK_REGISTER : static_cast<u8>(opcode.dst.Value()),
+        .src_a = static_cast<u8>(opcode.src_a.Value()),
+        .src_b = static_cast<u8>(opcode.src_b.Value()),
+        .bf_src_bit = static_cast<u8>(opcode.bf_src_bit.Value()),
+        .bf_dst_bit = static_cast<u8>(opcode.bf_dst_bit.Value()),
+        .immediate = static_cast<u32>(opcode.immediate.Value()),
+        .bf_mask = opcode.GetBitfieldMask(),
+    };
+    switch (opcode.operation) {
+    case Macro::Operation::ALU:
+        switch (opcode.alu_operation) {
+        case Macro::ALUOperation::Add:
+            inst.op = Op::Add;
+            break;
+        case Macro::ALUOperation::AddWithCarry:
+            inst.op = Op::AddWithCarry;
+            break;
+        case Macro::ALUOperation::Subtract:
+            inst.op = Op::Subtract;
+            break;
+        case Macro::ALUOperation::SubtractWithBorrow:
+            inst.op = Op::SubtractWithBorrow;
+            break;
+        case Macro::ALUOperation::Xor:
+            inst.op = Op::Xor;
+            break;
+        case Macro::ALUOperation::Or:
+            inst.op = Op::Or;
+            break;
+        case Macro::ALUOperation::And:
+            inst.op = Op::And;
+            break;
+        case Macro::ALUOperation::AndNot:
+            inst.op = Op::AndNot;
+            break;
+        case Macro::ALUOperation::Nand:
+            inst.op = Op::Nand;
+            break;
+        default:
+            // The result of unknown operations is zero, it is still processed
+            UNIMPLEMENTED_MSG("Unimplemented ALU operation {}", opcode.alu_operation.Value());
+            inst.op = Op::AddImmediate;
+            inst.src_a = 0;
+            inst.immediate = 0;
+            break;
+        }
+        break;
+    case Macro::Operation::AddImmediate:
+        inst.op = Op::AddImmediate;
+        break;
+    case Macro::Operation::ExtractInsert:
+        inst.op = Op::ExtractInsert;
+        break;
+    case Macro::Operation::ExtractShiftLeftImmediate:
+        inst.op = Op::ExtractShiftLeftImmediate;
+        break;
+    case Macro::Operation::ExtractShiftLeftRegister:
+        inst.op = Op::ExtractShiftLeftRegister;
+        break;
+    case Macro::Operation::Read:
+        inst.op = Op::Read;
+        break;
+    case Macro::Operation::Branch:
+        inst.op = opcode.branch_condition == Macro::BranchCondition::Zero ? Op::BranchZero
+                                                                         : Op::BranchNotZero;
+        return inst;
+    default:
+        UNIMPLEMENTED_MSG("Unimplemented macro operation {}", opcode.operation.Value());
+        return inst;
+    }
+
+    // Fuse the most common result operations into their operation
+    const bool writes_carry = inst.op == Op::Add || inst.op == Op::AddWithCarry ||
+                              inst.op == Op::Subtract || inst.op == Op::SubtractWithBorrow;
+    if (inst.result == Macro::ResultOperation::IgnoreAndFetch && !writes_carry) {
+        inst.op = Op::Fetch;
+    } else if (inst.op == Op::AddImmediate && inst.result == Macro::ResultOperation::Move) {
+        inst.op = Op::AddImmediateMove;
+    }
+    return inst;
+}
+
+u32 ThreadedMacro::AddDelaySlot(std::span<const u32> code, u32 pc, u32 next) {
+    if (pc >= code.size()) {
+        return static_cast<u32>(code.size());
+    }
+    Instruction inst = Decode(Macro::Opcode{code[pc]});
+    if (inst.op == Op::BranchZero || inst.op == Op::BranchNotZero) {
+        inst.op = Op::DelaySlotBranch;
+    }
+    inst.next = next;
+    instructions.push_back(inst);
+    return static_cast<u32>(instructions.size() - 1);
+}
+
+void ThreadedMacro::Execute(const std::vector<u32>& parameters, u32 method) {
+    MICROPROFILE_SCOPE(MacroThreaded);
+
+    std::array<u32, Macro::NUM_MACRO_REGISTERS + 1> registers{};
+    registers[1] = parameters[0];
+    // The first parameter is already in $r1
+    size_t next_parameter = 1;
+    Macro::MethodAddress method_address{};
+    bool carry_flag = false;
+    u32 value = 0;
+
+    const auto fetch = [&]() -> u32 {
+        if (next_parameter >= parameters.size()) {
+            ASSERT_MSG(false, "Macro fetched more than its {} parameters", parameters.size());
+            return 0;
+        }
+        return parameters[next_parameter++];
+    };
+    const auto send = [&](u32 argument) {
+        maxwell3d.CallMethod(method_address.address, argument, true);
+        method_address.address.Assign(method_address.address.Value() +
+                                      method_address.increment.Value());
+    };
+
+    const Instruction* const base = instructions.data();
+    const Instruction* inst = base;
+
+#ifdef MACRO_COMPUTED_GOTO
+#define HANDLER_ADDRESS(name) &&op_##name,
+#define RESULT_ADDRESS(name) &&result_##name,
+    static void* const op_table[] = {THREADED_MACRO_OPS(HANDLER_ADDRESS)};
+    static void* const result_table[] = {THREADED_MACRO_RESULTS(RESULT_ADDRESS)};
+#undef HANDLER_ADDRESS
+#undef RESULT_ADDRESS
+#define DISPATCH() goto* op_table[static_cast<size_t>(inst->op)]
+#define COMMIT() goto* result_table[static_cast<size_t>(inst->result)]
+#else
+#define DISPATCH() goto dispatch
+#define COMMIT() goto commit
+#endif
+#define NEXT()                                                                                     \
+    inst = base + inst->next;                                                                      \
+    DISPATCH()
+
+    DISPATCH();
+
+#ifndef MACRO_COMPUTED_GOTO
+dispatch:
+    switch (inst->op) {
+#define HANDLER_CASE(name)                                                                         \
+    case Op::name:                                                                                 \
+        goto op_##name;
+        THREADED_MACRO_OPS(HANDLER_CASE)
+#undef HANDLER_CASE
+    }
+commit:
+    switch (inst->result) {
+#define RESULT_CASE(name)                                                                          \
+    case Macro::ResultOperation::name:                                                             \
+        goto result_##name;
+        THREADED_MACRO_RESULTS(RESULT_CASE)
+#undef RESULT_CASE
+    }
+#endif
+
+op_Add: {
+    const u64 result{static_cast<u64>(registers[inst->src_a]) + registers[inst->src_b]};
+    carry_flag = result > 0xffffffff;
+    value = static_cast<u32>(result);
+    COMMIT();
+}
+op_AddWithCarry: {
+    const u64 result{static_cast<u64>(registers[inst->src_a]) + registers[inst->src_b] +
+                     (carry_flag ? 1ULL : 0ULL)};
+    carry_flag = result > 0xffffffff;
+    value = static_cast<u32>(result);
+    COMMIT();
+}
+op_Subtract: {
+    const u64 result{static_cast<u64>(registers[inst->src_a]) - registers[inst->src_b]};
+    carry_flag = result < 0x100000000;
+    value = static_cast<u32>(result);
+    COMMIT();
+}
+op_SubtractWithBorrow: {
+    const u64 result{static_cast<u64>(registers[inst->src_a]) - registers[inst->src_b] -
+                     (carry_flag ? 0ULL : 1ULL)};
+    carry_flag = result < 0x100000000;
+    value = static_cast<u32>(result);
+    COMMIT();
+}
+op_Xor:
+    value = registers[inst->src_a] ^ registers[inst->src_b];
+    COMMIT();
+op_Or:
+    value = registers[inst->src_a] | registers[inst->src_b];
+    COMMIT();
+op_And:
+    value = registers[inst->src_a] & registers[inst->src_b];
+    COMMIT();
+op_AndNot:
+    value = registers[inst->src_a] & ~registers[inst->src_b];
+    COMMIT();
+op_Nand:
+    value = ~(registers[inst->src_a] & registers[inst->src_b]);
+    COMMIT();
+op_AddImmediate:
+    value = registers[inst->src_a] + inst->immediate;
+    COMMIT();
+op_ExtractInsert: {
+    const u32 src = (registers[inst->src_b] >> inst->bf_src_bit) & inst->bf_mask;
+    value = registers[inst->src_a] & ~(inst->bf_mask << inst->bf_dst_bit);
+    value |= src << inst->bf_dst_bit;
+    COMMIT();
+}
+op_ExtractShiftLeftImmediate:
+    value = ((registers[inst->src_b] >> registers[inst->src_a]) & inst->bf_mask)
+            << inst->bf_dst_bit;
+    COMMIT();
+op_ExtractShiftLeftRegister:
+    value = ((registers[inst->src_b] >> inst->bf_src_bit) & inst->bf_mask)
+            << registers[inst->src_a];
+    COMMIT();
+op_Read:
+    value = maxwell3d.GetRegisterValue(registers[inst->src_a] + inst->immediate);
+    COMMIT();
+op_BranchZero:
+    inst = base + (registers[inst->src_a] == 0 ? inst->target : inst->next);
+    DISPATCH();
+op_BranchNotZero:
+    inst = base + (registers[inst->src_a] != 0 ? inst->target : inst->next);
+    DISPATCH();
+op_Fetch:
+    registers[inst->dst] = fetch();
+    NEXT();
+op_AddImmediateMove:
+    registers[inst->dst] = registers[inst->src_a] + inst->immediate;
+    NEXT();
+op_Nop:
+    NEXT();
+op_DelaySlotBranch:
+    ASSERT_MSG(false, "Executing a branch in a delay slot is not valid");
+    NEXT();
+
+result_IgnoreAndFetch:
+    registers[inst->dst] = fetch();
+    NEXT();
+result_Move:
+    registers[inst->dst] = value;
+    NEXT();
+result_MoveAndSetMethod:
+    registers[inst->dst] = value;
+    method_address.raw = value;
+    NEXT();
+result_FetchAndSend:
+    registers[inst->dst] = fetch();
+    send(value);
+    NEXT();
+result_MoveAndSend:
+    registers[inst->dst] = value;
+    send(value);
+    NEXT();
+result_FetchAndSetMethod:
+    registers[inst->dst] = fetch();
+    method_address.raw = value;
+    NEXT();
+result_MoveAndSetMethodFetchAndSend:
+    registers[inst->dst] = value;
+    method_address.raw = value;
+    send(fetch());
+    NEXT();
+result_MoveAndSetMethodSend:
+    registers[inst->dst] = value;
+    method_address.raw = value;
+    send((value >> 12) & 0b111111);
+    NEXT();
+
+op_OutOfBounds:
+    ASSERT_MSG(false, "Macro executed past the end of its code");
+    return;
+op_Exit:
+    // Assert the the macro used all the input parameters
+    ASSERT(next_parameter == parameters.size());
+
+#undef DISPATCH
+#undef COMMIT
+#undef NEXT
+}
+
+} // Anonymous namespace
+
+MacroThreadedInterpreter::MacroThreadedInterpreter(Engines::Maxwell3D& maxwell3d_)
+    : MacroEngine{maxwell3d_}, maxwell3d{maxwell3d_} {}
+
+std::unique_ptr<CachedMacro> MacroThreadedInterpreter::Compile(const std::vector<u32>& code) {
+    return std::make_unique<ThreadedMacro>(maxwell3d, code);
+}
+
+} // namespace Tegra
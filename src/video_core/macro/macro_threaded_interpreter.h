@@ -0,0 +1,36 @@
+// SPDX-FileCopyrightText: Copyright 2026 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <vector>
+
+#include "common/common_types.h"
+#include "video_core/macro/macro.h"
+
+namespace Tegra {
+namespace Engines {
+class Maxwell3D;
+}
+
+/**
+ * Macro engine translating each macro once into an array of pre-decoded instructions.
+ * Operands, branch targets and delay slots are resolved at translation time and the instructions
+ * are executed with threaded dispatch, avoiding the per step decoding of MacroInterpreter.
+ */
+class MacroThreadedInterpreter final : public MacroEngine {
+public:
+    explicit MacroThreadedInterpreter(Engines::Maxwell3D& maxwell3d_);
+
+protected:
+    std::unique_ptr<CachedMacro> Compile(const std::vector<u32>& code) override;
+
+    MacroBackend GetBackend() const override {
+        return MacroBackend::ThreadedInterpreter;
+    }
+
+private:
+    Engines::Maxwell3D& maxwell3d;
+};
+
+} // namespace Tegra
@@ -19,6 +19,14 @@
 namespace Tegra {
 using Tegra::Memory::GuestMemoryFlags;
 
+namespace {
+/// Returns true when the range is not empty and within a single device page, ranges like this are
+/// linear in device memory regardless of the size of the GPU pages mapping them
+[[nodiscard]] bool IsWithinDevicePage(GPUVAddr gpu_addr, std::size_t size) {
+    return size != 0 && (gpu_addr & Core::DEVICE_PAGEMASK) + size <= Core::DEVICE_PAGESIZE;
+}
+} // Anonymous namespace
+
 std::atomic<size_t> MemoryManager::unique_identifier_generator{};
 
 MemoryManager::MemoryManager(Core::System& system_, MaxwellDeviceMemoryManager& memory_,
@@ -128,7 +136,10 @@ GPUVAddr MemoryManager::PageTableOp(GPUVAddr gpu_addr, [[maybe_unused]] DAddr de
         }
         remaining_size -= page_size;
     }
-    kind_map.Map(gpu_addr, gpu_addr + size, kind);
+    {
+        std::unique_lock<std::mutex> lock(guard);
+        kind_map.Map(gpu_addr, gpu_addr + size, kind);
+    }
     return gpu_addr;
 }
 
@@ -228,6 +239,27 @@ std::optional<DAddr> MemoryManager::GpuToCpuAddress(GPUVAddr gpu_addr) const {
     return dev_addr_base + (gpu_addr & big_page_mask);
 }
 
+std::optional<DAddr> MemoryManager::TranslateMapped(GPUVAddr gpu_addr) const {
+    if (!IsWithinGPUAddressRange(gpu_addr)) [[unlikely]] {
+        return std::nullopt;
+    }
+    switch (GetEntry<true>(gpu_addr)) {
+    case EntryType::Mapped:
+        return (static_cast<DAddr>(big_page_table_dev[PageEntryIndex<true>(gpu_addr)])
+                << cpu_page_bits) +
+               (gpu_addr & big_page_mask);
+    case EntryType::Free:
+        if (GetEntry<false>(gpu_addr) != EntryType::Mapped) {
+            return std::nullopt;
+        }
+        return (static_cast<DAddr>(page_table[PageEntryIndex<false>(gpu_addr)])
+                << cpu_page_bits) +
+               (gpu_addr & page_mask);
+    default:
+        return std::nullopt;
+    }
+}
+
 std::optional<DAddr> MemoryManager::GpuToCpuAddress(GPUVAddr addr, std::size_t size) const {
     size_t page_index{addr >> page_bits};
     const size_t page_last{(addr + size + page_size - 1) >> page_bits};
@@ -368,6 +400,17 @@ inline void MemoryManager::MemoryOperation(GPUVAddr gpu_src_addr, std::size_t si
 template <bool is_safe>
 void MemoryManager::ReadBlockImpl(GPUVAddr gpu_src_addr, void* dest_buffer, std::size_t size,
                                   [[maybe_unused]] VideoCommon::CacheType which) const {
+    if (IsWithinDevicePage(gpu_src_addr, size)) [[likely]] {
+        const auto dev_addr{TranslateMapped(gpu_src_addr)};
+        const u8* const physical{dev_addr ? memory.GetPointer<u8>(*dev_addr) : nullptr};
+        if (physical) [[likely]] {
+            if constexpr (is_safe) {
+                rasterizer->FlushRegion(*dev_addr, size, which);
+            }
+            std::memcpy(dest_buffer, physical, size);
+            return;
+        }
+    }
     auto set_to_zero = [&]([[maybe_unused]] std::size_t page_index,
                            [[maybe_unused]] std::size_t offset, std::size_t copy_amount) {
         std::memset(dest_buffer, 0, copy_amount);
@@ -418,6 +461,17 @@ void MemoryManager::ReadBlockUnsafe(GPUVAddr gpu_src_addr, void* dest_buffer,
 template <bool is_safe>
 void MemoryManager::WriteBlockImpl(GPUVAddr gpu_dest_addr, const void* src_buffer, std::size_t size,
                                    [[maybe_unused]] VideoCommon::CacheType which) {
+    if (IsWithinDevicePage(gpu_dest_addr, size)) [[likely]] {
+        const auto dev_addr{TranslateMapped(gpu_dest_addr)};
+        u8* const physical{dev_addr ? memory.GetPointer<u8>(*dev_addr) : nullptr};
+        if (physical) [[likely]] {
+            if constexpr (is_safe) {
+                rasterizer->InvalidateRegion(*dev_addr, size, which);
+            }
+            std::memcpy(physical, src_buffer, size);
+            return;
+        }
+    }
     auto just_advance = [&]([[maybe_unused]] std::size_t page_index,
                             [[maybe_unused]] std::size_t offset, std::size_t copy_amount) {
         src_buffer = static_cast<const u8*>(src_buffer) + copy_amount;
@@ -687,6 +741,16 @@ void MemoryManager::GetSubmappedRangeImpl(
     boost::container::small_vector<
         std::pair<std::conditional_t<is_gpu_address, GPUVAddr, DAddr>, std::size_t>, 32>& result)
     const {
+    if (IsWithinDevicePage(gpu_addr, size)) {
+        if (const auto dev_addr{TranslateMapped(gpu_addr)}) {
+            if constexpr (is_gpu_address) {
+                result.emplace_back(gpu_addr, size);
+            } else {
+                result.emplace_back(*dev_addr, size);
+            }
+            return;
+        }
+    }
     std::optional<std::pair<std::conditional_t<is_gpu_address, GPUVAddr, DAddr>, std::size_t>>
         last_segment{};
     std::optional<DAddr> old_page_addr{};
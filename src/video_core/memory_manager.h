@@ -162,6 +162,10 @@ private:
     inline void MemoryOperation(GPUVAddr gpu_src_addr, std::size_t size, FuncMapped&& func_mapped,
                                 FuncReserved&& func_reserved, FuncUnmapped&& func_unmapped) const;
 
+    /// Translates an address the same way MemoryOperation does, small pages below a reserved big
+    /// page are not considered mapped
+    [[nodiscard]] std::optional<DAddr> TranslateMapped(GPUVAddr gpu_addr) const;
+
     template <bool is_safe>
     void ReadBlockImpl(GPUVAddr gpu_src_addr, void* dest_buffer, std::size_t size,
                        VideoCommon::CacheType which) const;
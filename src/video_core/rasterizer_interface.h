@@ -159,6 +159,9 @@ public:
     virtual void LoadDiskResources(u64 title_id, std::stop_token stop_loading,
                                    const DiskResourceLoadCallback& callback) {}
 
+    /// Initialize the disk cache of transcoded textures for the game being emulated
+    virtual void LoadDiskTextureCache(u64 title_id) {}
+
     virtual void InitializeChannel(Tegra::Control::ChannelState& channel) {}
 
     virtual void BindChannel(Tegra::Control::ChannelState& channel) {}
@@ -155,6 +155,11 @@ void RasterizerOpenGL::LoadDiskResources(u64 title_id, std::stop_token stop_load
     shader_cache.LoadDiskResources(title_id, stop_loading, callback);
 }
 
+void RasterizerOpenGL::LoadDiskTextureCache(u64 title_id) {
+    std::scoped_lock lock{texture_cache.mutex};
+    texture_cache.LoadDiskResources(title_id);
+}
+
 void RasterizerOpenGL::Clear(u32 layer_count) {
     MICROPROFILE_SCOPE(OpenGL_Clears);
 
@@ -125,6 +125,7 @@ public:
                                   std::span<const u8> memory) override;
     void LoadDiskResources(u64 title_id, std::stop_token stop_loading,
                            const VideoCore::DiskResourceLoadCallback& callback) override;
+    void LoadDiskTextureCache(u64 title_id) override;
 
     /// Returns true when there are commands queued to the OpenGL server.
     bool AnyCommandQueued() const {
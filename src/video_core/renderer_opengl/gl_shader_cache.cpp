@@ -2,7 +2,6 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <atomic>
-#include <fstream>
 #include <functional>
 #include <mutex>
 #include <string>
@@ -290,12 +289,15 @@ void ShaderCache::LoadDiskResources(u64 title_id, std::stop_token stop_loading,
             workers->QueueWork(std::move(work));
         }
     }};
-    const auto load_compute{[&](std::ifstream& file, FileEnvironment env) {
-        ComputePipelineKey key;
-        file.read(reinterpret_cast<char*>(&key), sizeof(key));
-        queue_work([this, key, env_ = std::move(env), &state, &callback](Context* ctx) mutable {
+    const auto load_compute{[&](VideoCommon::SerializedPipeline serialized) {
+        const auto key{serialized.ReadKey<ComputePipelineKey>()};
+        queue_work([this, key, serialized_ = std::move(serialized), &state,
+                    &callback](Context* ctx) mutable {
+            std::vector<FileEnvironment> envs{serialized_.Deserialize()};
             ctx->pools.ReleaseContents();
-            auto pipeline{CreateComputePipeline(ctx->pools, key, env_, true)};
+            auto pipeline{envs.empty()
+                              ? nullptr
+                              : CreateComputePipeline(ctx->pools, key, envs.front(), true)};
             std::scoped_lock lock{state.mutex};
             if (pipeline) {
                 compute_cache.emplace(key, std::move(pipeline));
@@ -307,16 +309,19 @@ void ShaderCache::LoadDiskResources(u64 title_id, std::stop_token stop_loading,
         });
         ++state.total;
     }};
-    const auto load_graphics{[&](std::ifstream& file, std::vector<FileEnvironment> envs) {
-        GraphicsPipelineKey key;
-        file.read(reinterpret_cast<char*>(&key), sizeof(key));
-        queue_work([this, key, envs_ = std::move(envs), &state, &callback](Context* ctx) mutable {
+    const auto load_graphics{[&](VideoCommon::SerializedPipeline serialized) {
+        const auto key{serialized.ReadKey<GraphicsPipelineKey>()};
+        queue_work([this, key, serialized_ = std::move(serialized), &state,
+                    &callback](Context* ctx) mutable {
+            std::vector<FileEnvironment> envs{serialized_.Deserialize()};
             boost::container::static_vector<Shader::Environment*, 5> env_ptrs;
-            for (auto& env : envs_) {
+            for (auto& env : envs) {
                 env_ptrs.push_back(&env);
             }
             ctx->pools.ReleaseContents();
-            auto pipeline{CreateGraphicsPipeline(ctx->pools, key, MakeSpan(env_ptrs), false, true)};
+            auto pipeline{envs.empty() ? nullptr
+                                       : CreateGraphicsPipeline(ctx->pools, key, MakeSpan(env_ptrs),
+                                                                false, true)};
             std::scoped_lock lock{state.mutex};
             if (pipeline) {
                 graphics_cache.emplace(key, std::move(pipeline));
@@ -328,7 +333,8 @@ void ShaderCache::LoadDiskResources(u64 title_id, std::stop_token stop_loading,
         });
         ++state.total;
     }};
-    LoadPipelines(stop_loading, shader_cache_filename, CACHE_VERSION, load_compute, load_graphics);
+    LoadPipelines<ComputePipelineKey, GraphicsPipelineKey>(
+        stop_loading, shader_cache_filename, CACHE_VERSION, load_compute, load_graphics);
 
     LOG_INFO(Render_OpenGL, "Total Pipeline Count: {}", state.total);
 
@@ -450,6 +456,7 @@ std::unique_ptr<GraphicsPipeline> ShaderCache::CreateGraphicsPipeline(
     ShaderContext::ShaderPools& pools, const GraphicsPipelineKey& key,
     std::span<Shader::Environment* const> envs, bool use_shader_workers,
     bool force_context_flush) try {
+    const Shader::ScopedArena scoped_arena{pools.arena};
     auto hash = key.Hash();
     LOG_INFO(Render_OpenGL, "0x{:016x}", hash);
     size_t env_index{};
@@ -572,6 +579,7 @@ std::unique_ptr<ComputePipeline> ShaderCache::CreateComputePipeline(
 std::unique_ptr<ComputePipeline> ShaderCache::CreateComputePipeline(
     ShaderContext::ShaderPools& pools, const ComputePipelineKey& key, Shader::Environment& env,
     bool force_context_flush) try {
+    const Shader::ScopedArena scoped_arena{pools.arena};
     auto hash = key.Hash();
     LOG_INFO(Render_OpenGL, "0x{:016x}", hash);
 
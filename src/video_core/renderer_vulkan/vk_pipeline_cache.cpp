@@ -61,6 +61,12 @@ auto MakeSpan(Container& container) {
     return std::span(container.data(), container.size());
 }
 
+/// Returns the pools of the calling worker, reused for every pipeline it recompiles
+ShaderPools& WorkerPools() {
+    thread_local ShaderPools pools;
+    return pools;
+}
+
 Shader::OutputTopology MaxwellToOutputTopology(Maxwell::PrimitiveTopology topology) {
     switch (topology) {
     case Maxwell::PrimitiveTopology::Points:
@@ -477,6 +483,11 @@ void PipelineCache::LoadDiskResources(u64 title_id, std::stop_token stop_loading
         vulkan_pipeline_cache =
             LoadVulkanPipelineCache(vulkan_pipeline_cache_filename, CACHE_VERSION);
     }
+    // Dumping shaders needs their environments, which are only read when they are recompiled
+    if (!Settings::values.dump_shaders) {
+        module_cache.Open(base_dir / "vulkan_modules.bin",
+                          VideoCommon::ShaderModuleCache::BuildHash(profile, host_info));
+    }
 
     struct {
         std::mutex mutex;
@@ -489,13 +500,29 @@ void PipelineCache::LoadDiskResources(u64 title_id, std::stop_token stop_loading
     if (device.IsKhrPipelineExecutablePropertiesEnabled()) {
         state.statistics = std::make_unique<PipelineStatistics>(device);
     }
-    const auto load_compute{[&](std::ifstream& file, FileEnvironment env) {
-        ComputePipelineCacheKey key;
-        file.read(reinterpret_cast<char*>(&key), sizeof(key));
+    const auto load_compute{[&](VideoCommon::SerializedPipeline serialized) {
+        const auto key{serialized.ReadKey<ComputePipelineCacheKey>()};
 
-        workers.QueueWork([this, key, env_ = std::move(env), &state, &callback]() mutable {
-            ShaderPools pools;
-            auto pipeline{CreateComputePipeline(pools, key, env_, state.statistics.get(), false)};
+        workers.QueueWork([this, key, serialized_ = std::move(serialized), &state,
+                           &callback]() mutable {
+            const u64 pipeline_hash{serialized_.Hash()};
+            std::unique_ptr<ComputePipeline> pipeline;
+            if (const auto shaders{module_cache.Find(pipeline_hash)}) {
+                pipeline = CreateComputePipeline(key, *shaders, state.statistics.get(), false);
+            }
+            if (!pipeline) {
+                ShaderPools& pools{WorkerPools()};
+                pools.ReleaseContents();
+                std::vector<FileEnvironment> envs{serialized_.Deserialize()};
+                std::vector<VideoCommon::CachedShader> shaders;
+                if (!envs.empty()) {
+                    pipeline = CreateComputePipeline(pools, key, envs.front(),
+                                                     state.statistics.get(), false, &shaders);
+                }
+                if (pipeline) {
+                    module_cache.Insert(pipeline_hash, shaders);
+                }
+            }
             std::scoped_lock lock{state.mutex};
             if (pipeline) {
                 compute_cache.emplace(key, std::move(pipeline));
@@ -507,9 +534,8 @@ void PipelineCache::LoadDiskResources(u64 title_id, std::stop_token stop_loading
         });
         ++state.total;
     }};
-    const auto load_graphics{[&](std::ifstream& file, std::vector<FileEnvironment> envs) {
-        GraphicsPipelineCacheKey key;
-        file.read(reinterpret_cast<char*>(&key), sizeof(key));
+    const auto load_graphics{[&](VideoCommon::SerializedPipeline serialized) {
+        const auto key{serialized.ReadKey<GraphicsPipelineCacheKey>()};
 
         if ((key.state.extended_dynamic_state != 0) !=
                 dynamic_features.has_extended_dynamic_state ||
@@ -524,14 +550,30 @@ void PipelineCache::LoadDiskResources(u64 title_id, std::stop_token stop_loading
             (key.state.dynamic_vertex_input != 0) != dynamic_features.has_dynamic_vertex_input) {
             return;
         }
-        workers.QueueWork([this, key, envs_ = std::move(envs), &state, &callback]() mutable {
-            ShaderPools pools;
-            boost::container::static_vector<Shader::Environment*, 5> env_ptrs;
-            for (auto& env : envs_) {
-                env_ptrs.push_back(&env);
+        workers.QueueWork([this, key, serialized_ = std::move(serialized), &state,
+                           &callback]() mutable {
+            const u64 pipeline_hash{serialized_.Hash()};
+            std::unique_ptr<GraphicsPipeline> pipeline;
+            if (const auto shaders{module_cache.Find(pipeline_hash)}) {
+                pipeline = CreateGraphicsPipeline(key, *shaders, state.statistics.get(), false);
+            }
+            if (!pipeline) {
+                ShaderPools& pools{WorkerPools()};
+                pools.ReleaseContents();
+                std::vector<FileEnvironment> envs{serialized_.Deserialize()};
+                boost::container::static_vector<Shader::Environment*, 5> env_ptrs;
+                for (auto& env : envs) {
+                    env_ptrs.push_back(&env);
+                }
+                std::vector<VideoCommon::CachedShader> shaders;
+                if (!envs.empty()) {
+                    pipeline = CreateGraphicsPipeline(pools, key, MakeSpan(env_ptrs),
+                                                      state.statistics.get(), false, &shaders);
+                }
+                if (pipeline) {
+                    module_cache.Insert(pipeline_hash, shaders);
+                }
             }
-            auto pipeline{CreateGraphicsPipeline(pools, key, MakeSpan(env_ptrs),
-                                                 state.statistics.get(), false)};
 
             std::scoped_lock lock{state.mutex};
             if (pipeline) {
@@ -544,8 +586,8 @@ void PipelineCache::LoadDiskResources(u64 title_id, std::stop_token stop_loading
         });
         ++state.total;
     }};
-    VideoCommon::LoadPipelines(stop_loading, pipeline_cache_filename, CACHE_VERSION, load_compute,
-                               load_graphics);
+    VideoCommon::LoadPipelines<ComputePipelineCacheKey, GraphicsPipelineCacheKey>(
+        stop_loading, pipeline_cache_filename, CACHE_VERSION, load_compute, load_graphics);
 
     LOG_INFO(Render_Vulkan, "Total Pipeline Count: {}", state.total);
 
@@ -607,7 +649,8 @@ GraphicsPipeline* PipelineCache::BuiltPipeline(GraphicsPipeline* pipeline) const
 std::unique_ptr<GraphicsPipeline> PipelineCache::CreateGraphicsPipeline(
     ShaderPools& pools, const GraphicsPipelineCacheKey& key,
     std::span<Shader::Environment* const> envs, PipelineStatistics* statistics,
-    bool build_in_parallel) try {
+    bool build_in_parallel, std::vector<VideoCommon::CachedShader>* cached_shaders) try {
+    const Shader::ScopedArena scoped_arena{pools.arena};
     auto hash = key.Hash();
     LOG_INFO(Render_Vulkan, "0x{:016x}", hash);
     size_t env_index{0};
@@ -673,15 +716,28 @@ std::unique_ptr<GraphicsPipeline> PipelineCache::CreateGraphicsPipeline(
 
         const auto runtime_info{MakeRuntimeInfo(programs, key, program, previous_stage)};
         ConvertLegacyToGeneric(program, runtime_info);
-        const std::vector<u32> code{EmitSPIRV(profile, runtime_info, program, binding)};
+        std::vector<u32> code{EmitSPIRV(profile, runtime_info, program, binding)};
         device.SaveShader(code);
         modules[stage_index] = BuildShader(device, code);
         if (device.HasDebuggingToolAttached()) {
             const std::string name{fmt::format("Shader {:016x}", key.unique_hashes[index])};
             modules[stage_index].SetObjectNameEXT(name.c_str());
         }
+        if (cached_shaders) {
+            cached_shaders->push_back(VideoCommon::CachedShader{
+                .stage_index = static_cast<u32>(stage_index),
+                .info = {},
+                .code = std::move(code),
+            });
+        }
         previous_stage = &program;
     }
+    if (cached_shaders) {
+        // The pipeline is built from the information of each stage once every stage is emitted
+        for (VideoCommon::CachedShader& shader : *cached_shaders) {
+            shader.info = *infos[shader.stage_index];
+        }
+    }
     Common::ThreadWorker* const thread_worker{build_in_parallel ? &workers : nullptr};
     return std::make_unique<GraphicsPipeline>(
         scheduler, buffer_cache, texture_cache, vulkan_pipeline_cache, &shader_notify, device,
@@ -706,17 +762,46 @@ std::unique_ptr<GraphicsPipeline> PipelineCache::CreateGraphicsPipeline(
     return nullptr;
 }
 
+std::unique_ptr<GraphicsPipeline> PipelineCache::CreateGraphicsPipeline(
+    const GraphicsPipelineCacheKey& key, std::span<const VideoCommon::CachedShader> shaders,
+    PipelineStatistics* statistics, bool build_in_parallel) {
+    LOG_INFO(Render_Vulkan, "0x{:016x} (cached)", key.Hash());
+    std::array<const Shader::Info*, Maxwell::MaxShaderStage> infos{};
+    std::array<vk::ShaderModule, Maxwell::MaxShaderStage> modules;
+    for (const VideoCommon::CachedShader& shader : shaders) {
+        const size_t stage_index{shader.stage_index};
+        if (stage_index >= Maxwell::MaxShaderStage || infos[stage_index] != nullptr) {
+            return nullptr;
+        }
+        infos[stage_index] = &shader.info;
+        device.SaveShader(shader.code);
+        modules[stage_index] = BuildShader(device, shader.code);
+        if (device.HasDebuggingToolAttached()) {
+            const std::string name{
+                fmt::format("Shader {:016x}", key.unique_hashes[stage_index + 1])};
+            modules[stage_index].SetObjectNameEXT(name.c_str());
+        }
+    }
+    Common::ThreadWorker* const thread_worker{build_in_parallel ? &workers : nullptr};
+    return std::make_unique<GraphicsPipeline>(
+        scheduler, buffer_cache, texture_cache, vulkan_pipeline_cache, &shader_notify, device,
+        descriptor_pool, guest_descriptor_queue, thread_worker, statistics, render_pass_cache, key,
+        std::move(modules), infos);
+}
+
 std::unique_ptr<GraphicsPipeline> PipelineCache::CreateGraphicsPipeline() {
     GraphicsEnvironments environments;
     GetGraphicsEnvironments(environments, graphics_key.unique_hashes);
 
     main_pools.ReleaseContents();
-    auto pipeline{
-        CreateGraphicsPipeline(main_pools, graphics_key, environments.Span(), nullptr, true)};
+    std::vector<VideoCommon::CachedShader> shaders;
+    auto pipeline{CreateGraphicsPipeline(main_pools, graphics_key, environments.Span(), nullptr,
+                                         true, module_cache.IsOpen() ? &shaders : nullptr)};
     if (!pipeline || pipeline_cache_filename.empty()) {
         return pipeline;
     }
-    serialization_thread.QueueWork([this, key = graphics_key, envs = std::move(environments.envs)] {
+    serialization_thread.QueueWork([this, key = graphics_key, envs = std::move(environments.envs),
+                                    shaders = std::move(shaders)] {
         boost::container::static_vector<const GenericEnvironment*, Maxwell::MaxShaderProgram>
             env_ptrs;
         for (size_t index = 0; index < Maxwell::MaxShaderProgram; ++index) {
@@ -724,7 +809,11 @@ std::unique_ptr<GraphicsPipeline> PipelineCache::CreateGraphicsPipeline() {
                 env_ptrs.push_back(&envs[index]);
             }
         }
-        SerializePipeline(key, env_ptrs, pipeline_cache_filename, CACHE_VERSION);
+        const auto pipeline_hash{
+            SerializePipeline(key, env_ptrs, pipeline_cache_filename, CACHE_VERSION)};
+        if (pipeline_hash && !shaders.empty()) {
+            module_cache.Insert(*pipeline_hash, shaders);
+        }
     });
     return pipeline;
 }
@@ -737,20 +826,29 @@ std::unique_ptr<ComputePipeline> PipelineCache::CreateComputePipeline(
     env.SetCachedSize(shader->size_bytes);
 
     main_pools.ReleaseContents();
-    auto pipeline{CreateComputePipeline(main_pools, key, env, nullptr, true)};
+    std::vector<VideoCommon::CachedShader> shaders;
+    auto pipeline{CreateComputePipeline(main_pools, key, env, nullptr, true,
+                                        module_cache.IsOpen() ? &shaders : nullptr)};
     if (!pipeline || pipeline_cache_filename.empty()) {
         return pipeline;
     }
-    serialization_thread.QueueWork([this, key, env_ = std::move(env)] {
-        SerializePipeline(key, std::array<const GenericEnvironment*, 1>{&env_},
-                          pipeline_cache_filename, CACHE_VERSION);
-    });
+    serialization_thread.QueueWork(
+        [this, key, env_ = std::move(env), shaders = std::move(shaders)] {
+            const auto pipeline_hash{
+                SerializePipeline(key, std::array<const GenericEnvironment*, 1>{&env_},
+                                  pipeline_cache_filename, CACHE_VERSION)};
+            if (pipeline_hash && !shaders.empty()) {
+                module_cache.Insert(*pipeline_hash, shaders);
+            }
+        });
     return pipeline;
 }
 
 std::unique_ptr<ComputePipeline> PipelineCache::CreateComputePipeline(
     ShaderPools& pools, const ComputePipelineCacheKey& key, Shader::Environment& env,
-    PipelineStatistics* statistics, bool build_in_parallel) try {
+    PipelineStatistics* statistics, bool build_in_parallel,
+    std::vector<VideoCommon::CachedShader>* cached_shaders) try {
+    const Shader::ScopedArena scoped_arena{pools.arena};
     auto hash = key.Hash();
     if (device.HasBrokenCompute()) {
         LOG_ERROR(Render_Vulkan, "Skipping 0x{:016x}", hash);
@@ -767,13 +865,20 @@ std::unique_ptr<ComputePipeline> PipelineCache::CreateComputePipeline(
     }
 
     auto program{TranslateProgram(pools.inst, pools.block, env, cfg, host_info)};
-    const std::vector<u32> code{EmitSPIRV(profile, program)};
+    std::vector<u32> code{EmitSPIRV(profile, program)};
     device.SaveShader(code);
     vk::ShaderModule spv_module{BuildShader(device, code)};
     if (device.HasDebuggingToolAttached()) {
         const auto name{fmt::format("Shader {:016x}", key.unique_hash)};
         spv_module.SetObjectNameEXT(name.c_str());
     }
+    if (cached_shaders) {
+        cached_shaders->push_back(VideoCommon::CachedShader{
+            .stage_index = 0,
+            .info = program.info,
+            .code = std::move(code),
+        });
+    }
     Common::ThreadWorker* const thread_worker{build_in_parallel ? &workers : nullptr};
     return std::make_unique<ComputePipeline>(device, vulkan_pipeline_cache, descriptor_pool,
                                              guest_descriptor_queue, thread_worker, statistics,
@@ -784,6 +889,26 @@ std::unique_ptr<ComputePipeline> PipelineCache::CreateComputePipeline(
     return nullptr;
 }
 
+std::unique_ptr<ComputePipeline> PipelineCache::CreateComputePipeline(
+    const ComputePipelineCacheKey& key, std::span<const VideoCommon::CachedShader> shaders,
+    PipelineStatistics* statistics, bool build_in_parallel) {
+    if (shaders.size() != 1 || device.HasBrokenCompute()) {
+        return nullptr;
+    }
+    LOG_INFO(Render_Vulkan, "0x{:016x} (cached)", key.Hash());
+    const VideoCommon::CachedShader& shader{shaders.front()};
+    device.SaveShader(shader.code);
+    vk::ShaderModule spv_module{BuildShader(device, shader.code)};
+    if (device.HasDebuggingToolAttached()) {
+        const auto name{fmt::format("Shader {:016x}", key.unique_hash)};
+        spv_module.SetObjectNameEXT(name.c_str());
+    }
+    Common::ThreadWorker* const thread_worker{build_in_parallel ? &workers : nullptr};
+    return std::make_unique<ComputePipeline>(device, vulkan_pipeline_cache, descriptor_pool,
+                                             guest_descriptor_queue, thread_worker, statistics,
+                                             &shader_notify, shader.info, std::move(spv_module));
+}
+
 void PipelineCache::SerializeVulkanPipelineCache(const std::filesystem::path& filename,
                                                  const vk::PipelineCache& pipeline_cache,
                                                  u32 cache_version) try {
@@ -13,6 +13,7 @@
 
 #include "common/common_types.h"
 #include "common/thread_worker.h"
+#include "shader_recompiler/arena.h"
 #include "shader_recompiler/frontend/ir/basic_block.h"
 #include "shader_recompiler/frontend/ir/value.h"
 #include "shader_recompiler/frontend/maxwell/control_flow.h"
@@ -27,6 +28,7 @@
 #include "video_core/renderer_vulkan/vk_graphics_pipeline.h"
 #include "video_core/renderer_vulkan/vk_texture_cache.h"
 #include "video_core/shader_cache.h"
+#include "video_core/shader_module_cache.h"
 
 namespace Core {
 class System;
@@ -90,8 +92,10 @@ struct ShaderPools {
         flow_block.ReleaseContents();
         block.ReleaseContents();
         inst.ReleaseContents();
+        arena.Reset();
     }
 
+    Shader::Arena arena;
     Shader::ObjectPool<Shader::IR::Inst> inst{8192};
     Shader::ObjectPool<Shader::IR::Block> block{32};
     Shader::ObjectPool<Shader::Maxwell::Flow::Block> flow_block{32};
@@ -120,19 +124,28 @@ private:
 
     std::unique_ptr<GraphicsPipeline> CreateGraphicsPipeline();
 
+    /// Recompiles the pipeline, its shaders are returned in cached_shaders when it is not null
     std::unique_ptr<GraphicsPipeline> CreateGraphicsPipeline(
         ShaderPools& pools, const GraphicsPipelineCacheKey& key,
         std::span<Shader::Environment* const> envs, PipelineStatistics* statistics,
-        bool build_in_parallel);
+        bool build_in_parallel, std::vector<VideoCommon::CachedShader>* cached_shaders);
+
+    /// Builds the pipeline from shaders of the shader module cache
+    std::unique_ptr<GraphicsPipeline> CreateGraphicsPipeline(
+        const GraphicsPipelineCacheKey& key, std::span<const VideoCommon::CachedShader> shaders,
+        PipelineStatistics* statistics, bool build_in_parallel);
 
     std::unique_ptr<ComputePipeline> CreateComputePipeline(const ComputePipelineCacheKey& key,
                                                            const ShaderInfo* shader);
 
-    std::unique_ptr<ComputePipeline> CreateComputePipeline(ShaderPools& pools,
-                                                           const ComputePipelineCacheKey& key,
-                                                           Shader::Environment& env,
-                                                           PipelineStatistics* statistics,
-                                                           bool build_in_parallel);
+    std::unique_ptr<ComputePipeline> CreateComputePipeline(
+        ShaderPools& pools, const ComputePipelineCacheKey& key, Shader::Environment& env,
+        PipelineStatistics* statistics, bool build_in_parallel,
+        std::vector<VideoCommon::CachedShader>* cached_shaders);
+
+    std::unique_ptr<ComputePipeline> CreateComputePipeline(
+        const ComputePipelineCacheKey& key, std::span<const VideoCommon::CachedShader> shaders,
+        PipelineStatistics* statistics, bool build_in_parallel);
 
     void SerializeVulkanPipelineCache(const std::filesystem::path& filename,
                                       const vk::PipelineCache& pipeline_cache, u32 cache_version);
@@ -167,6 +180,8 @@ private:
     std::filesystem::path vulkan_pipeline_cache_filename;
     vk::PipelineCache vulkan_pipeline_cache;
 
+    VideoCommon::ShaderModuleCache module_cache;
+
     Common::ThreadWorker workers;
     Common::ThreadWorker serialization_thread;
     DynamicFeatures dynamic_features;
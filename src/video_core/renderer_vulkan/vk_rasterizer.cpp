@@ -845,6 +845,11 @@ void RasterizerVulkan::LoadDiskResources(u64 title_id, std::stop_token stop_load
     pipeline_cache.LoadDiskResources(title_id, stop_loading, callback);
 }
 
+void RasterizerVulkan::LoadDiskTextureCache(u64 title_id) {
+    std::scoped_lock lock{texture_cache.mutex};
+    texture_cache.LoadDiskResources(title_id);
+}
+
 void RasterizerVulkan::FlushWork() {
 #ifdef ANDROID
     static constexpr u32 DRAWS_TO_DISPATCH = 1024;
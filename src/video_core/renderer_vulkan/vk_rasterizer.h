@@ -127,6 +127,7 @@ public:
                                   std::span<const u8> memory) override;
     void LoadDiskResources(u64 title_id, std::stop_token stop_loading,
                            const VideoCore::DiskResourceLoadCallback& callback) override;
+    void LoadDiskTextureCache(u64 title_id) override;
 
     void InitializeChannel(Tegra::Control::ChannelState& channel) override;
 
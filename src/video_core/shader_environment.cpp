@@ -2,20 +2,28 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <algorithm>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
+#include <istream>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <sstream>
+#include <streambuf>
 #include <utility>
 
 #include "common/assert.h"
 #include "common/cityhash.h"
 #include "common/common_types.h"
 #include "common/div_ceil.h"
+#include "common/fs/file.h"
 #include "common/fs/fs.h"
+#include "common/fs/mapped_file.h"
 #include "common/fs/path_util.h"
 #include "common/logging/log.h"
 #include "common/polyfill_ranges.h"
+#include "common/zstd_compression.h"
 #include "shader_recompiler/environment.h"
 #include "video_core/engines/kepler_compute.h"
 #include "video_core/memory_manager.h"
@@ -25,8 +33,6 @@
 
 namespace VideoCommon {
 
-constexpr std::array<char, 8> MAGIC_NUMBER{'y', 'u', 'z', 'u', 'c', 'a', 'c', 'h'};
-
 constexpr size_t INST_SIZE = sizeof(u64);
 
 using Maxwell = Tegra::Engines::Maxwell3D::Regs;
@@ -193,7 +199,7 @@ void GenericEnvironment::Dump(u64 pipeline_hash, u64 shader_hash) {
     DumpImpl(pipeline_hash, shader_hash, code, read_highest, read_lowest, initial_offset, stage);
 }
 
-void GenericEnvironment::Serialize(std::ofstream& file) const {
+void GenericEnvironment::Serialize(std::ostream& file) const {
     const u64 code_size{static_cast<u64>(CachedSizeBytes())};
     const u64 num_texture_types{static_cast<u64>(texture_types.size())};
     const u64 num_texture_pixel_formats{static_cast<u64>(texture_pixel_formats.size())};
@@ -448,7 +454,7 @@ u32 ComputeEnvironment::ReadViewportTransformState() {
     return viewport_transform_state;
 }
 
-void FileEnvironment::Deserialize(std::ifstream& file) {
+void FileEnvironment::Deserialize(std::istream& file) {
     u64 code_size{};
     u64 num_texture_types{};
     u64 num_texture_pixel_formats{};
@@ -582,93 +588,546 @@ std::optional<Shader::ReplaceConstant> FileEnvironment::GetReplaceConstBuffer(u3
     return it->second;
 }
 
-void SerializePipeline(std::span<const char> key, std::span<const GenericEnvironment* const> envs,
-                       const std::filesystem::path& filename, u32 cache_version) try {
-    std::ofstream file(filename, std::ios::binary | std::ios::ate | std::ios::app);
-    file.exceptions(std::ifstream::failbit);
-    if (!file.is_open()) {
-        LOG_ERROR(Common_Filesystem, "Failed to open pipeline cache file {}",
-                  Common::FS::PathToUTF8String(filename));
-        return;
+namespace {
+constexpr std::array<char, 8> MAGIC_NUMBER{'c', 'i', 't', 'r', 'o', 'n', 'p', 'c'};
+constexpr std::array<char, 8> LEGACY_MAGIC_NUMBER{'y', 'u', 'z', 'u', 'c', 'a', 'c', 'h'};
+
+// Bump when the layout of the container changes, its contents are versioned by the backends
+constexpr u32 CONTAINER_VERSION = 1;
+
+constexpr u32 MAX_GRAPHICS_ENVS = 5;
+
+// The file is rewritten when dead records take more than a quarter of the live records' size
+constexpr u64 COMPACTION_DEAD_DIVISOR = 4;
+
+/**
+ * Pipelines are appended as self contained records after the header. An index record listing the
+ * offsets of every live pipeline is appended after loading whenever the file has changed, and the
+ * header points at the latest one. Records appended after the latest index are found by walking the
+ * file from it, and every record carries a checksum so a damaged one is skipped on its own.
+ */
+struct CacheHeader {
+    std::array<char, 8> magic;
+    u32 container_version;
+    u32 cache_version;
+    u64 index_offset; ///< Offset of the latest index record, zero when there is none
+};
+static_assert(std::is_trivially_copyable_v<CacheHeader>);
+
+enum class RecordType : u32 {
+    Compute,
+    Graphics,
+    Index,
+};
+
+struct RecordHeader {
+    u64 checksum; ///< Hash of the rest of the record
+    RecordType type;
+    u32 num_envs;
+    u32 key_size;
+    u32 payload_size;      ///< Size of the payload stored after the key
+    u32 uncompressed_size; ///< Size of the serialized environments before compression
+    u32 padding;
+};
+static_assert(std::is_trivially_copyable_v<RecordHeader>);
+static_assert(sizeof(RecordHeader) == 32);
+
+std::mutex cache_file_mutex;
+
+/// Read-only stream buffer over memory, lets environments be deserialized without copies
+class SpanStreamBuffer final : public std::streambuf {
+public:
+    explicit SpanStreamBuffer(std::span<const char> data) {
+        char* const begin = const_cast<char*>(data.data());
+        setg(begin, begin, begin + data.size());
     }
-    if (file.tellp() == 0) {
-        // Write header
-        file.write(MAGIC_NUMBER.data(), MAGIC_NUMBER.size())
-            .write(reinterpret_cast<const char*>(&cache_version), sizeof(cache_version));
+
+protected:
+    pos_type seekoff(off_type offset, std::ios_base::seekdir dir,
+                     std::ios_base::openmode which) override {
+        if ((which & std::ios_base::in) == 0) {
+            return pos_type(off_type(-1));
+        }
+        if (dir == std::ios_base::cur) {
+            offset += gptr() - eback();
+        } else if (dir == std::ios_base::end) {
+            offset += egptr() - eback();
+        }
+        if (offset < 0 || offset > egptr() - eback()) {
+            return pos_type(off_type(-1));
+        }
+        setg(eback(), eback() + offset, egptr());
+        return pos_type(offset);
     }
-    if (!std::ranges::all_of(envs, &GenericEnvironment::CanBeSerialized)) {
-        return;
+
+    pos_type seekpos(pos_type position, std::ios_base::openmode which) override {
+        return seekoff(off_type(position), std::ios_base::beg, which);
     }
-    const u32 num_envs{static_cast<u32>(envs.size())};
-    file.write(reinterpret_cast<const char*>(&num_envs), sizeof(num_envs));
-    for (const GenericEnvironment* const env : envs) {
-        env->Serialize(file);
+};
+
+CacheHeader MakeHeader(u32 cache_version, u64 index_offset) {
+    return CacheHeader{
+        .magic = MAGIC_NUMBER,
+        .container_version = CONTAINER_VERSION,
+        .cache_version = cache_version,
+        .index_offset = index_offset,
+    };
+}
+
+u64 RecordSize(const RecordHeader& record) {
+    return sizeof(RecordHeader) + u64{record.key_size} + record.payload_size;
+}
+
+/// Reads the header of the record at offset, returns false when the record does not fit the file
+bool ReadRecordHeader(std::span<const u8> data, u64 offset, RecordHeader& record) {
+    if (offset > data.size() || data.size() - offset < sizeof(RecordHeader)) {
+        return false;
     }
-    file.write(key.data(), key.size_bytes());
+    std::memcpy(&record, data.data() + offset, sizeof(record));
+    return RecordSize(record) <= data.size() - offset;
+}
 
-} catch (const std::ios_base::failure& e) {
-    LOG_ERROR(Common_Filesystem, "{}", e.what());
+u64 RecordChecksum(std::span<const u8> record) {
+    const std::span<const u8> hashed = record.subspan(sizeof(u64));
+    return Common::CityHash64(reinterpret_cast<const char*>(hashed.data()), hashed.size());
+}
+
+bool IsRecordIntact(std::span<const u8> data, u64 offset, const RecordHeader& record) {
+    return RecordChecksum(data.subspan(offset, RecordSize(record))) == record.checksum;
+}
+
+bool IsPipelineRecordValid(const RecordHeader& record, size_t compute_key_size,
+                           size_t graphics_key_size) {
+    switch (record.type) {
+    case RecordType::Compute:
+        return record.num_envs == 1 && record.key_size == compute_key_size;
+    case RecordType::Graphics:
+        return record.num_envs != 0 && record.num_envs <= MAX_GRAPHICS_ENVS &&
+               record.key_size == graphics_key_size;
+    default:
+        return false;
+    }
+}
+
+std::vector<u8> MakeRecord(RecordType type, u32 num_envs, std::span<const char> key,
+                           std::span<const u8> payload, u32 uncompressed_size) {
+    const RecordHeader header{
+        .checksum = 0,
+        .type = type,
+        .num_envs = num_envs,
+        .key_size = static_cast<u32>(key.size()),
+        .payload_size = static_cast<u32>(payload.size()),
+        .uncompressed_size = uncompressed_size,
+        .padding = 0,
+    };
+    std::vector<u8> record(RecordSize(header));
+    std::memcpy(record.data(), &header, sizeof(header));
+    std::ranges::copy(key, record.begin() + sizeof(header));
+    std::ranges::copy(payload, record.begin() + sizeof(header) + key.size());
+    const u64 checksum = RecordChecksum(record);
+    std::memcpy(record.data(), &checksum, sizeof(checksum));
+    return record;
+}
+
+std::vector<u8> MakePipelineRecord(RecordType type, u32 num_envs, std::span<const char> key,
+                                   std::span<const char> serialized) {
+    const std::vector<u8> compressed = Common::Compression::CompressDataZSTDDefault(
+        reinterpret_cast<const u8*>(serialized.data()), serialized.size());
+    return MakeRecord(type, num_envs, key, compressed, static_cast<u32>(serialized.size()));
+}
+
+std::vector<u8> MakeIndexRecord(std::span<const u64> offsets) {
+    const std::span<const u8> payload(reinterpret_cast<const u8*>(offsets.data()),
+                                      offsets.size_bytes());
+    return MakeRecord(RecordType::Index, 0, {}, payload, static_cast<u32>(payload.size()));
+}
+
+std::filesystem::path TempPath(const std::filesystem::path& filename) {
+    std::filesystem::path temp_path = filename;
+    temp_path += ".tmp";
+    return temp_path;
+}
+
+/// Writes a new cache file holding the given records followed by their index
+bool WriteCacheFile(const std::filesystem::path& path, u32 cache_version,
+                    std::span<const std::span<const u8>> records) {
+    Common::FS::IOFile file(path, Common::FS::FileAccessMode::Write);
+    if (!file.IsOpen() || !file.WriteObject(MakeHeader(cache_version, 0))) {
+        return false;
+    }
+    std::vector<u64> offsets;
+    offsets.reserve(records.size());
+    u64 offset = sizeof(CacheHeader);
+    for (const std::span<const u8> record : records) {
+        if (file.WriteSpan(record) != record.size()) {
+            return false;
+        }
+        offsets.push_back(offset);
+        offset += record.size();
+    }
+    const std::vector<u8> index = MakeIndexRecord(offsets);
+    return file.WriteSpan(std::span<const u8>(index)) == index.size() && file.Seek(0) &&
+           file.WriteObject(MakeHeader(cache_version, offset));
+}
+
+/// Replaces the cache with a file written by WriteCacheFile to its temporary path
+bool CommitCacheFile(const std::filesystem::path& filename) {
+    return Common::FS::RemoveFile(filename) &&
+           Common::FS::RenameFile(TempPath(filename), filename);
+}
+
+/// Truncates the cache to end and appends an index of the given offsets
+bool AppendIndex(const std::filesystem::path& filename, u32 cache_version,
+                 std::span<const u64> offsets, u64 end) {
+    Common::FS::IOFile file(filename, Common::FS::FileAccessMode::ReadWrite);
+    const std::vector<u8> index = MakeIndexRecord(offsets);
+    // The header is updated last, an interrupted write leaves the previous index in use
+    return file.IsOpen() && file.SetSize(end) && file.Seek(static_cast<s64>(end)) &&
+           file.WriteSpan(std::span<const u8>(index)) == index.size() && file.Flush() &&
+           file.Seek(0) && file.WriteObject(MakeHeader(cache_version, end));
+}
+
+void RemoveCacheFile(const std::filesystem::path& filename, bool is_outdated) {
     if (!Common::FS::RemoveFile(filename)) {
-        LOG_ERROR(Common_Filesystem, "Failed to delete pipeline cache file {}",
+        LOG_ERROR(Common_Filesystem,
+                  "Invalid pipeline cache file and failed to delete it in \"{}\"",
                   Common::FS::PathToUTF8String(filename));
+    } else if (is_outdated) {
+        LOG_INFO(Common_Filesystem, "Deleting old pipeline cache");
+    } else {
+        LOG_ERROR(Common_Filesystem, "Invalid pipeline cache file");
     }
 }
 
-void LoadPipelines(
-    std::stop_token stop_loading, const std::filesystem::path& filename, u32 expected_cache_version,
-    Common::UniqueFunction<void, std::ifstream&, FileEnvironment> load_compute,
-    Common::UniqueFunction<void, std::ifstream&, std::vector<FileEnvironment>> load_graphics) try {
-    std::ifstream file(filename, std::ios::binary | std::ios::ate);
-    if (!file.is_open()) {
-        return;
+struct RecordList {
+    std::vector<u64> offsets; ///< Offsets of the pipeline records, not validated yet
+    size_t num_indexed;       ///< Number of offsets read from the index
+    u64 end;                  ///< End of the last complete record
+};
+
+/// Finds the pipeline records listed in the latest index and the ones appended after it
+RecordList FindRecords(std::span<const u8> data, const CacheHeader& header) {
+    RecordList list{};
+    u64 scan_offset = sizeof(CacheHeader);
+    RecordHeader record{};
+    if (header.index_offset != 0) {
+        if (ReadRecordHeader(data, header.index_offset, record) &&
+            record.type == RecordType::Index && record.payload_size % sizeof(u64) == 0 &&
+            IsRecordIntact(data, header.index_offset, record)) {
+            list.offsets.resize(record.payload_size / sizeof(u64));
+            std::memcpy(list.offsets.data(),
+                        data.data() + header.index_offset + sizeof(RecordHeader),
+                        record.payload_size);
+            scan_offset = header.index_offset + RecordSize(record);
+        } else {
+            LOG_WARNING(Common_Filesystem,
+                        "Pipeline cache index is corrupt, scanning the whole file");
+        }
     }
-    file.exceptions(std::ifstream::failbit);
-    const auto end{file.tellg()};
-    file.seekg(0, std::ios::beg);
+    list.num_indexed = list.offsets.size();
+    while (ReadRecordHeader(data, scan_offset, record)) {
+        if (record.type != RecordType::Index) {
+            list.offsets.push_back(scan_offset);
+        }
+        scan_offset += RecordSize(record);
+    }
+    list.end = scan_offset;
+    if (list.end != data.size()) {
+        LOG_WARNING(Common_Filesystem, "Pipeline cache is truncated at offset {}", list.end);
+    }
+    return list;
+}
 
-    std::array<char, 8> magic_number;
-    u32 cache_version;
-    file.read(magic_number.data(), magic_number.size())
-        .read(reinterpret_cast<char*>(&cache_version), sizeof(cache_version));
-    if (magic_number != MAGIC_NUMBER || cache_version != expected_cache_version) {
-        file.close();
-        if (Common::FS::RemoveFile(filename)) {
-            if (magic_number != MAGIC_NUMBER) {
-                LOG_ERROR(Common_Filesystem, "Invalid pipeline cache file");
+SerializedPipeline MakeSerializedPipeline(std::span<const u8> data, u64 offset,
+                                          const RecordHeader& record) {
+    const u8* const key = data.data() + offset + sizeof(RecordHeader);
+    return SerializedPipeline(std::span(reinterpret_cast<const char*>(key), record.key_size),
+                              std::span(key + record.key_size, record.payload_size),
+                              record.num_envs, record.uncompressed_size, record.checksum);
+}
+
+/**
+ * Converts a cache written by older versions, where pipelines were stored back to back without
+ * an index or checksums and had to be deserialized to find where each one ends.
+ * Returns nullopt when the cache was written for another cache version.
+ */
+std::optional<std::vector<std::vector<u8>>> ConvertLegacyCache(std::span<const u8> data,
+                                                               u32 expected_cache_version,
+                                                               size_t compute_key_size,
+                                                               size_t graphics_key_size) {
+    static constexpr size_t LEGACY_HEADER_SIZE = LEGACY_MAGIC_NUMBER.size() + sizeof(u32);
+    u32 cache_version{};
+    std::memcpy(&cache_version, data.data() + LEGACY_MAGIC_NUMBER.size(), sizeof(cache_version));
+    if (cache_version != expected_cache_version) {
+        return std::nullopt;
+    }
+    const std::span<const char> chars(reinterpret_cast<const char*>(data.data()), data.size());
+    SpanStreamBuffer buffer(chars);
+    std::istream file(&buffer);
+    file.exceptions(std::ios_base::failbit);
+    file.seekg(LEGACY_HEADER_SIZE);
+
+    std::vector<std::vector<u8>> records;
+    size_t offset = LEGACY_HEADER_SIZE;
+    try {
+        while (offset != data.size()) {
+            u32 num_envs{};
+            file.read(reinterpret_cast<char*>(&num_envs), sizeof(num_envs));
+            if (num_envs == 0 || num_envs > MAX_GRAPHICS_ENVS) {
+                break;
             }
-            if (cache_version != expected_cache_version) {
-                LOG_INFO(Common_Filesystem, "Deleting old pipeline cache");
+            const size_t envs_begin = offset + sizeof(num_envs);
+            Shader::Stage stage{};
+            for (u32 index = 0; index < num_envs; ++index) {
+                FileEnvironment env;
+                env.Deserialize(file);
+                if (index == 0) {
+                    stage = env.ShaderStage();
+                }
             }
-        } else {
-            LOG_ERROR(Common_Filesystem,
-                      "Invalid pipeline cache file and failed to delete it in \"{}\"",
+            const size_t envs_end = static_cast<size_t>(file.tellg());
+            const bool is_compute = stage == Shader::Stage::Compute;
+            const size_t key_size = is_compute ? compute_key_size : graphics_key_size;
+            if (data.size() - envs_end < key_size) {
+                break;
+            }
+            const RecordType type = is_compute ? RecordType::Compute : RecordType::Graphics;
+            records.push_back(MakePipelineRecord(type, num_envs, chars.subspan(envs_end, key_size),
+                                                 chars.subspan(envs_begin, envs_end - envs_begin)));
+            offset = envs_end + key_size;
+            file.seekg(static_cast<std::streamoff>(offset));
+        }
+    } catch (const std::exception&) {
+        // Damaged records are dropped along with the rest of the file, as their size is unknown
+    }
+    if (offset != data.size()) {
+        LOG_WARNING(Common_Filesystem, "Old pipeline cache is damaged at offset {}", offset);
+    }
+    return records;
+}
+} // Anonymous namespace
+
+SerializedPipeline::SerializedPipeline(std::span<const char> key_, std::span<const u8> payload_,
+                                       u32 num_envs_, u32 uncompressed_size_, u64 hash_)
+    : key(key_.begin(), key_.end()), payload(payload_.begin(), payload_.end()),
+      num_envs{num_envs_}, uncompressed_size{uncompressed_size_}, hash{hash_} {}
+
+std::vector<FileEnvironment> SerializedPipeline::Deserialize() const try {
+    const std::vector<u8> serialized = Common::Compression::DecompressDataZSTD(payload);
+    if (serialized.size() != uncompressed_size) {
+        LOG_ERROR(Common_Filesystem, "Failed to decompress a pipeline cache record");
+        return {};
+    }
+    SpanStreamBuffer buffer(
+        std::span(reinterpret_cast<const char*>(serialized.data()), serialized.size()));
+    std::istream file(&buffer);
+    file.exceptions(std::ios_base::failbit);
+    std::vector<FileEnvironment> envs(num_envs);
+    for (FileEnvironment& env : envs) {
+        env.Deserialize(file);
+    }
+    return envs;
+
+} catch (const std::ios_base::failure& e) {
+    LOG_ERROR(Common_Filesystem, "Failed to deserialize a pipeline cache record: {}", e.what());
+    return {};
+}
+
+std::optional<u64> SerializePipeline(std::span<const char> key,
+                                     std::span<const GenericEnvironment* const> envs,
+                                     const std::filesystem::path& filename, u32 cache_version) {
+    if (!std::ranges::all_of(envs, &GenericEnvironment::CanBeSerialized)) {
+        return std::nullopt;
+    }
+    std::ostringstream serialized(std::ios_base::binary);
+    for (const GenericEnvironment* const env : envs) {
+        env->Serialize(serialized);
+    }
+    const bool is_compute = envs.front()->ShaderStage() == Shader::Stage::Compute;
+    const std::vector<u8> record =
+        MakePipelineRecord(is_compute ? RecordType::Compute : RecordType::Graphics,
+                           static_cast<u32>(envs.size()), key, std::move(serialized).str());
+
+    std::scoped_lock lock{cache_file_mutex};
+    Common::FS::IOFile file(filename, Common::FS::FileAccessMode::ReadAppend);
+    if (!file.IsOpen()) {
+        LOG_ERROR(Common_Filesystem, "Failed to open pipeline cache file {}",
+                  Common::FS::PathToUTF8String(filename));
+        return std::nullopt;
+    }
+    if (file.GetSize() == 0) {
+        if (!file.WriteObject(MakeHeader(cache_version, 0))) {
+            LOG_ERROR(Common_Filesystem, "Failed to write pipeline cache file {}",
                       Common::FS::PathToUTF8String(filename));
+            return std::nullopt;
+        }
+    } else {
+        CacheHeader header{};
+        if (!file.ReadObject(header) || header.magic != MAGIC_NUMBER ||
+            header.container_version != CONTAINER_VERSION ||
+            header.cache_version != cache_version) {
+            // The cache is converted or replaced the next time it is loaded
+            return std::nullopt;
         }
+    }
+    // A partially written record is dropped when the cache is loaded
+    if (!file.Seek(0, Common::FS::SeekOrigin::End) ||
+        file.WriteSpan(std::span<const u8>(record)) != record.size()) {
+        LOG_ERROR(Common_Filesystem, "Failed to write pipeline cache file {}",
+                  Common::FS::PathToUTF8String(filename));
+        return std::nullopt;
+    }
+    RecordHeader header{};
+    std::memcpy(&header, record.data(), sizeof(header));
+    return header.checksum;
+}
+
+void LoadPipelines(std::stop_token stop_loading, const std::filesystem::path& filename,
+                   u32 expected_cache_version, size_t compute_key_size, size_t graphics_key_size,
+                   Common::UniqueFunction<void, SerializedPipeline> load_compute,
+                   Common::UniqueFunction<void, SerializedPipeline> load_graphics) {
+    if (!Common::FS::Exists(filename)) {
+        return;
+    }
+    Common::FS::MappedFile file(filename);
+    if (!file.IsOpen()) {
         return;
     }
-    while (file.tellg() != end) {
+    std::span<const u8> data = file.Data();
+    if (data.size() >= LEGACY_MAGIC_NUMBER.size() + sizeof(u32) &&
+        std::memcmp(data.data(), LEGACY_MAGIC_NUMBER.data(), LEGACY_MAGIC_NUMBER.size()) == 0) {
+        const auto records = ConvertLegacyCache(data, expected_cache_version, compute_key_size,
+                                                graphics_key_size);
+        if (!records) {
+            file.Close();
+            RemoveCacheFile(filename, true);
+            return;
+        }
+        const std::vector<std::span<const u8>> spans(records->begin(), records->end());
+        const bool is_written = WriteCacheFile(TempPath(filename), expected_cache_version, spans);
+        file.Close();
+        if (!is_written || !CommitCacheFile(filename)) {
+            LOG_ERROR(Common_Filesystem, "Failed to convert pipeline cache file {}",
+                      Common::FS::PathToUTF8String(filename));
+            Common::FS::RemoveFile(TempPath(filename));
+            return;
+        }
+        LOG_INFO(Common_Filesystem, "Converted {} pipelines to the current pipeline cache format",
+                 records->size());
+        if (!file.Open(filename)) {
+            return;
+        }
+        data = file.Data();
+    }
+
+    CacheHeader header{};
+    if (data.size() >= sizeof(header)) {
+        std::memcpy(&header, data.data(), sizeof(header));
+    }
+    if (data.size() < sizeof(header) || header.magic != MAGIC_NUMBER ||
+        header.container_version != CONTAINER_VERSION ||
+        header.cache_version != expected_cache_version) {
+        file.Close();
+        RemoveCacheFile(filename, header.magic == MAGIC_NUMBER);
+        return;
+    }
+
+    const RecordList list = FindRecords(data, header);
+    const std::vector<u64>& offsets = list.offsets;
+    const bool is_truncated = list.end != data.size();
+
+    // Records are validated here, the environments are decompressed and deserialized by the
+    // backends on their pipeline workers
+    std::vector<u64> live_offsets;
+    live_offsets.reserve(offsets.size());
+    RecordHeader record{};
+    u64 live_bytes = 0;
+    size_t num_corrupt = 0;
+    for (const u64 offset : offsets) {
         if (stop_loading.stop_requested()) {
             return;
         }
-        u32 num_envs{};
-        file.read(reinterpret_cast<char*>(&num_envs), sizeof(num_envs));
-        std::vector<FileEnvironment> envs(num_envs);
-        for (FileEnvironment& env : envs) {
-            env.Deserialize(file);
+        if (!ReadRecordHeader(data, offset, record) ||
+            !IsPipelineRecordValid(record, compute_key_size, graphics_key_size) ||
+            !IsRecordIntact(data, offset, record)) {
+            ++num_corrupt;
+            continue;
         }
-        if (envs.front().ShaderStage() == Shader::Stage::Compute) {
-            load_compute(file, std::move(envs.front()));
+        live_offsets.push_back(offset);
+        live_bytes += RecordSize(record);
+
+        SerializedPipeline pipeline{MakeSerializedPipeline(data, offset, record)};
+        if (record.type == RecordType::Compute) {
+            load_compute(std::move(pipeline));
         } else {
-            load_graphics(file, std::move(envs));
+            load_graphics(std::move(pipeline));
         }
     }
+    if (num_corrupt != 0) {
+        LOG_WARNING(Common_Filesystem, "Skipped {} corrupt pipeline cache records", num_corrupt);
+    }
+    if (offsets.size() == list.num_indexed && num_corrupt == 0 && !is_truncated) {
+        return;
+    }
 
-} catch (const std::ios_base::failure& e) {
-    LOG_ERROR(Common_Filesystem, "{}", e.what());
-    if (!Common::FS::RemoveFile(filename)) {
-        LOG_ERROR(Common_Filesystem, "Failed to delete pipeline cache file {}",
+    std::scoped_lock lock{cache_file_mutex};
+    const u64 dead_bytes = data.size() - sizeof(CacheHeader) - live_bytes;
+    if (dead_bytes > live_bytes / COMPACTION_DEAD_DIVISOR) {
+        std::vector<std::span<const u8>> records;
+        records.reserve(live_offsets.size());
+        for (const u64 offset : live_offsets) {
+            std::memcpy(&record, data.data() + offset, sizeof(record));
+            records.push_back(data.subspan(offset, RecordSize(record)));
+        }
+        const bool is_written = WriteCacheFile(TempPath(filename), expected_cache_version, records);
+        file.Close();
+        if (!is_written || !CommitCacheFile(filename)) {
+            LOG_ERROR(Common_Filesystem, "Failed to compact pipeline cache file {}",
+                      Common::FS::PathToUTF8String(filename));
+            Common::FS::RemoveFile(TempPath(filename));
+        }
+        return;
+    }
+    file.Close();
+    if (!AppendIndex(filename, expected_cache_version, live_offsets, list.end)) {
+        LOG_ERROR(Common_Filesystem, "Failed to index pipeline cache file {}",
                   Common::FS::PathToUTF8String(filename));
     }
 }
 
+void ReadPipelines(const std::filesystem::path& filename,
+                   Common::UniqueFunction<void, SerializedPipeline> load_compute,
+                   Common::UniqueFunction<void, SerializedPipeline> load_graphics) {
+    const Common::FS::MappedFile file(filename);
+    const std::span<const u8> data = file.Data();
+    CacheHeader header{};
+    if (data.size() >= sizeof(header)) {
+        std::memcpy(&header, data.data(), sizeof(header));
+    }
+    if (data.size() < sizeof(header) || header.magic != MAGIC_NUMBER ||
+        header.container_version != CONTAINER_VERSION) {
+        LOG_ERROR(Common_Filesystem, "{} is not a pipeline cache in the current format",
+                  Common::FS::PathToUTF8String(filename));
+        return;
+    }
+    size_t num_corrupt = 0;
+    for (const u64 offset : FindRecords(data, header).offsets) {
+        RecordHeader record{};
+        if (!ReadRecordHeader(data, offset, record) ||
+            !IsPipelineRecordValid(record, record.key_size, record.key_size) ||
+            !IsRecordIntact(data, offset, record)) {
+            ++num_corrupt;
+            continue;
+        }
+        if (record.type == RecordType::Compute) {
+            load_compute(MakeSerializedPipeline(data, offset, record));
+        } else {
+            load_graphics(MakeSerializedPipeline(data, offset, record));
+        }
+    }
+    if (num_corrupt != 0) {
+        LOG_WARNING(Common_Filesystem, "Skipped {} corrupt pipeline cache records", num_corrupt);
+    }
+}
+
 } // namespace VideoCommon
@@ -3,7 +3,9 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <cstring>
 #include <filesystem>
 #include <iosfwd>
 #include <limits>
@@ -12,6 +14,7 @@
 #include <span>
 #include <type_traits>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "common/common_types.h"
@@ -60,7 +63,7 @@ public:
 
     void Dump(u64 pipeline_hash, u64 shader_hash) override;
 
-    void Serialize(std::ofstream& file) const;
+    void Serialize(std::ostream& file) const;
 
     bool HasHLEMacroState() const override {
         return has_hle_engine_state;
@@ -165,7 +168,7 @@ public:
     FileEnvironment& operator=(const FileEnvironment&) = delete;
     FileEnvironment(const FileEnvironment&) = delete;
 
-    void Deserialize(std::ifstream& file);
+    void Deserialize(std::istream& file);
 
     [[nodiscard]] u64 ReadInstruction(u32 address) override;
 
@@ -212,21 +215,84 @@ private:
     u32 viewport_transform_state = 1;
 };
 
-void SerializePipeline(std::span<const char> key, std::span<const GenericEnvironment* const> envs,
-                       const std::filesystem::path& filename, u32 cache_version);
+/**
+ * Appends a pipeline to the pipeline cache at filename.
+ * Returns the hash SerializedPipeline::Hash gives for it once loaded, or nullopt when it was not
+ * written.
+ */
+std::optional<u64> SerializePipeline(std::span<const char> key,
+                                     std::span<const GenericEnvironment* const> envs,
+                                     const std::filesystem::path& filename, u32 cache_version);
 
 template <typename Key, typename Envs>
-void SerializePipeline(const Key& key, const Envs& envs, const std::filesystem::path& filename,
-                       u32 cache_version) {
+std::optional<u64> SerializePipeline(const Key& key, const Envs& envs,
+                                     const std::filesystem::path& filename, u32 cache_version) {
     static_assert(std::is_trivially_copyable_v<Key>);
     static_assert(std::has_unique_object_representations_v<Key>);
-    SerializePipeline(std::span(reinterpret_cast<const char*>(&key), sizeof(key)),
+    return SerializePipeline(std::span(reinterpret_cast<const char*>(&key), sizeof(key)),
                       std::span(envs.data(), envs.size()), filename, cache_version);
 }
 
-void LoadPipelines(
-    std::stop_token stop_loading, const std::filesystem::path& filename, u32 expected_cache_version,
-    Common::UniqueFunction<void, std::ifstream&, FileEnvironment> load_compute,
-    Common::UniqueFunction<void, std::ifstream&, std::vector<FileEnvironment>> load_graphics);
+/**
+ * Pipeline read from the pipeline cache. Its environments stay compressed until Deserialize is
+ * called, so records can be decoded concurrently on the pipeline workers. The record is copied out
+ * of the cache file, which may be rewritten once loading finishes.
+ */
+class SerializedPipeline {
+public:
+    explicit SerializedPipeline(std::span<const char> key_, std::span<const u8> payload_,
+                                u32 num_envs_, u32 uncompressed_size_, u64 hash_);
+
+    /// Returns the pipeline key, which must be of the size given to LoadPipelines
+    template <typename Key>
+    [[nodiscard]] Key ReadKey() const {
+        static_assert(std::is_trivially_copyable_v<Key>);
+        Key result;
+        std::memcpy(&result, key.data(), std::min(key.size(), sizeof(result)));
+        return result;
+    }
+
+    /// Decompresses and deserializes the environments, returns an empty vector on failure
+    [[nodiscard]] std::vector<FileEnvironment> Deserialize() const;
+
+    /// Returns a hash of the key and the environments, which is the same on every load
+    [[nodiscard]] u64 Hash() const noexcept {
+        return hash;
+    }
+
+private:
+    std::vector<char> key;
+    std::vector<u8> payload;
+    u32 num_envs;
+    u32 uncompressed_size;
+    u64 hash;
+};
+
+/**
+ * Loads the pipeline cache at filename. Records are validated with their checksum on the calling
+ * thread, corrupt records are skipped and caches written by older versions are converted.
+ * The key sizes are used to validate records and to convert old caches.
+ */
+void LoadPipelines(std::stop_token stop_loading, const std::filesystem::path& filename,
+                   u32 expected_cache_version, size_t compute_key_size, size_t graphics_key_size,
+                   Common::UniqueFunction<void, SerializedPipeline> load_compute,
+                   Common::UniqueFunction<void, SerializedPipeline> load_graphics);
+
+template <typename ComputeKey, typename GraphicsKey>
+void LoadPipelines(std::stop_token stop_loading, const std::filesystem::path& filename,
+                   u32 expected_cache_version,
+                   Common::UniqueFunction<void, SerializedPipeline> load_compute,
+                   Common::UniqueFunction<void, SerializedPipeline> load_graphics) {
+    LoadPipelines(stop_loading, filename, expected_cache_version, sizeof(ComputeKey),
+                  sizeof(GraphicsKey), std::move(load_compute), std::move(load_graphics));
+}
+
+/**
+ * Reads every pipeline of a pipeline cache without modifying the file, for offline tools.
+ * The cache version and key sizes are not checked, and caches in the old format are not read.
+ */
+void ReadPipelines(const std::filesystem::path& filename,
+                   Common::UniqueFunction<void, SerializedPipeline> load_compute,
+                   Common::UniqueFunction<void, SerializedPipeline> load_graphics);
 
 } // namespace VideoCommon
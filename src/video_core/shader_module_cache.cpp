@@ -0,0 +1,417 @@
+// SPDX-FileCopyrightText: Copyright 2026 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <map>
+#include <type_traits>
+
+#include "common/cityhash.h"
+#include "common/fs/file.h"
+#include "common/fs/fs.h"
+#include "common/fs/path_util.h"
+#include "common/logging/log.h"
+#include "common/scm_rev.h"
+#include "common/settings.h"
+#include "common/zstd_compression.h"
+#include "shader_recompiler/host_translate_info.h"
+#include "shader_recompiler/profile.h"
+#include "video_core/shader_module_cache.h"
+
+namespace VideoCommon {
+namespace {
+constexpr std::array<char, 8> MAGIC_NUMBER{'c', 'i', 't', 'r', 'o', 'n', 's', 'm'};
+
+// Bump when the layout of the file or of the serialized shaders changes
+constexpr u32 CONTAINER_VERSION = 1;
+
+/// Records of the shaders of one pipeline are appended after the header
+struct CacheHeader {
+    std::array<char, 8> magic;
+    u32 container_version;
+    u32 padding;
+    u64 build_hash;
+};
+static_assert(std::is_trivially_copyable_v<CacheHeader>);
+
+struct RecordHeader {
+    u64 checksum; ///< Hash of the rest of the record
+    u64 pipeline_hash;
+    u32 payload_size;      ///< Size of the compressed shaders stored after the header
+    u32 uncompressed_size; ///< Size of the serialized shaders before compression
+};
+static_assert(std::is_trivially_copyable_v<RecordHeader>);
+static_assert(sizeof(RecordHeader) == 24);
+
+template <typename T>
+concept Map = requires {
+    typename T::key_type;
+    typename T::mapped_type;
+};
+
+template <typename T>
+concept Sequence = requires(T& value) {
+    typename T::value_type;
+    value.resize(size_t{});
+    value.max_size();
+};
+
+/// Appends values to a byte buffer
+class Writer {
+public:
+    template <typename... Ts>
+    void operator()(const Ts&... values) {
+        (Write(values), ...);
+    }
+
+    [[nodiscard]] std::vector<u8>& Data() noexcept {
+        return data;
+    }
+
+private:
+    template <typename T>
+    void Write(const T& value) {
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            const auto* const bytes = reinterpret_cast<const u8*>(&value);
+            data.insert(data.end(), bytes, bytes + sizeof(T));
+        } else if constexpr (Map<T>) {
+            Write(static_cast<u32>(value.size()));
+            for (const auto& [key, mapped] : value) {
+                Write(key);
+                Write(mapped);
+            }
+        } else {
+            static_assert(Sequence<T>);
+            static_assert(std::is_trivially_copyable_v<typename T::value_type>);
+            Write(static_cast<u32>(value.size()));
+            const auto* const bytes = reinterpret_cast<const u8*>(value.data());
+            data.insert(data.end(), bytes, bytes + value.size() * sizeof(typename T::value_type));
+        }
+    }
+
+    std::vector<u8> data;
+};
+
+/// Reads values written by Writer, Failed returns true once the data was too short or invalid
+class Reader {
+public:
+    explicit Reader(std::span<const u8> data_) : data{data_} {}
+
+    template <typename... Ts>
+    void operator()(Ts&... values) {
+        (Read(values), ...);
+    }
+
+    [[nodiscard]] bool Failed() const noexcept {
+        return failed;
+    }
+
+    [[nodiscard]] bool AtEnd() const noexcept {
+        return offset == data.size();
+    }
+
+private:
+    bool ReadBytes(void* destination, size_t size) {
+        if (failed || data.size() - offset < size) {
+            failed = true;
+            return false;
+        }
+        std::memcpy(destination, data.data() + offset, size);
+        offset += size;
+        return true;
+    }
+
+    template <typename T>
+    void Read(T& value) {
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            ReadBytes(&value, sizeof(T));
+        } else if constexpr (Map<T>) {
+            u32 size{};
+            Read(size);
+            value.clear();
+            for (u32 index = 0; index < size && !failed; ++index) {
+                typename T::key_type key{};
+                typename T::mapped_type mapped{};
+                Read(key);
+                Read(mapped);
+                value.emplace(key, mapped);
+            }
+        } else {
+            static_assert(Sequence<T>);
+            using Element = typename T::value_type;
+            u32 size{};
+            Read(size);
+            if (failed || size > value.max_size() ||
+                size > (data.size() - offset) / sizeof(Element)) {
+                failed = true;
+                return;
+            }
+            value.resize(size);
+            ReadBytes(value.data(), size * sizeof(Element));
+        }
+    }
+
+    std::span<const u8> data;
+    size_t offset{};
+    bool failed{};
+};
+
+// Members added to Shader::Info have to be added here, as every member is needed to bind shaders
+template <typename Archive, typename Info>
+void VisitInfo(Archive& ar, Info& info) {
+    ar(info.uses_workgroup_id, info.uses_local_invocation_id, info.uses_invocation_id,
+       info.uses_invocation_info, info.uses_sample_id, info.uses_is_helper_invocation,
+       info.uses_subgroup_invocation_id, info.uses_subgroup_shuffles, info.uses_patches);
+    ar(info.interpolation, info.loads, info.stores, info.passthrough, info.legacy_stores_mapping,
+       info.loads_indexed_attributes);
+    ar(info.stores_frag_color, info.stores_sample_mask, info.stores_frag_depth,
+       info.stores_tess_level_outer, info.stores_tess_level_inner, info.stores_indexed_attributes,
+       info.stores_global_memory, info.uses_local_memory);
+    ar(info.uses_fp16, info.uses_fp64, info.uses_fp16_denorms_flush,
+       info.uses_fp16_denorms_preserve, info.uses_fp32_denorms_flush,
+       info.uses_fp32_denorms_preserve, info.uses_int8, info.uses_int16, info.uses_int64,
+       info.uses_image_1d, info.uses_sampled_1d, info.uses_sparse_residency,
+       info.uses_demote_to_helper_invocation, info.uses_subgroup_vote, info.uses_subgroup_mask,
+       info.uses_fswzadd, info.uses_derivatives, info.uses_typeless_image_reads,
+       info.uses_typeless_image_writes, info.uses_image_buffers, info.uses_shared_increment,
+       info.uses_shared_decrement, info.uses_global_increment, info.uses_global_decrement,
+       info.uses_atomic_f32_add, info.uses_atomic_f16x2_add, info.uses_atomic_f16x2_min,
+       info.uses_atomic_f16x2_max, info.uses_atomic_f32x2_add, info.uses_atomic_f32x2_min,
+       info.uses_atomic_f32x2_max, info.uses_atomic_s32_min, info.uses_atomic_s32_max,
+       info.uses_int64_bit_atomics, info.uses_global_memory, info.uses_atomic_image_u32,
+       info.uses_shadow_lod, info.uses_rescaling_uniform, info.uses_cbuf_indirect,
+       info.uses_render_area);
+    ar(info.used_constant_buffer_types, info.used_storage_buffer_types,
+       info.used_indirect_cbuf_types, info.constant_buffer_mask, info.constant_buffer_used_sizes,
+       info.nvn_buffer_base, info.nvn_buffer_used, info.requires_layer_emulation,
+       info.emulated_layer, info.used_clip_distances);
+    ar(info.constant_buffer_descriptors, info.storage_buffers_descriptors,
+       info.texture_buffer_descriptors, info.image_buffer_descriptors, info.texture_descriptors,
+       info.image_descriptors);
+}
+
+// Members are written one by one, the padding of the structures would make the hash unstable
+void WriteProfile(Writer& ar, const Shader::Profile& profile) {
+    ar(profile.supported_spirv, profile.unified_descriptor_binding,
+       profile.support_descriptor_aliasing, profile.support_int8, profile.support_int16,
+       profile.support_int64, profile.support_vertex_instance_id, profile.support_float_controls,
+       profile.support_separate_denorm_behavior, profile.support_separate_rounding_mode,
+       profile.support_fp16_denorm_preserve, profile.support_fp32_denorm_preserve,
+       profile.support_fp16_denorm_flush, profile.support_fp32_denorm_flush,
+       profile.support_fp16_signed_zero_nan_preserve,
+       profile.support_fp32_signed_zero_nan_preserve,
+       profile.support_fp64_signed_zero_nan_preserve, profile.support_explicit_workgroup_layout,
+       profile.support_vote, profile.support_viewport_index_layer_non_geometry,
+       profile.support_viewport_mask, profile.support_typeless_image_loads,
+       profile.support_demote_to_helper_invocation, profile.support_int64_atomics,
+       profile.support_derivative_control, profile.support_geometry_shader_passthrough,
+       profile.support_native_ndc, profile.support_gl_nv_gpu_shader_5,
+       profile.support_gl_amd_gpu_shader_half_float, profile.support_gl_texture_shadow_lod,
+       profile.support_gl_warp_intrinsics, profile.support_gl_variable_aoffi,
+       profile.support_gl_sparse_textures, profile.support_gl_derivative_control,
+       profile.support_scaled_attributes, profile.support_multi_viewport,
+       profile.support_geometry_streams, profile.warp_size_potentially_larger_than_guest);
+    ar(profile.lower_left_origin_mode, profile.need_declared_frag_colors,
+       profile.need_fastmath_off, profile.need_gather_subpixel_offset,
+       profile.has_broken_spirv_clamp, profile.has_broken_spirv_position_input,
+       profile.has_broken_unsigned_image_offsets, profile.has_broken_signed_operations,
+       profile.has_broken_fp16_float_controls, profile.has_gl_component_indexing_bug,
+       profile.has_gl_precise_bug, profile.has_gl_cbuf_ftou_bug, profile.has_gl_bool_ref_bug,
+       profile.ignore_nan_fp_comparisons,
+       profile.has_broken_spirv_subgroup_mask_vector_extract_dynamic,
+       profile.gl_max_compute_smem_size, profile.has_broken_robust, profile.min_ssbo_alignment,
+       profile.max_user_clip_distances);
+}
+
+void WriteHostInfo(Writer& ar, const Shader::HostTranslateInfo& host_info) {
+    ar(host_info.support_float64, host_info.support_float16, host_info.support_int64,
+       host_info.needs_demote_reorder, host_info.support_snorm_render_buffer,
+       host_info.support_viewport_index_layer, host_info.min_ssbo_alignment,
+       host_info.support_geometry_shader_passthrough, host_info.support_conditional_barrier);
+}
+
+/// Settings read by the recompiler while translating and emitting shaders
+void WriteSettings(Writer& ar) {
+    const Settings::ResolutionScalingInfo& resolution = Settings::values.resolution_info;
+    ar(resolution.active, resolution.up_scale, resolution.down_shift, resolution.up_factor,
+       resolution.down_factor, Settings::values.renderer_debug.GetValue(),
+       Settings::values.disable_shader_loop_safety_checks.GetValue());
+}
+
+u64 Hash(std::span<const u8> data) {
+    return Common::CityHash64(reinterpret_cast<const char*>(data.data()), data.size());
+}
+
+u64 RecordChecksum(std::span<const u8> record) {
+    return Hash(record.subspan(sizeof(u64)));
+}
+
+bool ReadHeader(std::span<const u8> data, CacheHeader& header) {
+    if (data.size() < sizeof(header)) {
+        return false;
+    }
+    std::memcpy(&header, data.data(), sizeof(header));
+    return true;
+}
+
+bool CreateCacheFile(const std::filesystem::path& filename, u64 build_hash) {
+    const CacheHeader header{
+        .magic = MAGIC_NUMBER,
+        .container_version = CONTAINER_VERSION,
+        .padding = 0,
+        .build_hash = build_hash,
+    };
+    const Common::FS::IOFile file(filename, Common::FS::FileAccessMode::Write);
+    return file.IsOpen() && file.WriteObject(header);
+}
+} // Anonymous namespace
+
+ShaderModuleCache::ShaderModuleCache() = default;
+
+ShaderModuleCache::~ShaderModuleCache() = default;
+
+u64 ShaderModuleCache::BuildHash(const Shader::Profile& profile,
+                                 const Shader::HostTranslateInfo& host_info) {
+    Writer ar;
+    const std::string_view revision{Common::g_scm_rev};
+    ar(CONTAINER_VERSION, Common::CityHash64(revision.data(), revision.size()));
+    WriteProfile(ar, profile);
+    WriteHostInfo(ar, host_info);
+    WriteSettings(ar);
+    return Hash(ar.Data());
+}
+
+void ShaderModuleCache::Open(const std::filesystem::path& filename_, u64 build_hash) {
+    Close();
+
+    CacheHeader header{};
+    if (Common::FS::Exists(filename_) && file.Open(filename_)) {
+        const bool is_valid = ReadHeader(file.Data(), header) && header.magic == MAGIC_NUMBER &&
+                              header.container_version == CONTAINER_VERSION &&
+                              header.build_hash == build_hash;
+        if (!is_valid) {
+            LOG_INFO(Render, "Discarding shader module cache written by another build or device");
+            file.Close();
+        }
+    }
+    if (!file.IsOpen()) {
+        if (!CreateCacheFile(filename_, build_hash) || !file.Open(filename_)) {
+            LOG_ERROR(Common_Filesystem, "Failed to create shader module cache file {}",
+                      Common::FS::PathToUTF8String(filename_));
+            file.Close();
+            return;
+        }
+    }
+
+    // Checksums are verified when records are read, only their sizes are needed to find them
+    std::span<const u8> data = file.Data();
+    u64 offset = sizeof(CacheHeader);
+    RecordHeader record{};
+    while (data.size() - offset >= sizeof(RecordHeader)) {
+        std::memcpy(&record, data.data() + offset, sizeof(record));
+        if (record.payload_size > data.size() - offset - sizeof(RecordHeader)) {
+            break;
+        }
+        record_offsets.insert_or_assign(record.pipeline_hash, offset);
+        offset += sizeof(RecordHeader) + record.payload_size;
+    }
+    if (offset != data.size()) {
+        // Drop the partially written record, so new records can be found after it
+        LOG_WARNING(Common_Filesystem, "Shader module cache is truncated at offset {}", offset);
+        file.Close();
+        const Common::FS::IOFile resized(filename_, Common::FS::FileAccessMode::ReadAppend);
+        if (!resized.IsOpen() || !resized.SetSize(offset) || !file.Open(filename_)) {
+            LOG_ERROR(Common_Filesystem, "Failed to truncate shader module cache file {}",
+                      Common::FS::PathToUTF8String(filename_));
+            record_offsets.clear();
+            file.Close();
+            return;
+        }
+    }
+    filename = filename_;
+    LOG_INFO(Render, "Loaded {} pipelines from the shader module cache", record_offsets.size());
+}
+
+void ShaderModuleCache::Close() {
+    filename.clear();
+    record_offsets.clear();
+    file.Close();
+}
+
+std::optional<std::vector<CachedShader>> ShaderModuleCache::Find(u64 pipeline_hash) const {
+    const auto it = record_offsets.find(pipeline_hash);
+    if (it == record_offsets.end()) {
+        return std::nullopt;
+    }
+    const std::span<const u8> data = file.Data();
+    RecordHeader record{};
+    std::memcpy(&record, data.data() + it->second, sizeof(record));
+    const std::span<const u8> bytes =
+        data.subspan(it->second, sizeof(RecordHeader) + record.payload_size);
+    if (RecordChecksum(bytes) != record.checksum) {
+        LOG_WARNING(Common_Filesystem, "Shader module cache record {:016x} is corrupt",
+                    pipeline_hash);
+        return std::nullopt;
+    }
+    const std::vector<u8> serialized =
+        Common::Compression::DecompressDataZSTD(bytes.subspan(sizeof(RecordHeader)));
+    if (serialized.size() != record.uncompressed_size) {
+        LOG_WARNING(Common_Filesystem, "Failed to decompress shader module cache record {:016x}",
+                    pipeline_hash);
+        return std::nullopt;
+    }
+    Reader ar(serialized);
+    u32 num_shaders{};
+    ar(num_shaders);
+    std::vector<CachedShader> shaders;
+    for (u32 index = 0; index < num_shaders && !ar.Failed(); ++index) {
+        CachedShader& shader = shaders.emplace_back();
+        ar(shader.stage_index);
+        VisitInfo(ar, shader.info);
+        ar(shader.code);
+    }
+    if (ar.Failed() || !ar.AtEnd()) {
+        LOG_WARNING(Common_Filesystem, "Shader module cache record {:016x} is invalid",
+                    pipeline_hash);
+        return std::nullopt;
+    }
+    return shaders;
+}
+
+void ShaderModuleCache::Insert(u64 pipeline_hash, std::span<const CachedShader> shaders) {
+    if (!IsOpen()) {
+        return;
+    }
+    Writer ar;
+    ar(static_cast<u32>(shaders.size()));
+    for (const CachedShader& shader : shaders) {
+        ar(shader.stage_index);
+        VisitInfo(ar, shader.info);
+        ar(shader.code);
+    }
+    const std::vector<u8>& serialized = ar.Data();
+    const std::vector<u8> compressed =
+        Common::Compression::CompressDataZSTDDefault(serialized.data(), serialized.size());
+    RecordHeader header{
+        .checksum = 0,
+        .pipeline_hash = pipeline_hash,
+        .payload_size = static_cast<u32>(compressed.size()),
+        .uncompressed_size = static_cast<u32>(serialized.size()),
+    };
+    std::vector<u8> record(sizeof(RecordHeader) + compressed.size());
+    std::memcpy(record.data(), &header, sizeof(header));
+    std::ranges::copy(compressed, record.begin() + sizeof(header));
+    header.checksum = RecordChecksum(record);
+    std::memcpy(record.data(), &header.checksum, sizeof(header.checksum));
+
+    std::scoped_lock lock{write_mutex};
+    const Common::FS::IOFile cache_file(filename, Common::FS::FileAccessMode::Append);
+    if (!cache_file.IsOpen() ||
+        cache_file.WriteSpan(std::span<const u8>(record)) != record.size()) {
+        LOG_ERROR(Common_Filesystem, "Failed to write shader module cache file {}",
+                  Common::FS::PathToUTF8String(filename));
+    }
+}
+
+} // namespace VideoCommon
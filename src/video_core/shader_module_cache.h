@@ -0,0 +1,73 @@
+// SPDX-FileCopyrightText: Copyright 2026 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "common/common_types.h"
+#include "common/fs/mapped_file.h"
+#include "shader_recompiler/shader_info.h"
+
+namespace Shader {
+struct HostTranslateInfo;
+struct Profile;
+} // namespace Shader
+
+namespace VideoCommon {
+
+/// Host code of one stage of a pipeline, with the information the backend needs to bind it
+struct CachedShader {
+    u32 stage_index{};
+    Shader::Info info;
+    std::vector<u32> code;
+};
+
+/**
+ * Persistent cache of the host code emitted for the pipelines of the pipeline cache, so they are
+ * built without running the recompiler on the next boot.
+ * Pipelines are looked up with SerializedPipeline::Hash. The file is discarded when it was written
+ * by another build of the recompiler or for another profile, see BuildHash.
+ */
+class ShaderModuleCache {
+public:
+    ShaderModuleCache();
+    ~ShaderModuleCache();
+
+    ShaderModuleCache(const ShaderModuleCache&) = delete;
+    ShaderModuleCache& operator=(const ShaderModuleCache&) = delete;
+
+    /// Returns a hash of everything besides the pipeline that changes the emitted code
+    [[nodiscard]] static u64 BuildHash(const Shader::Profile& profile,
+                                       const Shader::HostTranslateInfo& host_info);
+
+    /// Opens the cache at filename, creating it or discarding it when build_hash does not match
+    void Open(const std::filesystem::path& filename, u64 build_hash);
+
+    void Close();
+
+    [[nodiscard]] bool IsOpen() const noexcept {
+        return !filename.empty();
+    }
+
+    /// Returns the shaders of a pipeline, or nullopt when they are not cached or are damaged.
+    /// Thread safe with other calls to Find and Insert.
+    [[nodiscard]] std::optional<std::vector<CachedShader>> Find(u64 pipeline_hash) const;
+
+    /// Appends the shaders of a pipeline to the file, they can be found from the next Open.
+    /// Thread safe with other calls to Find and Insert.
+    void Insert(u64 pipeline_hash, std::span<const CachedShader> shaders);
+
+private:
+    std::filesystem::path filename;
+    Common::FS::MappedFile file;
+    std::unordered_map<u64, u64> record_offsets;
+    std::mutex write_mutex;
+};
+
+} // namespace VideoCommon
@@ -5,15 +5,22 @@
 #include <array>
 #include <span>
 #include <bc_decoder.h>
+#include <boost/container/small_vector.hpp>
 
 #include "common/common_types.h"
+#include "common/div_ceil.h"
+#include "common/logging/log.h"
 #include "video_core/texture_cache/decode_bc.h"
+#include "video_core/textures/workers.h"
 
 namespace VideoCommon {
 
 namespace {
 constexpr u32 BLOCK_SIZE = 4;
 
+// Images with fewer blocks are decoded on the calling thread
+constexpr size_t PARALLEL_DECODE_THRESHOLD = 4096;
+
 using VideoCore::Surface::PixelFormat;
 
 constexpr bool IsSigned(PixelFormat pixel_format) {
@@ -41,6 +48,87 @@ constexpr u32 BlockSize(PixelFormat pixel_format) {
         return 16;
     }
 }
+template <auto decompress, PixelFormat pixel_format>
+void DecompressRows(const u8* input, u8* output, const BufferImageCopy& copy, u32 first_row,
+                    u32 last_row, bool is_signed) {
+    const u32 out_bpp = ConvertedBytesPerBlock(pixel_format);
+    const u32 block_size = BlockSize(pixel_format);
+    const u32 width = copy.image_extent.width;
+    const u32 height = copy.image_extent.height;
+    const u32 blocks_per_row = Common::DivCeil(copy.buffer_row_length, BLOCK_SIZE);
+    const u32 rows_per_slice = Common::DivCeil(copy.buffer_image_height, BLOCK_SIZE);
+    const size_t pitch = size_t{width} * out_bpp;
+    for (u32 row = first_row; row < last_row; ++row) {
+        const u32 slice = row / rows_per_slice;
+        const u32 y = (row % rows_per_slice) * BLOCK_SIZE;
+        const u8* src = input + size_t{row} * blocks_per_row * block_size;
+        u8* dst = output + (size_t{slice} * height + y) * pitch;
+        for (u32 x = 0; x < width; x += BLOCK_SIZE) {
+            if constexpr (IsSigned(pixel_format)) {
+                decompress(src, dst, x, y, width, height, is_signed);
+            } else {
+                decompress(src, dst, x, y, width, height);
+            }
+            src += block_size;
+            dst += BLOCK_SIZE * out_bpp;
+        }
+    }
+}
+
+template <auto decompress, PixelFormat pixel_format>
+size_t DecompressLevels(std::span<const u8> input, std::span<u8> output,
+                        std::span<BufferImageCopy> copies, bool is_signed = false) {
+    struct Level {
+        const u8* input;
+        u8* output;
+        u32 num_rows;
+    };
+    boost::container::small_vector<Level, 16> levels;
+    size_t output_offset = 0;
+    u32 total_rows = 0;
+    for (BufferImageCopy& copy : copies) {
+        const u32 num_slices = copy.image_subresource.num_layers * copy.image_extent.depth;
+        const u32 num_rows = Common::DivCeil(copy.buffer_image_height, BLOCK_SIZE) * num_slices;
+        levels.push_back({
+            .input = input.data() + copy.buffer_offset,
+            .output = output.data() + output_offset,
+            .num_rows = num_rows,
+        });
+        total_rows += num_rows;
+        copy.buffer_offset = output_offset;
+        output_offset += size_t{copy.image_extent.width} * copy.image_extent.height * num_slices *
+                         ConvertedBytesPerBlock(pixel_format);
+    }
+
+    const u32 blocks_per_row = Common::DivCeil(copies.front().buffer_row_length, BLOCK_SIZE);
+    if (size_t{total_rows} * blocks_per_row < PARALLEL_DECODE_THRESHOLD) {
+        for (size_t level = 0; level < copies.size(); ++level) {
+            DecompressRows<decompress, pixel_format>(levels[level].input, levels[level].output,
+                                                     copies[level], 0, levels[level].num_rows,
+                                                     is_signed);
+        }
+        return output_offset;
+    }
+
+    // Split the block rows of every level, layer and slice into a few tiles per worker, tiles do
+    // not cross levels so that each one is described by a single copy.
+    Common::ThreadWorker& workers{Tegra::Texture::GetThreadWorkers()};
+    const u32 num_tiles = std::min<u32>(total_rows, static_cast<u32>(workers.NumWorkers()) * 4);
+    const u32 rows_per_tile = Common::DivCeil(total_rows, std::max(num_tiles, 1U));
+    for (size_t level = 0; level < copies.size(); ++level) {
+        const Level& info = levels[level];
+        const BufferImageCopy& copy = copies[level];
+        for (u32 first_row = 0; first_row < info.num_rows; first_row += rows_per_tile) {
+            const u32 last_row = std::min(first_row + rows_per_tile, info.num_rows);
+            workers.QueueWork([info, copy, first_row, last_row, is_signed] {
+                DecompressRows<decompress, pixel_format>(info.input, info.output, copy, first_row,
+                                                         last_row, is_signed);
+            });
+        }
+    }
+    workers.WaitForRequests();
+    return output_offset;
+}
 } // Anonymous namespace
 
 u32 ConvertedBytesPerBlock(VideoCore::Surface::PixelFormat pixel_format) {
@@ -59,76 +147,41 @@ u32 ConvertedBytesPerBlock(VideoCore::Surface::PixelFormat pixel_format) {
     }
 }
 
-template <auto decompress, PixelFormat pixel_format>
-void DecompressBlocks(std::span<const u8> input, std::span<u8> output, BufferImageCopy& copy,
-                      bool is_signed = false) {
-    const u32 out_bpp = ConvertedBytesPerBlock(pixel_format);
-    const u32 block_size = BlockSize(pixel_format);
-    const u32 width = copy.image_extent.width;
-    const u32 height = copy.image_extent.height * copy.image_subresource.num_layers;
-    const u32 depth = copy.image_extent.depth;
-    const u32 block_width = std::min(width, BLOCK_SIZE);
-    const u32 block_height = std::min(height, BLOCK_SIZE);
-    const u32 pitch = width * out_bpp;
-    size_t input_offset = 0;
-    size_t output_offset = 0;
-    for (u32 slice = 0; slice < depth; ++slice) {
-        for (u32 y = 0; y < height; y += block_height) {
-            size_t src_offset = input_offset;
-            size_t dst_offset = output_offset;
-            for (u32 x = 0; x < width; x += block_width) {
-                const u8* src = input.data() + src_offset;
-                u8* const dst = output.data() + dst_offset;
-                if constexpr (IsSigned(pixel_format)) {
-                    decompress(src, dst, x, y, width, height, is_signed);
-                } else {
-                    decompress(src, dst, x, y, width, height);
-                }
-                src_offset += block_size;
-                dst_offset += block_width * out_bpp;
-            }
-            input_offset += copy.buffer_row_length * block_size / block_width;
-            output_offset += block_height * pitch;
-        }
+size_t DecompressBCn(std::span<const u8> input, std::span<u8> output,
+                     std::span<BufferImageCopy> copies,
+                     VideoCore::Surface::PixelFormat pixel_format) {
+    if (copies.empty()) {
+        return 0;
     }
-}
-
-void DecompressBCn(std::span<const u8> input, std::span<u8> output, BufferImageCopy& copy,
-                   VideoCore::Surface::PixelFormat pixel_format) {
     switch (pixel_format) {
     case PixelFormat::BC1_RGBA_UNORM:
     case PixelFormat::BC1_RGBA_SRGB:
-        DecompressBlocks<bcn::DecodeBc1, PixelFormat::BC1_RGBA_UNORM>(input, output, copy);
-        break;
+        return DecompressLevels<bcn::DecodeBc1, PixelFormat::BC1_RGBA_UNORM>(input, output,
+                                                                             copies);
     case PixelFormat::BC2_UNORM:
     case PixelFormat::BC2_SRGB:
-        DecompressBlocks<bcn::DecodeBc2, PixelFormat::BC2_UNORM>(input, output, copy);
-        break;
+        return DecompressLevels<bcn::DecodeBc2, PixelFormat::BC2_UNORM>(input, output, copies);
     case PixelFormat::BC3_UNORM:
     case PixelFormat::BC3_SRGB:
-        DecompressBlocks<bcn::DecodeBc3, PixelFormat::BC3_UNORM>(input, output, copy);
-        break;
+        return DecompressLevels<bcn::DecodeBc3, PixelFormat::BC3_UNORM>(input, output, copies);
     case PixelFormat::BC4_SNORM:
     case PixelFormat::BC4_UNORM:
-        DecompressBlocks<bcn::DecodeBc4, PixelFormat::BC4_UNORM>(
-            input, output, copy, pixel_format == PixelFormat::BC4_SNORM);
-        break;
+        return DecompressLevels<bcn::DecodeBc4, PixelFormat::BC4_UNORM>(
+            input, output, copies, pixel_format == PixelFormat::BC4_SNORM);
     case PixelFormat::BC5_SNORM:
     case PixelFormat::BC5_UNORM:
-        DecompressBlocks<bcn::DecodeBc5, PixelFormat::BC5_UNORM>(
-            input, output, copy, pixel_format == PixelFormat::BC5_SNORM);
-        break;
+        return DecompressLevels<bcn::DecodeBc5, PixelFormat::BC5_UNORM>(
+            input, output, copies, pixel_format == PixelFormat::BC5_SNORM);
     case PixelFormat::BC6H_SFLOAT:
     case PixelFormat::BC6H_UFLOAT:
-        DecompressBlocks<bcn::DecodeBc6, PixelFormat::BC6H_UFLOAT>(
-            input, output, copy, pixel_format == PixelFormat::BC6H_SFLOAT);
-        break;
+        return DecompressLevels<bcn::DecodeBc6, PixelFormat::BC6H_UFLOAT>(
+            input, output, copies, pixel_format == PixelFormat::BC6H_SFLOAT);
     case PixelFormat::BC7_SRGB:
     case PixelFormat::BC7_UNORM:
-        DecompressBlocks<bcn::DecodeBc7, PixelFormat::BC7_UNORM>(input, output, copy);
-        break;
+        return DecompressLevels<bcn::DecodeBc7, PixelFormat::BC7_UNORM>(input, output, copies);
     default:
         LOG_WARNING(HW_GPU, "Unimplemented BCn decompression {}", pixel_format);
+        return 0;
     }
 }
 
@@ -13,7 +13,18 @@ namespace VideoCommon {
 
 [[nodiscard]] u32 ConvertedBytesPerBlock(VideoCore::Surface::PixelFormat pixel_format);
 
-void DecompressBCn(std::span<const u8> input, std::span<u8> output, BufferImageCopy& copy,
-                   VideoCore::Surface::PixelFormat pixel_format);
+/**
+ * Decodes the levels of a BCn image described by copies, in parallel on the texture worker pool.
+ * The decoded levels are written back to back to output, which may be the staging buffer the
+ * image is uploaded from.
+ * @param input        Unswizzled image, the buffer offset of each copy points to its level
+ * @param output       Buffer receiving the decoded levels
+ * @param copies       Levels to decode, their buffer offsets are rewritten to point to output
+ * @param pixel_format Format of the image
+ * @returns Size in bytes of the decoded data
+ */
+size_t DecompressBCn(std::span<const u8> input, std::span<u8> output,
+                     std::span<BufferImageCopy> copies,
+                     VideoCore::Surface::PixelFormat pixel_format);
 
 } // namespace VideoCommon
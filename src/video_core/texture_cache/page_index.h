@@ -0,0 +1,95 @@
+// SPDX-FileCopyrightText: Copyright 2026 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include <boost/container/small_vector.hpp>
+
+#include "common/common_types.h"
+
+namespace VideoCommon {
+
+/**
+ * Two level radix table mapping pages to the ids registered in them.
+ * Buckets are allocated in blocks on first use and never move, a lookup is two array accesses and
+ * references to a bucket stay valid while ids are registered in other pages.
+ * Buckets keep a few ids inline, most pages only hold a handful of them.
+ */
+template <typename Id, size_t inline_ids = 4>
+class PageIndex {
+    static constexpr u64 BLOCK_BITS = 10;
+    static constexpr u64 BLOCK_SIZE = 1ULL << BLOCK_BITS;
+    static constexpr u64 BLOCK_MASK = BLOCK_SIZE - 1;
+
+public:
+    using Bucket = boost::container::small_vector<Id, inline_ids>;
+
+    /// Returns the bucket of a page, or null when no id has been registered in its block
+    [[nodiscard]] Bucket* Find(u64 page) noexcept {
+        const u64 block_index = page >> BLOCK_BITS;
+        if (block_index >= blocks.size() || !blocks[block_index]) {
+            return nullptr;
+        }
+        return &(*blocks[block_index])[page & BLOCK_MASK];
+    }
+
+    /// Returns the bucket of a page, or null when no id has been registered in its block
+    [[nodiscard]] const Bucket* Find(u64 page) const noexcept {
+        return const_cast<PageIndex*>(this)->Find(page);
+    }
+
+    /// Returns the bucket of a page, allocating its block if needed
+    [[nodiscard]] Bucket& operator[](u64 page) {
+        const u64 block_index = page >> BLOCK_BITS;
+        if (block_index >= blocks.size()) {
+            blocks.resize(block_index + 1);
+        }
+        std::unique_ptr<Block>& block = blocks[block_index];
+        if (!block) {
+            block = std::make_unique<Block>();
+        }
+        return (*block)[page & BLOCK_MASK];
+    }
+
+    /// Registers id in the pages from first_page to last_page, both included
+    void Insert(u64 first_page, u64 last_page, Id id) {
+        for (u64 page = first_page; page <= last_page; ++page) {
+            (*this)[page].push_back(id);
+        }
+    }
+
+    /**
+     * Unregisters id from the pages from first_page to last_page, both included
+     *
+     * @returns The first page id was not registered in, if any
+     */
+    std::optional<u64> Erase(u64 first_page, u64 last_page, Id id) {
+        std::optional<u64> missing_page;
+        for (u64 page = first_page; page <= last_page; ++page) {
+            if (Bucket* const bucket = Find(page)) {
+                const auto it = std::ranges::find(*bucket, id);
+                if (it != bucket->end()) {
+                    bucket->erase(it);
+                    continue;
+                }
+            }
+            if (!missing_page) {
+                missing_page = page;
+            }
+        }
+        return missing_page;
+    }
+
+private:
+    using Block = std::array<Bucket, BLOCK_SIZE>;
+
+    std::vector<std::unique_ptr<Block>> blocks;
+};
+
+} // namespace VideoCommon
@@ -7,6 +7,8 @@
 #include <boost/container/small_vector.hpp>
 
 #include "common/alignment.h"
+#include "common/fs/fs.h"
+#include "common/fs/path_util.h"
 #include "common/settings.h"
 #include "video_core/control/channel_state.h"
 #include "video_core/dirty_flags.h"
@@ -70,6 +72,20 @@ TextureCache<P>::TextureCache(Runtime& runtime_, Tegra::MaxwellDeviceMemoryManag
     }
 }
 
+template <class P>
+void TextureCache<P>::LoadDiskResources(u64 title_id) {
+    if (title_id == 0 || !Settings::values.use_disk_texture_cache.GetValue()) {
+        return;
+    }
+    const auto shader_dir{Common::FS::GetCitronPath(Common::FS::CitronPath::ShaderDir)};
+    const auto base_dir{shader_dir / fmt::format("{:016x}", title_id)};
+    if (!Common::FS::CreateDir(shader_dir) || !Common::FS::CreateDir(base_dir)) {
+        LOG_ERROR(Common_Filesystem, "Failed to create texture transcode cache directories");
+        return;
+    }
+    transcode_cache.Open(base_dir / "texture_transcode.bin");
+}
+
 template <class P>
 void TextureCache<P>::RunGarbageCollector() {
     bool high_priority_mode = false;
@@ -732,13 +748,12 @@ template <class P>
 std::pair<typename P::ImageView*, bool> TextureCache<P>::TryFindFramebufferImageView(
     const Tegra::FramebufferConfig& config, DAddr cpu_addr) {
     // TODO: Properly implement this
-    const auto it = page_table.find(cpu_addr >> CITRON_PAGEBITS);
-    if (it == page_table.end()) {
+    const auto* const image_map_ids = page_table.Find(cpu_addr >> CITRON_PAGEBITS);
+    if (!image_map_ids) {
         return {};
     }
-    const auto& image_map_ids = it->second;
     boost::container::small_vector<ImageId, 4> valid_image_ids;
-    for (const ImageMapId map_id : image_map_ids) {
+    for (const ImageMapId map_id : *image_map_ids) {
         const ImageMapView& map = slot_map_views[map_id];
         const ImageBase& image = slot_images[map.image_id];
         if (image.cpu_addr != cpu_addr) {
@@ -1087,10 +1102,19 @@ void TextureCache<P>::UploadImageContents(Image& image, StagingBuffer& staging)
         *gpu_memory, gpu_addr, image.guest_size_bytes, &swizzle_data_buffer);
 
     if (True(image.flags & ImageFlagBits::Converted)) {
+        const u64 transcode_key =
+            transcode_cache.IsOpen() ? TranscodeCache::ComputeKey(swizzle_data, image.info) : 0;
+        boost::container::small_vector<BufferImageCopy, 16> copies;
+        if (transcode_cache.Load(transcode_key, mapped_span, copies)) {
+            image.UploadMemory(staging, copies);
+            return;
+        }
         unswizzle_data_buffer.resize_destructive(image.unswizzled_size_bytes);
-        auto copies =
+        copies =
             UnswizzleImage(*gpu_memory, gpu_addr, image.info, swizzle_data, unswizzle_data_buffer);
-        ConvertImage(unswizzle_data_buffer, image.info, mapped_span, copies);
+        const size_t converted_size =
+            ConvertImage(unswizzle_data_buffer, image.info, mapped_span, copies);
+        transcode_cache.Store(transcode_key, mapped_span.first(converted_size), copies);
         image.UploadMemory(staging, copies);
     } else {
         const auto copies =
@@ -1292,16 +1316,26 @@ void TextureCache<P>::QueueAsyncDecode(Image& image, ImageId image_id) {
     Tegra::Memory::GpuGuestMemory<u8, Tegra::Memory::GuestMemoryFlags::UnsafeRead> swizzle_data(
         *gpu_memory, image.gpu_addr, image.guest_size_bytes, &swizzle_data_buffer);
 
+    // The transcode cache is only read on the decode worker, so the image is unswizzled here even
+    // when the worker ends up hitting the cache
     auto copies = UnswizzleImage(*gpu_memory, image.gpu_addr, image.info, swizzle_data,
                                  local_unswizzle_data_buffer);
     const size_t out_size = MapSizeBytes(image);
+    const u64 transcode_key =
+        transcode_cache.IsOpen() ? TranscodeCache::ComputeKey(swizzle_data, image.info) : 0;
 
     auto func = [out_size, copies, info = image.info,
-                 input = std::move(local_unswizzle_data_buffer),
-                 async_decode = decode_ptr]() mutable {
+                 input = std::move(local_unswizzle_data_buffer), async_decode = decode_ptr,
+                 cache = &transcode_cache, transcode_key]() mutable {
         async_decode->decoded_data.resize_destructive(out_size);
-        std::span copies_span{copies.data(), copies.size()};
-        ConvertImage(input, info, async_decode->decoded_data, copies_span);
+        if (!cache->Load(transcode_key, async_decode->decoded_data, copies)) {
+            std::span copies_span{copies.data(), copies.size()};
+            const size_t converted_size =
+                ConvertImage(input, info, async_decode->decoded_data, copies_span);
+            cache->Store(transcode_key,
+                         std::span<const u8>(async_decode->decoded_data).first(converted_size),
+                         copies_span);
+        }
 
         // TODO: Do we need this lock?
         std::unique_lock lock{async_decode->mutex};
@@ -1812,15 +1846,15 @@ void TextureCache<P>::ForEachImageInRegion(DAddr cpu_addr, size_t size, Func&& f
     boost::container::small_vector<ImageId, 32> images;
     boost::container::small_vector<ImageMapId, 32> maps;
     ForEachCPUPage(cpu_addr, size, [this, &images, &maps, cpu_addr, size, func](u64 page) {
-        const auto it = page_table.find(page);
-        if (it == page_table.end()) {
+        const auto* const map_ids = page_table.Find(page);
+        if (!map_ids) {
             if constexpr (BOOL_BREAK) {
                 return false;
             } else {
                 return;
             }
         }
-        for (const ImageMapId map_id : it->second) {
+        for (const ImageMapId map_id : *map_ids) {
             ImageMapView& map = slot_map_views[map_id];
             if (map.picked) {
                 continue;
@@ -1870,15 +1904,15 @@ void TextureCache<P>::ForEachImageInRegionGPU(size_t as_id, GPUVAddr gpu_addr, s
     auto& gpu_page_table = gpu_page_table_storage[*storage_id * 2];
     ForEachGPUPage(gpu_addr, size,
                    [this, &gpu_page_table, &images, gpu_addr, size, func](u64 page) {
-                       const auto it = gpu_page_table.find(page);
-                       if (it == gpu_page_table.end()) {
+                       const auto* const image_ids = gpu_page_table.Find(page);
+                       if (!image_ids) {
                            if constexpr (BOOL_BREAK) {
                                return false;
                            } else {
                                return;
                            }
                        }
-                       for (const ImageId image_id : it->second) {
+                       for (const ImageId image_id : *image_ids) {
                            Image& image = slot_images[image_id];
                            if (True(image.flags & ImageFlagBits::Picked)) {
                                continue;
@@ -1919,15 +1953,15 @@ void TextureCache<P>::ForEachSparseImageInRegion(size_t as_id, GPUVAddr gpu_addr
     auto& sparse_page_table = gpu_page_table_storage[*storage_id * 2 + 1];
     ForEachGPUPage(gpu_addr, size,
                    [this, &sparse_page_table, &images, gpu_addr, size, func](u64 page) {
-                       const auto it = sparse_page_table.find(page);
-                       if (it == sparse_page_table.end()) {
+                       const auto* const image_ids = sparse_page_table.Find(page);
+                       if (!image_ids) {
                            if constexpr (BOOL_BREAK) {
                                return false;
                            } else {
                                return;
                            }
                        }
-                       for (const ImageId image_id : it->second) {
+                       for (const ImageId image_id : *image_ids) {
                            Image& image = slot_images[image_id];
                            if (True(image.flags & ImageFlagBits::Picked)) {
                                continue;
@@ -2000,14 +2034,13 @@ void TextureCache<P>::RegisterImage(ImageId image_id) {
     total_used_memory += Common::AlignUp(tentative_size, 1024);
     image.lru_index = lru_cache.Insert(image_id, frame_tick);
 
-    ForEachGPUPage(image.gpu_addr, image.guest_size_bytes, [this, image_id](u64 page) {
-        (*channel_state->gpu_page_table)[page].push_back(image_id);
-    });
+    const auto [gpu_page_begin, gpu_page_end] = PageRange(image.gpu_addr, image.guest_size_bytes);
+    channel_state->gpu_page_table->Insert(gpu_page_begin, gpu_page_end, image_id);
     if (False(image.flags & ImageFlagBits::Sparse)) {
         auto map_id =
             slot_map_views.insert(image.gpu_addr, image.cpu_addr, image.guest_size_bytes, image_id);
-        ForEachCPUPage(image.cpu_addr, image.guest_size_bytes,
-                       [this, map_id](u64 page) { page_table[page].push_back(map_id); });
+        const auto [page_begin, page_end] = PageRange(image.cpu_addr, image.guest_size_bytes);
+        page_table.Insert(page_begin, page_end, map_id);
         image.map_view_id = map_id;
         return;
     }
@@ -2015,14 +2048,12 @@ void TextureCache<P>::RegisterImage(ImageId image_id) {
     ForEachSparseSegment(
         image, [this, image_id, &sparse_maps](GPUVAddr gpu_addr, DAddr cpu_addr, size_t size) {
             auto map_id = slot_map_views.insert(gpu_addr, cpu_addr, size, image_id);
-            ForEachCPUPage(cpu_addr, size,
-                           [this, map_id](u64 page) { page_table[page].push_back(map_id); });
+            const auto [page_begin, page_end] = PageRange(cpu_addr, size);
+            page_table.Insert(page_begin, page_end, map_id);
             sparse_maps.push_back(map_id);
         });
     sparse_views.emplace(image_id, std::move(sparse_maps));
-    ForEachGPUPage(image.gpu_addr, image.guest_size_bytes, [this, image_id](u64 page) {
-        (*channel_state->sparse_page_table)[page].push_back(image_id);
-    });
+    channel_state->sparse_page_table->Insert(gpu_page_begin, gpu_page_end, image_id);
 }
 
 template <class P>
@@ -2033,50 +2064,22 @@ void TextureCache<P>::UnregisterImage(ImageId image_id) {
     image.flags &= ~ImageFlagBits::Registered;
     image.flags &= ~ImageFlagBits::BadOverlap;
     lru_cache.Free(image.lru_index);
-    const auto& clear_page_table =
-        [image_id](u64 page,
-                   std::unordered_map<u64, std::vector<ImageId>, Common::IdentityHash<u64>>&
-                       selected_page_table) {
-            const auto page_it = selected_page_table.find(page);
-            if (page_it == selected_page_table.end()) {
-                ASSERT_MSG(false, "Unregistering unregistered page=0x{:x}", page << CITRON_PAGEBITS);
-                return;
-            }
-            std::vector<ImageId>& image_ids = page_it->second;
-            const auto vector_it = std::ranges::find(image_ids, image_id);
-            if (vector_it == image_ids.end()) {
-                ASSERT_MSG(false, "Unregistering unregistered image in page=0x{:x}",
-                           page << CITRON_PAGEBITS);
-                return;
-            }
-            image_ids.erase(vector_it);
-        };
-    ForEachGPUPage(image.gpu_addr, image.guest_size_bytes, [this, &clear_page_table](u64 page) {
-        clear_page_table(page, (*channel_state->gpu_page_table));
-    });
+    const auto erase_pages = [](auto& selected_page_table, u64 page_begin, u64 page_end,
+                                auto id) {
+        const std::optional<u64> missing_page = selected_page_table.Erase(page_begin, page_end, id);
+        ASSERT_MSG(!missing_page, "Unregistering unregistered image in page=0x{:x}",
+                   missing_page.value_or(0) << CITRON_PAGEBITS);
+    };
+    const auto [gpu_page_begin, gpu_page_end] = PageRange(image.gpu_addr, image.guest_size_bytes);
+    erase_pages(*channel_state->gpu_page_table, gpu_page_begin, gpu_page_end, image_id);
     if (False(image.flags & ImageFlagBits::Sparse)) {
         const auto map_id = image.map_view_id;
-        ForEachCPUPage(image.cpu_addr, image.guest_size_bytes, [this, map_id](u64 page) {
-            const auto page_it = page_table.find(page);
-            if (page_it == page_table.end()) {
-                ASSERT_MSG(false, "Unregistering unregistered page=0x{:x}", page << CITRON_PAGEBITS);
-                return;
-            }
-            std::vector<ImageMapId>& image_map_ids = page_it->second;
-            const auto vector_it = std::ranges::find(image_map_ids, map_id);
-            if (vector_it == image_map_ids.end()) {
-                ASSERT_MSG(false, "Unregistering unregistered image in page=0x{:x}",
-                           page << CITRON_PAGEBITS);
-                return;
-            }
-            image_map_ids.erase(vector_it);
-        });
+        const auto [page_begin, page_end] = PageRange(image.cpu_addr, image.guest_size_bytes);
+        erase_pages(page_table, page_begin, page_end, map_id);
         slot_map_views.erase(map_id);
         return;
     }
-    ForEachGPUPage(image.gpu_addr, image.guest_size_bytes, [this, &clear_page_table](u64 page) {
-        clear_page_table(page, (*channel_state->sparse_page_table));
-    });
+    erase_pages(*channel_state->sparse_page_table, gpu_page_begin, gpu_page_end, image_id);
     auto it = sparse_views.find(image_id);
     ASSERT(it != sparse_views.end());
     auto& sparse_maps = it->second;
@@ -2085,12 +2088,12 @@ void TextureCache<P>::UnregisterImage(ImageId image_id) {
         const DAddr cpu_addr = map_range.cpu_addr;
         const std::size_t size = map_range.size;
         ForEachCPUPage(cpu_addr, size, [this, image_id](u64 page) {
-            const auto page_it = page_table.find(page);
-            if (page_it == page_table.end()) {
+            auto* const image_map_ids_ptr = page_table.Find(page);
+            if (!image_map_ids_ptr) {
                 ASSERT_MSG(false, "Unregistering unregistered page=0x{:x}", page << CITRON_PAGEBITS);
                 return;
             }
-            std::vector<ImageMapId>& image_map_ids = page_it->second;
+            auto& image_map_ids = *image_map_ids_ptr;
             auto vector_it = image_map_ids.begin();
             while (vector_it != image_map_ids.end()) {
                 ImageMapView& map = slot_map_views[*vector_it];
@@ -11,6 +11,7 @@
 #include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 #include <boost/container/small_vector.hpp>
 #include <queue>
@@ -32,7 +33,9 @@
 #include "video_core/texture_cache/image_base.h"
 #include "video_core/texture_cache/image_info.h"
 #include "video_core/texture_cache/image_view_base.h"
+#include "video_core/texture_cache/page_index.h"
 #include "video_core/texture_cache/render_targets.h"
+#include "video_core/texture_cache/transcode_cache.h"
 #include "video_core/texture_cache/types.h"
 #include "video_core/textures/texture.h"
 
@@ -63,7 +66,7 @@ struct AsyncDecodeContext {
     std::atomic_bool complete;
 };
 
-using TextureCacheGPUMap = std::unordered_map<u64, std::vector<ImageId>, Common::IdentityHash<u64>>;
+using TextureCacheGPUMap = PageIndex<ImageId>;
 
 class TextureCacheChannelInfo : public ChannelInfo {
 public:
@@ -131,6 +134,9 @@ class TextureCache : public VideoCommon::ChannelSetupCaches<TextureCacheChannelI
 public:
     explicit TextureCache(Runtime&, Tegra::MaxwellDeviceMemoryManager&);
 
+    /// Open the per-title transcoded texture cache
+    void LoadDiskResources(u64 title_id);
+
     /// Notify the cache that a new frame has been queued
     void TickFrame();
 
@@ -269,6 +275,11 @@ private:
         }
     }
 
+    /// Returns the first and last pages touched by a range
+    static std::pair<u64, u64> PageRange(u64 addr, size_t size) {
+        return {addr >> CITRON_PAGEBITS, (addr + size - 1) >> CITRON_PAGEBITS};
+    }
+
     template <typename Func>
     static void ForEachGPUPage(GPUVAddr addr, size_t size, Func&& func) {
         static constexpr bool RETURNS_BOOL = std::is_same_v<std::invoke_result<Func, u64>, bool>;
@@ -431,7 +442,7 @@ private:
 
     std::unordered_map<RenderTargets, FramebufferId> framebuffers;
 
-    std::unordered_map<u64, std::vector<ImageMapId>, Common::IdentityHash<u64>> page_table;
+    PageIndex<ImageMapId> page_table;
     std::unordered_map<ImageId, boost::container::small_vector<ImageViewId, 16>> sparse_views;
 
     DAddr virtual_invalid_space{};
@@ -489,6 +500,8 @@ private:
     u64 modification_tick = 0;
     u64 frame_tick = 0;
 
+    TranscodeCache transcode_cache;
+
     Common::ThreadWorker texture_decode_worker{1, "TextureDecoder"};
     std::vector<std::unique_ptr<AsyncDecodeContext>> async_decodes;
 
@@ -0,0 +1,292 @@
+// SPDX-FileCopyrightText: Copyright 2026 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "common/cityhash.h"
+#include "common/fs/fs.h"
+#include "common/logging/log.h"
+#include "common/settings.h"
+#include "video_core/texture_cache/image_info.h"
+#include "video_core/texture_cache/transcode_cache.h"
+
+namespace VideoCommon {
+namespace {
+// Bump when the output of any CPU decoder or encoder changes
+constexpr u32 TRANSCODE_CACHE_VERSION = 2;
+
+constexpr std::array<char, 4> MAGIC{'C', 'T', 'X', 'C'};
+
+struct PackHeader {
+    std::array<char, 4> magic;
+    u32 version;
+};
+static_assert(std::is_trivially_copyable_v<PackHeader>);
+
+struct RecordHeader {
+    u64 key;
+    u64 data_size;
+    u32 num_copies;
+    u32 padding;
+};
+static_assert(std::is_trivially_copyable_v<RecordHeader>);
+static_assert(std::is_trivially_copyable_v<BufferImageCopy>);
+
+/// Image parameters that, together with the guest data, determine the transcoded output
+struct KeyParams {
+    u32 format;
+    u32 type;
+    s32 levels;
+    s32 layers;
+    Extent3D size;
+    Extent3D block;
+    u32 layer_stride;
+    u32 tile_width_spacing;
+    u32 astc_recompression;
+    u32 version;
+};
+static_assert(std::has_unique_object_representations_v<KeyParams>);
+} // Anonymous namespace
+
+TranscodeCache::TranscodeCache(u64 size_budget_) : size_budget{size_budget_} {}
+
+TranscodeCache::~TranscodeCache() {
+    Close();
+}
+
+void TranscodeCache::Open(const std::filesystem::path& path) {
+    std::scoped_lock lock{mutex};
+    if (file.IsOpen()) {
+        return;
+    }
+    file_path = path;
+
+    const auto create_file = [this] {
+        Common::FS::IOFile new_file(file_path, Common::FS::FileAccessMode::Write);
+        const PackHeader header{.magic = MAGIC, .version = TRANSCODE_CACHE_VERSION};
+        return new_file.IsOpen() && new_file.WriteObject(header);
+    };
+    if (!Common::FS::Exists(file_path) && !create_file()) {
+        LOG_ERROR(HW_GPU, "Failed to create texture transcode cache {}", file_path.string());
+        return;
+    }
+    file.Open(file_path, Common::FS::FileAccessMode::ReadWrite);
+    PackHeader header{};
+    if (!file.IsOpen() || !file.ReadObject(header) || header.magic != MAGIC ||
+        header.version != TRANSCODE_CACHE_VERSION) {
+        LOG_INFO(HW_GPU, "Texture transcode cache is incompatible, recreating it");
+        file.Close();
+        if (!create_file()) {
+            LOG_ERROR(HW_GPU, "Failed to recreate texture transcode cache {}", file_path.string());
+            return;
+        }
+        file.Open(file_path, Common::FS::FileAccessMode::ReadWrite);
+        if (!file.IsOpen()) {
+            return;
+        }
+    }
+
+    // Records are appended, so the last ones in the file are the most recently used
+    const u64 file_size = file.GetSize();
+    u64 offset = sizeof(PackHeader);
+    while (offset < file_size) {
+        RecordHeader record{};
+        if (!file.Seek(static_cast<s64>(offset)) || !file.ReadObject(record)) {
+            break;
+        }
+        const u64 record_size =
+            sizeof(RecordHeader) + record.num_copies * sizeof(BufferImageCopy) + record.data_size;
+        if (offset + record_size > file_size) {
+            break;
+        }
+        Insert(record.key, offset, record.data_size, record.num_copies);
+        offset += record_size;
+    }
+    if (offset != file_size) {
+        LOG_WARNING(HW_GPU, "Texture transcode cache is truncated at offset {}", offset);
+        if (!file.SetSize(offset)) {
+            file.Close();
+            return;
+        }
+    }
+    EvictToBudget();
+    is_open = true;
+    LOG_INFO(HW_GPU, "Loaded {} transcoded textures ({} MiB) from disk", entries.size(),
+             live_bytes >> 20);
+}
+
+void TranscodeCache::Close() {
+    std::scoped_lock lock{mutex};
+    if (!file.IsOpen()) {
+        return;
+    }
+    LOG_INFO(HW_GPU, "Texture transcode cache: {} hits, {} misses, {} MiB saved", statistics.hits,
+             statistics.misses, statistics.bytes_saved >> 20);
+    is_open = false;
+    Compact();
+    file.Close();
+    entries.clear();
+    lru.clear();
+    live_bytes = 0;
+    dead_bytes = 0;
+}
+
+bool TranscodeCache::IsOpen() const {
+    return is_open.load(std::memory_order_relaxed);
+}
+
+u64 TranscodeCache::ComputeKey(std::span<const u8> guest_data, const ImageInfo& info) {
+    const KeyParams params{
+        .format = static_cast<u32>(info.format),
+        .type = static_cast<u32>(info.type),
+        .levels = info.resources.levels,
+        .layers = info.resources.layers,
+        .size = info.size,
+        .block = info.block,
+        .layer_stride = info.layer_stride,
+        .tile_width_spacing = info.tile_width_spacing,
+        .astc_recompression = static_cast<u32>(Settings::values.astc_recompression.GetValue()),
+        .version = TRANSCODE_CACHE_VERSION,
+    };
+    const u64 seed = Common::CityHash64(reinterpret_cast<const char*>(&params), sizeof(params));
+    return Common::CityHash64WithSeed(reinterpret_cast<const char*>(guest_data.data()),
+                                      guest_data.size(), seed);
+}
+
+bool TranscodeCache::Load(u64 key, std::span<u8> output,
+                          boost::container::small_vector<BufferImageCopy, 16>& copies) {
+    std::scoped_lock lock{mutex};
+    if (!file.IsOpen()) {
+        return false;
+    }
+    const auto it = entries.find(key);
+    if (it == entries.end() || it->second.data_size > output.size()) {
+        ++statistics.misses;
+        return false;
+    }
+    Entry& entry = it->second;
+    // Callers keep using their copies on a miss, only replace them once the record is read whole
+    boost::container::small_vector<BufferImageCopy, 16> record_copies(entry.num_copies);
+    if (!file.Seek(static_cast<s64>(entry.offset + sizeof(RecordHeader))) ||
+        file.ReadSpan(std::span(record_copies.data(), record_copies.size())) != entry.num_copies ||
+        file.ReadSpan(output.first(entry.data_size)) != entry.data_size) {
+        LOG_ERROR(HW_GPU, "Failed to read transcoded texture {:016x}", key);
+        lru.erase(entry.lru_it);
+        live_bytes -= RecordSize(entry);
+        dead_bytes += RecordSize(entry);
+        entries.erase(it);
+        ++statistics.misses;
+        return false;
+    }
+    copies = std::move(record_copies);
+    lru.splice(lru.begin(), lru, entry.lru_it);
+    ++statistics.hits;
+    statistics.bytes_saved += entry.data_size;
+    return true;
+}
+
+void TranscodeCache::Store(u64 key, std::span<const u8> data,
+                           std::span<const BufferImageCopy> copies) {
+    std::scoped_lock lock{mutex};
+    // Past twice the budget on disk, wait for the compaction on close instead of growing the file
+    if (!file.IsOpen() || entries.contains(key) || dead_bytes > size_budget) {
+        return;
+    }
+    const RecordHeader record{
+        .key = key,
+        .data_size = data.size(),
+        .num_copies = static_cast<u32>(copies.size()),
+        .padding = 0,
+    };
+    const u64 record_size = sizeof(RecordHeader) + copies.size_bytes() + data.size();
+    if (record_size > size_budget || !file.Seek(0, Common::FS::SeekOrigin::End)) {
+        return;
+    }
+    const s64 offset = file.Tell();
+    if (offset < 0 || !file.WriteObject(record) || file.WriteSpan(copies) != copies.size() ||
+        file.WriteSpan(data) != data.size()) {
+        LOG_ERROR(HW_GPU, "Failed to write transcoded texture {:016x}, closing the cache", key);
+        is_open = false;
+        file.Close();
+        return;
+    }
+    Insert(key, static_cast<u64>(offset), data.size(), record.num_copies);
+    EvictToBudget();
+}
+
+TranscodeCache::Statistics TranscodeCache::GetStatistics() const {
+    std::scoped_lock lock{mutex};
+    return statistics;
+}
+
+u64 TranscodeCache::RecordSize(const Entry& entry) {
+    return sizeof(RecordHeader) + entry.num_copies * sizeof(BufferImageCopy) + entry.data_size;
+}
+
+void TranscodeCache::Insert(u64 key, u64 offset, u64 data_size, u32 num_copies) {
+    const auto [it, is_new] = entries.try_emplace(key);
+    Entry& entry = it->second;
+    if (is_new) {
+        lru.push_front(key);
+    } else {
+        // A newer record for the same key supersedes the old one
+        live_bytes -= RecordSize(entry);
+        dead_bytes += RecordSize(entry);
+        lru.splice(lru.begin(), lru, entry.lru_it);
+    }
+    entry = Entry{
+        .offset = offset,
+        .data_size = data_size,
+        .num_copies = num_copies,
+        .lru_it = lru.begin(),
+    };
+    live_bytes += RecordSize(entry);
+}
+
+void TranscodeCache::EvictToBudget() {
+    while (live_bytes > size_budget && !lru.empty()) {
+        const auto it = entries.find(lru.back());
+        live_bytes -= RecordSize(it->second);
+        dead_bytes += RecordSize(it->second);
+        entries.erase(it);
+        lru.pop_back();
+    }
+}
+
+void TranscodeCache::Compact() {
+    if (dead_bytes == 0) {
+        return;
+    }
+    std::filesystem::path temp_path = file_path;
+    temp_path += ".tmp";
+    {
+        Common::FS::IOFile temp_file(temp_path, Common::FS::FileAccessMode::Write);
+        const PackHeader header{.magic = MAGIC, .version = TRANSCODE_CACHE_VERSION};
+        if (!temp_file.IsOpen() || !temp_file.WriteObject(header)) {
+            LOG_ERROR(HW_GPU, "Failed to compact texture transcode cache");
+            return;
+        }
+        std::vector<u8> record;
+        for (auto it = lru.rbegin(); it != lru.rend(); ++it) {
+            const Entry& entry = entries.at(*it);
+            record.resize(RecordSize(entry));
+            if (!file.Seek(static_cast<s64>(entry.offset)) ||
+                file.ReadSpan(std::span(record)) != record.size() ||
+                temp_file.WriteSpan(std::span<const u8>(record)) != record.size()) {
+                LOG_ERROR(HW_GPU, "Failed to compact texture transcode cache");
+                temp_file.Close();
+                Common::FS::RemoveFile(temp_path);
+                return;
+            }
+        }
+    }
+    file.Close();
+    if (!Common::FS::RemoveFile(file_path) || !Common::FS::RenameFile(temp_path, file_path)) {
+        LOG_ERROR(HW_GPU, "Failed to replace texture transcode cache {}", file_path.string());
+    }
+}
+
+} // namespace VideoCommon
@@ -0,0 +1,109 @@
+// SPDX-FileCopyrightText: Copyright 2026 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <filesystem>
+#include <list>
+#include <mutex>
+#include <span>
+#include <unordered_map>
+
+#include <boost/container/small_vector.hpp>
+
+#include "common/common_types.h"
+#include "common/fs/file.h"
+#include "video_core/texture_cache/types.h"
+
+namespace VideoCommon {
+
+struct ImageInfo;
+
+/**
+ * Persistent, content addressed cache of images transcoded on the CPU (ASTC decoding, BCn
+ * recompression and BCn decoding). Entries are keyed by a hash of the guest texel data and the
+ * image parameters, and are stored in a per-title pack file next to the pipeline cache.
+ *
+ * The pack file is append-only while the cache is open. Entries over the size budget are evicted
+ * in least recently used order and the file is compacted when the cache is closed. Compaction
+ * writes the surviving entries from least to most recently used, so the order is restored on the
+ * next boot. Once the file holds more dead records than the budget, new entries are dropped until
+ * then.
+ */
+class TranscodeCache {
+public:
+    static constexpr u64 DEFAULT_SIZE_BUDGET = 512ULL * 1024 * 1024;
+
+    struct Statistics {
+        u64 hits;
+        u64 misses;
+        u64 bytes_saved; ///< Transcoded bytes served from the cache
+    };
+
+    explicit TranscodeCache(u64 size_budget = DEFAULT_SIZE_BUDGET);
+    ~TranscodeCache();
+
+    TranscodeCache(const TranscodeCache&) = delete;
+    TranscodeCache& operator=(const TranscodeCache&) = delete;
+
+    /// Opens the pack file at path, creating it or discarding it when it is incompatible
+    void Open(const std::filesystem::path& path);
+
+    /// Compacts and closes the pack file
+    void Close();
+
+    /// Returns true when a pack file is open
+    [[nodiscard]] bool IsOpen() const;
+
+    /// Computes the key of an image from its guest (swizzled) data
+    [[nodiscard]] static u64 ComputeKey(std::span<const u8> guest_data, const ImageInfo& info);
+
+    /**
+     * Looks up a transcoded image
+     * @param key    Key computed with ComputeKey
+     * @param output Buffer receiving the transcoded data
+     * @param copies Receives the buffer image copies describing the transcoded data, left
+     *               untouched on a miss
+     * @returns True on a hit, false otherwise
+     */
+    [[nodiscard]] bool Load(u64 key, std::span<u8> output,
+                            boost::container::small_vector<BufferImageCopy, 16>& copies);
+
+    /// Inserts a transcoded image into the cache
+    void Store(u64 key, std::span<const u8> data, std::span<const BufferImageCopy> copies);
+
+    [[nodiscard]] Statistics GetStatistics() const;
+
+private:
+    struct Entry {
+        u64 offset;    ///< Offset of the record header in the pack file
+        u64 data_size; ///< Size of the transcoded data
+        u32 num_copies;
+        std::list<u64>::iterator lru_it;
+    };
+
+    [[nodiscard]] static u64 RecordSize(const Entry& entry);
+
+    void Insert(u64 key, u64 offset, u64 data_size, u32 num_copies);
+
+    void EvictToBudget();
+
+    /// Rewrites the pack file without evicted or superseded records, on close
+    void Compact();
+
+    mutable std::mutex mutex;
+    std::atomic_bool is_open{false}; ///< Mirrors file.IsOpen(), read without the mutex
+    Common::FS::IOFile file;
+    std::filesystem::path file_path;
+    u64 size_budget;
+    u64 live_bytes = 0;
+    u64 dead_bytes = 0;
+
+    std::unordered_map<u64, Entry> entries;
+    std::list<u64> lru; ///< Most recently used keys at the front
+
+    Statistics statistics{};
+};
+
+} // namespace VideoCommon
@@ -910,28 +910,36 @@ boost::container::small_vector<BufferImageCopy, 16> UnswizzleImage(Tegra::Memory
     return copies;
 }
 
-void ConvertImage(std::span<const u8> input, const ImageInfo& info, std::span<u8> output,
-                  std::span<BufferImageCopy> copies) {
-    u32 output_offset = 0;
-    Common::ScratchBuffer<u8> decode_scratch;
-
+size_t ConvertImage(std::span<const u8> input, const ImageInfo& info, std::span<u8> output,
+                    std::span<BufferImageCopy> copies) {
     const Extent2D tile_size = DefaultBlockSize(info.format);
-    for (BufferImageCopy& copy : copies) {
-        const u32 level = copy.image_subresource.base_level;
-        const Extent3D mip_size = AdjustMipSize(info.size, level);
+    for (const BufferImageCopy& copy : copies) {
+        const Extent3D mip_size = AdjustMipSize(info.size, copy.image_subresource.base_level);
         ASSERT(copy.image_offset == Offset3D{});
         ASSERT(copy.image_subresource.base_layer == 0);
         ASSERT(copy.image_extent == mip_size);
         ASSERT(copy.buffer_row_length == Common::AlignUp(mip_size.width, tile_size.width));
         ASSERT(copy.buffer_image_height == Common::AlignUp(mip_size.height, tile_size.height));
+    }
+
+    if (!IsPixelFormatASTC(info.format)) {
+        // Every level is decoded at once, so small levels do not leave the workers idle
+        const size_t decoded_size = DecompressBCn(input, output, copies, info.format);
+        for (BufferImageCopy& copy : copies) {
+            copy.buffer_row_length = copy.image_extent.width;
+            copy.buffer_image_height = copy.image_extent.height;
+        }
+        return decoded_size;
+    }
 
+    u32 output_offset = 0;
+    Common::ScratchBuffer<u8> decode_scratch;
+    for (BufferImageCopy& copy : copies) {
         const auto input_offset = input.subspan(copy.buffer_offset);
         copy.buffer_offset = output_offset;
 
         const auto recompression_setting = Settings::values.astc_recompression.GetValue();
-        const bool astc = IsPixelFormatASTC(info.format);
-
-        if (astc && recompression_setting == Settings::AstcRecompression::Uncompressed) {
+        if (recompression_setting == Settings::AstcRecompression::Uncompressed) {
             Tegra::Texture::ASTC::Decompress(
                 input_offset, copy.image_extent.width, copy.image_extent.height,
                 copy.image_subresource.num_layers * copy.image_extent.depth, tile_size.width,
@@ -940,7 +948,7 @@ void ConvertImage(std::span<const u8> input, const ImageInfo& info, std::span<u8
             output_offset += copy.image_extent.width * copy.image_extent.height *
                              copy.image_subresource.num_layers *
                              BytesPerBlock(PixelFormat::A8B8G8R8_UNORM);
-        } else if (astc) {
+        } else {
             // BC1 uses 0.5 bytes per texel
             // BC3 uses 1 byte per texel
             const auto compress = recompression_setting == Settings::AstcRecompression::Bc1
@@ -961,7 +969,7 @@ void ConvertImage(std::span<const u8> input, const ImageInfo& info, std::span<u8
 
             compress(decode_scratch, copy.image_extent.width, copy.image_extent.height,
                      copy.image_subresource.num_layers * copy.image_extent.depth,
-                     output.subspan(output_offset));
+                     output.subspan(output_offset), Tegra::Texture::BCN::GetHostEncoderKernel());
 
             const u32 aligned_plane_dim = Common::AlignUp(copy.image_extent.width, 4) *
                                           Common::AlignUp(copy.image_extent.height, 4);
@@ -970,16 +978,12 @@ void ConvertImage(std::span<const u8> input, const ImageInfo& info, std::span<u8
                 (aligned_plane_dim * copy.image_extent.depth * copy.image_subresource.num_layers) /
                 bpp_div;
             output_offset += static_cast<u32>(copy.buffer_size);
-        } else {
-            DecompressBCn(input_offset, output.subspan(output_offset), copy, info.format);
-            output_offset += copy.image_extent.width * copy.image_extent.height *
-                             copy.image_subresource.num_layers *
-                             ConvertedBytesPerBlock(info.format);
         }
 
-        copy.buffer_row_length = mip_size.width;
-        copy.buffer_image_height = mip_size.height;
+        copy.buffer_row_length = copy.image_extent.width;
+        copy.buffer_image_height = copy.image_extent.height;
     }
+    return output_offset;
 }
 
 boost::container::small_vector<BufferImageCopy, 16> FullDownloadCopies(const ImageInfo& info) {
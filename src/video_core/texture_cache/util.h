@@ -66,8 +66,9 @@ struct OverlapResult {
     Tegra::MemoryManager& gpu_memory, GPUVAddr gpu_addr, const ImageInfo& info,
     std::span<const u8> input, std::span<u8> output);
 
-void ConvertImage(std::span<const u8> input, const ImageInfo& info, std::span<u8> output,
-                  std::span<BufferImageCopy> copies);
+/// Converts unswizzled data to a host supported format, returns the number of bytes written
+size_t ConvertImage(std::span<const u8> input, const ImageInfo& info, std::span<u8> output,
+                    std::span<BufferImageCopy> copies);
 
 [[nodiscard]] boost::container::small_vector<BufferImageCopy, 16> FullDownloadCopies(
     const ImageInfo& info);
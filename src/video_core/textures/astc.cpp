@@ -13,6 +13,10 @@
 
 #include <boost/container/static_vector.hpp>
 
+#ifdef ARCHITECTURE_x86_64
+#include <emmintrin.h>
+#endif
+
 #include "common/alignment.h"
 #include "common/common_types.h"
 #include "common/polyfill_ranges.h"
@@ -621,11 +625,6 @@ static constexpr auto MakeReplicateTable() {
     return table;
 }
 
-static constexpr auto REPLICATE_BYTE_TO_16_TABLE = MakeReplicateTable<u32, 8, 16>();
-static constexpr u32 ReplicateByteTo16(std::size_t value) {
-    return REPLICATE_BYTE_TO_16_TABLE[value];
-}
-
 static constexpr auto REPLICATE_BIT_TO_7_TABLE = MakeReplicateTable<u32, 1, 7>();
 static constexpr u32 ReplicateBitTo7(std::size_t value) {
     return REPLICATE_BIT_TO_7_TABLE[value];
@@ -1075,11 +1074,68 @@ static u32 UnquantizeTexelWeight(const IntegerEncodedValue& val) {
     return result;
 }
 
+// Bilinear infill coefficients of every texel of a block for a given weight grid (Section C.2.18).
+// Grid texels outside of the grid point to a trailing zero weight, which weighs nothing.
+struct InfillTable {
+    u32 key = UINT32_MAX;
+    std::array<std::array<u8, 4>, 144> index;
+    std::array<std::array<u8, 4>, 144> factor;
+};
+
+static const InfillTable& GetInfillTable(const TexelWeightParams& params, const u32 blockWidth,
+                                         const u32 blockHeight) {
+    // Blocks of a texture almost always share the same weight grid, keep the last one per thread
+    thread_local InfillTable table;
+    const u32 key = blockWidth | (blockHeight << 4) | (params.m_Width << 8) |
+                    (params.m_Height << 12);
+    if (table.key == key) {
+        return table;
+    }
+    table.key = key;
+
+    const u32 Ds = (1024 + (blockWidth / 2)) / (blockWidth - 1);
+    const u32 Dt = (1024 + (blockHeight / 2)) / (blockHeight - 1);
+    const u32 numWeights = params.m_Width * params.m_Height;
+    for (u32 t = 0; t < blockHeight; t++) {
+        for (u32 s = 0; s < blockWidth; s++) {
+            const u32 cs = Ds * s;
+            const u32 ct = Dt * t;
+
+            const u32 gs = (cs * (params.m_Width - 1) + 32) >> 6;
+            const u32 gt = (ct * (params.m_Height - 1) + 32) >> 6;
+
+            const u32 js = gs >> 4;
+            const u32 fs = gs & 0xF;
+
+            const u32 jt = gt >> 4;
+            const u32 ft = gt & 0x0F;
+
+            const u32 w11 = (fs * ft + 8) >> 4;
+            const u32 w10 = ft - w11;
+            const u32 w01 = fs - w11;
+            const u32 w00 = 16 - fs - ft + w11;
+
+            const u32 v0 = js + jt * params.m_Width;
+            const std::array<u32, 4> texels{v0, v0 + 1, v0 + params.m_Width,
+                                            v0 + params.m_Width + 1};
+
+            const u32 texel = t * blockWidth + s;
+            for (u32 i = 0; i < 4; i++) {
+                table.index[texel][i] = static_cast<u8>(texels[i] < numWeights ? texels[i] : 144);
+            }
+            table.factor[texel] = {static_cast<u8>(w00), static_cast<u8>(w01), static_cast<u8>(w10),
+                                   static_cast<u8>(w11)};
+        }
+    }
+    return table;
+}
+
 static void UnquantizeTexelWeights(u32 out[2][144], const IntegerEncodedVector& weights,
                                    const TexelWeightParams& params, const u32 blockWidth,
                                    const u32 blockHeight) {
     u32 weightIdx = 0;
-    u32 unquantized[2][144];
+    // One extra zero weight is used for grid texels outside of the grid
+    u32 unquantized[2][145];
 
     for (auto itr = weights.begin(); itr != weights.end(); ++itr) {
         unquantized[0][weightIdx] = UnquantizeTexelWeight(*itr);
@@ -1095,52 +1151,23 @@ static void UnquantizeTexelWeights(u32 out[2][144], const IntegerEncodedVector&
         if (++weightIdx >= (params.m_Width * params.m_Height))
             break;
     }
+    unquantized[0][144] = 0;
+    unquantized[1][144] = 0;
 
     // Do infill if necessary (Section C.2.18) ...
-    u32 Ds = (1024 + (blockWidth / 2)) / (blockWidth - 1);
-    u32 Dt = (1024 + (blockHeight / 2)) / (blockHeight - 1);
-
+    const InfillTable& table = GetInfillTable(params, blockWidth, blockHeight);
+    const u32 numTexels = blockWidth * blockHeight;
     const u32 kPlaneScale = params.m_bDualPlane ? 2U : 1U;
-    for (u32 plane = 0; plane < kPlaneScale; plane++)
-        for (u32 t = 0; t < blockHeight; t++)
-            for (u32 s = 0; s < blockWidth; s++) {
-                u32 cs = Ds * s;
-                u32 ct = Dt * t;
-
-                u32 gs = (cs * (params.m_Width - 1) + 32) >> 6;
-                u32 gt = (ct * (params.m_Height - 1) + 32) >> 6;
-
-                u32 js = gs >> 4;
-                u32 fs = gs & 0xF;
-
-                u32 jt = gt >> 4;
-                u32 ft = gt & 0x0F;
-
-                u32 w11 = (fs * ft + 8) >> 4;
-                u32 w10 = ft - w11;
-                u32 w01 = fs - w11;
-                u32 w00 = 16 - fs - ft + w11;
-
-                u32 v0 = js + jt * params.m_Width;
-
-#define FIND_TEXEL(tidx, bidx)                                                                     \
-    u32 p##bidx = 0;                                                                               \
-    do {                                                                                           \
-        if ((tidx) < (params.m_Width * params.m_Height)) {                                         \
-            p##bidx = unquantized[plane][(tidx)];                                                  \
-        }                                                                                          \
-    } while (0)
-
-                FIND_TEXEL(v0, 00);
-                FIND_TEXEL(v0 + 1, 01);
-                FIND_TEXEL(v0 + params.m_Width, 10);
-                FIND_TEXEL(v0 + params.m_Width + 1, 11);
-
-#undef FIND_TEXEL
-
-                out[plane][t * blockWidth + s] =
-                    (p00 * w00 + p01 * w01 + p10 * w10 + p11 * w11 + 8) >> 4;
-            }
+    for (u32 plane = 0; plane < kPlaneScale; plane++) {
+        const u32* const grid = unquantized[plane];
+        for (u32 texel = 0; texel < numTexels; texel++) {
+            const auto& index = table.index[texel];
+            const auto& factor = table.factor[texel];
+            out[plane][texel] = (grid[index[0]] * factor[0] + grid[index[1]] * factor[1] +
+                                 grid[index[2]] * factor[2] + grid[index[3]] * factor[3] + 8) >>
+                                4;
+        }
+    }
 }
 
 // Transfers a bit as described in C.2.14
@@ -1419,6 +1446,63 @@ static void FillError(std::span<u32> outBuf, u32 blockWidth, u32 blockHeight) {
     }
 }
 
+// Interpolates between the 8-bit endpoints of each texel's partition and packs the result as RGBA8.
+// Endpoints are expanded to 16 bits (x * 257), blended with 6-bit weights and rounded back to 8
+// bits as (255 * C + 32768) >> 16, which is exact for the whole 16-bit range.
+#ifdef ARCHITECTURE_x86_64
+static void InterpolateTexels(std::span<u32, 12 * 12> outBuf,
+                              const std::array<std::array<std::array<u8, 4>, 2>, 4>& endpoints,
+                              const std::array<u8, 144>& partitions, const u32 weights[2][144],
+                              const u32 dualPlaneChannel, const u32 numTexels) {
+    // Interleave both endpoints of each channel so a single madd blends all four channels
+    __m128i endpointPairs[4];
+    for (u32 i = 0; i < endpoints.size(); i++) {
+        const auto& e = endpoints[i];
+        endpointPairs[i] = _mm_setr_epi16(e[0][0], e[1][0], e[0][1], e[1][1], e[0][2], e[1][2],
+                                          e[0][3], e[1][3]);
+    }
+    // Lanes of the channel that reads from the second weight plane
+    const __m128i dualPlaneMask = _mm_cmpeq_epi32(
+        _mm_setr_epi32(0, 1, 2, 3), _mm_set1_epi32(static_cast<s32>(dualPlaneChannel)));
+    const u32* const secondPlane = dualPlaneChannel < 4 ? weights[1] : weights[0];
+    const __m128i weightSum = _mm_set1_epi32(64);
+    for (u32 texel = 0; texel < numTexels; texel++) {
+        const __m128i w0 = _mm_set1_epi32(static_cast<s32>(weights[0][texel]));
+        const __m128i w1 = _mm_set1_epi32(static_cast<s32>(secondPlane[texel]));
+        const __m128i w = _mm_or_si128(_mm_andnot_si128(dualPlaneMask, w0),
+                                       _mm_and_si128(dualPlaneMask, w1));
+        // (64 - w) in the low half and w in the high half of each 32-bit lane
+        const __m128i factors = _mm_or_si128(_mm_sub_epi32(weightSum, w), _mm_slli_epi32(w, 16));
+        const __m128i blend = _mm_madd_epi16(endpointPairs[partitions[texel]], factors);
+        // C = (blend * 257 + 32) >> 6
+        const __m128i c = _mm_srli_epi32(
+            _mm_add_epi32(_mm_add_epi32(_mm_slli_epi32(blend, 8), blend), _mm_set1_epi32(32)), 6);
+        // (255 * C + 32768) >> 16
+        const __m128i rounded = _mm_srli_epi32(
+            _mm_add_epi32(_mm_sub_epi32(_mm_slli_epi32(c, 8), c), _mm_set1_epi32(32768)), 16);
+        const __m128i packed = _mm_packus_epi16(_mm_packs_epi32(rounded, rounded), rounded);
+        outBuf[texel] = static_cast<u32>(_mm_cvtsi128_si32(packed));
+    }
+}
+#else
+static void InterpolateTexels(std::span<u32, 12 * 12> outBuf,
+                              const std::array<std::array<std::array<u8, 4>, 2>, 4>& endpoints,
+                              const std::array<u8, 144>& partitions, const u32 weights[2][144],
+                              const u32 dualPlaneChannel, const u32 numTexels) {
+    for (u32 texel = 0; texel < numTexels; texel++) {
+        const auto& e = endpoints[partitions[texel]];
+        u32 packed = 0;
+        for (u32 c = 0; c < 4; c++) {
+            const u32 weight = weights[c == dualPlaneChannel ? 1 : 0][texel];
+            const u32 blend = e[0][c] * (64 - weight) + e[1][c] * weight;
+            const u32 C = (blend * 257 + 32) >> 6;
+            packed |= ((255 * C + 32768) >> 16) << (c * 8);
+        }
+        outBuf[texel] = packed;
+    }
+}
+#endif
+
 static void DecompressBlock(std::span<const u8, 16> inBuf, const u32 blockWidth,
                             const u32 blockHeight, std::span<u32, 12 * 12> outBuf) {
     InputBitStream strm(inBuf);
@@ -1619,36 +1703,31 @@ static void DecompressBlock(std::span<const u8, 16> inBuf, const u32 blockWidth,
 
     // Now that we have endpoints and weights, we can interpolate and generate
     // the proper decoding...
-    for (u32 j = 0; j < blockHeight; j++)
-        for (u32 i = 0; i < blockWidth; i++) {
-            u32 partition = Select2DPartition(partitionIndex, i, j, nPartitions,
-                                              (blockHeight * blockWidth) < 32);
-            assert(partition < nPartitions);
+    const u32 dualPlaneChannel = weightParams.m_bDualPlane ? (planeIdx & 3) : 4;
+    std::array<u8, 144> partitions{};
+    if (nPartitions > 1) {
+        const bool smallBlock = (blockHeight * blockWidth) < 32;
+        for (u32 j = 0; j < blockHeight; j++) {
+            for (u32 i = 0; i < blockWidth; i++) {
+                const u32 partition =
+                    Select2DPartition(partitionIndex, i, j, nPartitions, smallBlock);
+                assert(partition < nPartitions);
+                partitions[j * blockWidth + i] = static_cast<u8>(partition);
+            }
+        }
+    }
 
-            Pixel p;
+    // Endpoints in RGBA order, matching the packed output
+    std::array<std::array<std::array<u8, 4>, 2>, 4> rgbaEndpoints;
+    for (u32 i = 0; i < nPartitions; i++) {
+        for (u32 e = 0; e < 2; e++) {
             for (u32 c = 0; c < 4; c++) {
-                u32 C0 = endpoints[partition][0].Component(c);
-                C0 = ReplicateByteTo16(C0);
-                u32 C1 = endpoints[partition][1].Component(c);
-                C1 = ReplicateByteTo16(C1);
-
-                u32 plane = 0;
-                if (weightParams.m_bDualPlane && (((planeIdx + 1) & 3) == c)) {
-                    plane = 1;
-                }
-
-                u32 weight = weights[plane][j * blockWidth + i];
-                u32 C = (C0 * (64 - weight) + C1 * weight + 32) / 64;
-                if (C == 65535) {
-                    p.Component(c) = 255;
-                } else {
-                    double Cf = static_cast<double>(C);
-                    p.Component(c) = static_cast<u16>(255.0 * (Cf / 65536.0) + 0.5);
-                }
+                rgbaEndpoints[i][e][c] = static_cast<u8>(endpoints[i][e].Component((c + 1) & 3));
             }
-
-            outBuf[j * blockWidth + i] = p.Pack();
         }
+    }
+    InterpolateTexels(outBuf, rgbaEndpoints, partitions, weights, dualPlaneChannel,
+                      blockWidth * blockHeight);
 }
 
 void Decompress(std::span<const uint8_t> data, uint32_t width, uint32_t height, uint32_t depth,
@@ -1658,36 +1737,43 @@ void Decompress(std::span<const uint8_t> data, uint32_t width, uint32_t height,
 
     Common::ThreadWorker& workers{GetThreadWorkers()};
 
-    for (u32 z = 0; z < depth; ++z) {
-        const u32 depth_offset = z * height * width * 4;
-        for (u32 y_index = 0; y_index < rows; ++y_index) {
-            auto decompress_stride = [data, width, height, block_width, block_height, output, rows,
-                                      cols, z, depth_offset, y_index] {
+    // Split the block rows of every slice into a few tiles per worker, so that all slices are
+    // decoded with a single wait and the queue is not flooded with one task per row.
+    const u32 total_rows = rows * depth;
+    const u32 num_tiles = std::min<u32>(total_rows, static_cast<u32>(workers.NumWorkers()) * 4);
+    const u32 rows_per_tile = Common::DivideUp(total_rows, std::max(num_tiles, 1U));
+
+    for (u32 first_row = 0; first_row < total_rows; first_row += rows_per_tile) {
+        const u32 last_row = std::min(first_row + rows_per_tile, total_rows);
+        auto decompress_tile = [data, width, height, block_width, block_height, output, rows,
+                                cols, first_row, last_row] {
+            // Blocks can be at most 12x12
+            std::array<u32, 12 * 12> uncompData;
+            for (u32 row = first_row; row < last_row; ++row) {
+                const u32 z = row / rows;
+                const u32 y_index = row % rows;
+                const u32 depth_offset = z * height * width * 4;
                 const u32 y = y_index * block_height;
+                const u32 decompHeight = std::min(block_height, height - y);
                 for (u32 x_index = 0; x_index < cols; ++x_index) {
-                    const u32 block_index = (z * rows * cols) + (y_index * cols) + x_index;
+                    const u32 block_index = row * cols + x_index;
                     const u32 x = x_index * block_width;
 
                     const std::span<const u8, 16> blockPtr{data.subspan(block_index * 16, 16)};
-
-                    // Blocks can be at most 12x12
-                    std::array<u32, 12 * 12> uncompData;
                     DecompressBlock(blockPtr, block_width, block_height, uncompData);
 
-                    u32 decompWidth = std::min(block_width, width - x);
-                    u32 decompHeight = std::min(block_height, height - y);
-
+                    const u32 decompWidth = std::min(block_width, width - x);
                     const std::span<u8> outRow = output.subspan(depth_offset + (y * width + x) * 4);
                     for (u32 h = 0; h < decompHeight; ++h) {
                         std::memcpy(outRow.data() + h * width * 4,
                                     uncompData.data() + h * block_width, decompWidth * 4);
                     }
                 }
-            };
-            workers.QueueWork(std::move(decompress_stride));
-        }
-        workers.WaitForRequests();
+            }
+        };
+        workers.QueueWork(std::move(decompress_tile));
     }
+    workers.WaitForRequests();
 }
 
 } // namespace Tegra::Texture::ASTC
@@ -1,86 +1,572 @@
 // SPDX-FileCopyrightText: Copyright 2023 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
 #include <stb_dxt.h>
 #include <string.h>
+
+#ifdef ARCHITECTURE_x86_64
+#include <emmintrin.h>
+#endif
+
 #include "common/alignment.h"
 #include "video_core/textures/bcn.h"
 #include "video_core/textures/workers.h"
 
 namespace Tegra::Texture::BCN {
 
+namespace {
+
 using BCNCompressor = void(u8* block_output, const u8* block_input, bool any_alpha);
 
+constexpr u8 ALPHA_THRESHOLD = 128;
+constexpr u32 BYTES_PER_TEXEL = 4;
+
+// Input bytes encoded by each job, small enough for a strip to stay in the L2 cache of a core
+constexpr u32 STRIP_SIZE = 256 * 1024;
+
+constexpr EncoderKernel DetectEncoderKernel() {
+#ifdef ARCHITECTURE_x86_64
+    // SSE2 is part of the x86_64 baseline
+    return EncoderKernel::SSE;
+#else
+    return EncoderKernel::Stb;
+#endif
+}
+
+void StbCompressBC1(u8* block_output, const u8* block_input, bool any_alpha) {
+    stb_compress_bc1_block(block_output, block_input, any_alpha, STB_DXT_NORMAL);
+}
+
+void StbCompressBC3(u8* block_output, const u8* block_input, bool) {
+    stb_compress_bc3_block(block_output, block_input, STB_DXT_NORMAL);
+}
+
+#ifdef ARCHITECTURE_x86_64
+constexpr u32 Expand5(u32 value) {
+    return (value << 3) | (value >> 2);
+}
+
+constexpr u32 Expand6(u32 value) {
+    return (value << 2) | (value >> 4);
+}
+
+/// Endpoint pairs whose 2/3 interpolation reproduces each 8-bit value as close as possible
+template <u32 Bits>
+constexpr std::array<std::array<u8, 2>, 256> MakeSingleColorTable() {
+    constexpr u32 max_value = (1U << Bits) - 1;
+    std::array<std::array<u8, 2>, 256> table{};
+    for (u32 value = 0; value < 256; ++value) {
+        u32 best_error = 256;
+        for (u32 high = 0; high <= max_value && best_error > 0; ++high) {
+            for (u32 low = 0; low <= max_value; ++low) {
+                const u32 expanded_high = Bits == 5 ? Expand5(high) : Expand6(high);
+                const u32 expanded_low = Bits == 5 ? Expand5(low) : Expand6(low);
+                const u32 interpolated = (2 * expanded_high + expanded_low) / 3;
+                const u32 error =
+                    interpolated > value ? interpolated - value : value - interpolated;
+                if (error < best_error) {
+                    best_error = error;
+                    table[value] = {static_cast<u8>(high), static_cast<u8>(low)};
+                }
+            }
+        }
+    }
+    return table;
+}
+
+constexpr auto SINGLE_COLOR_5 = MakeSingleColorTable<5>();
+constexpr auto SINGLE_COLOR_6 = MakeSingleColorTable<6>();
+
+float HorizontalSum(__m128 value) {
+    const __m128 high = _mm_movehl_ps(value, value);
+    const __m128 pairs = _mm_add_ps(value, high);
+    return _mm_cvtss_f32(_mm_add_ss(pairs, _mm_shuffle_ps(pairs, pairs, 1)));
+}
+
+/// 4x4 block of texels in structure of arrays form, four texels per vector
+struct ColorBlock {
+    __m128 r[4];
+    __m128 g[4];
+    __m128 b[4];
+    __m128 weight[4];       ///< 1 for texels taking part in the fit, 0 for transparent ones
+    __m128i transparent[4]; ///< All bits set for transparent texels
+};
+
+struct Color {
+    float r;
+    float g;
+    float b;
+};
+
+struct BlockFit {
+    u16 color0;
+    u16 color1;
+    u32 indices;
+    float error;
+};
+
+ColorBlock LoadColorBlock(const u8* texels, bool three_color) {
+    const __m128i byte_mask = _mm_set1_epi32(0xFF);
+    const __m128 one = _mm_set1_ps(1.0f);
+    ColorBlock block;
+    for (u32 i = 0; i < 4; ++i) {
+        const __m128i row = _mm_loadu_si128(reinterpret_cast<const __m128i*>(texels + i * 16));
+        block.r[i] = _mm_cvtepi32_ps(_mm_and_si128(row, byte_mask));
+        block.g[i] = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(row, 8), byte_mask));
+        block.b[i] = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(row, 16), byte_mask));
+        if (three_color) {
+            block.transparent[i] = _mm_cmpeq_epi32(_mm_srli_epi32(row, 24), _mm_setzero_si128());
+            block.weight[i] = _mm_andnot_ps(_mm_castsi128_ps(block.transparent[i]), one);
+        } else {
+            block.transparent[i] = _mm_setzero_si128();
+            block.weight[i] = one;
+        }
+    }
+    return block;
+}
+
+Color Unpack565(u16 color) {
+    return {
+        static_cast<float>(Expand5(color >> 11)),
+        static_cast<float>(Expand6((color >> 5) & 0x3F)),
+        static_cast<float>(Expand5(color & 0x1F)),
+    };
+}
+
+u16 Pack565(const Color& color) {
+    const auto quantize = [](float value, float max_value) {
+        const float clamped = std::clamp(value, 0.0f, 255.0f);
+        return static_cast<u32>(clamped * max_value / 255.0f + 0.5f);
+    };
+    return static_cast<u16>((quantize(color.r, 31.0f) << 11) | (quantize(color.g, 63.0f) << 5) |
+                            quantize(color.b, 31.0f));
+}
+
+/// Finds the closest palette entry of every texel, transparent texels take index 3 in three
+/// color mode.
+BlockFit MatchColors(const ColorBlock& block, u16 color0, u16 color1, bool three_color) {
+    const Color c0 = Unpack565(color0);
+    const Color c1 = Unpack565(color1);
+    std::array<Color, 4> palette{c0, c1};
+    if (three_color) {
+        palette[2] = {std::floor((c0.r + c1.r) / 2), std::floor((c0.g + c1.g) / 2),
+                      std::floor((c0.b + c1.b) / 2)};
+        palette[3] = palette[2];
+    } else {
+        palette[2] = {std::floor((2 * c0.r + c1.r) / 3), std::floor((2 * c0.g + c1.g) / 3),
+                      std::floor((2 * c0.b + c1.b) / 3)};
+        palette[3] = {std::floor((c0.r + 2 * c1.r) / 3), std::floor((c0.g + 2 * c1.g) / 3),
+                      std::floor((c0.b + 2 * c1.b) / 3)};
+    }
+    const u32 num_colors = three_color ? 3 : 4;
+    __m128 total_error = _mm_setzero_ps();
+    u32 indices = 0;
+    for (u32 i = 0; i < 4; ++i) {
+        __m128 best_error = _mm_set1_ps(std::numeric_limits<float>::max());
+        __m128i best_index = _mm_setzero_si128();
+        for (u32 entry = 0; entry < num_colors; ++entry) {
+            const __m128 dr = _mm_sub_ps(block.r[i], _mm_set1_ps(palette[entry].r));
+            const __m128 dg = _mm_sub_ps(block.g[i], _mm_set1_ps(palette[entry].g));
+            const __m128 db = _mm_sub_ps(block.b[i], _mm_set1_ps(palette[entry].b));
+            const __m128 error = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dr, dr), _mm_mul_ps(dg, dg)),
+                                            _mm_mul_ps(db, db));
+            const __m128i closer = _mm_castps_si128(_mm_cmplt_ps(error, best_error));
+            best_error = _mm_min_ps(error, best_error);
+            best_index = _mm_or_si128(_mm_andnot_si128(closer, best_index),
+                                      _mm_and_si128(closer, _mm_set1_epi32(entry)));
+        }
+        best_index = _mm_or_si128(best_index, _mm_and_si128(block.transparent[i],
+                                                            _mm_set1_epi32(3)));
+        total_error = _mm_add_ps(total_error, _mm_mul_ps(best_error, block.weight[i]));
+
+        alignas(16) std::array<u32, 4> lanes;
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes.data()), best_index);
+        for (u32 lane = 0; lane < 4; ++lane) {
+            indices |= lanes[lane] << ((i * 4 + lane) * 2);
+        }
+    }
+    return {color0, color1, indices, HorizontalSum(total_error)};
+}
+
+/// Solves the least squares endpoints for the given indices, returns false when the system is
+/// singular.
+bool RefineEndpoints(const ColorBlock& block, u32 indices, bool three_color, u16& color0,
+                     u16& color1) {
+    static constexpr std::array<float, 4> FOUR_COLOR_WEIGHTS{1.0f, 0.0f, 2.0f / 3, 1.0f / 3};
+    static constexpr std::array<float, 4> THREE_COLOR_WEIGHTS{1.0f, 0.0f, 0.5f, 0.0f};
+    const auto& weights = three_color ? THREE_COLOR_WEIGHTS : FOUR_COLOR_WEIGHTS;
+
+    __m128 aa = _mm_setzero_ps();
+    __m128 bb = _mm_setzero_ps();
+    __m128 ab = _mm_setzero_ps();
+    __m128 ax[3]{_mm_setzero_ps(), _mm_setzero_ps(), _mm_setzero_ps()};
+    __m128 bx[3]{_mm_setzero_ps(), _mm_setzero_ps(), _mm_setzero_ps()};
+    for (u32 i = 0; i < 4; ++i) {
+        const u32 shift = i * 8;
+        const __m128 alpha = _mm_setr_ps(
+            weights[(indices >> shift) & 3], weights[(indices >> (shift + 2)) & 3],
+            weights[(indices >> (shift + 4)) & 3], weights[(indices >> (shift + 6)) & 3]);
+        const __m128 beta = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(1.0f), alpha), block.weight[i]);
+        const __m128 weighted_alpha = _mm_mul_ps(alpha, block.weight[i]);
+        aa = _mm_add_ps(aa, _mm_mul_ps(weighted_alpha, alpha));
+        bb = _mm_add_ps(bb, _mm_mul_ps(beta, beta));
+        ab = _mm_add_ps(ab, _mm_mul_ps(weighted_alpha, beta));
+        const __m128 channels[3]{block.r[i], block.g[i], block.b[i]};
+        for (u32 channel = 0; channel < 3; ++channel) {
+            ax[channel] = _mm_add_ps(ax[channel], _mm_mul_ps(weighted_alpha, channels[channel]));
+            bx[channel] = _mm_add_ps(bx[channel], _mm_mul_ps(beta, channels[channel]));
+        }
+    }
+    const float sum_aa = HorizontalSum(aa);
+    const float sum_bb = HorizontalSum(bb);
+    const float sum_ab = HorizontalSum(ab);
+    const float determinant = sum_aa * sum_bb - sum_ab * sum_ab;
+    if (std::abs(determinant) < 1e-3f) {
+        return false;
+    }
+    const float inverse = 1.0f / determinant;
+    float endpoint0[3];
+    float endpoint1[3];
+    for (u32 channel = 0; channel < 3; ++channel) {
+        const float sum_ax = HorizontalSum(ax[channel]);
+        const float sum_bx = HorizontalSum(bx[channel]);
+        endpoint0[channel] = (sum_bb * sum_ax - sum_ab * sum_bx) * inverse;
+        endpoint1[channel] = (sum_aa * sum_bx - sum_ab * sum_ax) * inverse;
+    }
+    color0 = Pack565({endpoint0[0], endpoint0[1], endpoint0[2]});
+    color1 = Pack565({endpoint1[0], endpoint1[1], endpoint1[2]});
+    return true;
+}
+
+/// Fits the endpoints to the extent of the block along its principal axis
+void FitPrincipalAxis(const ColorBlock& block, u16& color0, u16& color1) {
+    __m128 count = _mm_setzero_ps();
+    __m128 sum[3]{_mm_setzero_ps(), _mm_setzero_ps(), _mm_setzero_ps()};
+    for (u32 i = 0; i < 4; ++i) {
+        count = _mm_add_ps(count, block.weight[i]);
+        sum[0] = _mm_add_ps(sum[0], _mm_mul_ps(block.r[i], block.weight[i]));
+        sum[1] = _mm_add_ps(sum[1], _mm_mul_ps(block.g[i], block.weight[i]));
+        sum[2] = _mm_add_ps(sum[2], _mm_mul_ps(block.b[i], block.weight[i]));
+    }
+    const float inverse_count = 1.0f / HorizontalSum(count);
+    const Color mean{HorizontalSum(sum[0]) * inverse_count, HorizontalSum(sum[1]) * inverse_count,
+                     HorizontalSum(sum[2]) * inverse_count};
+
+    // Covariance matrix, in the order rr, rg, rb, gg, gb, bb
+    __m128 covariance[6]{};
+    __m128 dr[4];
+    __m128 dg[4];
+    __m128 db[4];
+    for (u32 i = 0; i < 4; ++i) {
+        dr[i] = _mm_mul_ps(_mm_sub_ps(block.r[i], _mm_set1_ps(mean.r)), block.weight[i]);
+        dg[i] = _mm_mul_ps(_mm_sub_ps(block.g[i], _mm_set1_ps(mean.g)), block.weight[i]);
+        db[i] = _mm_mul_ps(_mm_sub_ps(block.b[i], _mm_set1_ps(mean.b)), block.weight[i]);
+        covariance[0] = _mm_add_ps(covariance[0], _mm_mul_ps(dr[i], dr[i]));
+        covariance[1] = _mm_add_ps(covariance[1], _mm_mul_ps(dr[i], dg[i]));
+        covariance[2] = _mm_add_ps(covariance[2], _mm_mul_ps(dr[i], db[i]));
+        covariance[3] = _mm_add_ps(covariance[3], _mm_mul_ps(dg[i], dg[i]));
+        covariance[4] = _mm_add_ps(covariance[4], _mm_mul_ps(dg[i], db[i]));
+        covariance[5] = _mm_add_ps(covariance[5], _mm_mul_ps(db[i], db[i]));
+    }
+    float cov[6];
+    for (u32 i = 0; i < 6; ++i) {
+        cov[i] = HorizontalSum(covariance[i]);
+    }
+
+    // Power iteration, starting from the covariance row of the channel with the largest variance
+    Color axis{cov[0], cov[1], cov[2]};
+    if (cov[3] > cov[0] && cov[3] >= cov[5]) {
+        axis = {cov[1], cov[3], cov[4]};
+    } else if (cov[5] > cov[0] && cov[5] > cov[3]) {
+        axis = {cov[2], cov[4], cov[5]};
+    }
+    for (u32 iteration = 0; iteration < 4; ++iteration) {
+        const float magnitude = std::max({std::abs(axis.r), std::abs(axis.g), std::abs(axis.b)});
+        if (magnitude < 1e-6f) {
+            break;
+        }
+        const Color scaled{axis.r / magnitude, axis.g / magnitude, axis.b / magnitude};
+        axis = {
+            scaled.r * cov[0] + scaled.g * cov[1] + scaled.b * cov[2],
+            scaled.r * cov[1] + scaled.g * cov[3] + scaled.b * cov[4],
+            scaled.r * cov[2] + scaled.g * cov[4] + scaled.b * cov[5],
+        };
+    }
+    const float length_squared = axis.r * axis.r + axis.g * axis.g + axis.b * axis.b;
+    if (length_squared < 1e-6f) {
+        color0 = color1 = Pack565(mean);
+        return;
+    }
+    const float inverse_length = 1.0f / std::sqrt(length_squared);
+    axis = {axis.r * inverse_length, axis.g * inverse_length, axis.b * inverse_length};
+
+    // Transparent texels project onto the mean, which always lies inside the extent
+    __m128 min_projection = _mm_setzero_ps();
+    __m128 max_projection = _mm_setzero_ps();
+    for (u32 i = 0; i < 4; ++i) {
+        const __m128 projection =
+            _mm_add_ps(_mm_add_ps(_mm_mul_ps(dr[i], _mm_set1_ps(axis.r)),
+                                  _mm_mul_ps(dg[i], _mm_set1_ps(axis.g))),
+                       _mm_mul_ps(db[i], _mm_set1_ps(axis.b)));
+        min_projection = _mm_min_ps(min_projection, projection);
+        max_projection = _mm_max_ps(max_projection, projection);
+    }
+    min_projection = _mm_min_ps(min_projection, _mm_movehl_ps(min_projection, min_projection));
+    min_projection = _mm_min_ss(min_projection, _mm_shuffle_ps(min_projection, min_projection, 1));
+    max_projection = _mm_max_ps(max_projection, _mm_movehl_ps(max_projection, max_projection));
+    max_projection = _mm_max_ss(max_projection, _mm_shuffle_ps(max_projection, max_projection, 1));
+    const float low = _mm_cvtss_f32(min_projection);
+    const float high = _mm_cvtss_f32(max_projection);
+    color0 = Pack565({mean.r + axis.r * high, mean.g + axis.g * high, mean.b + axis.b * high});
+    color1 = Pack565({mean.r + axis.r * low, mean.g + axis.g * low, mean.b + axis.b * low});
+}
+
+void WriteColorBlock(u8* block_output, u16 color0, u16 color1, u32 indices) {
+    memcpy(block_output + 0, &color0, sizeof(color0));
+    memcpy(block_output + 2, &color1, sizeof(color1));
+    memcpy(block_output + 4, &indices, sizeof(indices));
+}
+
+void EncodeColorBlock(u8* block_output, const u8* block_input, bool three_color) {
+    u32 first_texel;
+    memcpy(&first_texel, block_input, sizeof(first_texel));
+    bool is_constant = true;
+    for (u32 i = 1; i < 16 && is_constant; ++i) {
+        is_constant = memcmp(block_input + i * BYTES_PER_TEXEL, &first_texel, 4) == 0;
+    }
+    if (three_color && is_constant && (first_texel >> 24) == 0) {
+        // Fully transparent
+        WriteColorBlock(block_output, 0, 0xFFFF, 0xFFFFFFFF);
+        return;
+    }
+    if (!three_color && is_constant) {
+        // Pick the endpoints whose interpolated color matches the block exactly
+        const auto& r = SINGLE_COLOR_5[first_texel & 0xFF];
+        const auto& g = SINGLE_COLOR_6[(first_texel >> 8) & 0xFF];
+        const auto& b = SINGLE_COLOR_5[(first_texel >> 16) & 0xFF];
+        u16 color0 = static_cast<u16>((r[0] << 11) | (g[0] << 5) | b[0]);
+        u16 color1 = static_cast<u16>((r[1] << 11) | (g[1] << 5) | b[1]);
+        u32 indices = 0xAAAAAAAA;
+        if (color0 < color1) {
+            std::swap(color0, color1);
+            indices ^= 0x55555555;
+        } else if (color0 == color1) {
+            indices = 0;
+        }
+        WriteColorBlock(block_output, color0, color1, indices);
+        return;
+    }
+
+    const ColorBlock block = LoadColorBlock(block_input, three_color);
+    u16 color0;
+    u16 color1;
+    FitPrincipalAxis(block, color0, color1);
+    BlockFit best = MatchColors(block, color0, color1, three_color);
+    for (u32 iteration = 0; iteration < 2; ++iteration) {
+        if (!RefineEndpoints(block, best.indices, three_color, color0, color1) ||
+            (color0 == best.color0 && color1 == best.color1)) {
+            break;
+        }
+        const BlockFit refined = MatchColors(block, color0, color1, three_color);
+        if (refined.error >= best.error) {
+            break;
+        }
+        best = refined;
+    }
+
+    // Four color mode is selected by color0 > color1, three color mode by color0 <= color1
+    if (three_color) {
+        if (best.color0 > best.color1) {
+            std::swap(best.color0, best.color1);
+            // Swap indices 0 and 1, leaving the midpoint and transparent indices untouched
+            best.indices ^= ~(best.indices >> 1) & 0x55555555;
+        }
+    } else if (best.color0 < best.color1) {
+        std::swap(best.color0, best.color1);
+        best.indices ^= 0x55555555;
+    } else if (best.color0 == best.color1) {
+        best.indices = 0;
+    }
+    WriteColorBlock(block_output, best.color0, best.color1, best.indices);
+}
+
+/// Encodes the alpha channel with the extremes as endpoints in eight value mode, the indices
+/// are optimal for these endpoints.
+void EncodeAlphaBlock(u8* block_output, const u8* block_input) {
+    __m128i alpha[4];
+    for (u32 i = 0; i < 4; ++i) {
+        const __m128i row =
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(block_input + i * 16));
+        alpha[i] = _mm_srli_epi32(row, 24);
+    }
+    const __m128i low_texels = _mm_packs_epi32(alpha[0], alpha[1]);
+    const __m128i high_texels = _mm_packs_epi32(alpha[2], alpha[3]);
+    const __m128i bytes = _mm_packus_epi16(low_texels, high_texels);
+    __m128i min_alpha = _mm_min_epu8(bytes, _mm_srli_si128(bytes, 8));
+    __m128i max_alpha = _mm_max_epu8(bytes, _mm_srli_si128(bytes, 8));
+    min_alpha = _mm_min_epu8(min_alpha, _mm_srli_si128(min_alpha, 4));
+    max_alpha = _mm_max_epu8(max_alpha, _mm_srli_si128(max_alpha, 4));
+    min_alpha = _mm_min_epu8(min_alpha, _mm_srli_si128(min_alpha, 2));
+    max_alpha = _mm_max_epu8(max_alpha, _mm_srli_si128(max_alpha, 2));
+    min_alpha = _mm_min_epu8(min_alpha, _mm_srli_si128(min_alpha, 1));
+    max_alpha = _mm_max_epu8(max_alpha, _mm_srli_si128(max_alpha, 1));
+    const int min_value = _mm_cvtsi128_si32(min_alpha) & 0xFF;
+    const int max_value = _mm_cvtsi128_si32(max_alpha) & 0xFF;
+
+    // See http://fgiesen.wordpress.com/2009/12/15/dxt5-alpha-block-index-determination/
+    const int distance = max_value - min_value;
+    const int bias = (distance < 8 ? distance - 1 : distance / 2 + 2) - min_value * 7;
+    const __m128i distance1 = _mm_set1_epi16(static_cast<s16>(distance));
+    const __m128i distance2 = _mm_set1_epi16(static_cast<s16>(distance * 2));
+    const __m128i distance4 = _mm_set1_epi16(static_cast<s16>(distance * 4));
+    const __m128i seven = _mm_set1_epi16(7);
+    alignas(16) std::array<u16, 16> indices;
+    for (u32 half = 0; half < 2; ++half) {
+        const __m128i texels = half == 0 ? low_texels : high_texels;
+        __m128i scaled =
+            _mm_add_epi16(_mm_mullo_epi16(texels, seven), _mm_set1_epi16(static_cast<s16>(bias)));
+        // Linear index from 0 (minimum) to 7 (maximum), compared as (a >= d) == !(d > a)
+        const __m128i ge4 = _mm_andnot_si128(_mm_cmpgt_epi16(distance4, scaled),
+                                             _mm_set1_epi16(-1));
+        scaled = _mm_sub_epi16(scaled, _mm_and_si128(ge4, distance4));
+        const __m128i ge2 = _mm_andnot_si128(_mm_cmpgt_epi16(distance2, scaled),
+                                             _mm_set1_epi16(-1));
+        scaled = _mm_sub_epi16(scaled, _mm_and_si128(ge2, distance2));
+        const __m128i ge1 = _mm_andnot_si128(_mm_cmpgt_epi16(distance1, scaled),
+                                             _mm_set1_epi16(-1));
+        __m128i index = _mm_add_epi16(_mm_and_si128(ge4, _mm_set1_epi16(4)),
+                                      _mm_and_si128(ge2, _mm_set1_epi16(2)));
+        index = _mm_add_epi16(index, _mm_and_si128(ge1, _mm_set1_epi16(1)));
+        // Map the linear index to the block index, where 0 and 1 are the extremes
+        index = _mm_and_si128(_mm_sub_epi16(_mm_setzero_si128(), index), seven);
+        index = _mm_xor_si128(index, _mm_and_si128(_mm_cmpgt_epi16(_mm_set1_epi16(2), index),
+                                                   _mm_set1_epi16(1)));
+        _mm_store_si128(reinterpret_cast<__m128i*>(indices.data() + half * 8), index);
+    }
+    u64 packed = 0;
+    for (u32 i = 0; i < 16; ++i) {
+        packed |= u64{indices[i]} << (i * 3);
+    }
+    block_output[0] = static_cast<u8>(max_value);
+    block_output[1] = static_cast<u8>(min_value);
+    for (u32 i = 0; i < 6; ++i) {
+        block_output[2 + i] = static_cast<u8>(packed >> (i * 8));
+    }
+}
+
+void SSECompressBC1(u8* block_output, const u8* block_input, bool any_alpha) {
+    EncodeColorBlock(block_output, block_input, any_alpha);
+}
+
+void SSECompressBC3(u8* block_output, const u8* block_input, bool) {
+    EncodeAlphaBlock(block_output, block_input);
+    EncodeColorBlock(block_output + 8, block_input, false);
+}
+#endif
+
 template <u32 BytesPerBlock, bool ThresholdAlpha = false>
 void CompressBCN(std::span<const uint8_t> data, uint32_t width, uint32_t height, uint32_t depth,
                  std::span<uint8_t> output, BCNCompressor f) {
-    constexpr u8 alpha_threshold = 128;
-    constexpr u32 bytes_per_px = 4;
     const u32 plane_dim = width * height;
+    const u32 blocks_per_row = Common::DivideUp(width, 4U);
+    const u32 rows_per_plane = Common::DivideUp(height, 4U);
+    const u32 bytes_per_row = BytesPerBlock * blocks_per_row;
+    const u32 bytes_per_plane = bytes_per_row * rows_per_plane;
 
     Common::ThreadWorker& workers{GetThreadWorkers()};
 
-    for (u32 z = 0; z < depth; z++) {
-        for (u32 y = 0; y < height; y += 4) {
-            auto compress_row = [z, y, width, height, plane_dim, f, data, output]() {
+    // Split the block rows of every slice into strips, sized to stay in cache while leaving a few
+    // strips per worker to balance the load, and wait once for all of them.
+    const u32 total_rows = rows_per_plane * depth;
+    if (total_rows == 0) {
+        return;
+    }
+    const u32 input_bytes_per_row = 4 * width * BYTES_PER_TEXEL;
+    const u32 num_workers = std::max(static_cast<u32>(workers.NumWorkers()), 1U);
+    const u32 rows_per_strip =
+        std::clamp(STRIP_SIZE / std::max(input_bytes_per_row, 1U), 1U,
+                   Common::DivideUp(total_rows, num_workers * 4));
+
+    for (u32 first_row = 0; first_row < total_rows; first_row += rows_per_strip) {
+        const u32 last_row = std::min(first_row + rows_per_strip, total_rows);
+        auto compress_strip = [=] {
+            for (u32 row = first_row; row < last_row; ++row) {
+                const u32 z = row / rows_per_plane;
+                const u32 y = (row % rows_per_plane) * 4;
+                u8* const row_output = output.data() + z * bytes_per_plane +
+                                       (y / 4) * bytes_per_row;
                 for (u32 x = 0; x < width; x += 4) {
-                    // Gather 4x4 block of RGBA texels
-                    u8 input_colors[4][4][4];
+                    // Gather 4x4 block of RGBA texels, replicating the edge texels of partial
+                    // blocks so they do not skew the endpoints
+                    alignas(16) u8 input_colors[4][4][4];
                     bool any_alpha = false;
 
                     for (u32 j = 0; j < 4; j++) {
-                        for (u32 i = 0; i < 4; i++) {
-                            const size_t coord =
-                                (z * plane_dim + (y + j) * width + (x + i)) * bytes_per_px;
-
-                            if ((x + i < width) && (y + j < height)) {
-                                if constexpr (ThresholdAlpha) {
-                                    if (data[coord + 3] >= alpha_threshold) {
-                                        input_colors[j][i][0] = data[coord + 0];
-                                        input_colors[j][i][1] = data[coord + 1];
-                                        input_colors[j][i][2] = data[coord + 2];
-                                        input_colors[j][i][3] = 255;
-                                    } else {
-                                        any_alpha = true;
-                                        memset(input_colors[j][i], 0, bytes_per_px);
-                                    }
+                        const u32 texel_y = std::min(y + j, height - 1);
+                        const size_t row_coord =
+                            (size_t{z} * plane_dim + size_t{texel_y} * width) * BYTES_PER_TEXEL;
+                        if (x + 4 <= width) {
+                            memcpy(input_colors[j], &data[row_coord + x * BYTES_PER_TEXEL], 16);
+                        } else {
+                            for (u32 i = 0; i < 4; i++) {
+                                const u32 texel_x = std::min(x + i, width - 1);
+                                memcpy(input_colors[j][i],
+                                       &data[row_coord + texel_x * BYTES_PER_TEXEL],
+                                       BYTES_PER_TEXEL);
+                            }
+                        }
+                        if constexpr (ThresholdAlpha) {
+                            for (u32 i = 0; i < 4; i++) {
+                                if (input_colors[j][i][3] >= ALPHA_THRESHOLD) {
+                                    input_colors[j][i][3] = 255;
                                 } else {
-                                    memcpy(input_colors[j][i], &data[coord], bytes_per_px);
+                                    any_alpha = true;
+                                    memset(input_colors[j][i], 0, BYTES_PER_TEXEL);
                                 }
-                            } else {
-                                memset(input_colors[j][i], 0, bytes_per_px);
                             }
                         }
                     }
 
-                    const u32 bytes_per_row = BytesPerBlock * Common::DivideUp(width, 4U);
-                    const u32 bytes_per_plane = bytes_per_row * Common::DivideUp(height, 4U);
-                    f(output.data() + z * bytes_per_plane + (y / 4) * bytes_per_row +
-                          (x / 4) * BytesPerBlock,
-                      reinterpret_cast<u8*>(input_colors), any_alpha);
+                    f(row_output + (x / 4) * BytesPerBlock, reinterpret_cast<u8*>(input_colors),
+                      any_alpha);
                 }
-            };
-            workers.QueueWork(std::move(compress_row));
-        }
-        workers.WaitForRequests();
+            }
+        };
+        workers.QueueWork(std::move(compress_strip));
     }
+    workers.WaitForRequests();
+}
+
+} // Anonymous namespace
+
+EncoderKernel GetHostEncoderKernel() {
+    return DetectEncoderKernel();
 }
 
 void CompressBC1(std::span<const uint8_t> data, uint32_t width, uint32_t height, uint32_t depth,
-                 std::span<uint8_t> output) {
-    CompressBCN<8, true>(data, width, height, depth, output,
-                         [](u8* block_output, const u8* block_input, bool any_alpha) {
-                             stb_compress_bc1_block(block_output, block_input, any_alpha,
-                                                    STB_DXT_NORMAL);
-                         });
+                 std::span<uint8_t> output, EncoderKernel kernel) {
+    BCNCompressor* compressor = StbCompressBC1;
+#ifdef ARCHITECTURE_x86_64
+    if (kernel == EncoderKernel::SSE) {
+        compressor = SSECompressBC1;
+    }
+#endif
+    CompressBCN<8, true>(data, width, height, depth, output, compressor);
 }
 
 void CompressBC3(std::span<const uint8_t> data, uint32_t width, uint32_t height, uint32_t depth,
-                 std::span<uint8_t> output) {
-    CompressBCN<16, false>(data, width, height, depth, output,
-                           [](u8* block_output, const u8* block_input, bool any_alpha) {
-                               stb_compress_bc3_block(block_output, block_input, STB_DXT_NORMAL);
-                           });
+                 std::span<uint8_t> output, EncoderKernel kernel) {
+    BCNCompressor* compressor = StbCompressBC3;
+#ifdef ARCHITECTURE_x86_64
+    if (kernel == EncoderKernel::SSE) {
+        compressor = SSECompressBC3;
+    }
+#endif
+    CompressBCN<16, false>(data, width, height, depth, output, compressor);
 }
 
 } // namespace Tegra::Texture::BCN
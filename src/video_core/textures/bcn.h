@@ -9,8 +9,20 @@
 
 namespace Tegra::Texture::BCN {
 
-void CompressBC1(std::span<const u8> data, u32 width, u32 height, u32 depth, std::span<u8> output);
+/// Block encoders used to recompress RGBA8 images into BC1 and BC3.
+enum class EncoderKernel : u32 {
+    Stb, ///< stb_dxt, the portable reference encoder
+    SSE, ///< Vectorized principal axis fit with least squares refinement
+};
 
-void CompressBC3(std::span<const u8> data, u32 width, u32 height, u32 depth, std::span<u8> output);
+/// Returns the fastest block encoder the host supports, used by CompressBC1 and CompressBC3 by
+/// default. Encoders the host does not support fall back to Stb.
+EncoderKernel GetHostEncoderKernel();
+
+void CompressBC1(std::span<const u8> data, u32 width, u32 height, u32 depth, std::span<u8> output,
+                 EncoderKernel kernel = GetHostEncoderKernel());
+
+void CompressBC3(std::span<const u8> data, u32 width, u32 height, u32 depth, std::span<u8> output,
+                 EncoderKernel kernel = GetHostEncoderKernel());
 
 } // namespace Tegra::Texture::BCN
@@ -2,10 +2,15 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <array>
+#include <bit>
 #include <cmath>
 #include <cstring>
 #include <span>
 
+#ifdef ARCHITECTURE_x86_64
+#include <immintrin.h>
+#endif
+
 #include "common/alignment.h"
 #include "common/assert.h"
 #include "common/bit_util.h"
@@ -13,8 +18,29 @@
 #include "video_core/gpu.h"
 #include "video_core/textures/decoders.h"
 
+#ifdef ARCHITECTURE_x86_64
+#include "common/x64/cpu_detect.h"
+#endif
+
+#if defined(ARCHITECTURE_x86_64) && !defined(_MSC_VER)
+#define AVX2_TARGET __attribute__((target("avx2")))
+#else
+#define AVX2_TARGET
+#endif
+
 namespace Tegra::Texture {
 namespace {
+GobCopyKernel DetectGobCopyKernel() {
+#ifdef ARCHITECTURE_x86_64
+    if (Common::GetCPUCaps().avx2) {
+        return GobCopyKernel::AVX2;
+    }
+    return GobCopyKernel::SSE;
+#else
+    return GobCopyKernel::Scalar;
+#endif
+}
+
 template <u32 mask>
 constexpr u32 pdep(u32 value) {
     u32 result = 0;
@@ -33,9 +59,195 @@ void incrpdep(u32& value) {
     value = ((value | ~mask) + swizzled_incr) & mask;
 }
 
+/// Byte offset of the 16 byte sector holding linear bytes [chunk * 16, chunk * 16 + 16) of 'row'
+/// inside a GOB. Equivalent to MakeSwizzleTable()[row][chunk * 16].
+constexpr u32 GobSectorOffset(u32 row, u32 chunk) {
+    return (chunk >> 1) * 256 + (row >> 1) * 64 + (chunk & 1) * 32 + (row & 1) * 16;
+}
+
+/// Copies a whole GOB between block linear and pitch linear memory.
+/// When TO_LINEAR is true, 'dst' is the GOB and 'src' the linear data, matching SwizzleImpl.
+template <bool TO_LINEAR>
+using GobCopyFn = void (*)(u8* dst, const u8* src, u32 pitch);
+
+template <bool TO_LINEAR>
+void CopyGobScalar(u8* dst, const u8* src, u32 pitch) {
+    for (u32 row = 0; row < GOB_SIZE_Y; ++row) {
+        for (u32 chunk = 0; chunk < GOB_SIZE_X / 16; ++chunk) {
+            const u32 sector = GobSectorOffset(row, chunk);
+            const u32 linear = row * pitch + chunk * 16;
+            if constexpr (TO_LINEAR) {
+                std::memcpy(dst + sector, src + linear, 16);
+            } else {
+                std::memcpy(dst + linear, src + sector, 16);
+            }
+        }
+    }
+}
+
+#ifdef ARCHITECTURE_x86_64
+template <bool TO_LINEAR>
+void CopyGobSSE(u8* dst, const u8* src, u32 pitch) {
+    for (u32 row = 0; row < GOB_SIZE_Y; ++row) {
+        const u8* const src_row = TO_LINEAR ? src + row * pitch : src;
+        u8* const dst_row = TO_LINEAR ? dst : dst + row * pitch;
+        // Load the whole row before storing it so the four sector moves can be in flight at once
+        __m128i chunks[4];
+        for (u32 chunk = 0; chunk < 4; ++chunk) {
+            const u32 offset = TO_LINEAR ? chunk * 16 : GobSectorOffset(row, chunk);
+            chunks[chunk] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src_row + offset));
+        }
+        for (u32 chunk = 0; chunk < 4; ++chunk) {
+            const u32 offset = TO_LINEAR ? GobSectorOffset(row, chunk) : chunk * 16;
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst_row + offset), chunks[chunk]);
+        }
+    }
+}
+
+/// Two vertically adjacent rows of the same 16 byte column are contiguous inside a GOB, so a
+/// single 32 byte access covers both rows on the swizzled side.
+template <bool TO_LINEAR>
+AVX2_TARGET void CopyGobAVX2(u8* dst, const u8* src, u32 pitch) {
+    for (u32 row = 0; row < GOB_SIZE_Y; row += 2) {
+        for (u32 chunk = 0; chunk < 4; ++chunk) {
+            const u32 sector = GobSectorOffset(row, chunk);
+            const u32 linear = row * pitch + chunk * 16;
+            if constexpr (TO_LINEAR) {
+                const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + linear));
+                const __m128i hi =
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + linear + pitch));
+                const __m256i pair = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + sector), pair);
+            } else {
+                const __m256i pair =
+                    _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + sector));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + linear),
+                                 _mm256_castsi256_si128(pair));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + linear + pitch),
+                                 _mm256_extracti128_si256(pair, 1));
+            }
+        }
+    }
+}
+#endif
+
+template <bool TO_LINEAR>
+GobCopyFn<TO_LINEAR> SelectGobCopy(GobCopyKernel kernel) {
+    if (static_cast<u32>(kernel) > static_cast<u32>(GetHostGobCopyKernel())) {
+        kernel = GobCopyKernel::Scalar;
+    }
+    switch (kernel) {
+#ifdef ARCHITECTURE_x86_64
+    case GobCopyKernel::AVX2:
+        return &CopyGobAVX2<TO_LINEAR>;
+    case GobCopyKernel::SSE:
+        return &CopyGobSSE<TO_LINEAR>;
+#endif
+    default:
+        return &CopyGobScalar<TO_LINEAR>;
+    }
+}
+
+struct BlockLinearLayout {
+    u32 block_size;
+    u32 block_height;
+    u32 block_height_mask;
+    u32 x_shift;
+};
+
+/// Copies texels one at a time for the lines [line_begin, line_end) and columns
+/// [column_begin, column_end) of a slice.
+template <bool TO_LINEAR, u32 BYTES_PER_PIXEL>
+void SwizzleTexels(std::span<u8> output, std::span<const u8> input, const BlockLinearLayout& layout,
+                   u32 offset_z, u32 slice_offset, u32 pitch, u32 origin_x, u32 origin_y,
+                   u32 line_begin, u32 line_end, u32 column_begin, u32 column_end) {
+    for (u32 line = line_begin; line < line_end; ++line) {
+        const u32 y = line + origin_y;
+        const u32 swizzled_y = pdep<SWIZZLE_Y_BITS>(y);
+
+        const u32 block_y = y >> GOB_SIZE_Y_SHIFT;
+        const u32 offset_y = (block_y >> layout.block_height) * layout.block_size +
+                             ((block_y & layout.block_height_mask) << GOB_SIZE_SHIFT);
+
+        u32 swizzled_x = pdep<SWIZZLE_X_BITS>((column_begin + origin_x) * BYTES_PER_PIXEL);
+        for (u32 column = column_begin; column < column_end;
+             ++column, incrpdep<SWIZZLE_X_BITS, BYTES_PER_PIXEL>(swizzled_x)) {
+            const u32 x = (column + origin_x) * BYTES_PER_PIXEL;
+            const u32 offset_x = (x >> GOB_SIZE_X_SHIFT) << layout.x_shift;
+
+            const u32 base_swizzled_offset = offset_z + offset_y + offset_x;
+            const u32 swizzled_offset = base_swizzled_offset + (swizzled_x | swizzled_y);
+
+            const u32 unswizzled_offset = slice_offset + line * pitch + column * BYTES_PER_PIXEL;
+
+            u8* const dst = &output[TO_LINEAR ? swizzled_offset : unswizzled_offset];
+            const u8* const src = &input[TO_LINEAR ? unswizzled_offset : swizzled_offset];
+
+            std::memcpy(dst, src, BYTES_PER_PIXEL);
+        }
+    }
+}
+
+/// Copies 'num_lines' lines of a slice, moving every GOB that is fully covered by the copied
+/// region with a single kernel call and falling back to per-texel copies on the edges.
+template <bool TO_LINEAR, u32 BYTES_PER_PIXEL>
+void SwizzleSlice(std::span<u8> output, std::span<const u8> input, const BlockLinearLayout& layout,
+                  GobCopyFn<TO_LINEAR> copy_gob, u32 offset_z, u32 slice_offset, u32 pitch,
+                  u32 origin_x, u32 origin_y, u32 extent_x, u32 num_lines) {
+    // Texels of non power of two sizes can straddle sectors, keep the per-texel path for them
+    if constexpr (!std::has_single_bit(BYTES_PER_PIXEL)) {
+        SwizzleTexels<TO_LINEAR, BYTES_PER_PIXEL>(output, input, layout, offset_z, slice_offset,
+                                                  pitch, origin_x, origin_y, 0, num_lines, 0,
+                                                  extent_x);
+        return;
+    }
+    const u32 x_begin = origin_x * BYTES_PER_PIXEL;
+    const u32 x_end = (origin_x + extent_x) * BYTES_PER_PIXEL;
+    const u32 gob_x_begin = Common::AlignUpLog2(x_begin, GOB_SIZE_X_SHIFT);
+    const u32 gob_x_end = Common::AlignDown(x_end, GOB_SIZE_X);
+
+    const u32 head_lines = std::min(num_lines, (GOB_SIZE_Y - (origin_y % GOB_SIZE_Y)) % GOB_SIZE_Y);
+    const u32 gob_lines = Common::AlignDown(num_lines - head_lines, GOB_SIZE_Y);
+    if (gob_x_begin >= gob_x_end || gob_lines == 0) {
+        SwizzleTexels<TO_LINEAR, BYTES_PER_PIXEL>(output, input, layout, offset_z, slice_offset,
+                                                  pitch, origin_x, origin_y, 0, num_lines, 0,
+                                                  extent_x);
+        return;
+    }
+    const u32 left_columns = (gob_x_begin - x_begin) / BYTES_PER_PIXEL;
+    const u32 right_column = gob_x_end / BYTES_PER_PIXEL - origin_x;
+
+    SwizzleTexels<TO_LINEAR, BYTES_PER_PIXEL>(output, input, layout, offset_z, slice_offset, pitch,
+                                              origin_x, origin_y, 0, head_lines, 0, extent_x);
+    const u32 body_end = head_lines + gob_lines;
+    for (u32 line = head_lines; line < body_end; line += GOB_SIZE_Y) {
+        const u32 block_y = (line + origin_y) >> GOB_SIZE_Y_SHIFT;
+        const u32 offset_y = (block_y >> layout.block_height) * layout.block_size +
+                             ((block_y & layout.block_height_mask) << GOB_SIZE_SHIFT);
+        const u32 line_offset = slice_offset + line * pitch;
+        for (u32 x = gob_x_begin; x < gob_x_end; x += GOB_SIZE_X) {
+            const u32 swizzled_offset =
+                offset_z + offset_y + ((x >> GOB_SIZE_X_SHIFT) << layout.x_shift);
+            const u32 unswizzled_offset = line_offset + (x - x_begin);
+            u8* const dst = &output[TO_LINEAR ? swizzled_offset : unswizzled_offset];
+            const u8* const src = &input[TO_LINEAR ? unswizzled_offset : swizzled_offset];
+            copy_gob(dst, src, pitch);
+        }
+        const u32 line_end = line + GOB_SIZE_Y;
+        SwizzleTexels<TO_LINEAR, BYTES_PER_PIXEL>(output, input, layout, offset_z, slice_offset,
+                                                  pitch, origin_x, origin_y, line, line_end, 0,
+                                                  left_columns);
+        SwizzleTexels<TO_LINEAR, BYTES_PER_PIXEL>(output, input, layout, offset_z, slice_offset,
+                                                  pitch, origin_x, origin_y, line, line_end,
+                                                  right_column, extent_x);
+    }
+    SwizzleTexels<TO_LINEAR, BYTES_PER_PIXEL>(output, input, layout, offset_z, slice_offset, pitch,
+                                              origin_x, origin_y, body_end, num_lines, 0, extent_x);
+}
+
 template <bool TO_LINEAR, u32 BYTES_PER_PIXEL>
 void SwizzleImpl(std::span<u8> output, std::span<const u8> input, u32 width, u32 height, u32 depth,
-                 u32 block_height, u32 block_depth, u32 stride) {
+                 u32 block_height, u32 block_depth, u32 stride, GobCopyKernel kernel) {
     // The origin of the transformation can be configured here, leave it as zero as the current API
     // doesn't expose it.
     static constexpr u32 origin_x = 0;
@@ -55,43 +267,29 @@ void SwizzleImpl(std::span<u8> output, std::span<const u8> input, u32 width, u32
     const u32 block_depth_mask = (1U << block_depth) - 1;
     const u32 x_shift = GOB_SIZE_SHIFT + block_height + block_depth;
 
+    const BlockLinearLayout layout{
+        .block_size = block_size,
+        .block_height = block_height,
+        .block_height_mask = block_height_mask,
+        .x_shift = x_shift,
+    };
+    const GobCopyFn<TO_LINEAR> copy_gob = SelectGobCopy<TO_LINEAR>(kernel);
+
     for (u32 slice = 0; slice < depth; ++slice) {
         const u32 z = slice + origin_z;
         const u32 offset_z = (z >> block_depth) * slice_size +
                              ((z & block_depth_mask) << (GOB_SIZE_SHIFT + block_height));
-        for (u32 line = 0; line < height; ++line) {
-            const u32 y = line + origin_y;
-            const u32 swizzled_y = pdep<SWIZZLE_Y_BITS>(y);
-
-            const u32 block_y = y >> GOB_SIZE_Y_SHIFT;
-            const u32 offset_y = (block_y >> block_height) * block_size +
-                                 ((block_y & block_height_mask) << GOB_SIZE_SHIFT);
-
-            u32 swizzled_x = pdep<SWIZZLE_X_BITS>(origin_x * BYTES_PER_PIXEL);
-            for (u32 column = 0; column < width;
-                 ++column, incrpdep<SWIZZLE_X_BITS, BYTES_PER_PIXEL>(swizzled_x)) {
-                const u32 x = (column + origin_x) * BYTES_PER_PIXEL;
-                const u32 offset_x = (x >> GOB_SIZE_X_SHIFT) << x_shift;
-
-                const u32 base_swizzled_offset = offset_z + offset_y + offset_x;
-                const u32 swizzled_offset = base_swizzled_offset + (swizzled_x | swizzled_y);
-
-                const u32 unswizzled_offset =
-                    slice * pitch * height + line * pitch + column * BYTES_PER_PIXEL;
-
-                u8* const dst = &output[TO_LINEAR ? swizzled_offset : unswizzled_offset];
-                const u8* const src = &input[TO_LINEAR ? unswizzled_offset : swizzled_offset];
-
-                std::memcpy(dst, src, BYTES_PER_PIXEL);
-            }
-        }
+        SwizzleSlice<TO_LINEAR, BYTES_PER_PIXEL>(output, input, layout, copy_gob, offset_z,
+                                                 slice * pitch * height, pitch, origin_x, origin_y,
+                                                 width, height);
     }
 }
 
 template <bool TO_LINEAR, u32 BYTES_PER_PIXEL>
 void SwizzleSubrectImpl(std::span<u8> output, std::span<const u8> input, u32 width, u32 height,
                         u32 depth, u32 origin_x, u32 origin_y, u32 extent_x, u32 num_lines,
-                        u32 block_height, u32 block_depth, u32 pitch_linear) {
+                        u32 block_height, u32 block_depth, u32 pitch_linear,
+                        GobCopyKernel kernel) {
     // The origin of the transformation can be configured here, leave it as zero as the current API
     // doesn't expose it.
     static constexpr u32 origin_z = 0;
@@ -110,6 +308,14 @@ void SwizzleSubrectImpl(std::span<u8> output, std::span<const u8> input, u32 wid
     const u32 block_depth_mask = (1U << block_depth) - 1;
     const u32 x_shift = GOB_SIZE_SHIFT + block_height + block_depth;
 
+    const BlockLinearLayout layout{
+        .block_size = block_size,
+        .block_height = block_height,
+        .block_height_mask = block_height_mask,
+        .x_shift = x_shift,
+    };
+    const GobCopyFn<TO_LINEAR> copy_gob = SelectGobCopy<TO_LINEAR>(kernel);
+
     u32 unprocessed_lines = num_lines;
     u32 extent_y = std::min(num_lines, height - origin_y);
 
@@ -118,32 +324,9 @@ void SwizzleSubrectImpl(std::span<u8> output, std::span<const u8> input, u32 wid
         const u32 offset_z = (z >> block_depth) * slice_size +
                              ((z & block_depth_mask) << (GOB_SIZE_SHIFT + block_height));
         const u32 lines_in_y = std::min(unprocessed_lines, extent_y);
-        for (u32 line = 0; line < lines_in_y; ++line) {
-            const u32 y = line + origin_y;
-            const u32 swizzled_y = pdep<SWIZZLE_Y_BITS>(y);
-
-            const u32 block_y = y >> GOB_SIZE_Y_SHIFT;
-            const u32 offset_y = (block_y >> block_height) * block_size +
-                                 ((block_y & block_height_mask) << GOB_SIZE_SHIFT);
-
-            u32 swizzled_x = pdep<SWIZZLE_X_BITS>(origin_x * BYTES_PER_PIXEL);
-            for (u32 column = 0; column < extent_x;
-                 ++column, incrpdep<SWIZZLE_X_BITS, BYTES_PER_PIXEL>(swizzled_x)) {
-                const u32 x = (column + origin_x) * BYTES_PER_PIXEL;
-                const u32 offset_x = (x >> GOB_SIZE_X_SHIFT) << x_shift;
-
-                const u32 base_swizzled_offset = offset_z + offset_y + offset_x;
-                const u32 swizzled_offset = base_swizzled_offset + (swizzled_x | swizzled_y);
-
-                const u32 unswizzled_offset =
-                    slice * pitch * height + line * pitch + column * BYTES_PER_PIXEL;
-
-                u8* const dst = &output[TO_LINEAR ? swizzled_offset : unswizzled_offset];
-                const u8* const src = &input[TO_LINEAR ? unswizzled_offset : swizzled_offset];
-
-                std::memcpy(dst, src, BYTES_PER_PIXEL);
-            }
-        }
+        SwizzleSlice<TO_LINEAR, BYTES_PER_PIXEL>(output, input, layout, copy_gob, offset_z,
+                                                 slice * pitch * height, pitch, origin_x, origin_y,
+                                                 extent_x, lines_in_y);
         unprocessed_lines -= lines_in_y;
         if (unprocessed_lines == 0) {
             return;
@@ -153,12 +336,13 @@ void SwizzleSubrectImpl(std::span<u8> output, std::span<const u8> input, u32 wid
 
 template <bool TO_LINEAR>
 void Swizzle(std::span<u8> output, std::span<const u8> input, u32 bytes_per_pixel, u32 width,
-             u32 height, u32 depth, u32 block_height, u32 block_depth, u32 stride_alignment) {
+             u32 height, u32 depth, u32 block_height, u32 block_depth, u32 stride_alignment,
+             GobCopyKernel kernel) {
     switch (bytes_per_pixel) {
 #define BPP_CASE(x)                                                                                \
     case x:                                                                                        \
         return SwizzleImpl<TO_LINEAR, x>(output, input, width, height, depth, block_height,        \
-                                         block_depth, stride_alignment);
+                                         block_depth, stride_alignment, kernel);
         BPP_CASE(1)
         BPP_CASE(2)
         BPP_CASE(3)
@@ -176,37 +360,42 @@ void Swizzle(std::span<u8> output, std::span<const u8> input, u32 bytes_per_pixe
 
 } // Anonymous namespace
 
+GobCopyKernel GetHostGobCopyKernel() {
+    static const GobCopyKernel kernel = DetectGobCopyKernel();
+    return kernel;
+}
+
 void UnswizzleTexture(std::span<u8> output, std::span<const u8> input, u32 bytes_per_pixel,
                       u32 width, u32 height, u32 depth, u32 block_height, u32 block_depth,
-                      u32 stride_alignment) {
+                      u32 stride_alignment, GobCopyKernel kernel) {
     const u32 stride = Common::AlignUpLog2(width, stride_alignment) * bytes_per_pixel;
     const u32 new_bpp = std::min(4U, static_cast<u32>(std::countr_zero(width * bytes_per_pixel)));
     width = (width * bytes_per_pixel) >> new_bpp;
     bytes_per_pixel = 1U << new_bpp;
     Swizzle<false>(output, input, bytes_per_pixel, width, height, depth, block_height, block_depth,
-                   stride);
+                   stride, kernel);
 }
 
 void SwizzleTexture(std::span<u8> output, std::span<const u8> input, u32 bytes_per_pixel, u32 width,
                     u32 height, u32 depth, u32 block_height, u32 block_depth,
-                    u32 stride_alignment) {
+                    u32 stride_alignment, GobCopyKernel kernel) {
     const u32 stride = Common::AlignUpLog2(width, stride_alignment) * bytes_per_pixel;
     const u32 new_bpp = std::min(4U, static_cast<u32>(std::countr_zero(width * bytes_per_pixel)));
     width = (width * bytes_per_pixel) >> new_bpp;
     bytes_per_pixel = 1U << new_bpp;
     Swizzle<true>(output, input, bytes_per_pixel, width, height, depth, block_height, block_depth,
-                  stride);
+                  stride, kernel);
 }
 
 void SwizzleSubrect(std::span<u8> output, std::span<const u8> input, u32 bytes_per_pixel, u32 width,
                     u32 height, u32 depth, u32 origin_x, u32 origin_y, u32 extent_x, u32 extent_y,
-                    u32 block_height, u32 block_depth, u32 pitch_linear) {
+                    u32 block_height, u32 block_depth, u32 pitch_linear, GobCopyKernel kernel) {
     switch (bytes_per_pixel) {
 #define BPP_CASE(x)                                                                                \
     case x:                                                                                        \
         return SwizzleSubrectImpl<true, x>(output, input, width, height, depth, origin_x,          \
                                            origin_y, extent_x, extent_y, block_height,             \
-                                           block_depth, pitch_linear);
+                                           block_depth, pitch_linear, kernel);
         BPP_CASE(1)
         BPP_CASE(2)
         BPP_CASE(3)
@@ -224,13 +413,14 @@ void SwizzleSubrect(std::span<u8> output, std::span<const u8> input, u32 bytes_p
 
 void UnswizzleSubrect(std::span<u8> output, std::span<const u8> input, u32 bytes_per_pixel,
                       u32 width, u32 height, u32 depth, u32 origin_x, u32 origin_y, u32 extent_x,
-                      u32 extent_y, u32 block_height, u32 block_depth, u32 pitch_linear) {
+                      u32 extent_y, u32 block_height, u32 block_depth, u32 pitch_linear,
+                      GobCopyKernel kernel) {
     switch (bytes_per_pixel) {
 #define BPP_CASE(x)                                                                                \
     case x:                                                                                        \
         return SwizzleSubrectImpl<false, x>(output, input, width, height, depth, origin_x,         \
                                             origin_y, extent_x, extent_y, block_height,            \
-                                            block_depth, pitch_linear);
+                                            block_depth, pitch_linear, kernel);
         BPP_CASE(1)
         BPP_CASE(2)
         BPP_CASE(3)
@@ -41,15 +41,26 @@ constexpr SwizzleTable MakeSwizzleTable() {
     return table;
 }
 
+/// Kernels used to move whole GOBs between block linear and pitch linear memory.
+enum class GobCopyKernel : u32 {
+    Scalar,
+    SSE,
+    AVX2,
+};
+
+/// Returns the fastest GOB copy kernel the host supports, used by the swizzle functions by default.
+/// Kernels the host does not support fall back to Scalar.
+GobCopyKernel GetHostGobCopyKernel();
+
 /// Unswizzles a block linear texture into linear memory.
 void UnswizzleTexture(std::span<u8> output, std::span<const u8> input, u32 bytes_per_pixel,
                       u32 width, u32 height, u32 depth, u32 block_height, u32 block_depth,
-                      u32 stride_alignment = 1);
+                      u32 stride_alignment = 1, GobCopyKernel kernel = GetHostGobCopyKernel());
 
 /// Swizzles linear memory into a block linear texture.
 void SwizzleTexture(std::span<u8> output, std::span<const u8> input, u32 bytes_per_pixel, u32 width,
                     u32 height, u32 depth, u32 block_height, u32 block_depth,
-                    u32 stride_alignment = 1);
+                    u32 stride_alignment = 1, GobCopyKernel kernel = GetHostGobCopyKernel());
 
 /// This function calculates the correct size of a texture depending if it's tiled or not.
 std::size_t CalculateSize(bool tiled, u32 bytes_per_pixel, u32 width, u32 height, u32 depth,
@@ -58,12 +69,14 @@ std::size_t CalculateSize(bool tiled, u32 bytes_per_pixel, u32 width, u32 height
 /// Copies an untiled subrectangle into a tiled surface.
 void SwizzleSubrect(std::span<u8> output, std::span<const u8> input, u32 bytes_per_pixel, u32 width,
                     u32 height, u32 depth, u32 origin_x, u32 origin_y, u32 extent_x, u32 extent_y,
-                    u32 block_height, u32 block_depth, u32 pitch_linear);
+                    u32 block_height, u32 block_depth, u32 pitch_linear,
+                    GobCopyKernel kernel = GetHostGobCopyKernel());
 
 /// Copies a tiled subrectangle into a linear surface.
 void UnswizzleSubrect(std::span<u8> output, std::span<const u8> input, u32 bytes_per_pixel,
                       u32 width, u32 height, u32 depth, u32 origin_x, u32 origin_y, u32 extent_x,
-                      u32 extent_y, u32 block_height, u32 block_depth, u32 pitch_linear);
+                      u32 extent_y, u32 block_height, u32 block_depth, u32 pitch_linear,
+                      GobCopyKernel kernel = GetHostGobCopyKernel());
 
 /// Obtains the offset of the gob for positions 'dst_x' & 'dst_y'
 u64 GetGOBOffset(u32 width, u32 height, u32 dst_x, u32 dst_y, u32 block_height,